@@ -4,6 +4,23 @@
  * System-wide audio constants for ESP32 Theremin.
  * Centralizes sample format and sample rate definitions.
  *
+ * OUTPUT CONFIGURATION (build flags, see platformio.ini):
+ *   -DAUDIO_SAMPLE_RATE=22050|44100|48000   Output sample rate (default 22050)
+ *   -DAUDIO_I2S_BITS=16|32                  I2S frame slot width (default 16)
+ *   -DAUDIO_USE_APLL=0|1                    Clock I2S from the audio PLL
+ *
+ * Every rate-dependent size (delay lines, reverb combs, chorus buffer,
+ * limiter look-ahead, block size) is derived from SAMPLE_RATE at startup,
+ * so changing the flag is all that is needed.
+ *
+ * 32-bit frames: the DSP path stays 16-bit; samples are placed in the upper
+ * half of each 32-bit slot (the PCM5102 auto-detects 32-bit frames). This
+ * is the first step of the 24-bit path below - the I2S side is already done.
+ *
+ * APLL: the default I2S clock is derived from the 160 MHz PLL with an integer
+ * divider, so 44.1 kHz comes out slightly off. The APLL generates the exact
+ * rate (at the cost of a bit more power).
+ *
  * IMPORTANT: When upgrading to 24-bit DAC:
  * - Change SAMPLE_BIT_DEPTH to 24
  * - Change sample types from int16_t to int32_t
@@ -32,5 +49,31 @@ namespace Audio {
     // ============================================
     // SYSTEM SAMPLE RATE
     // ============================================
-    constexpr uint32_t SAMPLE_RATE = 22050;  // Hz
+#ifndef AUDIO_SAMPLE_RATE
+#define AUDIO_SAMPLE_RATE 22050
+#endif
+    static_assert(AUDIO_SAMPLE_RATE == 22050 || AUDIO_SAMPLE_RATE == 44100 || AUDIO_SAMPLE_RATE == 48000,
+                  "AUDIO_SAMPLE_RATE must be 22050, 44100 or 48000");
+    constexpr uint32_t SAMPLE_RATE = AUDIO_SAMPLE_RATE;  // Hz
+
+    // ============================================
+    // I2S OUTPUT FORMAT
+    // ============================================
+#ifndef AUDIO_I2S_BITS
+#define AUDIO_I2S_BITS 16
+#endif
+#ifndef AUDIO_USE_APLL
+#define AUDIO_USE_APLL 0
+#endif
+    static_assert(AUDIO_I2S_BITS == 16 || AUDIO_I2S_BITS == 32,
+                  "AUDIO_I2S_BITS must be 16 or 32");
+    constexpr uint8_t I2S_FRAME_BITS = AUDIO_I2S_BITS;
+    constexpr bool I2S_USE_APLL = (AUDIO_USE_APLL != 0);
+
+#if AUDIO_I2S_BITS == 32
+    typedef int32_t I2SSample;   // One channel slot in the I2S DMA buffer
+#else
+    typedef int16_t I2SSample;
+#endif
+    constexpr int I2S_SAMPLE_SHIFT = I2S_FRAME_BITS - SAMPLE_BIT_DEPTH;  // 16-bit sample → slot
 }
@@ -14,10 +14,18 @@
 #include "system/PinConfig.h"
 #include "audio/Oscillator.h"
 #include "audio/effects/EffectsChain.h"
+#include "audio/MasterBus.h"
+#include "audio/HalfBandDecimator.h"
 #include "audio/AudioConstants.h"
+#include "system/StateTracker.h"
+#include "audio/AudioTap.h"
+#include "audio/ParameterMorph.h"
+#include "audio/AutomationLane.h"
+#include "audio/Looper.h"
 
 // Forward declaration to avoid circular dependency
 class PerformanceMonitor;
+class AudioCapture;
 
 // Musical note frequencies (Hz) - Scientific pitch notation
 // Based on A4 = 440 Hz (concert pitch)
@@ -77,6 +85,18 @@ class AudioEngine {
     RIGHT_ONLY     // Signal only on right channel, left muted
   };
 
+  /**
+   * Oscillator render quality presets
+   * QUALITY_HIGH renders the oscillator mix at 2× the sample rate and
+   * decimates it with a half-band FIR, which removes most of the aliasing of
+   * square/saw harmonics on high notes (OCTAVE_UP + RANGE_WIDE). It roughly
+   * doubles the oscillator cost - best used when effects are off.
+   */
+  enum QualityPreset {
+    QUALITY_STANDARD = 0,  // Render at the output rate (default)
+    QUALITY_HIGH = 1       // 2× oversampled render + half-band decimator
+  };
+
   /**
    * Constructor
    * @param perfMon Pointer to PerformanceMonitor instance (optional)
@@ -255,6 +275,11 @@ class AudioEngine {
    */
   EffectsChain* getEffectsChain() { return effectsChain; }
 
+  /**
+   * Get master output stage (drive, limiter, gate)
+   */
+  MasterBus* getMasterBus() { return &masterBus; }
+
   /**
    * Set pitch audio-level smoothing factor
    * @param factor Smoothing factor (0.0 = very smooth, 1.0 = instant)
@@ -291,6 +316,34 @@ class AudioEngine {
    */
   ChannelMode getChannelMode() const;
 
+  /**
+   * Set oscillator render quality preset
+   * Takes effect at the next audio block.
+   * @param preset QUALITY_STANDARD or QUALITY_HIGH
+   */
+  void setQualityPreset(QualityPreset preset);
+
+  /**
+   * Get oscillator render quality preset
+   * @return Current preset
+   */
+  QualityPreset getQualityPreset() const { return qualityPreset; }
+
+  /**
+   * Parameter swap at a buffer boundary (preset recall)
+   * beginSwap() fades the next block out; from then on the audio task
+   * outputs silence without rendering the oscillators or the effects, so
+   * another task can rewrite all their parameters with no partial mix and
+   * no click. holdSwap() claims the muted output (false until the fade-out
+   * is done, or after the timeout has unmuted it - call beginSwap() again);
+   * while held the timeout does not apply. endSwap() releases it and fades
+   * the following block back in. Unclaimed, never stays muted longer than
+   * SWAP_TIMEOUT_BLOCKS.
+   */
+  void beginSwap();
+  bool holdSwap();
+  void endSwap();
+
   /**
    * Set frequency range dynamically (for range presets)
    * @param minFreq Minimum frequency in Hz
@@ -316,6 +369,55 @@ class AudioEngine {
    */
   PerformanceMonitor* getPerformanceMonitor() const { return performanceMonitor; }
 
+  /**
+   * Get configuration change tracker (dirty bits for delta broadcasting)
+   * Oscillator, quality and frequency range setters mark their fields here.
+   */
+  StateTracker* getStateTracker() { return &stateTracker; }
+
+  /**
+   * Get the output tap (final mono output, read by analysis tasks)
+   * Written once per block after the master bus; readers never block audio.
+   */
+  const AudioTap* getOutputTap() const { return &outputTap; }
+
+  /**
+   * Attach the capture recorder (gets the same final output as the tap)
+   * @param recorder AudioCapture, or nullptr
+   */
+  void setCapture(AudioCapture* recorder) { capture = recorder; }
+
+  /**
+   * Get the preset morph (interpolated once per block by the audio task)
+   */
+  ParameterMorph* getMorph() { return &morph; }
+
+  /**
+   * Get the automation lane (recorded parameter moves, replayed per block)
+   */
+  AutomationLane* getAutomation() { return &automation; }
+
+  /**
+   * Get the looper (records the post-effects output, mixed back in per block)
+   */
+  Looper* getLooper() { return &looper; }
+
+  /**
+   * Record a player's change into the automation lane (no-op unless
+   * recording). Front ends call these after the setter; preset recalls and
+   * morphs don't, so only what the player moves is captured.
+   * @param oscNum Oscillator number (1-3)
+   * @param volume Volume (0.0-1.0)
+   */
+  void recordOscillatorVolume(int oscNum, float volume);
+
+  /**
+   * @param effect Registered effect
+   * @param index Parameter index (ignored if the effect can't automate it)
+   * @param value Value in the parameter's natural unit
+   */
+  void recordEffectParam(const AudioEffect* effect, uint8_t index, float value);
+
   /**
    * Calculate maximum audio task time based on buffer configuration
    * This is the time available per buffer before audio underruns occur.
@@ -330,11 +432,28 @@ class AudioEngine {
  private:
   // I2S configuration
   static const int I2S_NUM = 0;                // I2S port number
-  static const int BUFFER_SIZE = 256;          // Samples per buffer
-  static const int DMA_BUFFER_COUNT = 2;       // Number of DMA buffers
+  // Frames per buffer, scaled with the sample rate so a block always lasts
+  // ~11 ms: per-block smoothing, CPU budget and DMA latency stay the same at
+  // 44.1/48 kHz as at 22.05 kHz
+  static const int BUFFER_SIZE = (Audio::SAMPLE_RATE >= 44100) ? 512 : 256;
+  // A DMA descriptor holds at most 4092 bytes: 512 frames of 32-bit stereo
+  // (4096 bytes) are split over twice as many half-length DMA buffers, which
+  // keeps the total DMA latency the same
+  static const int DMA_BUFFER_SPLIT = (BUFFER_SIZE * 2 * sizeof(Audio::I2SSample) > 4092) ? 2 : 1;
+  static const int DMA_BUFFER_LEN = BUFFER_SIZE / DMA_BUFFER_SPLIT;  // Frames per DMA buffer
+  static const int DMA_BUFFER_COUNT = 2 * DMA_BUFFER_SPLIT;          // Number of DMA buffers
+
+  // Audio held by the whole DMA queue (µs) - longest possible gap between
+  // two i2s_write() calls without an underrun
+  static const uint32_t DMA_QUEUE_US =
+      (uint32_t)((uint64_t)DMA_BUFFER_COUNT * DMA_BUFFER_LEN * 1000000ULL / Audio::SAMPLE_RATE);
+
+  // Per-oscillator mix level (fixed headroom: 3 oscillators at full volume = full scale)
+  static constexpr float MIX_LEVEL = 1.0f / 3.0f;
 
   // Audio Buffer Timing: Why 11ms?
   // Buffer duration = BUFFER_SIZE / Audio::SAMPLE_RATE = 256 / 22050 = 11.6ms
+  //                  (512 / 44100 = 11.6ms, 512 / 48000 = 10.7ms)
   // This means the audio task generates a new buffer every ~11ms, which is:
   // - Independent of main loop timing (runs on separate FreeRTOS task on Core 1)
   // - Naturally paced by i2s_write() blocking until DMA buffer is consumed
@@ -375,6 +494,31 @@ class AudioEngine {
   // Stereo channel routing
   ChannelMode currentChannelMode;  // Current channel output mode
 
+  // Oscillator render quality (read once per block by the audio task)
+  volatile QualityPreset qualityPreset;
+  QualityPreset activeQualityPreset;  // Preset used for the last block (audio task only)
+
+  // End of the previous i2s_write() (underrun detection, audio task only)
+  uint32_t lastWriteEndUs;
+
+  // Parameter swap (beginSwap/holdSwap/endSwap): written by the requesting
+  // task to start/claim/finish, by the audio task to advance between
+  // blocks. Every transition is a compare-and-set under swapMux, so the
+  // timeout cannot unmute a swap that holdSwap() has just claimed.
+  enum SwapState : uint8_t {
+    SWAP_IDLE = 0,
+    SWAP_FADE_OUT,   // Next block fades out
+    SWAP_MUTED,      // Silence, oscillators/effects not touched (times out)
+    SWAP_HELD,       // Silence, parameters being rewritten (no timeout)
+    SWAP_FADE_IN     // Next block fades in
+  };
+  static const uint16_t SWAP_TIMEOUT_BLOCKS = 48;  // ~0.5 s of silence at most
+  volatile uint8_t swapState;
+  uint16_t swapMutedBlocks;  // Audio task only
+  portMUX_TYPE swapMux;
+
+  bool advanceSwap(uint8_t from, uint8_t to);
+
   // Oscillator instance
   Oscillator oscillator1;
   Oscillator oscillator2;
@@ -398,7 +542,7 @@ class AudioEngine {
   //   Header:       std::unique_ptr<EffectsChain> effectsChain;
   //   Constructor:  effectsChain.reset(new EffectsChain());  // C++11 compatible
   //   Destructor:   (nothing - automatic cleanup!)
-  //   Usage:        effectsChain->process(sample);  // same syntax with ->
+  //   Usage:        effectsChain->processBlock(block, n);  // same syntax with ->
   //
   // WHY MANUAL PATTERN IS USED HERE:
   //   - Educational reference: Shows traditional C++ memory management
@@ -434,6 +578,21 @@ class AudioEngine {
   // ════════════════════════════════════════════════════════════════════════
   EffectsChain* effectsChain;
 
+  // Master output stage (direct member - fixed size, lives as long as the engine)
+  MasterBus masterBus;
+
+  // 2:1 decimator and 2× render buffer for QUALITY_HIGH
+  HalfBandDecimator decimator;
+  int16_t oversampleBuffer[BUFFER_SIZE * 2];
+
+  // Mono block buffer (oscillator mix -> effects chain -> master bus)
+  // Kept as a member rather than on the 4 KB audio task stack
+  int16_t monoBuffer[BUFFER_SIZE];
+
+  // Interleaved stereo I2S buffer (16- or 32-bit slots, see AUDIO_I2S_BITS)
+  // Up to 4 KB at 512 frames x 32-bit - too large for the audio task stack
+  Audio::I2SSample i2sBuffer[BUFFER_SIZE * 2];
+
   // FreeRTOS task management
   TaskHandle_t audioTaskHandle;
   SemaphoreHandle_t paramMutex;  // Protects frequency/amplitude updates
@@ -441,6 +600,13 @@ class AudioEngine {
 
   // Performance monitoring
   PerformanceMonitor* performanceMonitor;  // Optional monitoring (nullptr = disabled)
+  DSPProfiler* profiler;                   // Per-stage profiling (nullptr = disabled)
+  StateTracker stateTracker;               // Changed configuration fields (web deltas)
+  AudioTap outputTap;                      // Post-master-bus output for scope/spectrum
+  ParameterMorph morph;                    // Preset morph (block-rate interpolation)
+  AutomationLane automation;               // Recorded parameter moves (looped playback)
+  Looper looper;                           // Loop recorder (post-effects, before master bus)
+  AudioCapture* capture;                   // WAV/stream recorder of the final output (nullptr = none)
 
   /**
    * Initialize I2S in built-in DAC mode
@@ -454,6 +620,38 @@ class AudioEngine {
    */
   void generateAudioBuffer();
 
+  /**
+   * Render the oscillator mix into a block buffer
+   * @param out Destination buffer
+   * @param numSamples Samples to render
+   * @param renderRate Rate the oscillators advance at (2× for QUALITY_HIGH)
+   * @param mixGainQ15 Amplitude × mix headroom (Q15)
+   */
+  void renderOscillators(int16_t* out, int numSamples, float renderRate, int32_t mixGainQ15);
+
+  /**
+   * Hand a block's morph values to the oscillators and effects
+   * Volumes and mixes ramp over the block; feedback and room size are set
+   * once. Audio task only (smoothing factors are applied by the caller).
+   * @param params Interpolated set for this block
+   * @param renderSamples Oscillator samples in this block (2× for QUALITY_HIGH)
+   */
+  void applyMorph(const ParameterMorph::Params& params, size_t renderSamples);
+
+  /**
+   * Apply the automation events due in this block (audio task)
+   * Volumes and mixes ramp over the block; the UI follows via StateTracker.
+   * @param events Events from AutomationLane::process()
+   * @param count Number of events
+   * @param renderSamples Oscillator samples in this block (2× for QUALITY_HIGH)
+   */
+  void applyAutomation(const AutomationLane::Event* events, uint8_t count, size_t renderSamples);
+
+  /**
+   * Linear gain ramp over one block (0 -> 1 or 1 -> 0), in place
+   */
+  static void applyGainRamp(int16_t* buffer, int numSamples, bool fadeIn);
+
   /**
    * Convert MIDI note number to frequency (Hz)
    * Uses standard equal temperament tuning: A4 = 440 Hz (MIDI note 69)
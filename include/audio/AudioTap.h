@@ -0,0 +1,100 @@
+/*
+ * AudioTap.h
+ *
+ * Lock-free single-producer ring of the final mono output (after effects
+ * and master bus), for analysis outside the audio task: spectrum/scope
+ * (SpectrumAnalyzer) and pitch detection.
+ *
+ * The audio task only copies its block in and publishes a running sample
+ * counter - it never waits for readers. Readers copy what they need and
+ * then check the counter again: if the writer lapped them during the copy,
+ * the data is discarded (latest-wins, like the telemetry frames).
+ *
+ * Memory: SIZE × 2 bytes (4 KB) - 93 ms at 22.05 kHz, 43 ms at 48 kHz.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+class AudioTap {
+ public:
+  static const uint32_t SIZE = 2048;  // Samples (power of two)
+  static const uint32_t MASK = SIZE - 1;
+
+  AudioTap() : writeCount(0) {
+    memset(buffer, 0, sizeof(buffer));
+  }
+
+  /**
+   * Append a block (audio task only, never blocks)
+   * @param samples Mono samples
+   * @param numSamples Block length (<= SIZE)
+   */
+  inline void write(const int16_t* samples, size_t numSamples) {
+    uint32_t pos = writeCount;
+    uint32_t start = pos & MASK;
+    uint32_t first = SIZE - start;
+    if (first > numSamples) {
+      first = numSamples;
+    }
+    memcpy(&buffer[start], samples, first * sizeof(int16_t));
+    memcpy(&buffer[0], samples + first, (numSamples - first) * sizeof(int16_t));
+
+    // Publish after the data (volatile store - ordered after the copies)
+    writeCount = pos + numSamples;
+  }
+
+  /**
+   * Total samples written since boot (wraps at 2^32)
+   */
+  uint32_t getWriteCount() const { return writeCount; }
+
+  /**
+   * Copy the most recent samples
+   * @param dst Destination (numSamples long)
+   * @param numSamples Samples to copy (<= SIZE / 2 to leave the writer room)
+   * @return false if the writer overwrote them during the copy (try later)
+   */
+  bool readLatest(int16_t* dst, size_t numSamples) const {
+    uint32_t end = writeCount;
+    return copyFrom(end - numSamples, dst, numSamples);
+  }
+
+  /**
+   * Copy samples written since `position` (incremental readers)
+   * A reader that fell more than half the ring behind skips ahead to the
+   * most recent data instead of reading samples being overwritten.
+   * @param position Reader position (sample count), advanced by the samples read
+   * @param dst Destination
+   * @param maxSamples Destination capacity
+   * @return Number of samples copied (0 = nothing new, or lapped during the copy)
+   */
+  size_t read(uint32_t& position, int16_t* dst, size_t maxSamples) const {
+    uint32_t end = writeCount;
+    uint32_t available = end - position;
+    if (available > SIZE / 2) {
+      position = end - SIZE / 2;
+      available = SIZE / 2;
+    }
+    if (available > maxSamples) {
+      available = maxSamples;
+    }
+    if (available == 0 || !copyFrom(position, dst, available)) {
+      return 0;
+    }
+    position += available;
+    return available;
+  }
+
+ private:
+  int16_t buffer[SIZE];
+  volatile uint32_t writeCount;
+
+  bool copyFrom(uint32_t start, int16_t* dst, size_t numSamples) const {
+    for (size_t i = 0; i < numSamples; i++) {
+      dst[i] = buffer[(start + i) & MASK];
+    }
+    // Still valid only if the writer has not wrapped onto the first sample
+    return (writeCount - start) <= SIZE;
+  }
+};
@@ -0,0 +1,158 @@
+/*
+ * AutomationLane.h
+ *
+ * Records parameter moves made by the player (web UI, serial, GPIO) and
+ * plays them back in a loop from the audio task, e.g. a reverb mix sweep
+ * that keeps repeating while both hands play.
+ *
+ * Timing: the audio task advances a frame clock once per block
+ * (process()). A change recorded from another task is stamped with the
+ * frame of the current block plus the time elapsed since that block
+ * started, so the stamp is sample-accurate relative to the rendered audio.
+ * Playback applies each event at the start of the block that contains it
+ * (AudioEngine ramps volumes and mixes across that block).
+ *
+ * Loop: a fixed length (setLoopLength, e.g. from the looper) ends the
+ * recording automatically; without one the length is set by stop(). The
+ * playback phase stays tied to the frame the recording started at, so the
+ * lane stays in step with anything started at the same frame.
+ *
+ * Storage: fixed array of 8-byte events (no heap). Values are stored
+ * normalized over the target's range (16-bit). Consecutive changes of the
+ * same target inside one block are merged, so a slider drag costs at most
+ * one event per block.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include "audio/AudioConstants.h"
+
+class AutomationLane {
+ public:
+  static const uint16_t MAX_EVENTS = 512;              // 4 KB
+  static const uint8_t MAX_EVENTS_PER_BLOCK = 8;       // More are applied one block later
+  static const uint8_t TARGET_OSC_VOLUME = 0xF0;       // + oscillator index (0-2)
+  static const uint32_t MIN_LOOP_FRAMES = 4096;        // Longer than any block
+
+  enum State : uint8_t {
+    STATE_IDLE = 0,
+    STATE_RECORDING,
+    STATE_PLAYING
+  };
+
+  struct Event {
+    uint32_t time;    // Frames from the loop start
+    uint8_t target;   // effectTarget() or oscTarget()
+    uint8_t reserved;
+    uint16_t value;   // 0-65535 over the target's range
+  };
+  static_assert(sizeof(Event) == 8, "Automation events are packed into 8 bytes");
+
+  /**
+   * Target code of an effect parameter
+   * @param effect Registration index (0-14)
+   * @param param Parameter table index (0-15)
+   */
+  static uint8_t effectTarget(uint8_t effect, uint8_t param) { return (effect << 4) | (param & 0x0F); }
+
+  /**
+   * Target code of an oscillator volume
+   * @param oscNum Oscillator number (1-3)
+   */
+  static uint8_t oscTarget(int oscNum) { return TARGET_OSC_VOLUME + (oscNum - 1); }
+
+  /**
+   * Event value back to 0.0-1.0
+   */
+  static float normalized(const Event& event) { return event.value / 65535.0f; }
+
+  AutomationLane();
+
+  /**
+   * Start a new recording (clears the lane, any task)
+   * The loop starts at the current block.
+   */
+  void startRecording();
+
+  /**
+   * Start looping the recorded events (any task)
+   * @return false if nothing is recorded
+   */
+  bool startPlayback();
+
+  /**
+   * Stop recording (then play what was recorded) or stop playback (any task)
+   * Parameters keep their last values.
+   */
+  void stop();
+
+  /**
+   * Erase all events (any task)
+   */
+  void clear();
+
+  /**
+   * Fix the loop length (any task)
+   * Events beyond a shorter length are dropped.
+   * @param frames Length in frames (at least MIN_LOOP_FRAMES), 0 = set by
+   *               the end of the next recording
+   */
+  void setLoopLength(uint32_t frames);
+
+  /**
+   * Record a change if recording (any task, no-op otherwise)
+   * @param target effectTarget() or oscTarget()
+   * @param value New value normalized to 0.0-1.0
+   */
+  void record(uint8_t target, float value);
+
+  /**
+   * Advance the clock by one block and collect the events due in it
+   * (audio task, call once per block before rendering)
+   * More than MAX_EVENTS_PER_BLOCK due events are deferred to the next
+   * block (at the loop end the extra ones are skipped).
+   * @param numFrames Frames in this block
+   * @param out Receives up to MAX_EVENTS_PER_BLOCK events, in time order
+   * @return Number of events in out (0 unless playing)
+   */
+  uint8_t process(uint32_t numFrames, Event* out);
+
+  State getState() const { return state; }
+  uint16_t getEventCount() const { return count; }
+  uint32_t getLoopLength() const { return loopLength; }
+
+  /**
+   * Events lost because the lane was full (since the last recording started)
+   */
+  uint32_t getDropped() const { return dropped; }
+
+ private:
+  Event events[MAX_EVENTS];
+  volatile uint16_t count;
+  uint16_t cursor;               // Next event to play
+  bool seek;                     // Playback (re)started: skip to the loop position
+
+  volatile State state;
+  volatile uint32_t loopLength;  // Frames, 0 = open
+  bool loopLengthFixed;          // Set by setLoopLength(), kept across recordings
+  uint32_t loopStart;            // Clock frame the loop started at
+  volatile uint32_t dropped;
+
+  // Frame clock (written by process())
+  uint32_t blockFrame;           // First frame of the current block
+  uint32_t blockFrames;          // Frames in the current block
+  uint32_t blockStartUs;         // micros() when the current block started
+  portMUX_TYPE mux;
+
+  /**
+   * Current frame, interpolated inside the current block (under mux)
+   */
+  uint32_t now() const;
+
+  /**
+   * Copy events with time < limit into out (audio task, under mux)
+   * @return Events in out
+   */
+  uint8_t collect(uint32_t limit, Event* out, uint8_t found);
+};
@@ -0,0 +1,61 @@
+/*
+ * GainRamp.h
+ *
+ * Per-sample linear ramp for gain-like parameters (oscillator volume,
+ * effect wet/dry mix) changed at block rate, e.g. by ParameterMorph.
+ *
+ * The step is computed once when the ramp starts; each sample then costs
+ * one add, so nothing is re-derived per sample and a new block-rate value
+ * never steps the gain (no zipper noise). The last sample lands exactly on
+ * the target.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+class GainRamp {
+ public:
+  GainRamp() : value(0.0f), target(0.0f), step(0.0f), remaining(0) {}
+
+  /**
+   * Start a ramp
+   * @param from Current value
+   * @param to Target value
+   * @param numSamples Ramp length (usually one block)
+   */
+  void start(float from, float to, size_t numSamples) {
+    value = from;
+    target = to;
+    if (numSamples == 0 || from == to) {
+      remaining = 0;
+      return;
+    }
+    step = (to - from) / (float)numSamples;
+    remaining = numSamples;
+  }
+
+  /**
+   * Stop ramping (a direct set wins over a ramp in progress)
+   */
+  void cancel() { remaining = 0; }
+
+  bool isActive() const { return remaining > 0; }
+
+  /**
+   * Value for the next sample (call only while isActive())
+   */
+  inline float next() {
+    if (--remaining == 0) {
+      value = target;
+    } else {
+      value += step;
+    }
+    return value;
+  }
+
+ private:
+  float value;
+  float target;
+  float step;
+  uint32_t remaining;
+};
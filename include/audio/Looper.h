@@ -0,0 +1,194 @@
+/*
+ * Looper.h
+ *
+ * Loop recorder for the instrument output: records the post-effects signal,
+ * then plays it back mixed in before the master bus, with overdub layers
+ * (the old loop decays by the feedback amount each pass) and undo of the
+ * last layer.
+ *
+ * Storage: one buffer allocated on the first recording - PSRAM when the
+ * module has it, otherwise a much smaller internal RAM buffer. Half holds
+ * the loop, half the undo copy of the layer being overdubbed. Samples are
+ * stored as 16-bit PCM or 8-bit µ-law (twice the loop length, some added
+ * noise per overdub pass); the format can only change while empty.
+ *
+ * Timing: everything happens on the audio task at block boundaries, so
+ * the loop length is a whole number of blocks and every read/write is one
+ * block copy. Per block the work is bounded: one block read and written,
+ * one block copied to the undo area while overdubbing, and at most
+ * UNDO_BLOCKS_PER_CALL blocks restored while an undo runs (the rest of the
+ * loop keeps playing from the undo copy until restored).
+ *
+ * Control (record/play/stop/undo/clear) may come from any task: requests
+ * are posted and taken at the next block boundary; a new request replaces
+ * one not yet taken.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+
+class Looper {
+ public:
+  static const uint32_t PSRAM_BYTES = 2 * 1024 * 1024;  // Loop + undo (~24 s 16-bit at 22.05 kHz)
+  static const uint32_t INTERNAL_BYTES = 64 * 1024;     // Without PSRAM (~1.5 s µ-law at 22.05 kHz)
+  static const size_t MAX_BLOCK = 512;                  // Largest audio block
+  static const uint8_t UNDO_BLOCKS_PER_CALL = 8;
+
+  enum State : uint8_t {
+    STATE_EMPTY = 0,
+    STATE_RECORDING,
+    STATE_PLAYING,
+    STATE_OVERDUBBING,
+    STATE_STOPPED
+  };
+
+  enum Format : uint8_t {
+    FORMAT_PCM16 = 0,
+    FORMAT_ULAW
+  };
+
+  Looper();
+  ~Looper();
+
+  /**
+   * One-button cycle (any task): empty → record → play → overdub → play...,
+   * stopped → play. Allocates the buffer on first use.
+   * @return false if no buffer could be allocated
+   */
+  bool record();
+
+  /**
+   * Play the loop from the start (any task)
+   */
+  void play();
+
+  /**
+   * Stop playback (a recording is closed first, any task)
+   */
+  void stop();
+
+  /**
+   * Remove the last overdub layer (any task)
+   * @return false if there is nothing to undo
+   */
+  bool undo();
+
+  /**
+   * Erase the loop (any task, the buffer stays allocated)
+   */
+  void clear();
+
+  /**
+   * Storage format (only while empty)
+   * @return false if a loop is recorded
+   */
+  bool setFormat(Format fmt);
+
+  /**
+   * Share of the old loop kept on each overdub pass
+   * @param amount 0.0 = replace, 1.0 = keep everything
+   */
+  void setFeedback(float amount) { feedback = constrain(amount, 0.0f, 1.0f); }
+
+  /**
+   * Playback level of the loop
+   * @param amount 0.0-1.0
+   */
+  void setLevel(float amount) { level = constrain(amount, 0.0f, 1.0f); }
+
+  /**
+   * Record and/or mix the loop into one block (audio task)
+   * @param buffer Post-effects block (loop added in place)
+   * @param numSamples Samples in the block (at most MAX_BLOCK, same every call)
+   */
+  void process(int16_t* buffer, size_t numSamples);
+
+  State getState() const { return state; }
+  Format getFormat() const { return format; }
+  float getFeedback() const { return feedback; }
+  float getLevel() const { return level; }
+  bool canUndo() const { return layerBlocks > 0; }
+
+  /**
+   * Loop length and longest possible loop, in samples
+   */
+  uint32_t getLengthSamples() const { return length; }
+  uint32_t getCapacitySamples() const;
+
+  /**
+   * Allocated buffer (0 before the first recording)
+   */
+  uint32_t getMemoryBytes() const { return storageBytes; }
+  bool isPsram() const { return storagePsram; }
+
+ private:
+  enum Request : uint8_t {
+    REQUEST_NONE = 0,
+    REQUEST_CYCLE,
+    REQUEST_PLAY,
+    REQUEST_STOP,
+    REQUEST_UNDO,
+    REQUEST_CLEAR
+  };
+
+  uint8_t* storage;          // Loop area, then undo area
+  uint32_t storageBytes;
+  uint32_t areaBytes;        // Bytes per area
+  bool storagePsram;
+
+  std::atomic<uint8_t> request;
+  volatile State state;
+  volatile Format format;
+  volatile float feedback;
+  volatile float level;
+
+  // Audio task
+  uint32_t blockSize;        // Samples per block (from the first process())
+  volatile uint32_t length;  // Samples, whole blocks
+  uint32_t position;         // Next sample to play/record
+  uint32_t layerStart;       // First block of the last overdub layer
+  volatile uint32_t layerBlocks;  // Blocks saved to the undo area (0 = no undo)
+  bool undoing;
+  uint32_t restoredBlocks;   // Undo progress
+
+  int16_t loopBlock[MAX_BLOCK];  // Loop as it was before this block
+  int16_t mixBlock[MAX_BLOCK];   // Overdub result written back
+
+  static int16_t ulawTable[256];
+
+  /**
+   * Allocate the buffer if not yet done (control tasks only)
+   */
+  bool allocate();
+
+  /**
+   * Apply a request at a block boundary (audio task)
+   */
+  void handleRequest(uint8_t req);
+
+  /**
+   * Close a recording: the recorded blocks become the loop
+   */
+  void closeLoop(State next);
+
+  uint8_t bytesPerSample() const { return (format == FORMAT_ULAW) ? 1 : 2; }
+
+  /**
+   * Block copies between a storage area and 16-bit samples
+   */
+  void readBlock(const uint8_t* area, uint32_t pos, int16_t* out, size_t n) const;
+  void writeBlock(uint8_t* area, uint32_t pos, const int16_t* in, size_t n);
+
+  /**
+   * Whether a block still has to come from the undo area (undo in progress)
+   */
+  bool pendingRestore(uint32_t block) const;
+
+  /**
+   * Restore up to UNDO_BLOCKS_PER_CALL blocks of the last layer
+   */
+  void restoreStep();
+
+  static uint8_t linearToUlaw(int16_t sample);
+};
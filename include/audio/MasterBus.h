@@ -0,0 +1,161 @@
+/*
+ * MasterBus.h
+ *
+ * Master output stage for ESP32 Theremin.
+ * Runs once per block on 32-bit intermediates after the effects chain:
+ *
+ *   effects out (int16) → gate (expander + hysteresis) → drive (makeup gain)
+ *                       → look-ahead peak limiter (optional) → tanh soft clip → int16
+ *
+ * WHY:
+ * - Oscillators are mixed with fixed headroom (see AudioEngine), so the signal
+ *   through the effects is ~10 dB below full scale and never hard-clips there.
+ *   The drive stage brings it back up on a 32-bit intermediate.
+ * - The limiter catches peaks (stacked oscillators, delay feedback build-up)
+ *   before they reach the clipper, so the output can be driven hotter without
+ *   crackle.
+ * - The soft clipper (tanh table) replaces the hard constrain() at the output:
+ *   anything the limiter lets through bends smoothly into full scale instead
+ *   of being flattened.
+ * - The gate replaces the old fixed MASTER_NOISE_GATE_THRESHOLD = 150 hard
+ *   gate: it opens/closes on an envelope with two thresholds (hysteresis) and
+ *   fades with a 1:2 expander curve, so tails decay instead of chattering.
+ *
+ * All processing is integer/fixed point; tanh is evaluated only once when the
+ * table is built.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "audio/AudioConstants.h"
+
+class MasterBus {
+ public:
+  /**
+   * Constructor
+   * @param sampleRate Audio sample rate (used for envelope/release times)
+   */
+  MasterBus(uint32_t sampleRate = Audio::SAMPLE_RATE);
+
+  /**
+   * Process a block through gate, drive, limiter and soft clip
+   * @param buffer Mono samples (modified in place)
+   * @param numSamples Number of samples in buffer
+   */
+  void processBlock(int16_t* buffer, size_t numSamples);
+
+  /**
+   * Set output drive (makeup gain applied after the effects)
+   * @param drive Linear gain (1.0 = unity, 2.0 = +6 dB), constrained to 0.25-4.0
+   */
+  void setDrive(float drive);
+  float getDrive() const { return driveQ12 / 4096.0f; }
+
+  /**
+   * Enable/disable look-ahead peak limiter
+   * When disabled, peaks go straight to the soft clipper (no added latency)
+   */
+  void setLimiterEnabled(bool enabled);
+  bool isLimiterEnabled() const { return limiterEnabled; }
+
+  /**
+   * Enable/disable output gate
+   */
+  void setGateEnabled(bool enabled);
+  bool isGateEnabled() const { return gateEnabled; }
+
+  /**
+   * Set gate thresholds (pre-drive sample level)
+   * @param openLevel Envelope level that opens the gate
+   * @param closeLevel Envelope level that closes the gate (must be < openLevel)
+   */
+  void setGateThresholds(int16_t openLevel, int16_t closeLevel);
+  int16_t getGateOpenLevel() const { return gateOpenLevel; }
+  int16_t getGateCloseLevel() const { return gateCloseLevel; }
+
+  /**
+   * Metering (read from other tasks - single word reads)
+   */
+  bool isGateOpen() const { return gateOpen; }
+  float getLimiterGainReductionDb() const;
+  uint32_t getClipCount() const { return clipCount; }  // Samples bent by soft clipper
+
+  /**
+   * Clear limiter delay line and envelopes
+   */
+  void reset();
+
+  // Defaults
+  static constexpr float DEFAULT_DRIVE = 2.0f;           // +6 dB makeup
+  static constexpr int16_t DEFAULT_GATE_OPEN = 100;      // Pre-drive level (old hard gate: 150 post-gain)
+  static constexpr int16_t DEFAULT_GATE_CLOSE = 60;      // Hysteresis band
+
+ private:
+  // Look-ahead delay: 1.5 ms at the active rate (33 @ 22050 Hz, 72 @ 48 kHz)
+  static constexpr float LOOKAHEAD_MS = 1.5f;
+  static const int MAX_LOOKAHEAD = 80;  // Delay line storage (enough for 48 kHz)
+
+  // Limiter ceiling (-0.5 dBFS). Peaks are held here; the soft clipper shapes
+  // whatever lies between the knee and the ceiling
+  static constexpr int32_t LIMIT_CEILING = 30900;
+
+  // Soft clip: linear below the knee, tanh curve above it
+  static constexpr int32_t CLIP_KNEE = 22938;  // ~0.7 FS (-3 dBFS)
+  static const int CLIP_TABLE_BITS = 8;        // 256 segments
+  static const int CLIP_TABLE_SHIFT = 8;       // Excess over knee >> 8 = table index
+  static const int CLIP_TABLE_SIZE = (1 << CLIP_TABLE_BITS) + 1;
+
+  // Q15 unity gain
+  static constexpr int32_t UNITY_Q15 = 32768;
+
+  uint32_t sampleRate;
+
+  // Drive (Q12: 4096 = 1.0)
+  int32_t driveQ12;
+
+  // Gate state
+  bool gateEnabled;
+  volatile bool gateOpen;
+  int16_t gateOpenLevel;
+  int16_t gateCloseLevel;
+  int32_t gateEnvelope;       // Peak envelope (Q8 sample level)
+  int32_t gateGainQ15;        // Smoothed gate gain
+  int32_t gateAttackStep;     // Q15 per sample (fast open)
+  int gateReleaseShift;       // Envelope release (larger = slower)
+
+  // Limiter state
+  bool limiterEnabled;
+  int32_t delayLine[MAX_LOOKAHEAD];
+  int lookahead;              // Active look-ahead length (samples)
+  int delayIndex;
+  int32_t limiterGainQ15;     // Current gain
+  int32_t limiterTargetQ15;   // Lowest gain needed by samples in the delay line
+  int32_t limiterAttackStep;  // Gain decrement per sample to reach target in time
+  int holdCounter;            // Samples left before release starts
+  int limiterReleaseShift;    // Exponential release (larger = slower)
+  volatile int32_t minGainQ15;  // Lowest gain in last block (metering)
+
+  // Soft clip table (excess over knee → output above knee)
+  int16_t clipTable[CLIP_TABLE_SIZE];
+  volatile uint32_t clipCount;
+
+  /**
+   * Build tanh soft-clip table (called once from constructor)
+   */
+  void buildClipTable();
+
+  /**
+   * Gate: update envelope/state and apply smoothed gain
+   */
+  inline int32_t processGate(int32_t x);
+
+  /**
+   * Limiter: push x into look-ahead line, return delayed sample with gain applied
+   */
+  inline int32_t processLimiter(int32_t x);
+
+  /**
+   * Soft clip 32-bit sample into int16 range via table
+   */
+  inline int16_t softClip(int32_t x);
+};
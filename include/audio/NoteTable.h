@@ -0,0 +1,56 @@
+/*
+ * NoteTable.h
+ *
+ * Frequency → note lookup for the tuner and anything else that needs to
+ * know which note is playing (web tuner, pitch quantizer, LEDs).
+ *
+ * Precomputed semitone boundaries (12-TET, A4 = 440 Hz) from C0 to B8,
+ * searched by binary search: 7 float compares per lookup, no log2f(),
+ * no allocation. Cents are interpolated piecewise-linearly between the
+ * lower boundary, the note centre and the upper boundary (within 0.2 cents
+ * of the exact 1200·log2 value).
+ */
+
+#pragma once
+#include <Arduino.h>
+
+namespace NoteTable {
+    constexpr int FIRST_MIDI = 12;    // C0 (16.35 Hz)
+    constexpr int LAST_MIDI = 119;    // B8 (7902 Hz)
+    constexpr int NUM_NOTES = LAST_MIDI - FIRST_MIDI + 1;
+    constexpr size_t NOTE_BUFFER_SIZE = 5;  // "C#8" + terminator, with margin
+
+    struct NoteInfo {
+        int midiNote;      // MIDI note number (69 = A4)
+        int noteIndex;     // 0-11 (C..B)
+        int octave;        // Scientific pitch octave (A4 → 4)
+        float cents;       // -50..+50 from the note centre
+    };
+
+    /**
+     * Find the nearest note to a frequency
+     * @param frequency Frequency in Hz
+     * @param info Result (unchanged if out of range)
+     * @return false if the frequency is outside C0-B8
+     */
+    bool lookup(float frequency, NoteInfo& info);
+
+    /**
+     * Note name without octave ("C", "C#", ...)
+     * @param noteIndex 0-11
+     */
+    const char* noteName(int noteIndex);
+
+    /**
+     * Centre frequency of a MIDI note (table range only)
+     * @return Frequency in Hz, or 0 outside FIRST_MIDI-LAST_MIDI
+     */
+    float noteFrequency(int midiNote);
+
+    /**
+     * Format note name with octave ("C#4") into a fixed buffer
+     * @param info Lookup result
+     * @param buffer Destination (NOTE_BUFFER_SIZE bytes)
+     */
+    void formatNote(const NoteInfo& info, char* buffer, size_t size);
+}
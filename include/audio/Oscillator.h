@@ -9,6 +9,7 @@
 #pragma once
 #include <Arduino.h>
 #include "audio/AudioConstants.h"
+#include "audio/GainRamp.h"
 
 class Oscillator {
  public:
@@ -53,6 +54,15 @@ class Oscillator {
    */
   void setVolume(float vol);
 
+  /**
+   * Ramp volume to a target over the next numSamples samples
+   * Block-rate automation from the audio task (ParameterMorph): one add
+   * per sample, no step in the gain.
+   * @param vol Target volume (0.0-1.0)
+   * @param numSamples Ramp length in rendered samples
+   */
+  void rampVolume(float vol, size_t numSamples);
+
   // Octave shift constants
   static constexpr int OCTAVE_DOWN = -1;  // One octave down (half frequency)
   static constexpr int OCTAVE_BASE = 0;   // No shift (base frequency)
@@ -118,6 +128,7 @@ class Oscillator {
   Waveform waveform;  // Current waveform
   int octaveShift;    // Octave shift (-1, 0, +1)
   float volume;       // Volume level (0.0 - 1.0)
+  GainRamp volumeRamp;  // Active while a rampVolume() is in progress
 
   /**
    * Calculate frequency with octave shift applied
@@ -0,0 +1,91 @@
+/*
+ * ParameterMorph.h
+ *
+ * Continuous interpolation between two parameter sets (two stored presets,
+ * see PresetManager::startMorph), driven by a 0.0-1.0 position from the
+ * web UI, serial or a sensor axis.
+ *
+ * Morphed: oscillator volumes, effect wet/dry mixes, delay feedback,
+ * reverb room size and the audio smoothing factors. Everything else
+ * (waveforms, octaves, effect order...) is set once when the morph starts.
+ *
+ * Runs on the audio task once per block: the position is smoothed, every
+ * parameter is interpolated once, and AudioEngine hands gain-like values
+ * (volumes, mixes) to per-sample ramps (GainRamp) and the rest to
+ * block-rate setters. Nothing is re-derived per sample.
+ *
+ * Endpoints are handed over from the loop task under a short critical
+ * section and picked up at the next block boundary.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+
+class ParameterMorph {
+ public:
+  static const uint8_t NUM_OSCILLATORS = 3;
+  static const uint8_t MAX_EFFECTS = 4;
+
+  struct Params {
+    float oscVolume[NUM_OSCILLATORS];  // 0.0-1.0 (0 for an oscillator that is OFF)
+    float effectMix[MAX_EFFECTS];      // Registration order (0 for a disabled effect)
+    float delayFeedback;
+    float reverbRoomSize;
+    float pitchSmoothing;              // AudioEngine smoothing factors
+    float volumeSmoothing;
+  };
+
+  ParameterMorph();
+
+  /**
+   * Start morphing between two parameter sets (any task)
+   * @param from Set at position 0.0
+   * @param to Set at position 1.0
+   */
+  void start(const Params& from, const Params& to);
+
+  /**
+   * Stop morphing; parameters keep their last interpolated values
+   */
+  void stop() { active = false; }
+
+  bool isActive() const { return active; }
+
+  /**
+   * Set the morph position (any task)
+   * @param pos 0.0 = first set, 1.0 = second set
+   */
+  void setPosition(float pos) { targetPosition = constrain(pos, 0.0f, 1.0f); }
+  float getPosition() const { return targetPosition; }
+
+  /**
+   * Interpolate the parameters for the next block (audio task)
+   * @param out Interpolated set
+   * @return false if not morphing (out untouched)
+   */
+  bool process(Params& out);
+
+ private:
+  // Per-block approach of the smoothed position to the target (~40 ms
+  // time constant at 22.05 kHz / 256 frames), so coarse UI or sensor
+  // steps become a glide
+  static constexpr float POSITION_SMOOTHING = 0.25f;
+
+  // Handed over by start(), copied by the audio task
+  Params pendingFrom;
+  Params pendingTo;
+  volatile bool pending;
+  portMUX_TYPE mux;
+
+  // Audio task copy
+  Params from;
+  Params to;
+  float position;
+  bool running;
+
+  volatile bool active;
+  volatile float targetPosition;
+
+  static float lerp(float a, float b, float t) { return a + (b - a) * t; }
+};
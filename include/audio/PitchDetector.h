@@ -0,0 +1,124 @@
+/*
+ * PitchDetector.h
+ *
+ * Measures the pitch of the actual output (YIN) for the tuner, so it shows
+ * what is heard - octave shifts, smoothing glide and effects included -
+ * instead of the target frequency handed to the oscillators.
+ *
+ *   AudioTap (post master bus) → half-band ÷2/÷4 (~11-12 kHz) → history ring
+ *   → YIN difference function (lag-sliced) → CMNDF threshold → parabolic
+ *   interpolation → frequency
+ *
+ * WHY THIS SHAPE:
+ * - Runs in its own task on Core 0 at priority 1; the audio task only fills
+ *   the tap (a memcpy), so detection never touches the audio deadline.
+ * - Decimation: the theremin fundamental is at most ~1.8 kHz (880 Hz range
+ *   top, +1 octave), so one or two HalfBandDecimator stages keep it while
+ *   cutting the difference function cost by 4-16×. A plain pair average
+ *   lets bright waveforms alias and pulls high notes sharp.
+ * - Incremental: each wake-up ingests the new samples and computes only a
+ *   slice of lags of the current estimate, so the work per wake-up is small
+ *   and bounded. An estimate completes every ~23 ms.
+ * - Silent windows (below the gate) skip the difference function entirely.
+ *
+ * Range: 50 Hz - 2 kHz. Below the gate or without a clear period (CMNDF
+ * minimum above the threshold), getFrequency() returns 0.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "audio/AudioTap.h"
+#include "audio/AudioConstants.h"
+#include "audio/HalfBandDecimator.h"
+
+class PitchDetector {
+ public:
+  static const int DECIMATION = (Audio::SAMPLE_RATE >= 44100) ? 4 : 2;
+  static const uint32_t DETECT_RATE = Audio::SAMPLE_RATE / DECIMATION;  // Hz
+
+  static const int MIN_FREQUENCY = 50;    // Hz (55 Hz = lowest range, octave down)
+  static const int MAX_FREQUENCY = 2000;  // Hz
+  static const int MIN_LAG = DETECT_RATE / MAX_FREQUENCY;
+  static const int MAX_LAG = DETECT_RATE / MIN_FREQUENCY;
+
+  static const int WINDOW_SIZE = 256;     // Integration window (decimated samples)
+  static const int HISTORY_SIZE = 512;    // Power of two, >= WINDOW_SIZE + MAX_LAG
+  static_assert(WINDOW_SIZE + MAX_LAG <= HISTORY_SIZE, "Pitch history too short for MAX_LAG");
+  static_assert(WINDOW_SIZE >= MAX_LAG, "YIN window must cover the longest period");
+
+  /**
+   * Constructor
+   * @param outputTap Output ring to analyze (AudioEngine::getOutputTap())
+   */
+  PitchDetector(const AudioTap* outputTap);
+
+  ~PitchDetector();
+
+  /**
+   * Start the detection task (Core 0, priority 1)
+   * @return true if the task was created
+   */
+  bool begin();
+
+  /**
+   * Detected fundamental frequency
+   * @return Frequency in Hz, or 0 if no clear pitch (silence/noise)
+   */
+  float getFrequency() const { return frequency; }
+
+  /**
+   * Periodicity of the last estimate (1 - CMNDF minimum)
+   * @return 0.0 (noise) to 1.0 (perfectly periodic)
+   */
+  float getClarity() const { return clarity; }
+
+  /**
+   * Check whether the detector is running (task started)
+   */
+  bool isRunning() const { return taskHandle != nullptr; }
+
+ private:
+  static const uint32_t POLL_INTERVAL_MS = 5;   // Wake-up period (audio block ≈ 11.6 ms)
+  static const int READ_CHUNK = 256;            // Tap samples per read (multiple of DECIMATION)
+  static const int LAGS_PER_SLICE = 64;         // Difference function lags per wake-up
+  static const int GATE_LEVEL = 100;            // RMS below this (≈ -50 dBFS) = no pitch
+  static constexpr float YIN_THRESHOLD = 0.15f;
+  static const int REFINE_LAG = 64;             // Interpolate at a period multiple near this lag
+
+  const AudioTap* tap;
+  TaskHandle_t taskHandle;
+  uint32_t tapPosition;
+
+  int16_t chunk[READ_CHUNK];     // Tap read buffer
+
+  // Anti-alias + decimation (second stage only at 44.1/48 kHz)
+  HalfBandDecimator stage1;
+  HalfBandDecimator stage2;
+  int16_t stage1Out[READ_CHUNK / 2];
+  int16_t stage2Out[READ_CHUNK / 4];
+
+  // Decimated history ring
+  int16_t history[HISTORY_SIZE];
+  uint32_t historyCount;         // Decimated samples since the last reset
+  uint32_t samplesSinceEstimate;
+
+  // Estimate in progress: snapshot of the newest WINDOW_SIZE + MAX_LAG samples
+  int16_t frame[WINDOW_SIZE + MAX_LAG];
+  float diff[MAX_LAG + 1];       // YIN difference function d(tau)
+  float normalized[MAX_LAG + 1]; // Cumulative mean normalized d'(tau)
+  int nextLag;                   // Next lag to compute, 0 = no estimate running
+
+  volatile float frequency;
+  volatile float clarity;
+
+  static void taskFunction(void* parameter);
+  void poll();
+  void ingest(const int16_t* samples, size_t numSamples);
+  void append(const int16_t* samples, size_t numSamples);
+  void reset();
+  bool startEstimate();
+  void computeSlice();
+  void finishEstimate();
+};
@@ -0,0 +1,134 @@
+/*
+ * AudioEffect.h
+ *
+ * Common interface for all effects hosted by EffectsChain.
+ *
+ * Each effect describes its own parameters through a static descriptor table
+ * (EffectParam). The web UI, serial console and OLED page walk that table
+ * instead of knowing about DelayEffect/ChorusEffect/ReverbEffect by name, so
+ * adding an effect only means implementing this interface and registering it
+ * in EffectsChain.
+ *
+ * Audio is processed one block at a time (processBlock), so the virtual call
+ * and the enabled check happen once per buffer instead of once per sample.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <strings.h>  // for strcasecmp
+#include "audio/GainRamp.h"
+
+/**
+ * Parameter descriptor (one row of an effect's parameter table)
+ *
+ * key      - Identifier used by WebSocket JSON and serial commands ("time", "roomSize")
+ * alias    - Optional short serial alias ("room"), nullptr if none
+ * label    - Short label for the OLED page ("Time")
+ * unit     - Display unit ("ms", "Hz", "%", "")
+ * minValue - Lowest accepted value (setters constrain to this range)
+ * maxValue - Highest accepted value
+ * step     - Suggested UI step (slider resolution)
+ * displayScale - Multiplier applied for display (100 for 0.0-1.0 shown as %)
+ */
+struct EffectParam {
+    const char* key;
+    const char* alias;
+    const char* label;
+    const char* unit;
+    float minValue;
+    float maxValue;
+    float step;
+    float displayScale;
+};
+
+class AudioEffect {
+public:
+    virtual ~AudioEffect() {}
+
+    /**
+     * Effect identifier used by web/serial ("delay", "chorus", "reverb")
+     */
+    virtual const char* getName() const = 0;
+
+    /**
+     * Three-letter tag for compact displays ("DLY", "CHR", "REV")
+     */
+    virtual const char* getShortName() const = 0;
+
+    /**
+     * Process a block of mono samples in place
+     * Bypassed effects return immediately without touching the buffer.
+     * @param buffer Samples to process (modified in place)
+     * @param numSamples Number of samples in buffer
+     */
+    virtual void processBlock(int16_t* buffer, size_t numSamples) = 0;
+
+    /**
+     * Enable/disable effect
+     */
+    virtual void setEnabled(bool enabled) = 0;
+    virtual bool isEnabled() const = 0;
+
+    /**
+     * Clear internal buffers (silence)
+     */
+    virtual void reset() = 0;
+
+    /**
+     * Parameter table access
+     */
+    virtual uint8_t getParamCount() const = 0;
+    virtual const EffectParam& getParamInfo(uint8_t index) const = 0;
+
+    /**
+     * Get/set parameter by table index
+     * Values are in the parameter's natural unit (ms, Hz, 0.0-1.0)
+     */
+    virtual float getParam(uint8_t index) const = 0;
+    virtual void setParam(uint8_t index, float value) = 0;
+
+    /**
+     * Ramp the wet/dry mix to a target over the next numSamples samples
+     * Block-rate automation from the audio task (ParameterMorph): no
+     * logging, one add per sample. Effects without a mix ignore it.
+     * @param mix Target mix (0.0-1.0)
+     * @param numSamples Ramp length (usually one block)
+     */
+    virtual void rampMix(float mix, size_t numSamples) {}
+
+    /**
+     * Set a parameter from the audio task (AutomationLane playback)
+     * No logging and no allocation; the mix ramps over numSamples.
+     * Parameters that can't change safely there (e.g. the delay time,
+     * which resizes its buffer) are refused.
+     * @param index Parameter index
+     * @param value Value in the parameter's natural unit
+     * @param numSamples Ramp length for the mix (usually one block)
+     * @return false if the parameter can't be automated
+     */
+    virtual bool automateParam(uint8_t index, float value, size_t numSamples) { return false; }
+
+    /**
+     * Whether automateParam() accepts a parameter
+     */
+    virtual bool isAutomatable(uint8_t index) const { return false; }
+
+    /**
+     * Find parameter index by key or alias (case-insensitive, serial
+     * command arguments keep the case they were typed in)
+     * @return Parameter index, or -1 if not found
+     */
+    int findParam(const char* key) const {
+        if (key == nullptr) {
+            return -1;
+        }
+        for (uint8_t i = 0; i < getParamCount(); i++) {
+            const EffectParam& info = getParamInfo(i);
+            if (strcasecmp(key, info.key) == 0 ||
+                (info.alias != nullptr && strcasecmp(key, info.alias) == 0)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+};
@@ -111,6 +111,7 @@
 #include <memory>
 #include "audio/Oscillator.h"  // Reuse Oscillator as LFO!
 #include "audio/AudioConstants.h"
+#include "audio/effects/AudioEffect.h"
 
 /*
  * MEMORY MANAGEMENT EVOLUTION:
@@ -136,7 +137,7 @@
  *   std::vector:        Automatic, safe, ~12 bytes overhead, overkill for fixed buffers
  */
 
-class ChorusEffect {
+class ChorusEffect : public AudioEffect {
 public:
     /**
      * Constructor
@@ -161,11 +162,16 @@ public:
      */
     int16_t process(int16_t input);
 
+    /**
+     * Process a block of samples in place (AudioEffect interface)
+     */
+    void processBlock(int16_t* buffer, size_t numSamples) override;
+
     /**
      * Enable/disable effect
      */
-    void setEnabled(bool enabled);
-    bool isEnabled() const { return enabled; }
+    void setEnabled(bool enabled) override;
+    bool isEnabled() const override { return enabled; }
 
     /**
      * Set LFO rate (modulation speed)
@@ -188,7 +194,7 @@ public:
     /**
      * Clear delay buffer
      */
-    void reset();
+    void reset() override;
 
     /**
      * Get current settings
@@ -202,7 +208,24 @@ public:
      */
     void setPreset(Preset preset);
 
+    /**
+     * AudioEffect interface: identification and parameter table
+     * Params: 0 = rate (Hz), 1 = depth (ms), 2 = mix
+     */
+    const char* getName() const override { return "chorus"; }
+    const char* getShortName() const override { return "CHR"; }
+    uint8_t getParamCount() const override { return PARAM_COUNT; }
+    const EffectParam& getParamInfo(uint8_t index) const override;
+    float getParam(uint8_t index) const override;
+    void setParam(uint8_t index, float value) override;
+    void rampMix(float mix, size_t numSamples) override;
+    bool automateParam(uint8_t index, float value, size_t numSamples) override;
+    bool isAutomatable(uint8_t index) const override;
+
 private:
+    static const uint8_t PARAM_COUNT = 3;
+    static const EffectParam PARAMS[PARAM_COUNT];
+
     std::unique_ptr<int16_t[]> delayBuffer;  // Fixed-size buffer (auto-managed)
     size_t bufferSize;
     size_t writeIndex;
@@ -212,6 +235,7 @@ private:
     Oscillator lfo;        // LFO using Oscillator class!
     float lfoDepthMs;      // Modulation depth in milliseconds
     float wetDryMix;       // Wet/dry mix
+    GainRamp mixRamp;  // Active while a rampMix() is in progress
     bool enabled;
 
     /**
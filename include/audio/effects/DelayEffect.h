@@ -76,6 +76,7 @@
 #include <Arduino.h>
 #include <vector>
 #include "audio/AudioConstants.h"
+#include "audio/effects/AudioEffect.h"
 
 /*
  * MEMORY MANAGEMENT EVOLUTION:
@@ -101,7 +102,7 @@
  *   std::vector:        Automatic, safe, tiny overhead, built-in resize (BEST for dynamic)
  */
 
-class DelayEffect {
+class DelayEffect : public AudioEffect {
 public:
     /**
      * Constructor
@@ -129,16 +130,21 @@ public:
      */
     int16_t process(int16_t input);
 
+    /**
+     * Process a block of samples in place (AudioEffect interface)
+     */
+    void processBlock(int16_t* buffer, size_t numSamples) override;
+
     /**
      * Enable or disable the effect
      * When disabled, process() returns input unchanged (bypass)
      */
-    void setEnabled(bool enabled);
+    void setEnabled(bool enabled) override;
 
     /**
      * Check if effect is enabled
      */
-    bool isEnabled() const { return enabled; }
+    bool isEnabled() const override { return enabled; }
 
     /**
      * Set delay time
@@ -153,6 +159,12 @@ public:
      */
     void setFeedback(float fb);
 
+    /**
+     * Block-rate feedback update from the audio task (ParameterMorph)
+     * Same as setFeedback() without logging.
+     */
+    void automateFeedback(float fb) { feedback = constrain(fb, 0.0f, 0.95f); }
+
     /**
      * Set wet/dry mix
      * @param mix Mix amount (0.0 = dry only, 1.0 = wet only, 0.5 = 50/50)
@@ -162,7 +174,7 @@ public:
     /**
      * Clear delay buffer (silence)
      */
-    void reset();
+    void reset() override;
 
     /**
      * Get current settings
@@ -176,7 +188,24 @@ public:
      */
     void setPreset(Preset preset);
 
+    /**
+     * AudioEffect interface: identification and parameter table
+     * Params: 0 = time (ms), 1 = feedback, 2 = mix
+     */
+    const char* getName() const override { return "delay"; }
+    const char* getShortName() const override { return "DLY"; }
+    uint8_t getParamCount() const override { return PARAM_COUNT; }
+    const EffectParam& getParamInfo(uint8_t index) const override;
+    float getParam(uint8_t index) const override;
+    void setParam(uint8_t index, float value) override;
+    void rampMix(float mix, size_t numSamples) override;
+    bool automateParam(uint8_t index, float value, size_t numSamples) override;
+    bool isAutomatable(uint8_t index) const override;
+
 private:
+    static const uint8_t PARAM_COUNT = 3;
+    static const EffectParam PARAMS[PARAM_COUNT];
+
     std::vector<int16_t> delayBuffer;  // Circular buffer (auto-managed, resizable)
     size_t writeIndex;                  // Current write position
 
@@ -185,6 +214,7 @@ private:
 
     float feedback;            // Feedback amount (0.0-0.95)
     float wetDryMix;           // Wet/dry mix (0.0-1.0)
+    GainRamp mixRamp;  // Active while a rampMix() is in progress
     bool enabled;              // Effect bypass
 
     /**
@@ -2,14 +2,23 @@
  * EffectsChain.h
  *
  * Manages chain of audio effects applied to mixed oscillator output.
+ *
+ * Effects are registered once (fixed storage, no heap churn at runtime) and
+ * then placed into processing slots. The slot order can be changed at runtime
+ * (serial "effects:order:...", WebSocket "setEffectOrder"), and everything that
+ * needs to list effects or their parameters goes through the AudioEffect
+ * interface (getEffectCount/getEffect/findEffect) instead of naming them.
  */
 
 #pragma once
 #include <Arduino.h>
 #include "audio/AudioConstants.h"
+#include "audio/effects/AudioEffect.h"
 #include "audio/effects/DelayEffect.h"
 #include "audio/effects/ChorusEffect.h"
 #include "audio/effects/ReverbEffect.h"
+#include "system/DSPProfiler.h"
+#include "system/StateTracker.h"
 
 class EffectsChain {
 public:
@@ -20,11 +29,12 @@ public:
     EffectsChain(uint32_t sampleRate = Audio::SAMPLE_RATE);
 
     /**
-     * Process audio sample through effect chain
-     * @param input Mixed oscillator output
-     * @return Processed sample with effects applied
+     * Process a block of mono samples through all slots, in slot order
+     * Each effect is dispatched once per block (not once per sample).
+     * @param buffer Mixed oscillator output (modified in place)
+     * @param numSamples Number of samples in buffer
      */
-    int16_t process(int16_t input);
+    void processBlock(int16_t* buffer, size_t numSamples);
 
     /**
      * Enable/disable individual effects
@@ -34,17 +44,92 @@ public:
     void setReverbEnabled(bool enabled);
 
     /**
-     * Get effect instances (for parameter control)
+     * Get effect instances (for preset control)
      */
     DelayEffect* getDelay() { return &delay; }
     ChorusEffect* getChorus() { return &chorus; }
     ReverbEffect* getReverb() { return &reverb; }
 
+    /**
+     * Generic effect access (registration order, independent of slot order)
+     */
+    uint8_t getEffectCount() const { return NUM_EFFECTS; }
+    AudioEffect* getEffect(uint8_t index);
+
+    /**
+     * Find effect by name ("delay", "chorus", "reverb"), case-insensitive
+     * @return Effect pointer, or nullptr if no effect has that name
+     */
+    AudioEffect* findEffect(const char* name);
+
+    /**
+     * Get effect occupying a processing slot
+     * @param slot Slot index (0 = first effect applied)
+     * @return Effect pointer, or nullptr if slot is out of range
+     */
+    AudioEffect* getSlot(uint8_t slot);
+
+    /**
+     * Set processing order from a comma-separated list of effect names
+     * e.g. "reverb,delay,chorus". Effects not listed keep their relative
+     * order and are appended after the listed ones.
+     * @param csv Comma-separated effect names
+     * @return true if every listed name was valid (order applied)
+     */
+    bool setOrder(const char* csv);
+
+    /**
+     * Move a single effect to a slot position, shifting the others
+     * @param name Effect name
+     * @param position Target slot (0 = first)
+     * @return true if effect exists and order was applied
+     */
+    bool moveEffect(const char* name, uint8_t position);
+
+    /**
+     * Enable/disable an effect and report the change (web/serial/GPIO use
+     * these rather than calling the effect directly, so deltas are sent)
+     * @param effect Registered effect
+     * @param enabled New state
+     */
+    void setEffectEnabled(AudioEffect* effect, bool enabled);
+
+    /**
+     * Set an effect parameter by table index and report the change
+     * @param effect Registered effect
+     * @param index Parameter index (see AudioEffect::getParamInfo)
+     * @param value Value in the parameter's natural unit
+     */
+    void setEffectParam(AudioEffect* effect, uint8_t index, float value);
+
+    /**
+     * Report a change made directly on an effect (e.g. setPreset())
+     * @param effect Registered effect
+     */
+    void notifyEffectChanged(const AudioEffect* effect);
+
+    /**
+     * Reset slot order to registration order (delay -> chorus -> reverb)
+     */
+    void resetOrder();
+
     /**
      * Reset all effect buffers
      */
     void reset();
 
+    /**
+     * Attach per-stage profiler (each effect is timed as its own stage)
+     * @param prof Profiler, or nullptr to disable
+     */
+    void setProfiler(DSPProfiler* prof) { profiler = prof; }
+
+    /**
+     * Attach change tracker (enable/param/order changes mark dirty bits)
+     * @param tracker Tracker, or nullptr to disable
+     */
+    void setStateTracker(StateTracker* tracker) { stateTracker = tracker; }
+
     /**
      * Get effect enable states
      */
@@ -53,9 +138,43 @@ public:
     bool isReverbEnabled() const;
 
 private:
+    static const uint8_t NUM_EFFECTS = 3;
+    static_assert(NUM_EFFECTS <= StateTracker::MAX_EFFECTS, "StateTracker has one dirty bit per effect");
+
     uint32_t sampleRate;
 
     DelayEffect delay;
     ChorusEffect chorus;
     ReverbEffect reverb;
+
+    // Registered effects (fixed storage, registration order)
+    AudioEffect* effects[NUM_EFFECTS];
+
+    // Slot order packed one effect index per byte (slot 0 in the low byte).
+    // A single aligned 32-bit store is atomic on the ESP32, so the audio task
+    // always sees a complete permutation even while the order is being changed
+    // from Core 0 - no mutex needed in the audio path.
+    volatile uint32_t slotOrder;
+
+    // Optional per-stage profiler (only used when ENABLE_DSP_PROFILING = 1)
+    DSPProfiler* profiler;
+
+    // Optional change tracker (web delta broadcasting)
+    StateTracker* stateTracker;
+
+    /**
+     * Pack an index array into the slotOrder word and publish it
+     */
+    void applyOrder(const uint8_t order[NUM_EFFECTS]);
+
+    /**
+     * Find registration index of an effect by name
+     * @return Index, or -1 if not found
+     */
+    int findEffectIndex(const char* name, size_t len) const;
+
+    /**
+     * Mark an effect's dirty bit by pointer (no-op without a tracker)
+     */
+    void markEffect(const AudioEffect* effect);
 };
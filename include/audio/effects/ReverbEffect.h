@@ -13,8 +13,9 @@
 #pragma once
 #include <Arduino.h>
 #include "audio/AudioConstants.h"
+#include "audio/effects/AudioEffect.h"
 
-class ReverbEffect {
+class ReverbEffect : public AudioEffect {
 public:
     /**
      * Constructor
@@ -39,11 +40,16 @@ public:
      */
     int16_t process(int16_t input);
 
+    /**
+     * Process a block of samples in place (AudioEffect interface)
+     */
+    void processBlock(int16_t* buffer, size_t numSamples) override;
+
     /**
      * Enable/disable effect
      */
-    void setEnabled(bool enabled);
-    bool isEnabled() const { return enabled; }
+    void setEnabled(bool enabled) override;
+    bool isEnabled() const override { return enabled; }
 
     /**
      * Set room size
@@ -51,6 +57,13 @@ public:
      */
     void setRoomSize(float size);
 
+    /**
+     * Block-rate room size update from the audio task (ParameterMorph)
+     * Same as setRoomSize() without logging; the comb coefficients are
+     * derived once per call, not per sample.
+     */
+    void automateRoomSize(float size);
+
     /**
      * Set damping (high-frequency absorption)
      * @param damp Damping amount (0.0 = bright, 1.0 = dark/muffled)
@@ -66,7 +79,7 @@ public:
     /**
      * Clear all delay buffers
      */
-    void reset();
+    void reset() override;
 
     /**
      * Get current settings
@@ -80,7 +93,24 @@ public:
      */
     void setPreset(Preset preset);
 
+    /**
+     * AudioEffect interface: identification and parameter table
+     * Params: 0 = roomSize, 1 = damping, 2 = mix
+     */
+    const char* getName() const override { return "reverb"; }
+    const char* getShortName() const override { return "REV"; }
+    uint8_t getParamCount() const override { return PARAM_COUNT; }
+    const EffectParam& getParamInfo(uint8_t index) const override;
+    float getParam(uint8_t index) const override;
+    void setParam(uint8_t index, float value) override;
+    void rampMix(float mix, size_t numSamples) override;
+    bool automateParam(uint8_t index, float value, size_t numSamples) override;
+    bool isAutomatable(uint8_t index) const override;
+
 private:
+    static const uint8_t PARAM_COUNT = 3;
+    static const EffectParam PARAMS[PARAM_COUNT];
+
     // Comb filter structure
     struct CombFilter {
         int16_t* buffer;
@@ -129,6 +159,7 @@ private:
     float roomSize;
     float damping;
     float wetDryMix;
+    GainRamp mixRamp;  // Active while a rampMix() is in progress
     bool enabled;
 
     CombFilter combs[NUM_COMBS];
@@ -3,12 +3,24 @@
  *
  * Manages physical oscillator controls via MCP23017 I2C GPIO expander.
  * Handles waveform and octave switches for 3 oscillators with debouncing.
+ *
+ * Input capture:
+ * - The MCP23017 raises its (mirrored) INTA/INTB line on any pin change.
+ *   update() samples that line (a plain ESP32 GPIO read, no bus traffic)
+ *   and only then reads all 16 inputs in a single GPIOAB read, which also
+ *   clears the interrupt. Idle switches cost no I2C time.
+ * - The captured word is debounced as a whole (stable for DEBOUNCE_MS),
+ *   and switch handling runs only when the debounced word changes.
+ * - A slow resync read catches anything missed. If it finds a change the
+ *   interrupt never reported (line not wired), or PIN_SWITCH_EXPANDER_INT
+ *   is -1, the expander is polled every POLL_INTERVAL_MS instead.
  */
 
 #pragma once
 #include <Adafruit_MCP23X17.h>
 #include "audio/Oscillator.h"
 #include "system/DisplayManager.h"
+#include "system/I2CBus.h"
 
 // Forward declaration to avoid circular dependency:
 // Theremin.h includes ControlHandler.h which includes GPIOControls.h
@@ -16,6 +28,7 @@
 // Full definition included in GPIOControls.cpp
 class Theremin;
 class NotificationManager;
+class AudioEffect;
 class GPIOControls {
 public:
   /**
@@ -30,6 +43,12 @@ public:
    */
   bool begin();
 
+  /**
+   * Set the bus manager (switch scans take the bus at expander priority)
+   * @param i2cBus Shared I2C bus, or nullptr for unarbitrated access
+   */
+  void setBus(I2CBus* i2cBus) { bus = i2cBus; }
+
   /**
    * Read all switches and update oscillator settings
    * Call from ControlHandler::update()
@@ -61,6 +80,13 @@ public:
    */
   bool isModifierActive() const { return modifierActive; }
 
+  /**
+   * Check if the multi-function button is held right now (debounced input,
+   * no bus access - safe to call from other tasks)
+   * @return true if pressed
+   */
+  bool isButtonPressed() const { return isPinActive(PIN_MULTI_BUTTON); }
+
   /**
    * Check if button was short-pressed since last check
    * Consumes the flag (returns true only once per press)
@@ -86,6 +112,8 @@ private:
   DisplayManager* displayManager;
   NotificationManager* notificationManager;
   Adafruit_MCP23X17 mcp;
+  I2CBus* bus;
+  bool rebootRequested;  // Very long press seen, reboot after the scan
   bool initialized;
   bool controlsEnabled;  // Master enable/disable for web interface override
   bool firstUpdate;      // Force initial sync with switch positions
@@ -94,16 +122,28 @@ private:
   struct OscillatorState {
     Oscillator::Waveform waveform;
     int8_t octave;
-    unsigned long lastChangeTime;
   };
 
   OscillatorState osc1State;
   OscillatorState osc2State;
   OscillatorState osc3State;
 
-  // Debounce timing
+  // Debounce timing (applied to the captured input word)
   static constexpr unsigned long DEBOUNCE_MS = 50;
 
+  // Expander reads without a change interrupt
+  static constexpr unsigned long RESYNC_INTERVAL_MS = 1000;  // Safety net with the INT line
+  static constexpr unsigned long POLL_INTERVAL_MS = 20;      // INT line not wired
+
+  // Captured MCP23017 inputs (bit n = pin n, active LOW)
+  uint16_t rawInputs;            // Last GPIOAB read
+  uint16_t inputs;               // Debounced
+  unsigned long rawChangeTime;   // When rawInputs last changed
+  unsigned long lastCaptureTime;
+  bool inputsChanged;            // Debounced word changed this update
+  bool interruptSeen;            // INT line asserted at least once
+  bool pollFallback;             // No usable INT line: poll instead
+
   // Multi-function button state machine
   enum ButtonState {
     IDLE,                // Button not pressed
@@ -151,6 +191,36 @@ private:
    */
   void updateButton();
 
+  /**
+   * Check the expander change line (ESP32 GPIO, no bus access)
+   * @return true if the MCP23017 reports a pin change
+   */
+  bool expanderInterruptPending() const;
+
+  /**
+   * Read all 16 expander inputs in one transaction (clears the interrupt)
+   * @param now Current millis()
+   * @param fromInterrupt true if triggered by the change line
+   */
+  void captureInputs(unsigned long now, bool fromInterrupt);
+
+  /**
+   * Accept the captured word once it has been stable for DEBOUNCE_MS
+   * Sets inputsChanged when the debounced word changes.
+   */
+  void debounceInputs(unsigned long now);
+
+  /**
+   * Check a debounced expander input
+   * @return true if the pin is active (LOW)
+   */
+  bool isPinActive(uint8_t pin) const { return (inputs & (1u << pin)) == 0; }
+
+  /**
+   * Run the button state machine and apply switch changes
+   */
+  void processControls();
+
   /**
    * Perform system reboot after very long button press
    * Shows notification and restarts ESP32
@@ -173,6 +243,13 @@ private:
   void osc2WaveformSecondaryControl();
   void osc3WaveformSecondaryControl();
 
+  /**
+   * Hand the values a secondary control just set to the automation lane
+   * (no-op unless it is recording)
+   */
+  void recordOscillatorMix();
+  void recordEffect(const AudioEffect* effect);
+
   /**
    * Show notification wrapper with included null check for
    * notificationManager existence.
@@ -180,7 +257,7 @@ private:
   void showNotification(const String& message, uint16_t durationMs = 2000);
 
   /**
-   * Read waveform from 3-pin switch
+   * Decode waveform from 3-pin switch (debounced inputs)
    * @param pinA Sine wave pin
    * @param pinB Triangle wave pin
    * @param pinC Square wave pin
@@ -189,7 +266,7 @@ private:
   Oscillator::Waveform readWaveform(uint8_t pinA, uint8_t pinB, uint8_t pinC);
 
   /**
-   * Read octave from 2-pin switch
+   * Decode octave from 2-pin switch (debounced inputs)
    * @param pinUp +1 octave pin
    * @param pinDown -1 octave pin
    * @return Octave shift (-1, 0, +1)
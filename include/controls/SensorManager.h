@@ -11,6 +11,7 @@
 #include <Wire.h>
 #include "Adafruit_VL53L0X.h"
 #include "system/PinConfig.h"
+#include "system/I2CBus.h"
 
 class SensorManager {
  public:
@@ -25,6 +26,12 @@ class SensorManager {
    */
   bool begin();
 
+  /**
+   * Set the bus manager (sensor reads take the bus at top priority)
+   * @param i2cBus Shared I2C bus, or nullptr for unarbitrated access
+   */
+  void setBus(I2CBus* i2cBus) { bus = i2cBus; }
+
   /**
    * Update sensor readings - reads both sensors and caches results.
    * Call this once per loop iteration before getting individual distances.
@@ -150,6 +157,11 @@ class SensorManager {
   // Alpha value is "how much (percentage) of new value to mix to the existing smoothed value"
   static constexpr float DEFAULT_SMOOTHING_ALPHA = 0.35f;
 
+  // XSHUT sequencing: a VL53L0X answers at its power-on address 0x29
+  // within tBOOT (1.2 ms max) of XSHUT going high
+  static const uint8_t SENSOR_BOOT_ADDR = 0x29;
+  static const uint32_t XSHUT_READY_TIMEOUT_MS = 10;
+
   float smoothedPitchDistance;
   float smoothedVolumeDistance;
   bool firstReading;  // Track if this is the first reading (to initialize smoothed values)
@@ -194,11 +206,26 @@ class SensorManager {
   // PIN_SENSOR_PITCH_XSHUT, PIN_SENSOR_VOLUME_XSHUT
   // I2C_ADDR_SENSOR_PITCH, I2C_ADDR_SENSOR_VOLUME
 
+  I2CBus* bus;
+
   Adafruit_VL53L0X pitchSensor;
   Adafruit_VL53L0X volumeSensor;
   VL53L0X_RangingMeasurementData_t pitchMeasure;
   VL53L0X_RangingMeasurementData_t volumeMeasure;
 
+  /**
+   * Wait for XSHUT to take effect: poll the power-on address until it
+   * answers (present) or goes quiet (!present). Fast start only; the
+   * regular build keeps the fixed 10 ms settle time.
+   * @return false on timeout (init carries on, begin() reports failures)
+   */
+  bool waitForBootAddress(bool present);
+
+  /**
+   * Bring one sensor out of reset and initialize it at its address
+   */
+  bool beginSensor(Adafruit_VL53L0X& sensor, uint8_t xshutPin, uint8_t address, const char* name);
+
   /**
    * Read raw pitch distance from VL53L0X sensor
    */
@@ -1,13 +1,18 @@
 /*
  * SerialControls.h
  *
- * Manages oscillator control inputs from serial commands.
- * Provides interface for changing oscillator parameters via serial.
+ * Serial console front end of the CommandRegistry.
+ *
+ * Syntax: "name:arg:arg", several commands per line separated by ';'
+ * ("osc1:sine;osc1:octave:1;osc1:vol:0.8"). Lines are read without
+ * blocking into a fixed buffer and split in place (no String), then the
+ * longest ':' prefix that names a command is looked up and the remaining
+ * tokens are its arguments. "<effect>:on|off" and
+ * "<effect>:<param>:<value>" are shorthands for enableEffect/setEffectParam.
  */
 
 #pragma once
 #include <Arduino.h>
-#include "audio/Oscillator.h"
 
 // Forward declaration to avoid circular dependency:
 // Theremin.h includes SerialControls.h (to contain SerialControls as a member)
@@ -35,53 +40,28 @@ public:
   void update();
 
 private:
+  static const size_t LINE_LENGTH = 256;  // Including terminator
+  static const uint8_t MAX_TOKENS = 8;    // ':' separated parts per command
+
   Theremin* theremin;
+  char line[LINE_LENGTH];
+  size_t lineLength;
+  bool lineOverflow;
 
   /**
-   * Check for and process serial commands
+   * Collect available serial bytes; run the line once complete
    */
   void handleSerialCommands();
 
   /**
-   * Parse and execute a single command string
-   * @param cmd Command string (e.g., "osc1:sine")
-   */
-  void executeCommand(String cmd);
-
-  /**
-   * Parse waveform name to enum
-   * @param name Waveform name ("off", "square", "sine", "triangle", "saw")
-   * @return Waveform enum or -1 if invalid
-   */
-  int parseWaveform(String name);
-
-  /**
-   * Print help text
-   */
-  void printHelp();
-
-  /**
-   * Print status of all oscillators
-   */
-  void printStatus();
-
-  /**
-   * Print the status of the sensors
-   */
-  void printSensorsStatus();
-
-  /**
-   * Print status of specific oscillator
-   */
-  void printOscillatorStatus(int oscNum);
-
-  /**
-   * Print status of all effects
+   * Run a line: split on ';', execute each command
+   * @param text Line (modified in place)
    */
-  void printEffectsStatus();
+  void executeLine(char* text);
 
   /**
-   * Get waveform name from enum
+   * Parse and execute a single command
+   * @param cmd Command string, e.g. "osc1:sine" (modified in place)
    */
-  const char* getWaveformName(Oscillator::Waveform wf);
+  void executeCommand(char* cmd);
 };
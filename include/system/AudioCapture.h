@@ -0,0 +1,225 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+#include "audio/AudioConstants.h"
+#include "system/StateTracker.h"
+
+/**
+ * @brief AudioCapture - Record the rendered output to a WAV file or a WebSocket stream
+ *
+ * Captures the final mono output (after effects and master bus, the same
+ * signal as the output tap) without an external recorder.
+ *
+ * Architecture:
+ *   AudioTask (Core 1) → ring → CaptureTask (Core 0) → { LittleFS WAV, stream packets → WebUIManager }
+ *
+ * - The audio task copies its block into a single-producer ring and never
+ *   waits: if the ring has no room for the whole block, the block is
+ *   dropped and counted (getDroppedBlocks())
+ * - CaptureTask runs at priority 1 on Core 0 and drains the ring:
+ *   - File: /capture.wav on LittleFS, written in whole 4 KB blocks (the
+ *     header is part of the first block and patched when the capture ends)
+ *   - Stream: packets of one PCM chunk or one ADPCM block, taken by
+ *     WebUIManager on the loop task and sent as binary frames to the
+ *     clients that asked for them (TelemetryProtocol.h MSG_AUDIO)
+ * - Samples are 16-bit PCM or IMA-ADPCM (4 bits/sample, standard WAV
+ *   blocks of 256 bytes = 505 samples, each block self-contained)
+ * - One capture at a time; start/stop may come from any task and are
+ *   taken by CaptureTask on its next pass
+ *
+ * Memory: the ring (32 KB, PSRAM when available) is allocated on the first
+ * capture and kept; ~5 KB of staging in the object.
+ *
+ * Bandwidth at 22.05 kHz: PCM 44 KB/s, ADPCM 11 KB/s (a 1 MB LittleFS
+ * partition holds ~23 s PCM or ~90 s ADPCM).
+ */
+class AudioCapture {
+public:
+    static constexpr uint32_t RING_SAMPLES = 16384;         // Power of two, ~0.74 s at 22.05 kHz
+    static constexpr uint32_t RING_MASK = RING_SAMPLES - 1;
+    static constexpr size_t WRITE_SIZE = 4096;              // LittleFS block
+    static constexpr size_t PCM_CHUNK_SAMPLES = 512;        // Samples per PCM stream packet
+    static constexpr size_t ADPCM_BLOCK_BYTES = 256;        // WAV block align
+    static constexpr size_t ADPCM_BLOCK_SAMPLES = (ADPCM_BLOCK_BYTES - 4) * 2 + 1;  // 505
+    static constexpr int STREAM_SLOTS = 4;                  // Packets waiting for the loop task
+    static constexpr size_t STREAM_PACKET_BYTES = PCM_CHUNK_SAMPLES * 2;
+    static constexpr uint32_t FILE_RESERVE_BYTES = 16 * 1024;  // Left free on LittleFS
+    static constexpr const char* FILE_PATH = "/capture.wav";
+
+    enum Sink : uint8_t {
+        SINK_NONE = 0,
+        SINK_FILE,
+        SINK_STREAM
+    };
+
+    enum Format : uint8_t {
+        FORMAT_PCM16 = 0,
+        FORMAT_ADPCM
+    };
+
+    enum Error : uint8_t {
+        ERROR_NONE = 0,
+        ERROR_NO_MEMORY,    // Ring could not be allocated
+        ERROR_FILE,         // LittleFS not mounted or file not writable
+        ERROR_FULL          // LittleFS full (capture kept up to that point)
+    };
+
+    /**
+     * @brief One stream packet (samples in the capture format)
+     */
+    struct StreamPacket {
+        uint32_t position;      // Index of the first sample since the capture started
+        uint32_t dropped;       // Blocks dropped so far in this capture
+        uint16_t sampleCount;
+        uint16_t bytes;         // Used bytes of data
+        uint8_t format;         // Format
+        uint8_t data[STREAM_PACKET_BYTES];
+    };
+
+    /**
+     * @brief Construct AudioCapture
+     * @param tracker Receives StateTracker::CAPTURE on state changes and
+     *                once per second while capturing (may be nullptr)
+     */
+    AudioCapture(StateTracker* tracker);
+
+    ~AudioCapture();
+
+    /**
+     * @brief Start the capture task (Core 0, idle until start())
+     * @return true if the task was created
+     */
+    bool begin();
+
+    /**
+     * @brief Start capturing (any task)
+     * A file capture replaces the previous /capture.wav.
+     * @return false if a capture is running or the ring could not be allocated
+     */
+    bool start(Sink sink, Format format);
+
+    /**
+     * @brief Stop capturing (any task); a file is completed by CaptureTask
+     */
+    void stop();
+
+    /**
+     * @brief Append the final output block (audio task only, never blocks)
+     * @param samples Mono samples
+     * @param numSamples Block length
+     */
+    inline void write(const int16_t* samples, size_t numSamples) {
+        if (!capturing) {
+            return;
+        }
+
+        uint32_t pos = writeCount;
+        if (RING_SAMPLES - (pos - readCount) < numSamples) {
+            droppedBlocks = droppedBlocks + 1;  // Consumer behind: drop the whole block
+            return;
+        }
+
+        uint32_t start = pos & RING_MASK;
+        uint32_t first = RING_SAMPLES - start;
+        if (first > numSamples) {
+            first = numSamples;
+        }
+        memcpy(&ring[start], samples, first * sizeof(int16_t));
+        memcpy(&ring[0], samples + first, (numSamples - first) * sizeof(int16_t));
+
+        // Publish after the data (volatile store - ordered after the copies)
+        writeCount = pos + numSamples;
+    }
+
+    /**
+     * @brief Oldest stream packet not yet sent (loop task)
+     * @return nullptr if none; release with releasePacket() once sent
+     */
+    const StreamPacket* peekPacket() const;
+    void releasePacket();
+
+    /**
+     * @brief Active sink (SINK_NONE when idle)
+     */
+    Sink getSink() const { return activeSink; }
+    bool isCapturing() const { return activeSink != SINK_NONE; }
+    Format getFormat() const { return format; }
+    Error getError() const { return lastError; }
+
+    /**
+     * @brief Statistics of the running (or last) capture
+     */
+    uint32_t getCapturedSamples() const { return capturedSamples; }
+    uint32_t getDroppedBlocks() const { return droppedBlocks; }
+    uint32_t getFileBytes() const { return fileBytes; }
+
+private:
+    static constexpr uint32_t DRAIN_INTERVAL_MS = 20;    // ~440 samples at 22.05 kHz per pass
+    static constexpr uint32_t IDLE_POLL_MS = 100;
+    static constexpr uint32_t STATUS_INTERVAL_MS = 1000;
+
+    enum Request : uint8_t {
+        REQUEST_NONE = 0,
+        REQUEST_START,
+        REQUEST_STOP
+    };
+
+    StateTracker* stateTracker;
+    TaskHandle_t taskHandle;
+
+    // Ring (audio task writes, CaptureTask reads)
+    int16_t* ring;
+    volatile uint32_t writeCount;
+    volatile uint32_t readCount;
+    volatile bool capturing;
+    volatile uint32_t droppedBlocks;
+
+    // Control
+    std::atomic<uint8_t> request;
+    volatile Sink pendingSink;
+    volatile Sink activeSink;
+    volatile Format format;
+    volatile Error lastError;
+
+    // CaptureTask
+    fs::File file;
+    uint32_t fileLimit;              // Bytes the file may grow to
+    volatile uint32_t fileBytes;
+    size_t writeFill;                // Bytes in writeBuffer
+    volatile uint32_t capturedSamples;
+    int8_t adpcmIndex;               // Step index carried between ADPCM blocks
+    uint32_t lastStatus;
+
+    // Stream packets (CaptureTask fills, loop task sends)
+    volatile uint32_t packetsWritten;
+    volatile uint32_t packetsRead;
+
+    // One sink at a time: file write buffer or stream packets
+    union {
+        uint8_t writeBuffer[WRITE_SIZE];
+        StreamPacket packets[STREAM_SLOTS];
+    };
+    int16_t chunk[PCM_CHUNK_SAMPLES];  // Samples taken from the ring
+
+    static void taskFunction(void* parameter);
+    void handleRequest(uint8_t req);
+    void open();
+    void close();
+    void drain(bool final);
+    void readRing(int16_t* dst, size_t numSamples);
+    bool emit(const int16_t* samples, size_t numSamples);
+
+    // File sink
+    bool openFile();
+    bool appendFile(const uint8_t* data, size_t len);
+    void closeFile();
+    size_t headerSize() const;
+    void fillHeader(uint8_t* header, uint32_t dataBytes) const;
+
+    void encodeAdpcmBlock(const int16_t* samples, uint8_t* out);
+    void markChanged();
+};
@@ -0,0 +1,104 @@
+/*
+ * BootTimeline.h
+ *
+ * Milestones of the boot sequence, in ms since power-on (millis()), so
+ * "how long until it makes sound" is a number rather than an impression.
+ *
+ * Each milestone is recorded once, by whichever task reaches it first
+ * (audio task, loop, network task). Target: first audio buffer within
+ * about 1 s; WiFi and the web server come up afterwards, in the
+ * background, and never hold up the instrument.
+ *
+ * Phases time the init steps themselves (serial, display, sensors,
+ * audio...) and are printed as a table with the milestones:
+ *
+ *   void setup() {
+ *     BootTimeline::Phase phase("sensors");
+ *     sensors.begin();
+ *   }
+ *
+ * Fast start (ENABLE_FAST_START = 1, platformio.ini): BOOT_DELAY() drops
+ * the fixed pauses that only let Serial catch up, and devices are waited
+ * for by readiness checks (I2C ACK polling) instead of fixed sleeps.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+#ifndef ENABLE_FAST_START
+  #define ENABLE_FAST_START 0
+#endif
+
+// Cosmetic boot pause (Serial settling, readable logs)
+#if ENABLE_FAST_START
+  #define BOOT_DELAY(ms) ((void)0)
+#else
+  #define BOOT_DELAY(ms) delay(ms)
+#endif
+
+namespace BootTimeline {
+    enum Milestone {
+        SETUP_START = 0,     // setup() entered
+        FIRST_AUDIO_BUFFER,  // First block handed to I2S
+        FIRST_SENSOR_SAMPLE, // First pair of distance readings
+        SETUP_DONE,          // setup() returned, loop() running
+        WIFI_UP,             // Connected (STA) or access point started
+        WEB_SERVER_UP,       // HTTP/WebSocket server listening
+        NUM_MILESTONES
+    };
+
+    /**
+     * Record a milestone (only the first call per milestone counts)
+     */
+    void mark(Milestone milestone);
+
+    /**
+     * Time of a milestone
+     * @return ms since power-on, or 0 if not reached yet
+     */
+    uint32_t get(Milestone milestone);
+
+    /**
+     * Short name for tables and JSON keys ("audio", "sensor", ...)
+     */
+    const char* name(Milestone milestone);
+
+    static const int MAX_PHASES = 16;
+
+    /**
+     * Record a finished init phase (safe from any task)
+     * @param name Static string, kept by pointer
+     * @param startUs micros() at the start of the phase
+     * @param endUs micros() at the end of the phase
+     */
+    void recordPhase(const char* name, uint32_t startUs, uint32_t endUs);
+
+    /**
+     * Recorded phases, in the order they finished
+     */
+    int getPhaseCount();
+    const char* getPhaseName(int index);
+    uint32_t getPhaseStartUs(int index);
+    uint32_t getPhaseDurationUs(int index);
+
+    /**
+     * Scoped phase: recorded when it goes out of scope
+     */
+    class Phase {
+     public:
+        explicit Phase(const char* name) : name(name), startUs(micros()) {}
+        ~Phase() { recordPhase(name, startUs, micros()); }
+
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+     private:
+        const char* name;
+        uint32_t startUs;
+    };
+
+    /**
+     * Print the milestones reached so far and the phase table
+     */
+    void print();
+}
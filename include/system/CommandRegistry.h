@@ -0,0 +1,162 @@
+/*
+ * CommandRegistry.h
+ *
+ * One table of control commands shared by every front end (serial console,
+ * WebSocket). Each command is a single line:
+ *
+ *   { "preset:save", "i:slot s:name?", cmdPresetSave },
+ *   { "savePreset",  "i:slot s:name?", cmdPresetSave },
+ *
+ * - Name: case-insensitive. A '#' stands for a number glued to a word in
+ *   the serial syntax ("osc#:vol" matches "osc1:vol") and is passed as the
+ *   first argument.
+ * - Arguments: "<type>:<name>" separated by spaces, '?' = optional.
+ *   Types: i (int), f (float), b (bool: on/off, true/false, 1/0),
+ *   s (string). Serial passes them by position ("preset:save:1:warm"),
+ *   the WebSocket by name ({"cmd":"savePreset","slot":1,"name":"warm"}).
+ * - Handler: static function in CommandRegistry.cpp, gets typed arguments
+ *   (no String, no heap) and may run on any task (serial = loop task,
+ *   WebSocket = async TCP task): flash writes and preset recalls go through
+ *   the PresetManager request*() calls.
+ *
+ * Lookup: the table is sorted once at construction (index array), then
+ * every lookup is a binary search (~7 comparisons for ~90 commands).
+ */
+
+#pragma once
+#include <Arduino.h>
+
+// Forward declaration
+class Theremin;
+
+/**
+ * Typed arguments of one command, in spec order
+ */
+class CommandArgs {
+ public:
+  static const uint8_t MAX_ARGS = 4;
+
+  bool has(uint8_t index) const { return index < MAX_ARGS && (present & (1 << index)); }
+  int32_t getInt(uint8_t index, int32_t fallback = 0) const { return has(index) ? values[index].i : fallback; }
+  float getFloat(uint8_t index, float fallback = 0.0f) const { return has(index) ? values[index].f : fallback; }
+  bool getBool(uint8_t index, bool fallback = false) const { return has(index) ? values[index].i != 0 : fallback; }
+  const char* getString(uint8_t index, const char* fallback = "") const { return has(index) ? values[index].s : fallback; }
+
+ private:
+  friend class CommandRegistry;
+
+  union Value {
+    int32_t i;
+    float f;
+    const char* s;  // Points into the front end's input (line buffer, JSON document)
+  };
+
+  Value values[MAX_ARGS];
+  uint8_t present = 0;
+};
+
+/**
+ * Argument source of a front end (positional or named)
+ */
+class CommandInput {
+ public:
+  enum Status {
+    ARG_OK = 0,
+    ARG_MISSING,
+    ARG_INVALID
+  };
+
+  virtual ~CommandInput() {}
+
+  // Read argument `index` (positional front ends) or `key` (named ones)
+  virtual Status readInt(uint8_t index, const char* key, int32_t& out) = 0;
+  virtual Status readFloat(uint8_t index, const char* key, float& out) = 0;
+  virtual Status readBool(uint8_t index, const char* key, bool& out) = 0;
+  virtual Status readString(uint8_t index, const char* key, const char*& out) = 0;
+
+  /**
+   * Positional arguments given (0 for named inputs, extras are an error)
+   */
+  virtual uint8_t count() const { return 0; }
+};
+
+/**
+ * Positional text arguments (serial tokens, nul-terminated, not copied)
+ */
+class TokenInput : public CommandInput {
+ public:
+  TokenInput(const char* const* tokens, uint8_t count) : tokens(tokens), tokenCount(count) {}
+
+  Status readInt(uint8_t index, const char* key, int32_t& out) override;
+  Status readFloat(uint8_t index, const char* key, float& out) override;
+  Status readBool(uint8_t index, const char* key, bool& out) override;
+  Status readString(uint8_t index, const char* key, const char*& out) override;
+  uint8_t count() const override { return tokenCount; }
+
+ private:
+  const char* const* tokens;
+  uint8_t tokenCount;
+};
+
+typedef bool (*CommandHandler)(Theremin* theremin, const CommandArgs& args);
+
+struct Command {
+  const char* name;       // Case-insensitive, '#' = number in the serial syntax
+  const char* args;       // Argument spec, e.g. "i:osc f:value"
+  CommandHandler handler; // Returns false if the command failed (reason printed)
+};
+
+class CommandRegistry {
+ public:
+  enum Result {
+    CMD_OK = 0,
+    CMD_UNKNOWN,    // No such command
+    CMD_BAD_ARGS,   // Missing, invalid or extra argument (usage printed)
+    CMD_FAILED      // Handler refused (reason printed)
+  };
+
+  /**
+   * Constructor - sorts the command table
+   * @param theremin Passed to every handler
+   */
+  CommandRegistry(Theremin* theremin);
+
+  /**
+   * Find a command by name
+   * @param name Command name (case-insensitive)
+   * @return Command, or nullptr if unknown
+   */
+  const Command* find(const char* name) const;
+
+  /**
+   * Parse the arguments of a command and run it
+   * @param command Command from find()
+   * @param input Argument source of the calling front end
+   * @return CMD_OK, CMD_BAD_ARGS or CMD_FAILED
+   */
+  Result execute(const Command* command, CommandInput& input);
+
+  /**
+   * find() + execute()
+   * @return CMD_UNKNOWN if there is no such command
+   */
+  Result dispatch(const char* name, CommandInput& input);
+
+  /**
+   * Print "name:<arg>[:<optional>]" for a command (serial syntax)
+   */
+  static void printUsage(const Command* command);
+
+  /**
+   * Text argument conversions (shared by the front ends)
+   */
+  static CommandInput::Status parseInt(const char* text, int32_t& out);
+  static CommandInput::Status parseFloat(const char* text, float& out);
+  static CommandInput::Status parseBool(const char* text, bool& out);
+
+ private:
+  Theremin* theremin;
+  const Command* table;
+  uint8_t count;
+  uint8_t* sorted;  // Table indices in name order
+};
@@ -0,0 +1,133 @@
+/*
+ * DSPProfiler.h
+ *
+ * Per-stage cycle profiling of the audio block for ESP32 Theremin.
+ * Uses the Xtensa CCOUNT register (one instruction to read, CPU clock
+ * resolution) to split generateAudioBuffer() into stages:
+ *
+ *   OSC     - oscillator mix + amplitude gain (+ decimator in QUALITY_HIGH)
+ *   DELAY   - delay effect      ┐
+ *   CHORUS  - chorus effect     ├ timed individually, in whatever slot order
+ *   REVERB  - reverb effect     ┘
+ *   MASTER  - gate, drive, limiter, soft clip
+ *   ROUTING - channel routing into the I2S buffer
+ *
+ * Each stage costs one CCOUNT read and one add per block. Totals are
+ * folded into averages/peaks once per block by endBlock().
+ *
+ * Compile-time toggle (platformio.ini):
+ *   -DENABLE_DSP_PROFILING=1   Profiling on (DSP page + WebSocket "dsp" object)
+ *   -DENABLE_DSP_PROFILING=0   Default - DSP_PROFILE_* macros compile to nothing
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifndef ENABLE_DSP_PROFILING
+  #define ENABLE_DSP_PROFILING 0
+#endif
+
+class DSPProfiler {
+ public:
+  /**
+   * Profiled stages (effect stages follow EffectsChain registration order)
+   */
+  enum Stage {
+    STAGE_OSC = 0,
+    STAGE_DELAY,
+    STAGE_CHORUS,
+    STAGE_REVERB,
+    STAGE_MASTER,
+    STAGE_ROUTING,
+    STAGE_COUNT
+  };
+
+  // First effect stage: EffectsChain marks STAGE_EFFECTS + registration index
+  static const int STAGE_EFFECTS = STAGE_DELAY;
+
+  /**
+   * Constructor
+   */
+  DSPProfiler();
+
+  /**
+   * Start timing a block (audio task)
+   */
+  inline void beginBlock() {
+    lastCycles = ESP.getCycleCount();
+  }
+
+  /**
+   * Close the current stage: cycles since the previous mark go to `stage`
+   * @param stage Stage that just finished
+   */
+  inline void mark(int stage) {
+    uint32_t now = ESP.getCycleCount();
+    blockCycles[stage] += now - lastCycles;
+    lastCycles = now;
+  }
+
+  /**
+   * Skip time since the previous mark (e.g. mutex wait) without charging a stage
+   */
+  inline void skip() {
+    lastCycles = ESP.getCycleCount();
+  }
+
+  /**
+   * Fold this block's stage totals into averages/peaks (audio task, once per block)
+   */
+  void endBlock();
+
+  /**
+   * Average time per block for a stage (exponential average over ~16 blocks)
+   * @return Microseconds
+   */
+  float getAverageUs(int stage) const;
+
+  /**
+   * Worst block for a stage since boot (or last reset)
+   * @return Microseconds
+   */
+  float getPeakUs(int stage) const;
+
+  /**
+   * Sum of all stage averages (≈ profiled part of the audio work time)
+   */
+  float getTotalUs() const;
+
+  /**
+   * Stage name for display/JSON ("osc", "delay", ...)
+   */
+  static const char* getStageName(int stage);
+
+  /**
+   * Clear averages and peaks
+   */
+  void reset();
+
+ private:
+  uint32_t lastCycles;
+  uint32_t blockCycles[STAGE_COUNT];           // Current block (audio task only)
+  volatile uint32_t avgCycles[STAGE_COUNT];    // EMA, 1/16 per block
+  volatile uint32_t peakCycles[STAGE_COUNT];
+
+  static float cyclesToUs(uint32_t cycles);
+};
+
+// ============================================================================
+// PROFILING MACROS (removed entirely when ENABLE_DSP_PROFILING = 0)
+// ============================================================================
+
+#if ENABLE_DSP_PROFILING
+  #define DSP_PROFILE_BEGIN(p) do { if (p) (p)->beginBlock(); } while (0)
+  #define DSP_PROFILE_MARK(p, stage) do { if (p) (p)->mark(stage); } while (0)
+  #define DSP_PROFILE_SKIP(p) do { if (p) (p)->skip(); } while (0)
+  #define DSP_PROFILE_END(p) do { if (p) (p)->endBlock(); } while (0)
+#else
+  #define DSP_PROFILE_BEGIN(p) ((void)0)
+  #define DSP_PROFILE_MARK(p, stage) ((void)0)
+  #define DSP_PROFILE_SKIP(p) ((void)0)
+  #define DSP_PROFILE_END(p) ((void)0)
+#endif
@@ -3,6 +3,18 @@
  *
  * Page-based display manager for SSD1306 OLED display.
  * Components register pages using callbacks, DisplayManager handles rendering.
+ *
+ * Rendering vs transfer:
+ * - update() renders at most once per FRAME_INTERVAL_MS into the RAM buffer
+ *   (cheap, CPU only) and compares every 8-pixel page row with what the
+ *   panel currently shows (shadow copy). Only the changed column span of
+ *   each changed row is sent - an unchanged page costs no bus time at all.
+ * - The I2C transfer runs in DisplayTask (Core 0, low priority), one page
+ *   row per bus lock (lowest I2CBus priority), so sensor and expander reads
+ *   on the shared bus get in between rows instead of waiting behind a 1 KB
+ *   frame.
+ * - A frame is skipped (not queued) while the previous one is still being
+ *   sent; the next frame carries all changes since.
  */
 
 #pragma once
@@ -11,8 +23,11 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
 #include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "system/DisplayPage.h"
 #include "system/PinConfig.h"
+#include "system/I2CBus.h"
 
 // Fonts
 #include <Fonts/TomThumb.h>  // 3x5 px - Small but readable
@@ -28,6 +43,8 @@ public:
     static constexpr int CHAR_WIDTH = 5;
     static constexpr int LINE_HEIGHT = 10;
     static constexpr int CONTENT_START_Y = 14;  // Y position where page content starts (below title separator)
+    static constexpr int PAGE_ROWS = SCREEN_HEIGHT / 8;   // SSD1306 pages (8-pixel rows)
+    static constexpr uint32_t FRAME_INTERVAL_MS = 33;     // Frame cap (~30 fps)
 
     // Default font
     static const GFXfont* SMALL_FONT;
@@ -38,6 +55,27 @@ public:
      */
     bool begin();
 
+    /**
+     * Run begin() and the loading screen on a helper task (Core 0), so the
+     * panel init overlaps sensor and audio setup (fast start). Both sides
+     * take the I2C bus per device, so they interleave instead of colliding.
+     * Call waitForBegin() before anything else touches the display.
+     */
+    void beginAsync();
+
+    /**
+     * Wait for beginAsync() to finish
+     * @return true if the display initialized
+     */
+    bool waitForBegin();
+
+    /**
+     * Set the bus manager (frame transfers take the bus at display priority)
+     * Call before begin().
+     * @param i2cBus Shared I2C bus, or nullptr for unarbitrated access
+     */
+    void setBus(I2CBus* i2cBus) { bus = i2cBus; }
+
     /**
      * Register a new page with name and drawing callback
      * @param name Page name (for debugging/navigation)
@@ -54,11 +92,25 @@ public:
     void registerOverlay(PageDrawCallback overlayFunc);
 
     /**
-     * Update display - renders current page
+     * Update display - renders current page (at most once per FRAME_INTERVAL_MS)
+     * and hands the changed rows to the flush task
      * Call this in main loop
      */
     void update();
 
+    /**
+     * Force a full transfer on the next frame
+     * Call after drawing and display()-ing directly through getDisplay()
+     */
+    void invalidate() { forceFullFrame = true; }
+
+    /**
+     * Frame statistics (since boot)
+     */
+    uint32_t getFramesSent() const { return framesSent; }
+    uint32_t getFramesSkipped() const { return framesSkipped; }
+    uint32_t getBytesSent() const { return bytesSent; }
+
     /**
      * Navigate to next page (wraps around to first page)
      */
@@ -69,6 +121,13 @@ public:
      */
     void previousPage();
 
+    /**
+     * Jump to a page by name
+     * @param name Page name as registered
+     * @return false if no page has that name
+     */
+    bool showPage(const String& name);
+
     /**
      * Get current page index
      * @return Index of currently displayed page
@@ -95,6 +154,7 @@ public:
 
     /**
      * Direct access to OLED display (for advanced use)
+     * If you call display() on it directly, call invalidate() afterwards.
      * @return Reference to underlying Adafruit_SSD1306 object
      */
     Adafruit_SSD1306& getDisplay() { return display; }
@@ -103,10 +163,36 @@ public:
 
 private:
     Adafruit_SSD1306 display;
+    I2CBus* bus;
     std::vector<DisplayPage> pages;
     std::vector<PageDrawCallback> overlays;
     uint8_t currentPageIndex;
     bool initialized;
 
+    // What the panel shows, and the spans still to send (owned by the flush
+    // task while flushPending is set)
+    uint8_t shadow[SCREEN_WIDTH * PAGE_ROWS];
+    uint8_t rowFirst[PAGE_ROWS];
+    uint8_t rowLast[PAGE_ROWS];
+    uint8_t dirtyRows;                 // Bit per page row
+    volatile bool flushPending;
+    bool forceFullFrame;
+
+    TaskHandle_t flushTaskHandle;
+    SemaphoreHandle_t initDone;        // Given by the beginAsync() helper task
+    uint32_t lastFrameTime;
+    uint32_t framesSent;
+    uint32_t framesSkipped;
+    uint32_t bytesSent;
+
     static constexpr int OLED_RESET = -1;  // Reset pin not used
+    static constexpr int DATA_CHUNK = 31;  // Data bytes per I2C transaction (+1 control byte)
+
+    void renderFrame();
+    bool collectDirtyRows();
+    void flushRows();
+    I2CBus::Result flushRow(int row);
+    uint8_t sendCommands(const uint8_t* commands, size_t count);
+    static void flushTaskFunction(void* parameter);
+    static void initTaskFunction(void* parameter);
 };
@@ -0,0 +1,189 @@
+/*
+ * I2CBus.h
+ *
+ * Owner of the shared I2C bus (two VL53L0X sensors, MCP23017, SSD1306).
+ *
+ * The bus is the control-rate ceiling: every sensor reading, switch scan
+ * and display row goes through it. This class sets it up, arbitrates it
+ * between the loop task and DisplayTask, and keeps the numbers that show
+ * how close to the ceiling we are.
+ *
+ * Arbitration:
+ * - Each device group is a client with a fixed priority:
+ *   sensors > expander > display. A client holds the bus for one
+ *   transaction (or one library call, for the VL53L0X/MCP drivers).
+ * - A lower-priority client does not take the bus while a higher-priority
+ *   client is waiting, and long transfers are split into slices (the
+ *   display sends one page row per lock), so a sensor read waits for at
+ *   most one slice instead of a whole frame.
+ *
+ * Error handling:
+ * - Results are counted per kind (NACK, timeout, other). After
+ *   RECOVERY_THRESHOLD consecutive failures the bus is recovered: up to nine
+ *   SCL pulses to release a slave holding SDA low, a STOP, and a fresh
+ *   Wire.begin() at the configured clock.
+ *
+ * Clock: I2C_CLOCK_HZ (platformio.ini), 400 kHz by default - the VL53L0X
+ * maximum, so 1 MHz fast-mode plus is not an option on this bus.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#ifndef I2C_CLOCK_HZ
+#define I2C_CLOCK_HZ 400000
+#endif
+
+class I2CBus {
+ public:
+  // Bus clients, in priority order (lower value = higher priority)
+  enum Client {
+    CLIENT_SENSORS = 0,
+    CLIENT_EXPANDER,
+    CLIENT_DISPLAY,
+    NUM_CLIENTS
+  };
+
+  enum Result {
+    RESULT_OK = 0,
+    RESULT_NACK,     // Address or data not acknowledged
+    RESULT_TIMEOUT,  // Clock stretching / bus busy beyond the Wire timeout
+    RESULT_ERROR     // Any other bus error
+  };
+
+  static const uint32_t TIMEOUT_MS = 1000;          // Wire transaction timeout
+  static const uint32_t ACQUIRE_TIMEOUT_MS = 100;   // Give up waiting for the bus
+  static const uint32_t BOOT_ACQUIRE_TIMEOUT_MS = 2000;  // Device init sequences (long holders)
+  static const uint8_t RECOVERY_THRESHOLD = 3;      // Consecutive failures before recovery
+  static const uint32_t STATS_WINDOW_MS = 1000;     // Utilization averaging window
+
+  /**
+   * Scoped bus ownership
+   *
+   *   I2CBus::Lock lock(bus, I2CBus::CLIENT_SENSORS);
+   *   if (lock) { ...Wire traffic...; lock.setResult(...); }
+   *
+   * A null bus always "locks" (devices used before the bus manager is
+   * wired in, or without it). Library init sequences, which hold the bus
+   * for tens of ms, wait with BOOT_ACQUIRE_TIMEOUT_MS.
+   */
+  class Lock {
+   public:
+    Lock(I2CBus* bus, Client client, uint32_t timeoutMs = ACQUIRE_TIMEOUT_MS)
+        : bus(bus), client(client), result(RESULT_OK),
+          locked(bus == nullptr || bus->acquire(client, timeoutMs)) {}
+    ~Lock() {
+      if (bus != nullptr && locked) {
+        bus->release(client, result);
+      }
+    }
+
+    explicit operator bool() const { return locked; }
+
+    /**
+     * Record the outcome of the transaction (default: OK)
+     */
+    void setResult(Result r) { result = r; }
+
+    Lock(const Lock&) = delete;
+    Lock& operator=(const Lock&) = delete;
+
+   private:
+    I2CBus* bus;
+    Client client;
+    Result result;
+    bool locked;
+  };
+
+  I2CBus();
+
+  /**
+   * Start the bus
+   * @param sda SDA pin
+   * @param scl SCL pin
+   * @param clockHz Bus clock
+   */
+  void begin(int sda, int scl, uint32_t clockHz = I2C_CLOCK_HZ);
+
+  /**
+   * Take the bus for one transaction
+   * Waits while a higher-priority client is queued.
+   * @param client Requesting client
+   * @param timeoutMs How long to wait for the bus
+   * @return false if the bus could not be taken within timeoutMs
+   */
+  bool acquire(Client client, uint32_t timeoutMs = ACQUIRE_TIMEOUT_MS);
+
+  /**
+   * Give the bus back and account for the transaction
+   * @param client Client that held the bus
+   * @param result Transaction outcome
+   */
+  void release(Client client, Result result);
+
+  /**
+   * Check whether a higher-priority client is waiting for the bus
+   * (long transfers check this between slices)
+   */
+  bool shouldYield(Client client) const;
+
+  /**
+   * Check whether a device acknowledges its address (empty write)
+   * Call with the bus held. An absent device is an expected answer here,
+   * so callers do not report it as a NACK.
+   */
+  static bool probe(uint8_t address);
+
+  /**
+   * Map a Wire.endTransmission() return code to a Result
+   */
+  static Result fromWire(uint8_t code);
+
+  /**
+   * Statistics
+   */
+  uint32_t getClockHz() const { return clockHz; }
+  uint8_t getUtilizationPercent() const { return utilization; }
+  uint32_t getTransactions(Client client) const { return transactions[client]; }
+  uint32_t getNackCount() const { return nackCount; }
+  uint32_t getTimeoutCount() const { return timeoutCount; }
+  uint32_t getErrorCount() const { return errorCount; }
+  uint32_t getRecoveryCount() const { return recoveryCount; }
+
+  /**
+   * Print bus statistics to Serial
+   */
+  void printStats() const;
+
+  static const char* clientName(Client client);
+
+ private:
+  SemaphoreHandle_t mutex;
+  int sdaPin;
+  int sclPin;
+  uint32_t clockHz;
+
+  volatile uint8_t waiting[NUM_CLIENTS];  // Clients queued for the bus
+  uint32_t acquiredAt;                    // micros() when the holder took the bus
+
+  // Statistics (written by the bus holder only)
+  uint32_t transactions[NUM_CLIENTS];
+  uint32_t nackCount;
+  uint32_t timeoutCount;
+  uint32_t errorCount;
+  uint32_t recoveryCount;
+  uint8_t consecutiveErrors;
+
+  uint32_t windowStart;      // millis()
+  uint32_t windowBusyUs;
+  volatile uint8_t utilization;
+
+  portMUX_TYPE waitMux;
+
+  void setWaiting(Client client, bool add);
+  void recover();
+};
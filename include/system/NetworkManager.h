@@ -12,6 +12,14 @@
  * - OTA firmware updates
  * - Network status display page
  *
+ * Bring-up runs in the background: begin() only starts NetTask (Core 0,
+ * priority 1), which steps through
+ *   STARTING → CONNECTING (saved WiFi) or PORTAL (button held at boot)
+ *            → SERVICES (mDNS, OTA, WebUI, static files, server) → RUNNING
+ * without blocking setup(), so sensors and audio are playing long before
+ * the network is up. Falls back to a plain access point when the saved
+ * network does not answer within the connect timeout.
+ *
  * Usage:
  *   NetworkManager network(&display);
  *   network.begin("Theremin-Setup", "admin", "theremin");
@@ -30,6 +38,8 @@
   #include <WiFiManager.h>
   #include <ESPmDNS.h>
   #include <ESPAsyncWebServer.h>
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
   #include "system/OTAManager.h"
   #include "system/DisplayManager.h"
   #include "system/WebUIManager.h"
@@ -38,7 +48,20 @@
 class Theremin;
 
 class NetworkManager {
+ public:
+  // Bring-up state (NetTask)
+  enum NetState : uint8_t {
+    NET_OFF = 0,      // begin() not called
+    NET_STARTING,     // Task started, WiFi not configured yet
+    NET_CONNECTING,   // Joining the saved network
+    NET_PORTAL,       // Captive portal (button held at boot)
+    NET_SERVICES,     // WiFi up, starting mDNS/OTA/WebUI/server
+    NET_RUNNING       // Everything up, task finished
+  };
+
  private:
+  static const uint32_t STEP_INTERVAL_MS = 50;         // NetTask poll period
+  static const uint32_t PORTAL_MAX_DURATION_MS = 300000;  // 5 minutes
   // Core components
   WiFiManager wifiManager;
   AsyncWebServer server;
@@ -47,23 +70,51 @@ class NetworkManager {
   DisplayManager* display;
   Theremin* theremin;
 
-  bool isInitialized;
+  volatile bool isInitialized;
   bool mdnsInitialized;
 
   // Configuration
   String apName;
   String mdnsHostname;
+  String otaUser;
+  String otaPass;
+  uint32_t connectTimeoutMs;
+  bool resetCredentials;
+  bool forcePortal;
+
+  // Background bring-up
+  TaskHandle_t taskHandle;
+  volatile NetState state;
+  uint32_t stateStart;         // millis() when the current state began
+  bool portalButtonReleased;   // Button let go since the portal started
+
+  static void taskFunction(void* parameter);
+  void step();
+  void setState(NetState newState);
 
   // Display page callback (member function)
   void renderNetworkPage(Adafruit_SSD1306& display);
 
+  // Bring-up steps (NetTask)
+  void startWiFi();
+  void startPortal();
+  void pollConnect();
+  void pollPortal();
+  void startAccessPoint();
+  void onWiFiUp();
+  void startServices();
+
   // Internal setup methods
-  void setupWiFi(uint8_t connectTimeout, uint16_t portalTimeout, bool resetCredentials,
-                  bool forcePortal);
   void setupMDNS(const char* hostname);
   void setupOTA(const char* user, const char* pass);
   void setupStaticFiles();
 
+  /**
+     * Register a route per precompressed asset ("name.gz" in the LittleFS root)
+     * @return Number of assets registered
+     */
+  int registerGzipAssets();
+
  public:
   /**
      * Constructor
@@ -84,15 +135,15 @@ class NetworkManager {
   void setTheremin(Theremin* thmn);
 
   /**
-     * Initialize all network services
+     * Start network bring-up in the background (returns immediately)
      * @param apName Access Point name for config portal
      * @param otaUser OTA authentication username
      * @param otaPass OTA authentication password
      * @param connectTimeout Seconds to try connecting to saved WiFi (default: 15)
-     * @param portalTimeout Seconds before portal times out (0 = never, default: 0)
+     * @param portalTimeout Unused (the portal closes on button press or after 5 minutes)
      * @param resetCredentials Reset saved WiFi credentials before starting
      * @param forcePortal Force captive portal mode (button pressed during boot)
-     * @return true if initialization successful
+     * @return true if the bring-up task was started
      */
   bool begin(const char* apName = "Theremin-Setup", const char* otaUser = "admin",
              const char* otaPass = "theremin", uint8_t connectTimeout = 15,
@@ -127,7 +178,8 @@ class NetworkManager {
 
   /**
      * Get current WiFi mode
-     * @return "STA" if connected to WiFi, "AP" if in Access Point mode, "Off" if disabled
+     * @return "STA" if connected to WiFi, "AP" if in Access Point mode, "Portal" or
+     *         "Connecting" during bring-up, "Off" if disabled
      */
   String getMode() const;
 
@@ -143,6 +195,13 @@ class NetworkManager {
      */
   int8_t getRSSI() const;
 
+  /**
+     * Current bring-up state
+     */
+  NetState getState() const {
+    return state;
+  }
+
   /**
      * Check if NetworkManager is initialized and running
      * @return true if running
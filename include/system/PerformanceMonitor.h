@@ -4,14 +4,31 @@
  * Watchdog-style performance monitoring for ESP32 Theremin.
  * Alerts when timing or RAM approaches critical thresholds.
  * Silent when everything is OK.
+ *
+ * Audio deadline statistics: every block's compute time goes into a rolling
+ * histogram (100 µs bins, halved every ~12 s so old spikes fade out), from
+ * which p50/p95/p99 are read; the max, I2S underruns and time blocked in
+ * i2s_write are tracked alongside. Spikes are kept even if they happen
+ * between status prints.
+ *
+ * System statistics (refreshed once per second from update()):
+ * - Per-core CPU load from the FreeRTOS idle tasks' run-time counters
+ *   (falls back to idle-hook time accounting when the framework is built
+ *   without configGENERATE_RUN_TIME_STATS)
+ * - Stack high-water marks of AudioTask, async_tcp (web server) and loopTask
+ * - Largest free heap block and fragmentation, minimum free heap since boot
  */
 
 #pragma once
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "system/DSPProfiler.h"
 
 // Forward declarations
 class DisplayManager;
 class Adafruit_SSD1306;
+class Looper;
 
 class PerformanceMonitor {
  public:
@@ -51,12 +68,124 @@ class PerformanceMonitor {
    */
   void recordAudioWork(uint32_t workTimeUs);
 
+  /**
+   * Record oscillator render time (part of the audio work time)
+   * Lets the cost of the oversampled quality preset be compared directly
+   * @param renderTimeUs Microseconds spent rendering (and decimating) the oscillator mix
+   * @param oversampled true if the block was rendered with QUALITY_HIGH
+   */
+  void recordOscillatorWork(uint32_t renderTimeUs, bool oversampled);
+
+  /**
+   * Record one i2s_write() call (called by audio task after each block)
+   * @param blockedUs Microseconds spent blocked inside i2s_write
+   * @param underrun true if the DMA queue ran dry before this write
+   *                 (or the write came back short)
+   */
+  void recordI2SWrite(uint32_t blockedUs, bool underrun);
+
+  /**
+   * Compute time percentile from the rolling histogram
+   * @param percent Percentile (e.g. 50, 95, 99)
+   * @return Upper edge of the histogram bin holding the percentile (µs)
+   */
+  uint32_t getAudioPercentileUs(uint8_t percent) const;
+
+  /**
+   * Worst compute time since boot (or last resetAudioStats)
+   */
+  uint32_t getAudioMaxUs() const { return maxAudioWorkTimeUs; }
+
+  /**
+   * I2S underruns detected since boot (or last resetAudioStats)
+   */
+  uint32_t getUnderrunCount() const { return underrunCount; }
+
+  /**
+   * Average / minimum time blocked in i2s_write (µs)
+   * Minimum close to zero means the audio task is near its deadline.
+   */
+  uint32_t getI2SBlockedAvgUs() const { return blockedAvgUs; }
+  uint32_t getI2SBlockedMinUs() const { return blockedMinUs; }
+
+  /**
+   * Clear histogram, max, underrun and blocked-time statistics
+   */
+  void resetAudioStats();
+
+  /**
+   * Print audio deadline statistics (serial "status" command)
+   */
+  void printAudioStats();
+
+  /**
+   * Get oscillator render time in milliseconds (for display)
+   * @return Oscillator render time in ms
+   */
+  float getOscillatorTimeMs() const { return latestOscWorkTimeUs / 1000.0f; }
+
+  /**
+   * Check if last block used the 2× oversampled render path
+   */
+  bool isOversampling() const { return latestOscOversampled; }
+
+  /**
+   * Per-core CPU load over the last second
+   * @param core 0 (protocol/WiFi core) or 1 (app core: loop + audio)
+   * @return Load in percent (0-100)
+   */
+  float getCoreLoad(uint8_t core) const { return core < NUM_CORES ? coreLoad[core] : 0.0f; }
+
+  /**
+   * Stack high-water marks of the tracked tasks
+   */
+  static const int NUM_TRACKED_TASKS = 3;
+  const char* getTaskLabel(int index) const;
+  /** @return Minimum free stack ever seen (bytes), -1 if task not running */
+  int32_t getTaskStackFree(int index) const;
+
+  /**
+   * Heap statistics (8-bit capable internal heap)
+   */
+  uint32_t getLargestFreeBlock() const { return largestFreeBlock; }
+  uint32_t getMinFreeHeap() const { return minFreeHeap; }
+  uint8_t getHeapFragmentation() const { return heapFragmentation; }  // % of free heap not in the largest block
+
+  /**
+   * Attach the looper so its buffer is reported with the heap statistics
+   * @param looperPtr Looper, or nullptr
+   */
+  void setLooper(const Looper* looperPtr) { looper = looperPtr; }
+
+  /**
+   * Looper buffer size (0 until the first recording allocates it)
+   */
+  uint32_t getLooperBytes() const;
+  bool isLooperInPsram() const;
+
+  /**
+   * Print CPU/stack/heap statistics (serial "status" command)
+   */
+  void printSystemStats();
+
   /**
    * Get audio work time in milliseconds (for display)
    * @return Audio work time in ms
    */
   float getAudioTimeMs() const { return latestAudioWorkTimeUs / 1000.0f; }
 
+  /**
+   * Get per-stage DSP profiler
+   * @return Profiler, or nullptr when built with ENABLE_DSP_PROFILING = 0
+   */
+  DSPProfiler* getDSPProfiler() {
+#if ENABLE_DSP_PROFILING
+    return &dspProfiler;
+#else
+    return nullptr;
+#endif
+  }
+
   /**
    * Get free RAM in kilobytes (for display)
    * @return Free heap memory in KB
@@ -68,20 +197,39 @@ class PerformanceMonitor {
    * @return true if system is OK, false if warnings present
    */
   bool isSystemOK() const {
-    return (latestAudioWorkTimeUs < AUDIO_WARN_US) &&
+    return (latestAudioWorkTimeUs < audioWarnUs) &&
            (ESP.getFreeHeap() > RAM_WARN_BYTES);
   }
 
  private:
   DisplayManager* display;
+  const Looper* looper;
 
   /**
    * Draw performance page for display
    */
   void drawPerformancePage(Adafruit_SSD1306& oled);
+
+  /**
+   * Draw per-core CPU / stack / heap page
+   */
+  void drawSystemPage(Adafruit_SSD1306& oled);
+
+#if ENABLE_DSP_PROFILING
+  // Per-stage cycle profiling of the audio block
+  DSPProfiler dspProfiler;
+
+  /**
+   * Draw per-stage DSP breakdown page
+   */
+  void drawDSPPage(Adafruit_SSD1306& oled);
+#endif
   // Performance thresholds (when to warn)
-  static const uint32_t AUDIO_WARN_US = 8000;      // 8ms (70% of 11ms buffer period)
+  // Audio threshold is 70% of the buffer period of the active output
+  // configuration (8.1ms at 22050 Hz/256 frames, 7.5ms at 48 kHz/512 frames)
+  static constexpr float AUDIO_WARN_RATIO = 0.70f;
   static const uint32_t RAM_WARN_BYTES = 50000;    // 50KB minimum free
+  uint32_t audioWarnUs;
 
   // Warning throttling (don't spam console)
   static const uint32_t WARN_THROTTLE_MS = 5000;  // Only warn every 5 seconds
@@ -90,11 +238,52 @@ class PerformanceMonitor {
 
   // Track latest audio timing for status report
   uint32_t latestAudioWorkTimeUs;
+  uint32_t latestOscWorkTimeUs;
+  bool latestOscOversampled;
+
+  // Rolling compute-time histogram (written by audio task, read by Core 0).
+  // Last bin collects everything >= (HIST_BINS - 1) * HIST_BIN_US.
+  static const int HIST_BINS = 128;
+  static const uint32_t HIST_BIN_US = 100;           // 128 × 100 µs = 12.8 ms range
+  static const uint32_t HIST_DECAY_BLOCKS = 1024;     // Halve all bins every ~12 s
+  volatile uint32_t histogram[HIST_BINS];
+  uint32_t histogramBlocks;                           // Blocks since last decay
+
+  // Deadline statistics
+  volatile uint32_t maxAudioWorkTimeUs;
+  volatile uint32_t underrunCount;
+  volatile uint32_t blockedAvgUs;                     // EMA (1/16 per block)
+  volatile uint32_t blockedMinUs;
 
   // Periodic status report
   static const uint32_t STATUS_INTERVAL_MS = 30000;  // Report every 30 seconds
   uint32_t lastStatusReport;
 
+  // System statistics (updated every SYSTEM_STATS_INTERVAL_MS from update())
+  static const uint32_t SYSTEM_STATS_INTERVAL_MS = 1000;
+  static const uint32_t STACK_WARN_BYTES = 512;   // Warn when a task gets this close to overflow
+  static const int NUM_CORES = 2;
+  uint32_t lastSystemStats;
+  uint32_t lastStackWarn;
+  float coreLoad[NUM_CORES];
+  uint32_t lastIdleTime[NUM_CORES];               // Idle run time at last sample
+  uint32_t lastTotalTime;                         // Total run time at last sample
+  TaskHandle_t taskHandles[NUM_TRACKED_TASKS];    // Looked up by name (tasks start late)
+  int32_t taskStackFree[NUM_TRACKED_TASKS];
+  uint32_t largestFreeBlock;
+  uint32_t minFreeHeap;
+  uint8_t heapFragmentation;
+
+  /**
+   * Refresh CPU load, stack and heap statistics
+   */
+  void updateSystemStats();
+
+  /**
+   * Sample per-core idle time and update coreLoad[]
+   */
+  void updateCoreLoad();
+
   /**
    * Check RAM and warn if low
    */
@@ -104,4 +293,10 @@ class PerformanceMonitor {
    * Print periodic status report (optional reassurance)
    */
   void printStatus();
+
+  /**
+   * Print active output configuration (rate, I2S frame width, clock source)
+   * Prefixes every CPU figure so reports from different builds can be compared
+   */
+  void printOutputConfig();
 };
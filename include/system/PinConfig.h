@@ -60,6 +60,8 @@
 //=============================================================================
 // MCP23017 I2C GPIO Expander
 #define PIN_SWITCH_EXPANDER_ADDR  0x20  // MCP23017 I2C address
+#define PIN_SWITCH_EXPANDER_INT   32    // MCP23017 INTA or INTB (mirrored, open-drain, active LOW)
+                                        // -1 = not wired, poll the expander instead
 
 // Waveform Rotary Switches (4-position, 3 GPIO each = 9 total)
 // Uses MCP23017 pins 0-5:
@@ -120,6 +122,7 @@
  *   25  - I2S BCK (Bit Clock for PCM5102)
  *   26  - I2S DOUT (Data Output for PCM5102)
  *   27  - I2S WS (Word Select for PCM5102)
+ *   32  - MCP23017 interrupt (INTA/INTB, switch change)
  *
  * Future GPIO Allocation:
  * -----------------------------------
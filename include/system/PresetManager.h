@@ -0,0 +1,315 @@
+/*
+ * PresetManager.h
+ *
+ * Preset bank: NUM_SLOTS complete sound setups (oscillators, effects and
+ * their order, smoothing, range, quality, channel) stored in NVS.
+ *
+ * Storage:
+ * - One blob per slot ("p0".."p7" in the "presets" namespace), a compact
+ *   fixed binary record: header (magic, format version, payload size,
+ *   CRC-16) + packed payload. A slot whose magic, version or CRC does not
+ *   match reads as empty, so a half-written or stale record is never
+ *   applied.
+ * - Wear: NVS spreads writes over its pages and replaces an entry only once
+ *   the new one is complete. All slots are cached in RAM at begin(), so
+ *   recall never touches flash, and saving a preset identical to the stored
+ *   one does not write at all. Writing flash briefly stalls both cores -
+ *   save between phrases, not while playing.
+ *
+ * Recall:
+ * - The record is decoded on the loop task, then AudioEngine::beginSwap()
+ *   fades the next block out and mutes the output. Once the audio task has
+ *   stopped rendering, AudioEngine::holdSwap() keeps it muted (no timeout)
+ *   while every parameter is applied through the normal setters (so the web
+ *   UI gets its deltas), then the next block fades in with the effect tails
+ *   intact. The audio task never sees a half-applied
+ *   preset and never waits on the loop task.
+ *
+ * Morph (startMorph): recalls a merge of two presets through the same
+ * swap, then ParameterMorph interpolates their continuous parameters on
+ * the audio task. The position comes from the web UI/serial or from the
+ * volume hand (MORPH_SENSOR - disable the volume sensor, "sensors:volume:
+ * off", to use that hand for morphing only).
+ *
+ * Access: serial ("preset:...", "morph:..."), WebSocket (savePreset/
+ * loadPreset/deletePreset, startMorph/stopMorph/setMorph/setMorphSource)
+ * and the multi-button (double-click on the Presets page). Serial and
+ * WebSocket commands (CommandRegistry) post requests (request*()), handled
+ * by update() on the loop task.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <Preferences.h>
+#include <freertos/FreeRTOS.h>
+#include "system/DisplayManager.h"
+#include "audio/ParameterMorph.h"
+
+// Forward declaration
+class Theremin;
+
+class PresetManager {
+ public:
+  static const uint8_t NUM_SLOTS = 8;
+  static const uint8_t NAME_LENGTH = 12;  // Including terminator
+
+  /**
+   * Where the morph position comes from
+   */
+  enum MorphSource {
+    MORPH_MANUAL = 0,  // Web UI slider / serial
+    MORPH_SENSOR = 1   // Volume hand distance (near = first preset)
+  };
+
+  /**
+   * Constructor
+   * @param theremin Owner (audio engine, smoothing and range presets)
+   */
+  PresetManager(Theremin* theremin);
+
+  /**
+   * Load all slots from NVS into the RAM cache
+   * Call once from Theremin::begin()
+   */
+  void begin();
+
+  /**
+   * Finish a pending recall and handle requests from other tasks
+   * Call from the loop task (Theremin::update)
+   */
+  void update();
+
+  /**
+   * Register the Presets OLED page
+   * @param disp Pointer to DisplayManager
+   */
+  void setDisplay(DisplayManager* disp);
+
+  /**
+   * Store the current sound in a slot (loop task)
+   * @param slot Slot index (0-based)
+   * @param name Preset name, or nullptr/"" to keep the stored one (or "Preset N")
+   * @return true if stored
+   */
+  bool save(uint8_t slot, const char* name = nullptr);
+
+  /**
+   * Start recalling a slot (loop task); applied at a buffer boundary
+   * @param slot Slot index (0-based)
+   * @return false if the slot is empty or out of range
+   */
+  bool recall(uint8_t slot);
+
+  /**
+   * Recall the next used slot after the active one (multi-button)
+   * @return false if the bank is empty
+   */
+  bool recallNext();
+
+  /**
+   * Erase a slot (loop task)
+   * @param slot Slot index (0-based)
+   * @return true if the slot existed
+   */
+  bool remove(uint8_t slot);
+
+  /**
+   * Start morphing between two stored presets (loop task)
+   * Waveforms, octaves, order and the other discrete settings come from
+   * the first preset (an oscillator it has OFF takes the second one's
+   * waveform); effects enabled in either preset are enabled.
+   * @param from Slot at position 0.0 (0-based)
+   * @param to Slot at position 1.0 (0-based)
+   * @return false if either slot is empty
+   */
+  bool startMorph(uint8_t from, uint8_t to);
+
+  /**
+   * Stop morphing; the sound stays where the morph left it (loop task)
+   */
+  void stopMorph();
+
+  bool isMorphing() const;
+
+  /**
+   * Morph slots (valid while isMorphing())
+   */
+  uint8_t getMorphFrom() const { return morphFrom; }
+  uint8_t getMorphTo() const { return morphTo; }
+
+  /**
+   * Set the morph position (any task; ignored with MORPH_SENSOR)
+   * @param position 0.0 = first preset, 1.0 = second preset
+   */
+  void setMorphPosition(float position);
+  float getMorphPosition() const;
+
+  void setMorphSource(MorphSource source);
+  MorphSource getMorphSource() const { return morphSource; }
+
+  /**
+   * Post a request from another task (WebSocket); handled by update()
+   */
+  void requestSave(uint8_t slot, const char* name);
+  void requestRecall(uint8_t slot);
+  void requestRemove(uint8_t slot);
+  void requestRecallNext();
+  void requestStartMorph(uint8_t from, uint8_t to);
+  void requestStopMorph();
+
+  /**
+   * Slot state (any task)
+   */
+  bool isUsed(uint8_t slot) const;
+
+  /**
+   * Copy a slot's name
+   * @param slot Slot index (0-based)
+   * @param out Destination buffer (at least NAME_LENGTH)
+   * @param len Size of out
+   * @return false if the slot is empty (out is set to "")
+   */
+  bool getName(uint8_t slot, char* out, size_t len) const;
+
+  /**
+   * Slot recalled or saved last
+   * @return Slot index, or -1 if none since boot
+   */
+  int getActiveSlot() const { return activeSlot; }
+
+  /**
+   * Print the bank to Serial
+   */
+  void printList() const;
+
+ private:
+  static const uint16_t RECORD_MAGIC = 0x5054;  // "TP"
+  static const uint8_t RECORD_VERSION = 1;
+  static const uint8_t NUM_OSCILLATORS = 3;
+  static const uint8_t MAX_EFFECTS = 4;
+  static const uint8_t MAX_PARAMS = 4;
+
+  // Stored payload (format RECORD_VERSION - append fields, bump the version)
+  struct __attribute__((packed)) PresetData {
+    char name[NAME_LENGTH];
+    uint8_t waveform[NUM_OSCILLATORS];      // Oscillator::Waveform
+    int8_t octave[NUM_OSCILLATORS];         // -1, 0, +1
+    uint8_t volume[NUM_OSCILLATORS];        // 0-100 %
+    uint8_t effectEnabled;                  // Bit per effect (registration order)
+    uint8_t effectOrder[MAX_EFFECTS];       // Registration index per slot
+    uint16_t effectParam[MAX_EFFECTS][MAX_PARAMS];  // Quantized over min..max
+    uint8_t pitchSmoothing;                 // Theremin::SmoothingPreset
+    uint8_t volumeSmoothing;
+    uint8_t frequencyRange;                 // Theremin::FrequencyRangePreset
+    uint8_t quality;                        // AudioEngine::QualityPreset
+    uint8_t channelMode;                    // AudioEngine::ChannelMode
+  };
+
+  struct __attribute__((packed)) RecordHeader {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t payloadSize;
+    uint16_t crc;  // CRC-16/CCITT of the payload
+  };
+
+  struct __attribute__((packed)) Record {
+    RecordHeader header;
+    PresetData data;
+  };
+
+  enum RequestType : uint8_t {
+    REQUEST_NONE = 0,
+    REQUEST_SAVE,
+    REQUEST_RECALL,
+    REQUEST_REMOVE,
+    REQUEST_MORPH,
+    REQUEST_MORPH_STOP,
+    REQUEST_NEXT
+  };
+
+  Theremin* theremin;
+  DisplayManager* display;
+  Preferences prefs;
+
+  // RAM copy of the bank (written by the loop task only)
+  PresetData slots[NUM_SLOTS];
+  bool used[NUM_SLOTS];
+  volatile int activeSlot;
+
+  // Recall in progress (waiting for the audio task to mute)
+  bool swapPending;
+  int swapSlot;       // Slot being recalled, -1 for a morph start
+  PresetData swapData;
+
+  // Morph endpoints (handed to ParameterMorph once the swap is applied)
+  ParameterMorph::Params morphStart;
+  ParameterMorph::Params morphEnd;
+  uint8_t morphFrom;
+  uint8_t morphTo;
+  volatile MorphSource morphSource;
+
+  // Request posted by another task
+  volatile RequestType requestType;
+  uint8_t requestSlot;
+  uint8_t requestSlot2;
+  char requestName[NAME_LENGTH];
+  mutable portMUX_TYPE mux;
+
+  /**
+   * Capture the current sound into a payload
+   */
+  void capture(PresetData& data);
+
+  /**
+   * Apply a payload (audio muted by the swap)
+   */
+  void apply(const PresetData& data);
+
+  /**
+   * Mute the output and apply data at the next buffer boundary
+   * @param slot Slot being recalled, -1 for a morph start
+   */
+  void beginSwap(const PresetData& data, int slot);
+
+  /**
+   * Continuous parameters of a stored preset, as morph endpoint
+   */
+  void toMorphParams(const PresetData& data, ParameterMorph::Params& params);
+
+  /**
+   * Stored effect parameter in its natural unit
+   * @param data Payload
+   * @param effectIndex Registration index
+   * @param key Parameter key ("mix", "feedback"...)
+   * @return Value, or 0 if the effect has no such parameter
+   */
+  float storedParam(const PresetData& data, uint8_t effectIndex, const char* key);
+
+  /**
+   * NVS key for a slot ("p0".."p7")
+   */
+  static void slotKey(uint8_t slot, char* key);
+
+  /**
+   * Read and validate one slot from NVS
+   * @return true if the record is intact and of a known version
+   */
+  bool load(uint8_t slot, PresetData& data);
+
+  static uint16_t crc16(const uint8_t* data, size_t length);
+
+  /**
+   * Post a request (replaces an unhandled one)
+   */
+  void post(RequestType type, uint8_t slot, const char* name, uint8_t slot2 = 0);
+
+  /**
+   * Report a bank change (web UI deltas)
+   */
+  void markChanged();
+
+  /**
+   * Draw the Presets page
+   */
+  void drawPresetsPage(Adafruit_SSD1306& oled);
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "audio/AudioTap.h"
+#include "audio/AudioConstants.h"
+#include "system/DisplayManager.h"
+
+/**
+ * @brief SpectrumAnalyzer - Live scope trace and magnitude spectrum of the output
+ *
+ * Reads the final output (after effects and master bus) from the AudioEngine
+ * output tap and produces frames for the Web UI scope view and an optional
+ * OLED mini-spectrum. Used to see aliasing, clipping and the reverb noise
+ * floor on the real signal rather than guessing.
+ *
+ * Architecture:
+ *   AudioTask (Core 1) → AudioTap → ScopeTask (Core 0) → { DisplayManager, WebUIManager }
+ *
+ * - The audio task only copies its block into the tap ring (no waiting)
+ * - ScopeTask runs at priority 1 on Core 0, and only while a consumer is
+ *   watching (keepAlive() from the scope view or the OLED page); otherwise
+ *   it sleeps and costs nothing
+ * - Each frame takes the latest window from the tap: a 256-point fixed-point
+ *   FFT (Hann window, Q15 twiddles) and a zero-crossing triggered scope trace
+ * - Frames are double-buffered; readers copy the published one and retry on
+ *   the next tick if it changed underneath them
+ *
+ * Performance: one FFT every 50 ms while active (~1 ms on Core 0)
+ */
+class SpectrumAnalyzer {
+public:
+    static constexpr int FFT_SIZE = 256;
+    static constexpr int FFT_BITS = 8;                 // log2(FFT_SIZE)
+    static constexpr int NUM_BINS = FFT_SIZE / 2;      // DC .. Nyquist - 1
+    static constexpr int SCOPE_POINTS = 128;           // One per OLED column
+
+    // Scope decimation: ~11 ms of signal across the trace at any sample rate
+    static constexpr int SCOPE_STEP = (Audio::SAMPLE_RATE >= 44100) ? 4 : 2;
+
+    // Samples per frame: trace plus half a trace to search for the trigger
+    static constexpr int WINDOW_SIZE = SCOPE_POINTS * SCOPE_STEP * 3 / 2;
+    static_assert(WINDOW_SIZE >= FFT_SIZE, "Analysis window shorter than the FFT");
+    static_assert(WINDOW_SIZE <= (int)AudioTap::SIZE / 2, "Analysis window too large for the tap ring");
+
+    // Bin encoding: value = (dBFS + BIN_DB_OFFSET) * 2, 0 = -120 dBFS or below
+    static constexpr int BIN_DB_OFFSET = 120;
+
+    /**
+     * @brief One analysis frame
+     */
+    struct Frame {
+        uint8_t bins[NUM_BINS];       // Magnitude, 0.5 dB steps (see BIN_DB_OFFSET)
+        int8_t scope[SCOPE_POINTS];   // Trace, sample >> 8
+        uint16_t peak;                // Largest |sample| in the window
+    };
+
+    /**
+     * @brief Construct SpectrumAnalyzer
+     * @param outputTap Output ring to analyze (AudioEngine::getOutputTap())
+     */
+    SpectrumAnalyzer(const AudioTap* outputTap);
+
+    ~SpectrumAnalyzer();
+
+    /**
+     * @brief Start the analysis task (Core 0, idle until keepAlive())
+     * @return true if the task was created
+     */
+    bool begin();
+
+    /**
+     * @brief Set display and register the spectrum page
+     * @param disp Pointer to DisplayManager
+     */
+    void setDisplay(DisplayManager* disp);
+
+    /**
+     * @brief Keep producing frames for a while (call periodically while watching)
+     * @param durationMs How long to stay active without another call
+     */
+    void keepAlive(uint32_t durationMs = ACTIVE_TIMEOUT_MS);
+
+    /**
+     * @brief Frame counter (increments on every published frame)
+     */
+    uint32_t getFrameSeq() const { return frameSeq; }
+
+    /**
+     * @brief Copy the latest frame
+     * @param out Destination
+     * @param seq Sequence number of the copied frame
+     * @return false if no frame yet, or it was replaced during the copy
+     */
+    bool copyFrame(Frame& out, uint32_t& seq) const;
+
+private:
+    static constexpr uint32_t FRAME_INTERVAL_MS = 50;    // 20 frames/s while active
+    static constexpr uint32_t IDLE_POLL_MS = 100;        // Sleep while nobody watches
+    static constexpr uint32_t ACTIVE_TIMEOUT_MS = 2000;  // Stop after 2 s without keepAlive()
+
+    const AudioTap* tap;
+    DisplayManager* display;
+    TaskHandle_t taskHandle;
+    volatile uint32_t activeUntil;
+
+    Frame frames[2];              // Double buffer: frames[frameSeq & 1] is published
+    volatile uint32_t frameSeq;
+
+    // Work buffers (members, not on the task stack)
+    int16_t window[WINDOW_SIZE];
+    int32_t re[FFT_SIZE];
+    int32_t im[FFT_SIZE];
+
+    // Tables computed once in the constructor (Q15)
+    int16_t hann[FFT_SIZE];
+    int16_t cosTable[FFT_SIZE / 2];
+    int16_t sinTable[FFT_SIZE / 2];
+
+    static void taskFunction(void* parameter);
+    bool isActive() const;
+    void analyze();
+    void computeSpectrum(Frame& frame);
+    void computeScope(Frame& frame);
+    void fft();
+
+    // Display page callback
+    void drawSpectrumPage(Adafruit_SSD1306& oled);
+};
@@ -0,0 +1,116 @@
+/*
+ * StateTracker.h
+ *
+ * Versioned change tracking for the user-facing configuration state
+ * (oscillators, effects, effect order, system presets).
+ *
+ * Setters in AudioEngine, EffectsChain and Theremin mark the fields they
+ * change; WebUIManager takes the accumulated dirty bits once per tick and
+ * broadcasts only those fields. Nothing changed = nothing sent, however
+ * many clients are connected.
+ *
+ * Dirty bit layout (32-bit word):
+ *   bits  0-8   oscillator 1-3 × {waveform, octave, volume}
+ *   bits  9-16  effect by registration index (enable + all params)
+ *   bit   17    effect slot order
+ *   bits 18-22  system: pitch/volume smoothing, range preset, quality,
+ *               frequency bounds
+ *   bit   23    preset bank (slot names, active slot)
+ *   bit   24    automation lane (state, event count, loop length)
+ *   bit   25    looper (state, length, settings)
+ *   bit   26    audio capture (state, duration, dropped blocks)
+ *
+ * Thread safety: setters run on the loop task (Core 1) and on the
+ * async_tcp task (Core 0), automation playback and looper state changes
+ * on the audio task, capture progress on the capture task, so marks are
+ * atomic ORs. The version counter increments on every mark; clients use
+ * it to detect missed deltas.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+
+class StateTracker {
+ public:
+  // Oscillator fields (combine with oscBit())
+  enum OscField {
+    OSC_WAVEFORM = 0,
+    OSC_OCTAVE = 1,
+    OSC_VOLUME = 2
+  };
+
+  static const uint32_t OSC_FIELDS = 3;
+  static const uint32_t MAX_OSCILLATORS = 3;
+  static const uint32_t EFFECT_SHIFT = 9;
+  static const uint32_t MAX_EFFECTS = 8;
+
+  static const uint32_t OSC_MASK = (1UL << (OSC_FIELDS * MAX_OSCILLATORS)) - 1;
+  static const uint32_t EFFECT_MASK = ((1UL << MAX_EFFECTS) - 1) << EFFECT_SHIFT;
+  static const uint32_t EFFECT_ORDER = 1UL << 17;
+  static const uint32_t PITCH_SMOOTHING = 1UL << 18;
+  static const uint32_t VOLUME_SMOOTHING = 1UL << 19;
+  static const uint32_t FREQUENCY_RANGE = 1UL << 20;
+  static const uint32_t QUALITY = 1UL << 21;
+  static const uint32_t FREQUENCY_BOUNDS = 1UL << 22;
+  static const uint32_t SYSTEM_MASK = PITCH_SMOOTHING | VOLUME_SMOOTHING | FREQUENCY_RANGE |
+                                      QUALITY | FREQUENCY_BOUNDS;
+  static const uint32_t PRESETS = 1UL << 23;
+  static const uint32_t AUTOMATION = 1UL << 24;
+  static const uint32_t LOOPER = 1UL << 25;
+  static const uint32_t CAPTURE = 1UL << 26;
+  static const uint32_t ALL = OSC_MASK | EFFECT_MASK | EFFECT_ORDER | SYSTEM_MASK | PRESETS | AUTOMATION |
+                              LOOPER | CAPTURE;
+
+  /**
+   * Dirty bit for one oscillator field
+   * @param oscNum Oscillator number (1-3)
+   */
+  static constexpr uint32_t oscBit(int oscNum, OscField field) {
+    return 1UL << ((oscNum - 1) * OSC_FIELDS + field);
+  }
+
+  /**
+   * Dirty bit for an effect (registration index, not slot)
+   */
+  static constexpr uint32_t effectBit(uint8_t index) {
+    return 1UL << (EFFECT_SHIFT + index);
+  }
+
+  StateTracker() : dirty(0), version(0) {}
+
+  /**
+   * Mark fields as changed (any task)
+   * @param bits One or more dirty bits
+   */
+  void mark(uint32_t bits) {
+    dirty.fetch_or(bits, std::memory_order_relaxed);
+    version.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Take and clear all pending dirty bits (broadcaster only)
+   * @return Fields changed since the previous take
+   */
+  uint32_t take() {
+    return dirty.exchange(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * Check for pending changes without clearing them
+   */
+  bool hasChanges() const {
+    return dirty.load(std::memory_order_relaxed) != 0;
+  }
+
+  /**
+   * State version (increments on every change)
+   */
+  uint32_t getVersion() const {
+    return version.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<uint32_t> dirty;
+  std::atomic<uint32_t> version;
+};
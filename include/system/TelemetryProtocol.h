@@ -0,0 +1,135 @@
+/*
+ * TelemetryProtocol.h
+ *
+ * Binary WebSocket message format for high-rate telemetry (sensor,
+ * performance, tuner, scope/spectrum) and the audio capture stream. Configuration messages (oscillators, effects,
+ * system presets, effect schema) stay JSON - they are rare and the UI
+ * benefits from named fields there.
+ *
+ * WIRE FORMAT:
+ * - Every message is one binary WebSocket frame: Header + payload.
+ * - Structs are packed, little-endian (native ESP32 byte order), so the
+ *   firmware fills them in place and the browser reads them with DataView.
+ * - `version` changes whenever a layout changes; the UI ignores frames with
+ *   a version it does not know (a stale page after a firmware update keeps
+ *   working on JSON until reloaded).
+ * - `seq` increments per message type, so the UI can count dropped frames.
+ *
+ * Keep in sync with web_ui_src/src/hooks/WebSocketProvider.jsx (decoders).
+ */
+
+#pragma once
+#include <Arduino.h>
+
+namespace Telemetry {
+    constexpr uint8_t PROTOCOL_VERSION = 1;
+
+    enum MessageType : uint8_t {
+        MSG_SENSOR = 1,
+        MSG_PERFORMANCE = 2,
+        MSG_TUNER = 3,
+        MSG_SPECTRUM = 4,   // Only sent to clients that enabled the scope view
+        MSG_AUDIO = 5       // Only sent to clients that asked for the audio stream
+    };
+
+    // Performance flags (PerformancePacket::flags)
+    constexpr uint8_t PERF_FLAG_OVERSAMPLED = 0x01;  // QUALITY_HIGH active
+    constexpr uint8_t PERF_FLAG_APLL = 0x02;         // I2S clocked from APLL
+
+    // Tuner flags (TunerPacket::flags)
+    constexpr uint8_t TUNER_FLAG_VALID = 0x01;    // Frequency >= 20 Hz
+    constexpr uint8_t TUNER_FLAG_IN_TUNE = 0x02;  // Within ±10 cents
+
+    constexpr int NUM_STACKS = 3;  // PerformanceMonitor::NUM_TRACKED_TASKS
+
+    struct __attribute__((packed)) Header {
+        uint8_t version;   // PROTOCOL_VERSION
+        uint8_t type;      // MessageType
+        uint16_t seq;      // Per-type sequence number (wraps)
+    };
+
+    // 12 bytes
+    struct __attribute__((packed)) SensorPacket {
+        Header header;
+        float pitch;       // mm
+        float volume;      // mm
+    };
+
+    // 56 bytes
+    struct __attribute__((packed)) PerformancePacket {
+        Header header;
+        uint32_t uptimeMs;
+        uint32_t freeHeap;          // bytes
+        uint32_t largestBlock;      // bytes
+        uint32_t minFreeHeap;       // bytes
+        uint32_t underruns;
+        uint32_t sampleRate;        // Hz
+        uint16_t audioTimeUs;       // Latest audio task work time
+        uint16_t maxAudioTimeUs;    // Block period (deadline)
+        uint16_t oscTimeUs;
+        uint16_t p50Us;
+        uint16_t p95Us;
+        uint16_t p99Us;
+        uint16_t maxUs;             // Worst block since boot/reset
+        uint16_t blockedAvgUs;      // Average time blocked in i2s_write
+        int16_t stackFree[NUM_STACKS];  // Audio, Web, Loop (bytes, -1 = not running)
+        uint8_t cpu0;               // %
+        uint8_t cpu1;               // %
+        uint8_t fragmentation;      // %
+        uint8_t i2sBits;
+        uint8_t flags;              // PERF_FLAG_*
+        uint8_t i2cLoad;            // % of time the I2C bus was held
+    };
+
+    // 12 bytes
+    struct __attribute__((packed)) TunerPacket {
+        Header header;
+        float frequency;   // Hz (0 = no signal)
+        int8_t noteIndex;  // 0-11 (C..B), -1 = no signal
+        int8_t octave;
+        int8_t cents;      // -50..+50
+        uint8_t flags;     // TUNER_FLAG_*
+    };
+
+    constexpr int SPECTRUM_BINS = 128;   // SpectrumAnalyzer::NUM_BINS
+    constexpr int SCOPE_POINTS = 128;    // SpectrumAnalyzer::SCOPE_POINTS
+
+    // 272 bytes
+    struct __attribute__((packed)) SpectrumPacket {
+        Header header;
+        uint32_t sampleRate;        // Hz (bin k = k * sampleRate / (2 * binCount))
+        uint8_t binCount;           // SPECTRUM_BINS
+        uint8_t scopeCount;         // SCOPE_POINTS
+        uint8_t scopeStep;          // Samples between scope points
+        uint8_t reserved;
+        uint16_t peak;              // Largest |sample| in the analysis window
+        uint16_t frameSeq;          // Analyzer frame counter (low 16 bits)
+        uint8_t bins[SPECTRUM_BINS];    // dBFS = value / 2 - 120
+        int8_t scope[SCOPE_POINTS];     // Output sample >> 8
+    };
+
+    // Audio stream formats (AudioPacket::format)
+    constexpr uint8_t AUDIO_FORMAT_PCM16 = 0;       // Little-endian int16 samples
+    constexpr uint8_t AUDIO_FORMAT_IMA_ADPCM = 1;   // One WAV IMA-ADPCM mono block
+
+    // 20 bytes + payload (variable: one AudioCapture stream packet)
+    struct __attribute__((packed)) AudioPacket {
+        Header header;
+        uint32_t sampleRate;        // Hz
+        uint32_t position;          // First sample's index since the stream started
+        uint32_t dropped;           // Output blocks dropped so far (capture task behind)
+        uint16_t sampleCount;       // Samples in the payload
+        uint8_t format;             // AUDIO_FORMAT_*
+        uint8_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 4, "Telemetry header must be 4 bytes");
+    static_assert(sizeof(SensorPacket) == 12, "SensorPacket layout changed - bump PROTOCOL_VERSION");
+    static_assert(sizeof(PerformancePacket) == 56, "PerformancePacket layout changed - bump PROTOCOL_VERSION");
+    static_assert(sizeof(TunerPacket) == 12, "TunerPacket layout changed - bump PROTOCOL_VERSION");
+    static_assert(sizeof(SpectrumPacket) == 272, "SpectrumPacket layout changed - bump PROTOCOL_VERSION");
+    static_assert(sizeof(AudioPacket) == 20, "AudioPacket layout changed - bump PROTOCOL_VERSION");
+
+    // Largest packet (sizes the preallocated send buffers)
+    constexpr size_t MAX_PACKET_SIZE = sizeof(SpectrumPacket);
+}
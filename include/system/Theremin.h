@@ -13,6 +13,11 @@
 #include "system/DisplayManager.h"
 #include "system/NotificationManager.h"
 #include "system/TunerManager.h"
+#include "system/SpectrumAnalyzer.h"
+#include "system/AudioCapture.h"
+#include "system/PresetManager.h"
+#include "system/CommandRegistry.h"
+#include "system/I2CBus.h"
 
 // Forward declaration
 class PerformanceMonitor;
@@ -94,6 +99,55 @@ class Theremin {
    */
   TunerManager* getTunerManager() { return tunerManager; }
 
+  /**
+   * Get pointer to SpectrumAnalyzer instance (scope/spectrum of the output)
+   * @return Pointer to SpectrumAnalyzer, or nullptr if not available
+   */
+  SpectrumAnalyzer* getSpectrumAnalyzer() { return spectrumAnalyzer; }
+
+  /**
+   * Get pointer to AudioCapture instance (WAV file / stream recorder)
+   * @return Pointer to AudioCapture
+   */
+  AudioCapture* getAudioCapture() { return audioCapture; }
+
+  /**
+   * Get pointer to PitchDetector instance (measured output pitch)
+   * @return Pointer to PitchDetector
+   */
+  PitchDetector* getPitchDetector() { return pitchDetector; }
+
+  /**
+   * Get pointer to PresetManager instance (preset bank)
+   * @return Pointer to PresetManager
+   */
+  PresetManager* getPresetManager() { return presetManager; }
+
+  /**
+   * Get pointer to the command table shared by serial and WebSocket
+   * @return Pointer to CommandRegistry
+   */
+  CommandRegistry* getCommandRegistry() { return commandRegistry; }
+
+  /**
+   * Set the shared I2C bus manager (sensors and expander arbitrate through it)
+   * Call before begin().
+   * @param bus Pointer to I2CBus instance
+   */
+  void setI2CBus(I2CBus* bus);
+
+  /**
+   * Get pointer to the shared I2C bus manager
+   * @return Pointer to I2CBus, or nullptr if not set
+   */
+  I2CBus* getI2CBus() { return i2cBus; }
+
+  /**
+   * Get pointer to GPIOControls instance (physical switches and button)
+   * @return Pointer to GPIOControls
+   */
+  GPIOControls* getGPIOControls() { return &gpioControls; }
+
   /**
    * Get reference to MCP23017 (for advanced use like WiFi reset check)
    * @return Reference to MCP23017 instance from GPIOControls
@@ -118,6 +172,13 @@ class Theremin {
    */
   void setFrequencyRangePreset(FrequencyRangePreset preset);
 
+  /**
+   * Audio-level smoothing factor used by a smoothing preset
+   * @param preset Smoothing preset level
+   * @return Factor for AudioEngine::setPitch/VolumeSmoothingFactor()
+   */
+  static float audioSmoothingFactor(SmoothingPreset preset);
+
   /**
    * Get current pitch smoothing preset
    * @return Current pitch smoothing preset
@@ -144,6 +205,12 @@ class Theremin {
   DisplayManager* display;
   NotificationManager* notifications;
   TunerManager* tunerManager;
+  SpectrumAnalyzer* spectrumAnalyzer;
+  AudioCapture* audioCapture;
+  PitchDetector* pitchDetector;
+  PresetManager* presetManager;
+  CommandRegistry* commandRegistry;
+  I2CBus* i2cBus;
   bool debugEnabled;
 
   // Current preset values (for WebUI state tracking)
@@ -176,6 +243,11 @@ class Theremin {
    */
   void drawSmoothPage(Adafruit_SSD1306& oled);
 
+  /**
+   * Draw looper page showing loop state, position and length
+   */
+  void drawLooperPage(Adafruit_SSD1306& oled);
+
   // Amplitude range constants (internal use only)
   static const int MIN_AMPLITUDE_PERCENT = 0;
   static const int MAX_AMPLITUDE_PERCENT = 100;
@@ -2,6 +2,8 @@
 
 #include <Arduino.h>
 #include "audio/AudioEngine.h"
+#include "audio/PitchDetector.h"
+#include "audio/NoteTable.h"
 #include "system/DisplayManager.h"
 
 /**
@@ -9,22 +11,31 @@
  *
  * Provides centralized tuner logic for both OLED display and Web UI:
  * - Converts frequency (Hz) to musical note with cents deviation
+ * - Frequency is measured from the output signal (PitchDetector) when
+ *   available, so the tuner shows what is heard: octave shifts, smoothing
+ *   glide and effects included. Falls back to the engine target frequency.
  * - Registers OLED display page
  * - Provides data for WebSocket broadcasting
  *
  * Architecture:
- *   AudioEngine → TunerManager → { DisplayManager, WebUIManager }
+ *   AudioEngine → AudioTap → PitchDetector → TunerManager → { DisplayManager, WebUIManager }
  *
- * Performance: <1% CPU overhead (simple logarithmic calculations)
+ * Note/cents come from NoteTable (binary search in a precomputed semitone
+ * table, fixed char buffers - no log2f, no String allocation), so the tuner
+ * runs at display frame rate.
+ *
+ * Performance: <0.1% CPU overhead
  */
 class TunerManager {
 private:
     AudioEngine* audioEngine;
+    PitchDetector* pitchDetector;
     DisplayManager* display;
 
     // Tuner state
-    String currentNote;          // Musical note name (e.g., "C#4", "A3")
-    String currentNoteName;      // Note name only (e.g., "C#", "A")
+    char currentNote[NoteTable::NOTE_BUFFER_SIZE];  // Musical note name (e.g., "C#4", "A3")
+    const char* currentNoteName; // Note name only (e.g., "C#", "A"), points into NoteTable
+    int currentNoteIndex;        // Index into NOTE_NAMES (0 = C), -1 = no signal
     int currentOctave;           // Octave number (e.g., 4, 3)
     float currentFrequency;      // Frequency in Hz
     int cents;                   // Deviation in cents (-50 to +50)
@@ -32,7 +43,7 @@ private:
 
     // Update tracking
     unsigned long lastUpdate;
-    static const int UPDATE_INTERVAL = 100;  // 100ms (10 Hz)
+    static const uint32_t UPDATE_INTERVAL = DisplayManager::FRAME_INTERVAL_MS;  // OLED frame rate
 
     // Display page callback
     void drawTunerPage(Adafruit_SSD1306& oled);
@@ -40,9 +51,6 @@ private:
     // Frequency-to-note conversion
     void calculateTunerData(float frequency);
 
-    // Note names lookup table
-    static const char* NOTE_NAMES[12];
-
 public:
     /**
      * @brief Construct TunerManager
@@ -56,6 +64,12 @@ public:
      */
     void setDisplay(DisplayManager* disp);
 
+    /**
+     * @brief Measure pitch from the output signal instead of the target frequency
+     * @param detector Pointer to PitchDetector (nullptr = use AudioEngine::getFrequency())
+     */
+    void setPitchDetector(PitchDetector* detector) { pitchDetector = detector; }
+
     /**
      * @brief Update tuner calculations (call in main loop)
      */
@@ -65,12 +79,17 @@ public:
     /**
      * @brief Get current note with octave (e.g., "C#4")
      */
-    const String& getCurrentNote() const { return currentNote; }
+    const char* getCurrentNote() const { return currentNote; }
 
     /**
      * @brief Get note name only (e.g., "C#")
      */
-    const String& getCurrentNoteName() const { return currentNoteName; }
+    const char* getCurrentNoteName() const { return currentNoteName; }
+
+    /**
+     * @brief Get note index within the octave (0 = C ... 11 = B, -1 = no signal)
+     */
+    int getNoteIndex() const { return currentNoteIndex; }
 
     /**
      * @brief Get octave number
@@ -0,0 +1,131 @@
+/*
+ * WebSocketDelivery.h
+ *
+ * Per-client send policy of the WebSocket interface (used by WebUIManager):
+ *
+ * - Shared send buffers: a message is serialized once into a refcounted
+ *   buffer and each client queues a reference. Pool buffers are allocated
+ *   once and reused when every client has sent them (use_count() back to 1).
+ * - Telemetry (snapshots) is skipped for a client with queueDepth messages
+ *   already queued: the next frame supersedes it, so a slow client never
+ *   holds up the others and holds at most queueDepth pool buffers.
+ * - Configuration messages are never dropped: a client with
+ *   RELIABLE_QUEUE_DEPTH queued is flagged instead, gets nothing more (no
+ *   telemetry either) until it has drained, then the complete state once
+ *   (takeResync()).
+ *
+ * Only depends on AsyncWebSocketClient (status, id, queueLen, text, binary),
+ * so it is tested on the host against a stub client (test/test_websocket_delivery).
+ *
+ * Loop task only (see WebUIManager.h, Threading).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ENABLE_NETWORK
+
+#include <ESPAsyncWebServer.h>
+
+class WebSocketDelivery {
+ public:
+  // Same as the library's client limit (DEFAULT_MAX_WS_CLIENTS)
+  static const int MAX_CLIENTS = 8;
+
+  // Per-client queue limits (messages waiting in AsyncWebSocketClient),
+  // well below the library limit (WS_MAX_QUEUED_MESSAGES) where it would
+  // drop messages or close the connection
+  static const size_t TELEMETRY_QUEUE_DEPTH = 3;
+  static const size_t RELIABLE_QUEUE_DEPTH = 16;
+
+  // Delivery state, by client id (0 = free slot)
+  struct ClientState {
+    uint32_t id;
+    bool resyncPending;         // Missed a configuration message: send the complete state once drained
+    uint32_t telemetrySkipped;  // Frames skipped because the client was behind
+  };
+
+  /**
+   * Preallocated shared send buffers
+   */
+  template <int SIZE>
+  class BufferPool {
+   public:
+    /**
+     * Allocate the buffers (once, at startup)
+     * @param capacity Largest message, reserved so reuse never allocates
+     */
+    void begin(size_t capacity) {
+      for (int i = 0; i < SIZE; i++) {
+        buffers[i] = std::make_shared<std::vector<uint8_t>>();
+        buffers[i]->reserve(capacity);
+      }
+    }
+
+    /**
+     * A buffer no client holds any more
+     * @return nullptr if all are still queued (clients behind)
+     */
+    AsyncWebSocketSharedBuffer* acquire() {
+      for (int i = 0; i < SIZE; i++) {
+        if (buffers[i] && buffers[i].use_count() == 1) {
+          return &buffers[i];
+        }
+      }
+      return nullptr;
+    }
+
+   private:
+    AsyncWebSocketSharedBuffer buffers[SIZE];
+  };
+
+  WebSocketDelivery();
+
+  /**
+   * Client table (clients not in it get no resync and no skip count)
+   */
+  void addClient(uint32_t clientId);
+  void removeClient(uint32_t clientId);
+  ClientState* findClient(uint32_t clientId);
+
+  /**
+   * Client id in a table slot (0 = free), to walk the connected clients
+   */
+  uint32_t getClientId(int slot) const { return clients[slot].id; }
+
+  /**
+   * Queue a telemetry frame unless the client is behind or waiting for a
+   * resync
+   * @return true if queued
+   */
+  bool queueTelemetry(AsyncWebSocketClient* client, const AsyncWebSocketSharedBuffer& buffer,
+                      size_t queueDepth = TELEMETRY_QUEUE_DEPTH);
+
+  /**
+   * Queue a configuration message, or flag the client for a resync if it
+   * is too far behind
+   * @return true if queued
+   */
+  bool queueReliable(AsyncWebSocketClient* client, const AsyncWebSocketSharedBuffer& buffer);
+
+  /**
+   * Whether a flagged client has drained its queue (clears the flag: the
+   * caller sends the complete state now)
+   */
+  bool takeResync(AsyncWebSocketClient* client);
+
+  /**
+   * Frames not delivered: pool exhausted (countDropped()) or, per client,
+   * the client was behind
+   */
+  void countDropped() { telemetryDropped++; }
+  uint32_t getTelemetryDropped() const { return telemetryDropped; }
+
+ private:
+  ClientState clients[MAX_CLIENTS];
+  uint32_t telemetryDropped;
+};
+
+#endif  // ENABLE_NETWORK
@@ -6,11 +6,32 @@
  *
  * Features:
  * - WebSocket endpoint at /ws
- * - JSON-based command protocol
- * - Real-time state broadcasting (10 Hz default)
- * - Multiple concurrent client support
+ * - JSON commands dispatched through the shared CommandRegistry
+ *   (arguments by name), configuration state as JSON
+ * - Configuration broadcast as deltas: only fields marked dirty in
+ *   StateTracker are sent, coalesced per tick (idle = no traffic)
+ * - Binary telemetry frames (sensor/tuner 25 Hz, performance 4 Hz,
+ *   scope/spectrum 20 Hz to subscribed clients), see TelemetryProtocol.h
+ * - Audio stream: AudioCapture packets as binary frames to the clients
+ *   that asked for it ("setAudioStream"; the first one starts the
+ *   capture, the last one to leave stops it)
+ * - Multiple concurrent clients, each with a bounded send queue:
+ *   - Telemetry is skipped for a client that is behind (the next frame
+ *     supersedes it), so a slow phone never holds up the others
+ *   - Configuration messages are never dropped: a client too far behind
+ *     for one is flagged, gets no telemetry meanwhile, and the complete
+ *     state once it has drained
+ *   - Every message is serialized once into a shared, refcounted buffer
+ *     queued by reference to each client
  * - Automatic state sync on client connect
  *
+ * Threading: WebSocket events arrive on the async_tcp task. Connect,
+ * disconnect and the per-connection commands (getState, setScope,
+ * setAudioStream) are posted to a queue and applied on the loop task in
+ * update(), which owns every client table. Sends walk those tables and
+ * look each client up by id (ws.client(), locked by the library), never
+ * the library's client list.
+ *
  * Usage:
  *   WebUIManager webUI(&server, &theremin);
  *   webUI.begin();
@@ -27,7 +48,11 @@
 
 #include <ESPAsyncWebServer.h>
 #include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 #include "system/Theremin.h"
+#include "system/TelemetryProtocol.h"
+#include "system/WebSocketDelivery.h"
 
 class WebUIManager {
  private:
@@ -35,32 +60,101 @@ class WebUIManager {
   AsyncWebSocket ws;
   Theremin* theremin;
 
-  unsigned long lastUpdate;
-  static const int UPDATE_INTERVAL = 200;  // 5 Hz broadcast rate (ms) - Reduced to prevent WebSocket queue overflow
+  unsigned long lastState;
+  unsigned long lastTelemetry;
+  unsigned long lastPerformance;
+  uint32_t lastSentVersion;                      // StateTracker version of the last delta
+  static const int STATE_INTERVAL = 50;          // Configuration delta tick, 20 Hz (ms)
+  static const int TELEMETRY_INTERVAL = 40;      // Binary sensor + tuner frames, 25 Hz (ms)
+  static const int PERFORMANCE_INTERVAL = 250;   // Binary performance frames, 4 Hz (ms)
+
+  // Per-client queue limits, buffer reuse and resync (see WebSocketDelivery.h).
+  // Its client table is also the list of clients broadcasts go to.
+  WebSocketDelivery delivery;
+
+  // Preallocated send buffers for binary telemetry. No buffer free = the
+  // clients are behind, so the frame is dropped rather than queued.
+  static const int TELEMETRY_POOL_SIZE = 8;
+  static const size_t AUDIO_QUEUE_DEPTH = 8;     // ~190 ms of stream packets
+  WebSocketDelivery::BufferPool<TELEMETRY_POOL_SIZE> telemetryPool;
+  static const int NUM_MESSAGE_TYPES = Telemetry::MSG_AUDIO + 1;
+  uint16_t telemetrySeq[NUM_MESSAGE_TYPES];  // Per message type (index = Telemetry::MessageType)
+
+  // Clients with the scope view open ("setScope"), by client id (0 = free).
+  // Spectrum frames are large, so they only go to these clients, and the
+  // analyzer task only runs while there is at least one.
+  static const int MAX_SCOPE_CLIENTS = 4;
+  uint32_t scopeClients[MAX_SCOPE_CLIENTS];
+  uint32_t lastScopeSeq;                     // Last analyzer frame sent
+
+  // Clients listening to the audio stream ("setAudioStream"), by client id
+  // (0 = free). Own buffer pool: stream packets are larger than telemetry
+  // frames and come at ~43/s.
+  static const int MAX_STREAM_CLIENTS = 2;
+  static const int AUDIO_POOL_SIZE = 8;
+  uint32_t streamClients[MAX_STREAM_CLIENTS];
+  WebSocketDelivery::BufferPool<AUDIO_POOL_SIZE> audioPool;
+
+  // Client events from the async_tcp task, applied on the loop task
+  enum ClientEventType : uint8_t {
+    CLIENT_CONNECT,
+    CLIENT_DISCONNECT,
+    CLIENT_GET_STATE,
+    CLIENT_SCOPE,
+    CLIENT_AUDIO_STREAM
+  };
+  struct ClientEvent {
+    uint32_t clientId;
+    ClientEventType type;
+    bool enabled;                 // CLIENT_SCOPE / CLIENT_AUDIO_STREAM
+    AudioCapture::Format format;  // CLIENT_AUDIO_STREAM
+  };
+  static const int CLIENT_EVENT_QUEUE_SIZE = 16;
+  QueueHandle_t clientEvents;
 
   // WebSocket event handlers
   static void onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketClient* client,
                                 AwsEventType type, void* arg, uint8_t* data, size_t len);
 
   void handleWebSocketMessage(AsyncWebSocketClient* client, uint8_t* data, size_t len);
+  bool postClientEvent(uint32_t clientId, ClientEventType type, bool enabled = false,
+                       AudioCapture::Format format = AudioCapture::FORMAT_PCM16);
+  void processClientEvents();
 
   // State broadcasting
   void sendFullState(AsyncWebSocketClient* client);
-  void broadcastUpdate(const char* type, JsonDocument& doc);
-
-  // Command handlers
-  void handleOscillatorCommand(JsonDocument& doc);
-  void handleEffectCommand(JsonDocument& doc);
-  void handleSystemCommand(JsonDocument& doc);
+  void sendStateDelta(uint32_t changes);
 
   // Helper methods
-  void sendOscillatorState(int oscNum, AsyncWebSocketClient* client = nullptr);
-  void sendEffectState(const char* effectName, AsyncWebSocketClient* client = nullptr);
+  void sendEffectSchema(AsyncWebSocketClient* client);
+  void addConfigValues(JsonDocument& doc, uint32_t changes);
+  void addOscillatorValues(JsonObject obj, int oscNum, uint32_t changes);
+  void addEffectValues(JsonObject obj, AudioEffect* effect);
+  void addSystemValues(JsonObject obj, uint32_t changes);
+  void addPerformanceValues(JsonObject obj);
   void sendSensorState(AsyncWebSocketClient* client = nullptr);
   void sendPerformanceState(AsyncWebSocketClient* client = nullptr);
-  void sendSystemState(AsyncWebSocketClient* client = nullptr);
+  void sendTunerState(AsyncWebSocketClient* client = nullptr);
+  void sendSpectrumFrame();
+  void setScopeClient(uint32_t clientId, bool enabled);
+  bool hasScopeClients() const;
+  void setStreamClient(uint32_t clientId, bool enabled, AudioCapture::Format format);
+  bool hasStreamClients() const;
+  void sendAudioStream();
   void sendCompleteState(AsyncWebSocketClient* client = nullptr);
 
+  // Binary telemetry
+  void fillHeader(Telemetry::Header& header, Telemetry::MessageType type);
+  void sendBinary(const void* packet, size_t len, AsyncWebSocketClient* client);
+  AsyncWebSocketSharedBuffer* fillTelemetryBuffer(const void* packet, size_t len);
+
+  // Reliable JSON messages (configuration, state, schema)
+  void sendJson(JsonDocument& doc, AsyncWebSocketClient* client = nullptr);
+  void resyncClients();
+
+  // Drop a client from every table (delivery, scope, audio stream)
+  void forgetClient(uint32_t clientId);
+
  public:
   /**
    * Constructor
@@ -92,6 +186,12 @@ class WebUIManager {
    * @return true if running
    */
   bool isRunning() const { return server != nullptr; }
+
+  /**
+   * Binary telemetry frames not delivered: every pool buffer still queued,
+   * or (counted per client) the client was behind
+   */
+  uint32_t getTelemetryDropped() const { return delivery.getTelemetryDropped(); }
 };
 
 #endif  // ENABLE_NETWORK
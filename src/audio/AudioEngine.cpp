@@ -2,12 +2,15 @@
  * AudioEngine.cpp
  *
  * Implementation of audio synthesis for ESP32 Theremin.
- * Uses I2S with external PCM5102 DAC for professional-grade 16-bit stereo audio output.
+ * Uses I2S with external PCM5102 DAC for professional-grade stereo audio output
+ * (16- or 32-bit frames at 22.05/44.1/48 kHz, see AudioConstants.h).
  */
 
 #include "audio/AudioEngine.h"
 #include "system/PerformanceMonitor.h"
+#include "system/AudioCapture.h"
 #include "system/Debug.h"
+#include "system/BootTimeline.h"
 
 // ============================================================================
 // SECTION 1: LIFECYCLE & INITIALIZATION
@@ -24,11 +27,19 @@ AudioEngine::AudioEngine(PerformanceMonitor* perfMon)
       pitchSmoothingFactor(DEFAULT_PITCH_SMOOTHING),
       volumeSmoothingFactor(DEFAULT_VOLUME_SMOOTHING),
       currentChannelMode(STEREO_BOTH),
+      qualityPreset(QUALITY_STANDARD),
+      activeQualityPreset(QUALITY_STANDARD),
+      lastWriteEndUs(0),
+      swapState(SWAP_IDLE),
+      swapMutedBlocks(0),
+      swapMux(portMUX_INITIALIZER_UNLOCKED),
       audioTaskHandle(NULL),
       paramMutex(NULL),
       taskRunning(false),
       effectsChain(nullptr),
-      performanceMonitor(perfMon) {
+      performanceMonitor(perfMon),
+      profiler(nullptr),
+      capture(nullptr) {
 
   // Create mutex for thread-safe parameter updates
   paramMutex = xSemaphoreCreateMutex();
@@ -38,6 +49,18 @@ AudioEngine::AudioEngine(PerformanceMonitor* perfMon)
   // and comparison with modern alternatives (std::unique_ptr, std::vector)
   effectsChain = new EffectsChain();
   DEBUG_PRINTLN("[AUDIO] Effects chain created");
+
+  // Per-stage profiler (nullptr unless built with ENABLE_DSP_PROFILING = 1)
+  profiler = (performanceMonitor != nullptr) ? performanceMonitor->getDSPProfiler() : nullptr;
+  effectsChain->setProfiler(profiler);
+
+  // Effect enable/param/order changes are reported to the same tracker
+  effectsChain->setStateTracker(&stateTracker);
+
+  // Looper buffer size is reported with the heap statistics
+  if (performanceMonitor != nullptr) {
+    performanceMonitor->setLooper(&looper);
+  }
 }
 
 // Destructor
@@ -66,18 +89,20 @@ AudioEngine::~AudioEngine() {
 // Initialize audio hardware
 void AudioEngine::begin() {
   // Delay to ensure Serial is fully initialized
-  delay(100);
+  BOOT_DELAY(100);
 
   DEBUG_PRINTLN("[AUDIO] Initializing PCM5102 I2S DAC...");
-  delay(50);  // Let Serial transmit before continuing
+  BOOT_DELAY(50);  // Let Serial transmit before continuing
 
   if (!setupI2S()) {
     DEBUG_PRINTLN("[AUDIO] ERROR: I2S initialization failed!");
     return;  // Don't start audio task if I2S failed
   }
 
-  DEBUG_PRINTLN("[AUDIO] PCM5102 initialized (BCK:GPIO26, WS:GPIO27, DIN:GPIO25) @ 22050 Hz stereo");
-  delay(50);  // Let Serial transmit before continuing
+  DEBUG_PRINTF("[AUDIO] PCM5102 initialized (BCK:GPIO26, WS:GPIO27, DIN:GPIO25) @ %u Hz stereo, %u-bit frames%s\n",
+               (unsigned)Audio::SAMPLE_RATE, (unsigned)Audio::I2S_FRAME_BITS,
+               Audio::I2S_USE_APLL ? ", APLL" : "");
+  BOOT_DELAY(50);  // Let Serial transmit before continuing
 
   // Initialize oscillators with default settings.
   setDefaultSettings();
@@ -210,6 +235,7 @@ void AudioEngine::setOscillatorWaveform(int oscNum, Oscillator::Waveform wf) {
     DEBUG_PRINTLN((int)wf);
 
     xSemaphoreGive(paramMutex);
+    stateTracker.mark(StateTracker::oscBit(oscNum, StateTracker::OSC_WAVEFORM));
   }
 }
 
@@ -249,6 +275,7 @@ void AudioEngine::setOscillatorOctave(int oscNum, int octave) {
     DEBUG_PRINTLN(octave);
 
     xSemaphoreGive(paramMutex);
+    stateTracker.mark(StateTracker::oscBit(oscNum, StateTracker::OSC_OCTAVE));
   }
 }
 
@@ -281,6 +308,7 @@ void AudioEngine::setOscillatorVolume(int oscNum, float volume) {
     DEBUG_PRINTLN(volume);
 
     xSemaphoreGive(paramMutex);
+    stateTracker.mark(StateTracker::oscBit(oscNum, StateTracker::OSC_VOLUME));
   }
 }
 
@@ -331,6 +359,53 @@ AudioEngine::ChannelMode AudioEngine::getChannelMode() const {
   return currentChannelMode;
 }
 
+// Set oscillator render quality (picked up by the audio task at the next block)
+void AudioEngine::setQualityPreset(QualityPreset preset) {
+  qualityPreset = preset;
+  stateTracker.mark(StateTracker::QUALITY);
+
+  DEBUG_PRINT("[AUDIO] Quality preset: ");
+  DEBUG_PRINTLN(preset == QUALITY_HIGH ? "HIGH (2x oversampled)" : "STANDARD");
+}
+
+// Swap state transition, only from the expected state
+bool AudioEngine::advanceSwap(uint8_t from, uint8_t to) {
+  portENTER_CRITICAL(&swapMux);
+  bool changed = (swapState == from);
+  if (changed) {
+    swapState = to;
+  }
+  portEXIT_CRITICAL(&swapMux);
+  return changed;
+}
+
+// Start a parameter swap (fade out at the next block, then silence)
+void AudioEngine::beginSwap() {
+  const uint8_t muted = taskRunning ? SWAP_FADE_OUT : SWAP_MUTED;
+  if (!advanceSwap(SWAP_IDLE, muted)) {
+    advanceSwap(SWAP_FADE_IN, muted);
+  }
+}
+
+// Claim the muted output for rewriting parameters (stops the timeout)
+bool AudioEngine::holdSwap() {
+  return advanceSwap(SWAP_MUTED, SWAP_HELD);
+}
+
+// Finish a parameter swap (fade in at the next block)
+void AudioEngine::endSwap() {
+  advanceSwap(SWAP_HELD, taskRunning ? SWAP_FADE_IN : SWAP_IDLE);
+}
+
+// Linear per-sample gain ramp over one block (Q15)
+void AudioEngine::applyGainRamp(int16_t* buffer, int numSamples, bool fadeIn) {
+  for (int i = 0; i < numSamples; i++) {
+    int32_t step = fadeIn ? i + 1 : numSamples - 1 - i;
+    int32_t gainQ15 = (step << 15) / numSamples;
+    buffer[i] = (int16_t)(((int32_t)buffer[i] * gainQ15) >> 15);
+  }
+}
+
 // Set frequency range dynamically (thread-safe)
 void AudioEngine::setFrequencyRange(int minFreq, int maxFreq) {
   if (paramMutex != NULL && xSemaphoreTake(paramMutex, portMAX_DELAY) == pdTRUE) {
@@ -348,6 +423,7 @@ void AudioEngine::setFrequencyRange(int minFreq, int maxFreq) {
     DEBUG_PRINTLN(" Hz");
 
     xSemaphoreGive(paramMutex);
+    stateTracker.mark(StateTracker::FREQUENCY_BOUNDS);
   }
 }
 
@@ -476,7 +552,7 @@ bool AudioEngine::getSpecialState(int state) {
 // Calculate maximum audio task time based on buffer configuration
 float AudioEngine::getMaxAudioTimeMs() {
   // Max time = BUFFER_SIZE / SAMPLE_RATE * 1000
-  // For current config: 256 / 22050 * 1000 = 11.61 ms
+  // 256 / 22050 * 1000 = 11.61 ms, 512 / 48000 * 1000 = 10.67 ms
   return (float)BUFFER_SIZE / Audio::SAMPLE_RATE * 1000.0f;
 }
 
@@ -674,7 +750,7 @@ void AudioEngine::startAudioTask() {
   );
 
   DEBUG_PRINTLN("[AUDIO] Continuous audio task started on Core 1");
-  delay(50);  // Let Serial transmit before continuing
+  BOOT_DELAY(50);  // Let Serial transmit before continuing
 }
 
 // Stop continuous audio generation task
@@ -728,17 +804,17 @@ void AudioEngine::audioTaskLoop() {
 
 // Initialize I2S for external PCM5102 DAC
 bool AudioEngine::setupI2S() {
-  // I2S configuration for PCM5102 external DAC (stereo 16-bit)
+  // I2S configuration for PCM5102 external DAC (stereo, 16- or 32-bit slots)
   i2s_config_t i2s_config = {
       .mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_TX),  // Standard I2S mode (no built-in DAC)
       .sample_rate = Audio::SAMPLE_RATE,
-      .bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT,
+      .bits_per_sample = (Audio::I2S_FRAME_BITS == 32) ? I2S_BITS_PER_SAMPLE_32BIT : I2S_BITS_PER_SAMPLE_16BIT,
       .channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT,  // Stereo output (L+R channels)
       .communication_format = I2S_COMM_FORMAT_STAND_I2S,
       .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,
       .dma_buf_count = DMA_BUFFER_COUNT,
-      .dma_buf_len = BUFFER_SIZE,
-      .use_apll = false,
+      .dma_buf_len = DMA_BUFFER_LEN,
+      .use_apll = Audio::I2S_USE_APLL,         // Exact 44.1/48 kHz clocks (see AudioConstants.h)
       .tx_desc_auto_clear = true,
       .fixed_mclk = 0
   };
@@ -771,20 +847,40 @@ bool AudioEngine::setupI2S() {
 
 // Generate audio buffer and write to I2S
 void AudioEngine::generateAudioBuffer() {
-  // Master output noise gate threshold
-  // Eliminates cumulative quantization noise from stacked effects
-  static constexpr int16_t MASTER_NOISE_GATE_THRESHOLD = 150;
-
-  // PCM5102 accepts signed 16-bit stereo samples directly
-  // Buffer holds stereo frames: [L0, R0, L1, R1, L2, R2, ...]
-  // BUFFER_SIZE = 256 frames = 512 individual samples (L+R)
-  int16_t buffer[BUFFER_SIZE * 2];
+  // PCM5102 accepts signed 16- or 32-bit stereo samples directly
+  // i2sBuffer holds stereo frames: [L0, R0, L1, R1, L2, R2, ...]
+  // BUFFER_SIZE = 256 frames = 512 individual samples (L+R) at 22050 Hz
+  Audio::I2SSample* buffer = i2sBuffer;
 
   // Start CPU measurement (only measure actual computation, not blocking I/O)
   uint32_t computeStart = micros();
 
+  // Parameter swap state (single read per block, see beginSwap()). A swap
+  // claimed during this block only moves MUTED to HELD, both silent.
+  const uint8_t swap = swapState;
+  const bool swapSilent = (swap == SWAP_MUTED || swap == SWAP_HELD);
+
+  // Preset morph: interpolate once for this block (not while a swap has
+  // the parameters muted and being rewritten)
+  ParameterMorph::Params morphParams;
+  const bool morphing = !swapSilent && morph.process(morphParams);
+
+  // Automation events due in this block (the lane's clock advances every
+  // block, also while muted; events due during a swap are dropped)
+  AutomationLane::Event automationEvents[AutomationLane::MAX_EVENTS_PER_BLOCK];
+  const AutomationLane::State automationState = automation.getState();
+  const uint8_t automationCount = automation.process(BUFFER_SIZE, automationEvents);
+  if (automation.getState() != automationState) {
+    stateTracker.mark(StateTracker::AUTOMATION);  // Fixed-length recording ended
+  }
+
   // Lock mutex to safely read parameters
   if (paramMutex != NULL && xSemaphoreTake(paramMutex, 0) == pdTRUE) {
+    if (morphing) {
+      pitchSmoothingFactor = morphParams.pitchSmoothing;
+      volumeSmoothingFactor = morphParams.volumeSmoothing;
+    }
+
     // Apply exponential smoothing to frequency (uses separate pitch factor)
     smoothedFrequency += (currentFrequency - smoothedFrequency) * pitchSmoothingFactor;
 
@@ -802,45 +898,106 @@ void AudioEngine::generateAudioBuffer() {
   // Calculate gain from smoothed amplitude (0-100% → 0.0-1.0)
   float gain = smoothedAmplitude / 100.0f;
 
-  // Generate audio samples
-  for (int i = 0; i < BUFFER_SIZE; i++) {
-    // Mix multiple oscillators with automatic gain adjustment
-    int activeCount = 0;
-    int32_t mixedSample = 0;  // Use int32_t to prevent overflow during addition
+  // Mixer gain (Q15): amplitude × fixed per-oscillator headroom.
+  // Every oscillator is mixed at MIX_LEVEL regardless of how many are active,
+  // so switching one on adds its level instead of halving the others (the old
+  // divide-by-activeCount). Three oscillators at full volume sum to exactly
+  // full scale, so nothing clips before or inside the effects; the master
+  // bus drive stage restores the level afterwards.
+  const int32_t mixGainQ15 = (int32_t)(gain * MIX_LEVEL * 32768.0f);
+
+  const float sampleRate = (float)Audio::SAMPLE_RATE;
+
+  // Quality preset snapshot (single read per block)
+  const QualityPreset quality = qualityPreset;
+  if (quality != activeQualityPreset) {
+    decimator.reset();  // Don't filter stale history from the last HIGH run
+    activeQualityPreset = quality;
+  }
 
-    // Add samples from all active oscillators
-    if (oscillator1.isActive()) {
-      mixedSample += oscillator1.getNextSample((float)Audio::SAMPLE_RATE);
-      activeCount++;
-    }
-    if (oscillator2.isActive()) {
-      mixedSample += oscillator2.getNextSample((float)Audio::SAMPLE_RATE);
-      activeCount++;
-    }
-    if (oscillator3.isActive()) {
-      mixedSample += oscillator3.getNextSample((float)Audio::SAMPLE_RATE);
-      activeCount++;
-    }
+  if (morphing) {
+    applyMorph(morphParams, (quality == QUALITY_HIGH) ? BUFFER_SIZE * 2 : BUFFER_SIZE);
+  }
+  if (automationCount > 0 && !swapSilent) {
+    applyAutomation(automationEvents, automationCount, (quality == QUALITY_HIGH) ? BUFFER_SIZE * 2 : BUFFER_SIZE);
+  }
 
-    // Average to prevent clipping and maintain consistent volume
-    int16_t sample = (activeCount > 0) ? (mixedSample / activeCount) : 0;
+  // Generate audio samples (mono mix into block buffer)
+  uint32_t renderStart = micros();
+  DSP_PROFILE_BEGIN(profiler);
+  if (swapSilent) {
+    // Oscillators and effects are left alone while another task rewrites them
+    memset(monoBuffer, 0, sizeof(monoBuffer));
+  } else if (quality == QUALITY_HIGH) {
+    // 2× oversampled: harmonics between 1× and 2× Nyquist are rendered
+    // correctly and then removed by the decimator instead of folding back
+    renderOscillators(oversampleBuffer, BUFFER_SIZE * 2, sampleRate * 2.0f, mixGainQ15);
+    decimator.process(oversampleBuffer, monoBuffer, BUFFER_SIZE);
+  } else {
+    renderOscillators(monoBuffer, BUFFER_SIZE, sampleRate, mixGainQ15);
+  }
+  uint32_t renderTime = micros() - renderStart;
+  DSP_PROFILE_MARK(profiler, DSPProfiler::STAGE_OSC);
 
-    // Apply amplitude scaling
-    int16_t scaledSample = (int16_t)(sample * gain);
+  // Process through effects chain (one dispatch per effect per block)
+  if (effectsChain != nullptr && !swapSilent) {
+    effectsChain->processBlock(monoBuffer, BUFFER_SIZE);
+  }
 
-    // Process through effects chain
-    if (effectsChain != nullptr) {
-      scaledSample = effectsChain->process(scaledSample);
-    }
+  // Looper: records the post-effects signal and mixes the loop back in
+  // before the master bus, so the limiter sees the sum
+  static_assert(BUFFER_SIZE <= Looper::MAX_BLOCK, "Looper works on whole blocks");
+  const Looper::State looperState = looper.getState();
+  const bool looperUndo = looper.canUndo();
+  looper.process(monoBuffer, BUFFER_SIZE);
+  if (looper.getState() != looperState || looper.canUndo() != looperUndo) {
+    stateTracker.mark(StateTracker::LOOPER);
+  }
 
-    // MASTER OUTPUT NOISE GATE
-    // Eliminates cumulative quantization noise from stacked effects (delay + chorus + reverb)
-    // Kills low-level graininess that accumulates through the effects chain
-    if (scaledSample > -MASTER_NOISE_GATE_THRESHOLD && scaledSample < MASTER_NOISE_GATE_THRESHOLD) {
-      scaledSample = 0;
-    }
+  // Master bus: gate → drive → look-ahead limiter → soft clip
+  // (replaces the old hard noise gate and hard constrain at the output)
+  masterBus.processBlock(monoBuffer, BUFFER_SIZE);
+  DSP_PROFILE_MARK(profiler, DSPProfiler::STAGE_MASTER);
+
+  // Swap fades on the final output, so nothing (limiter look-ahead, effect
+  // tails) steps at the boundary
+  switch (swap) {
+    case SWAP_FADE_OUT:
+      applyGainRamp(monoBuffer, BUFFER_SIZE, false);
+      swapMutedBlocks = 0;
+      advanceSwap(SWAP_FADE_OUT, SWAP_MUTED);
+      break;
+    case SWAP_MUTED:
+      memset(monoBuffer, 0, sizeof(monoBuffer));
+      if (++swapMutedBlocks >= SWAP_TIMEOUT_BLOCKS) {
+        // Safety net: never stay silent (unless claimed meanwhile)
+        advanceSwap(SWAP_MUTED, SWAP_FADE_IN);
+      }
+      break;
+    case SWAP_HELD:
+      memset(monoBuffer, 0, sizeof(monoBuffer));
+      break;
+    case SWAP_FADE_IN:
+      applyGainRamp(monoBuffer, BUFFER_SIZE, true);
+      advanceSwap(SWAP_FADE_IN, SWAP_IDLE);  // Unless a new swap began
+      break;
+    default:
+      break;
+  }
 
-    // PCM5102 accepts signed 16-bit samples directly - no conversion needed!
+  // Publish the final output for analysis (scope/spectrum) - copy only
+  outputTap.write(monoBuffer, BUFFER_SIZE);
+
+  // Recording to file/stream - copy only, dropped if the capture task is behind
+  if (capture != nullptr) {
+    capture->write(monoBuffer, BUFFER_SIZE);
+  }
+
+  for (int i = 0; i < BUFFER_SIZE; i++) {
+    // 16-bit sample into the upper bits of the I2S slot (no-op for 16-bit frames)
+    Audio::I2SSample scaledSample = (Audio::I2SSample)monoBuffer[i] << Audio::I2S_SAMPLE_SHIFT;
+
+    // PCM5102 accepts signed samples directly - no conversion needed!
     // Route to channels based on current mode
     switch (currentChannelMode) {
       case LEFT_ONLY:
@@ -859,22 +1016,134 @@ void AudioEngine::generateAudioBuffer() {
     }
   }
 
+  DSP_PROFILE_MARK(profiler, DSPProfiler::STAGE_ROUTING);
+  DSP_PROFILE_END(profiler);
+
   // Stop CPU measurement (sample calculation done)
   uint32_t computeTime = micros() - computeStart;
 
   // Write stereo buffer to I2S (blocks until DMA buffer available ~11ms)
   // Why this blocks for ~11ms:
-  // - ESP32 I2S hardware consumes samples at exactly SAMPLE_RATE (22050 Hz)
+  // - ESP32 I2S hardware consumes samples at exactly SAMPLE_RATE (e.g. 22050 Hz)
   // - 256 stereo frames / 22050 Hz = 11.6ms to consume one buffer
   // - i2s_write() blocks until DMA has space (natural flow control)
   // - This is GOOD: prevents buffer overruns, perfectly paced audio output
   // - This blocking is I/O waiting, NOT CPU work (CPU is free for other tasks)
   // - Audio task sleeps here, wakes up when hardware needs next buffer
+  const size_t bytesToWrite = BUFFER_SIZE * 2 * sizeof(Audio::I2SSample);
   size_t bytes_written = 0;
-  i2s_write((i2s_port_t)I2S_NUM, buffer, BUFFER_SIZE * 2 * sizeof(int16_t), &bytes_written, portMAX_DELAY);
+  uint32_t writeStart = micros();
+  i2s_write((i2s_port_t)I2S_NUM, buffer, bytesToWrite, &bytes_written, portMAX_DELAY);
+  uint32_t writeEnd = micros();
+  BootTimeline::mark(BootTimeline::FIRST_AUDIO_BUFFER);
+
+  // Underrun detection: the DMA queue holds at most DMA_QUEUE_US of audio.
+  // If more time than that passed between the end of the previous write and
+  // the start of this one, the queue ran dry and the DAC played silence
+  // (tx_desc_auto_clear). A short write also counts.
+  bool underrun = (bytes_written < bytesToWrite) ||
+                  (lastWriteEndUs != 0 && (writeStart - lastWriteEndUs) > DMA_QUEUE_US);
+  lastWriteEndUs = writeEnd;
 
   // Report only the actual CPU work time (not the blocking time)
   if (performanceMonitor != nullptr) {
     performanceMonitor->recordAudioWork(computeTime);
+    performanceMonitor->recordOscillatorWork(renderTime, quality == QUALITY_HIGH);
+    performanceMonitor->recordI2SWrite(writeEnd - writeStart, underrun);
+  }
+}
+
+// Ramp oscillator volumes and effect parameters to the morph position
+void AudioEngine::applyMorph(const ParameterMorph::Params& params, size_t renderSamples) {
+  oscillator1.rampVolume(params.oscVolume[0], renderSamples);
+  oscillator2.rampVolume(params.oscVolume[1], renderSamples);
+  oscillator3.rampVolume(params.oscVolume[2], renderSamples);
+
+  if (effectsChain == nullptr) {
+    return;
+  }
+  uint8_t count = effectsChain->getEffectCount();
+  for (uint8_t i = 0; i < count && i < ParameterMorph::MAX_EFFECTS; i++) {
+    effectsChain->getEffect(i)->rampMix(params.effectMix[i], BUFFER_SIZE);
+  }
+  effectsChain->getDelay()->automateFeedback(params.delayFeedback);
+  effectsChain->getReverb()->automateRoomSize(params.reverbRoomSize);
+}
+
+void AudioEngine::applyAutomation(const AutomationLane::Event* events, uint8_t count, size_t renderSamples) {
+  for (uint8_t i = 0; i < count; i++) {
+    const AutomationLane::Event& event = events[i];
+    const float value = AutomationLane::normalized(event);
+
+    if (event.target >= AutomationLane::TARGET_OSC_VOLUME) {
+      switch (event.target - AutomationLane::TARGET_OSC_VOLUME) {
+        case 0: oscillator1.rampVolume(value, renderSamples); break;
+        case 1: oscillator2.rampVolume(value, renderSamples); break;
+        case 2: oscillator3.rampVolume(value, renderSamples); break;
+        default: continue;
+      }
+      stateTracker.mark(StateTracker::oscBit(event.target - AutomationLane::TARGET_OSC_VOLUME + 1,
+                                             StateTracker::OSC_VOLUME));
+      continue;
+    }
+
+    const uint8_t effectIndex = event.target >> 4;
+    if (effectsChain == nullptr || effectIndex >= effectsChain->getEffectCount()) {
+      continue;
+    }
+    AudioEffect* effect = effectsChain->getEffect(effectIndex);
+    const uint8_t param = event.target & 0x0F;
+    if (param >= effect->getParamCount()) {
+      continue;
+    }
+    const EffectParam& info = effect->getParamInfo(param);
+    if (effect->automateParam(param, info.minValue + value * (info.maxValue - info.minValue), BUFFER_SIZE)) {
+      stateTracker.mark(StateTracker::effectBit(effectIndex));
+    }
+  }
+}
+
+void AudioEngine::recordOscillatorVolume(int oscNum, float volume) {
+  if (automation.getState() != AutomationLane::STATE_RECORDING || oscNum < 1 || oscNum > 3) {
+    return;
+  }
+  automation.record(AutomationLane::oscTarget(oscNum), volume);
+  stateTracker.mark(StateTracker::AUTOMATION);  // Event count
+}
+
+void AudioEngine::recordEffectParam(const AudioEffect* effect, uint8_t index, float value) {
+  if (automation.getState() != AutomationLane::STATE_RECORDING || effectsChain == nullptr ||
+      effect == nullptr || !effect->isAutomatable(index)) {
+    return;
+  }
+  for (uint8_t i = 0; i < effectsChain->getEffectCount(); i++) {
+    if (effectsChain->getEffect(i) == effect) {
+      const EffectParam& info = effect->getParamInfo(index);
+      automation.record(AutomationLane::effectTarget(i, index),
+                        (value - info.minValue) / (info.maxValue - info.minValue));
+      stateTracker.mark(StateTracker::AUTOMATION);  // Event count
+      return;
+    }
+  }
+}
+
+// Mix all active oscillators into a block buffer
+void AudioEngine::renderOscillators(int16_t* out, int numSamples, float renderRate, int32_t mixGainQ15) {
+  for (int i = 0; i < numSamples; i++) {
+    int32_t mixedSample = 0;  // Use int32_t to prevent overflow during addition
+
+    // Add samples from all active oscillators
+    if (oscillator1.isActive()) {
+      mixedSample += oscillator1.getNextSample(renderRate);
+    }
+    if (oscillator2.isActive()) {
+      mixedSample += oscillator2.getNextSample(renderRate);
+    }
+    if (oscillator3.isActive()) {
+      mixedSample += oscillator3.getNextSample(renderRate);
+    }
+
+    // Apply amplitude scaling and mix headroom (32-bit intermediate)
+    out[i] = (int16_t)((mixedSample * mixGainQ15) >> 15);
   }
 }
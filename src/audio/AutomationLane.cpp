@@ -0,0 +1,202 @@
+/*
+ * AutomationLane.cpp
+ *
+ * Parameter automation recording and looped playback. See AutomationLane.h.
+ */
+
+#include "audio/AutomationLane.h"
+
+AutomationLane::AutomationLane()
+    : count(0),
+      cursor(0),
+      seek(false),
+      state(STATE_IDLE),
+      loopLength(0),
+      loopLengthFixed(false),
+      loopStart(0),
+      dropped(0),
+      blockFrame(0),
+      blockFrames(0),
+      blockStartUs(0),
+      mux(portMUX_INITIALIZER_UNLOCKED) {
+  memset(events, 0, sizeof(events));
+}
+
+uint32_t AutomationLane::now() const {
+  if (blockFrames == 0) {
+    return blockFrame;
+  }
+  // Time since the block started, in frames, kept inside the block
+  uint32_t offset = (uint32_t)((uint64_t)(micros() - blockStartUs) * Audio::SAMPLE_RATE / 1000000UL);
+  if (offset >= blockFrames) {
+    offset = blockFrames - 1;
+  }
+  return blockFrame + offset;
+}
+
+void AutomationLane::startRecording() {
+  portENTER_CRITICAL(&mux);
+  count = 0;
+  cursor = 0;
+  dropped = 0;
+  if (!loopLengthFixed) {
+    loopLength = 0;
+  }
+  loopStart = now();
+  state = STATE_RECORDING;
+  portEXIT_CRITICAL(&mux);
+}
+
+bool AutomationLane::startPlayback() {
+  if (state == STATE_RECORDING) {
+    stop();
+    return state == STATE_PLAYING;
+  }
+
+  portENTER_CRITICAL(&mux);
+  bool ok = (count > 0 && loopLength > 0);
+  if (ok) {
+    cursor = 0;
+    seek = true;
+    state = STATE_PLAYING;
+  }
+  portEXIT_CRITICAL(&mux);
+  return ok;
+}
+
+void AutomationLane::stop() {
+  portENTER_CRITICAL(&mux);
+  if (state == STATE_RECORDING) {
+    if (!loopLengthFixed) {
+      uint32_t length = now() - loopStart;
+      loopLength = (length < MIN_LOOP_FRAMES) ? MIN_LOOP_FRAMES : length;
+    }
+    // Continue straight into playback of what was just recorded
+    cursor = 0;
+    seek = true;
+    state = (count > 0) ? STATE_PLAYING : STATE_IDLE;
+  } else {
+    state = STATE_IDLE;
+  }
+  portEXIT_CRITICAL(&mux);
+}
+
+void AutomationLane::clear() {
+  portENTER_CRITICAL(&mux);
+  state = STATE_IDLE;
+  count = 0;
+  cursor = 0;
+  dropped = 0;
+  if (!loopLengthFixed) {
+    loopLength = 0;
+  }
+  portEXIT_CRITICAL(&mux);
+}
+
+void AutomationLane::setLoopLength(uint32_t frames) {
+  portENTER_CRITICAL(&mux);
+  if (frames == 0) {
+    loopLengthFixed = false;  // Current loop keeps playing
+  } else {
+    loopLength = (frames < MIN_LOOP_FRAMES) ? MIN_LOOP_FRAMES : frames;
+    loopLengthFixed = true;
+
+    // Events are in time order: cut the tail that no longer fits
+    uint16_t kept = count;
+    while (kept > 0 && events[kept - 1].time >= loopLength) {
+      kept--;
+    }
+    count = kept;
+    cursor = 0;
+    seek = true;
+    if (count == 0 && state == STATE_PLAYING) {
+      state = STATE_IDLE;
+    }
+  }
+  portEXIT_CRITICAL(&mux);
+}
+
+void AutomationLane::record(uint8_t target, float value) {
+  if (state != STATE_RECORDING) {
+    return;
+  }
+
+  const uint16_t quantized = (uint16_t)(constrain(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+
+  portENTER_CRITICAL(&mux);
+  if (state == STATE_RECORDING) {
+    uint32_t time = now() - loopStart;
+
+    if (!loopLengthFixed || time < loopLength) {
+      Event* last = (count > 0) ? &events[count - 1] : nullptr;
+
+      // Changes from different tasks may arrive slightly out of order
+      if (last != nullptr && time < last->time) {
+        time = last->time;
+      }
+
+      if (last != nullptr && last->target == target && time - last->time < blockFrames) {
+        last->value = quantized;  // Same target within a block: keep the latest value
+      } else if (count < MAX_EVENTS) {
+        Event& event = events[count];
+        event.time = time;
+        event.target = target;
+        event.reserved = 0;
+        event.value = quantized;
+        count = count + 1;
+      } else {
+        dropped = dropped + 1;
+      }
+    }
+  }
+  portEXIT_CRITICAL(&mux);
+}
+
+uint8_t AutomationLane::collect(uint32_t limit, Event* out, uint8_t found) {
+  while (found < MAX_EVENTS_PER_BLOCK && cursor < count && events[cursor].time < limit) {
+    out[found++] = events[cursor++];
+  }
+  return found;
+}
+
+uint8_t AutomationLane::process(uint32_t numFrames, Event* out) {
+  uint8_t found = 0;
+
+  portENTER_CRITICAL(&mux);
+  blockFrame += blockFrames;
+  blockFrames = numFrames;
+  blockStartUs = micros();
+
+  // A fixed-length recording ends by itself after one loop
+  if (state == STATE_RECORDING && loopLengthFixed && blockFrame - loopStart >= loopLength) {
+    cursor = 0;
+    seek = true;
+    state = (count > 0) ? STATE_PLAYING : STATE_IDLE;
+  }
+
+  if (state == STATE_PLAYING && loopLength > 0) {
+    const uint32_t position = (blockFrame - loopStart) % loopLength;
+
+    // (Re)started mid-loop: events before this point wait for the next pass
+    if (seek) {
+      cursor = 0;
+      while (cursor < count && events[cursor].time < position) {
+        cursor++;
+      }
+      seek = false;
+    }
+
+    const uint32_t end = position + numFrames;
+    if (end < loopLength) {
+      found = collect(end, out, 0);
+    } else {
+      // Block crosses the loop end: finish this pass, start the next
+      found = collect(loopLength, out, 0);
+      cursor = 0;
+      found = collect(end - loopLength, out, found);
+    }
+  }
+  portEXIT_CRITICAL(&mux);
+
+  return found;
+}
@@ -0,0 +1,54 @@
+/*
+ * HalfBandDecimator.cpp
+ *
+ * Implementation of the fixed-point half-band 2:1 decimator.
+ */
+
+#include "audio/HalfBandDecimator.h"
+
+// Kaiser-windowed (β=7) half-band sinc, 31 taps, quantized to Q15.
+// Centre (16384) + 2 × sum(COEFFS) = 32768 → exactly unity gain at DC.
+const int16_t HalfBandDecimator::COEFFS[HalfBandDecimator::SIDE_TAPS] = {
+  10281, -3051, 1442, -708, 321, -124, 35, -4
+};
+
+HalfBandDecimator::HalfBandDecimator() {
+  reset();
+}
+
+void HalfBandDecimator::reset() {
+  memset(history, 0, sizeof(history));
+  writeIndex = 0;
+}
+
+inline void HalfBandDecimator::push(int16_t sample) {
+  history[writeIndex] = sample;
+  history[writeIndex + TAPS] = sample;
+  if (++writeIndex >= TAPS) {
+    writeIndex = 0;
+  }
+}
+
+void HalfBandDecimator::process(const int16_t* input, int16_t* output, size_t numOutput) {
+  for (size_t n = 0; n < numOutput; n++) {
+    push(input[n * 2]);
+    push(input[n * 2 + 1]);
+
+    // Window oldest → newest; centre sample of the window
+    const int16_t* window = &history[writeIndex];
+    const int16_t* center = window + CENTER;
+
+    // Branch 0: centre tap (0.5)
+    int32_t acc = (int32_t)center[0] << 14;
+
+    // Branch 1: symmetric odd taps, one multiply per pair
+    for (int k = 0; k < SIDE_TAPS; k++) {
+      int offset = 2 * k + 1;
+      acc += (int32_t)COEFFS[k] * ((int32_t)center[-offset] + center[offset]);
+    }
+
+    // Round, back to 16-bit (ringing on square edges can overshoot slightly)
+    acc = (acc + (1 << 14)) >> 15;
+    output[n] = (int16_t)constrain(acc, (int32_t)-32768, (int32_t)32767);
+  }
+}
@@ -0,0 +1,327 @@
+/*
+ * Looper.cpp
+ *
+ * Loop recorder with overdub and undo. See Looper.h.
+ */
+
+#include "audio/Looper.h"
+#include "audio/AudioConstants.h"
+#include "system/Debug.h"
+#include <esp_heap_caps.h>
+#include <string.h>
+
+int16_t Looper::ulawTable[256];
+
+// G.711 µ-law
+static const int ULAW_BIAS = 0x84;
+static const int ULAW_CLIP = 32635;
+
+static int16_t ulawToLinear(uint8_t code) {
+  code = ~code;
+  int exponent = (code >> 4) & 0x07;
+  int magnitude = ((((code & 0x0F) << 3) + ULAW_BIAS) << exponent) - ULAW_BIAS;
+  return (int16_t)((code & 0x80) ? -magnitude : magnitude);
+}
+
+uint8_t Looper::linearToUlaw(int16_t sample) {
+  int sign = (sample < 0) ? 0x80 : 0;
+  int magnitude = sign ? -(int)sample : sample;
+  if (magnitude > ULAW_CLIP) {
+    magnitude = ULAW_CLIP;
+  }
+  magnitude += ULAW_BIAS;
+
+  // Segment = position of the highest set bit above bit 7
+  int exponent = (31 - __builtin_clz(magnitude)) - 7;
+  int mantissa = (magnitude >> (exponent + 3)) & 0x0F;
+  return (uint8_t)~(sign | (exponent << 4) | mantissa);
+}
+
+static inline int16_t saturate(int32_t value) {
+  return (int16_t)constrain(value, -32768, 32767);
+}
+
+Looper::Looper()
+    : storage(nullptr),
+      storageBytes(0),
+      areaBytes(0),
+      storagePsram(false),
+      request(REQUEST_NONE),
+      state(STATE_EMPTY),
+      format(FORMAT_PCM16),
+      feedback(0.9f),
+      level(1.0f),
+      blockSize(0),
+      length(0),
+      position(0),
+      layerStart(0),
+      layerBlocks(0),
+      undoing(false),
+      restoredBlocks(0) {
+  for (int i = 0; i < 256; i++) {
+    ulawTable[i] = ulawToLinear((uint8_t)i);
+  }
+}
+
+Looper::~Looper() {
+  if (storage != nullptr) {
+    heap_caps_free(storage);
+    storage = nullptr;
+  }
+}
+
+bool Looper::allocate() {
+  if (storage != nullptr) {
+    return true;
+  }
+
+  if (psramFound()) {
+    storage = (uint8_t*)heap_caps_malloc(PSRAM_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (storage != nullptr) {
+      storageBytes = PSRAM_BYTES;
+      storagePsram = true;
+    }
+  }
+  if (storage == nullptr) {
+    storage = (uint8_t*)heap_caps_malloc(INTERNAL_BYTES, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (storage == nullptr) {
+      DEBUG_PRINTLN("[LOOPER] ERROR: No memory for the loop buffer");
+      return false;
+    }
+    storageBytes = INTERNAL_BYTES;
+    storagePsram = false;
+    format = FORMAT_ULAW;  // Short buffer: favour length
+  }
+
+  areaBytes = storageBytes / 2;
+  DEBUG_PRINTF("[LOOPER] %lu KB buffer in %s\n", (unsigned long)(storageBytes / 1024),
+               storagePsram ? "PSRAM" : "internal RAM");
+  return true;
+}
+
+uint32_t Looper::getCapacitySamples() const {
+  uint32_t samples = areaBytes / bytesPerSample();
+  return (blockSize > 0) ? samples - samples % blockSize : samples;
+}
+
+bool Looper::record() {
+  if (!allocate()) {
+    return false;
+  }
+  request = REQUEST_CYCLE;
+  return true;
+}
+
+void Looper::play() {
+  request = REQUEST_PLAY;
+}
+
+void Looper::stop() {
+  request = REQUEST_STOP;
+}
+
+bool Looper::undo() {
+  if (!canUndo()) {
+    return false;
+  }
+  request = REQUEST_UNDO;
+  return true;
+}
+
+void Looper::clear() {
+  request = REQUEST_CLEAR;
+}
+
+bool Looper::setFormat(Format fmt) {
+  if (state != STATE_EMPTY) {
+    return false;
+  }
+  format = fmt;
+  return true;
+}
+
+void Looper::closeLoop(State next) {
+  length = position;
+  position = 0;
+  layerBlocks = 0;
+  state = (length > 0) ? next : STATE_EMPTY;
+}
+
+void Looper::handleRequest(uint8_t req) {
+  switch (req) {
+    case REQUEST_CYCLE:
+      if (state == STATE_EMPTY) {
+        position = 0;
+        length = 0;
+        layerBlocks = 0;
+        state = STATE_RECORDING;
+      } else if (state == STATE_RECORDING) {
+        closeLoop(STATE_PLAYING);
+      } else if (state == STATE_PLAYING && !undoing) {
+        // New layer: the previous one can no longer be undone
+        layerStart = position / blockSize;
+        layerBlocks = 0;
+        state = STATE_OVERDUBBING;
+      } else if (state == STATE_OVERDUBBING) {
+        state = STATE_PLAYING;
+      } else if (state == STATE_STOPPED) {
+        position = 0;
+        state = STATE_PLAYING;
+      }
+      break;
+
+    case REQUEST_PLAY:
+      if (state == STATE_RECORDING) {
+        closeLoop(STATE_PLAYING);
+      } else if (state != STATE_EMPTY) {
+        if (state != STATE_OVERDUBBING) {
+          position = 0;
+        }
+        state = STATE_PLAYING;
+      }
+      break;
+
+    case REQUEST_STOP:
+      if (state == STATE_RECORDING) {
+        closeLoop(STATE_STOPPED);
+      } else if (state != STATE_EMPTY) {
+        state = STATE_STOPPED;
+      }
+      break;
+
+    case REQUEST_UNDO:
+      if (layerBlocks > 0 && !undoing) {
+        if (state == STATE_OVERDUBBING) {
+          state = STATE_PLAYING;
+        }
+        restoredBlocks = 0;
+        undoing = true;
+      }
+      break;
+
+    case REQUEST_CLEAR:
+      state = STATE_EMPTY;
+      length = 0;
+      position = 0;
+      layerBlocks = 0;
+      undoing = false;
+      break;
+
+    default:
+      break;
+  }
+}
+
+void Looper::readBlock(const uint8_t* area, uint32_t pos, int16_t* out, size_t n) const {
+  if (format == FORMAT_ULAW) {
+    const uint8_t* in = area + pos;
+    for (size_t i = 0; i < n; i++) {
+      out[i] = ulawTable[in[i]];
+    }
+  } else {
+    memcpy(out, area + pos * 2, n * 2);
+  }
+}
+
+void Looper::writeBlock(uint8_t* area, uint32_t pos, const int16_t* in, size_t n) {
+  if (format == FORMAT_ULAW) {
+    uint8_t* out = area + pos;
+    for (size_t i = 0; i < n; i++) {
+      out[i] = linearToUlaw(in[i]);
+    }
+  } else {
+    memcpy(area + pos * 2, in, n * 2);
+  }
+}
+
+bool Looper::pendingRestore(uint32_t block) const {
+  if (!undoing) {
+    return false;
+  }
+  const uint32_t loopBlocks = length / blockSize;
+  const uint32_t offset = (block + loopBlocks - layerStart) % loopBlocks;
+  return offset >= restoredBlocks && offset < layerBlocks;
+}
+
+void Looper::restoreStep() {
+  const uint32_t loopBlocks = length / blockSize;
+  const size_t blockBytes = blockSize * bytesPerSample();
+  for (uint8_t i = 0; i < UNDO_BLOCKS_PER_CALL && restoredBlocks < layerBlocks; i++) {
+    const uint32_t offset = ((layerStart + restoredBlocks) % loopBlocks) * blockBytes;
+    memcpy(storage + offset, storage + areaBytes + offset, blockBytes);
+    restoredBlocks++;
+  }
+  if (restoredBlocks >= layerBlocks) {
+    undoing = false;
+    layerBlocks = 0;  // No redo
+  }
+}
+
+void Looper::process(int16_t* buffer, size_t numSamples) {
+  if (numSamples == 0 || numSamples > MAX_BLOCK) {
+    return;
+  }
+  blockSize = numSamples;
+
+  uint8_t req = request.exchange(REQUEST_NONE);
+  if (req != REQUEST_NONE) {
+    handleRequest(req);
+  }
+
+  switch (state) {
+    case STATE_RECORDING:
+      writeBlock(storage, position, buffer, numSamples);
+      position += numSamples;
+      if (position + numSamples > getCapacitySamples()) {
+        closeLoop(STATE_PLAYING);  // Buffer full
+      }
+      return;
+
+    case STATE_PLAYING:
+    case STATE_OVERDUBBING:
+      break;
+
+    case STATE_STOPPED:
+      if (undoing) {
+        restoreStep();
+      }
+      return;
+
+    default:
+      return;
+  }
+
+  // The loop as it was (from the undo copy where an undo hasn't reached yet)
+  const uint32_t block = position / blockSize;
+  readBlock(pendingRestore(block) ? storage + areaBytes : storage, position, loopBlock, numSamples);
+
+  if (state == STATE_OVERDUBBING) {
+    // First pass of this layer over the block: keep the old content for undo
+    if (layerBlocks < length / blockSize) {
+      const size_t blockBytes = numSamples * bytesPerSample();
+      memcpy(storage + areaBytes + block * blockBytes, storage + block * blockBytes, blockBytes);
+      layerBlocks = layerBlocks + 1;
+    }
+
+    // Old loop decays by the feedback amount, the live signal is added
+    const int32_t feedbackQ15 = (int32_t)(feedback * 32768.0f);
+    for (size_t i = 0; i < numSamples; i++) {
+      mixBlock[i] = saturate(((loopBlock[i] * feedbackQ15) >> 15) + buffer[i]);
+    }
+    writeBlock(storage, position, mixBlock, numSamples);
+  }
+
+  if (undoing) {
+    restoreStep();
+  }
+
+  const int32_t levelQ15 = (int32_t)(level * 32768.0f);
+  for (size_t i = 0; i < numSamples; i++) {
+    buffer[i] = saturate(buffer[i] + ((loopBlock[i] * levelQ15) >> 15));
+  }
+
+  position += numSamples;
+  if (position >= length) {
+    position = 0;
+  }
+}
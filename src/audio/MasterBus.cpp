@@ -0,0 +1,273 @@
+/*
+ * MasterBus.cpp
+ *
+ * Implementation of the master output stage (gate, drive, limiter, soft clip).
+ */
+
+#include "audio/MasterBus.h"
+#include "system/Debug.h"
+#include <math.h>
+
+// Smallest shift so that (1 << shift) >= samples (time constant of a one-pole
+// filter implemented as x += (target - x) >> shift)
+static int samplesToShift(uint32_t samples) {
+  int shift = 0;
+  while ((1UL << shift) < samples && shift < 20) {
+    shift++;
+  }
+  return shift;
+}
+
+MasterBus::MasterBus(uint32_t sampleRate)
+    : sampleRate(sampleRate),
+      driveQ12((int32_t)(DEFAULT_DRIVE * 4096)),
+      gateEnabled(true),
+      gateOpen(false),
+      gateOpenLevel(DEFAULT_GATE_OPEN),
+      gateCloseLevel(DEFAULT_GATE_CLOSE),
+      gateEnvelope(0),
+      gateGainQ15(0),
+      limiterEnabled(true),
+      lookahead(1),
+      delayIndex(0),
+      limiterGainQ15(UNITY_Q15),
+      limiterTargetQ15(UNITY_Q15),
+      limiterAttackStep(1),
+      holdCounter(0),
+      minGainQ15(UNITY_Q15),
+      clipCount(0) {
+
+  // Rate-dependent time constants
+  lookahead = constrain((int)(sampleRate * LOOKAHEAD_MS / 1000.0f), 1, MAX_LOOKAHEAD);
+  gateAttackStep = UNITY_Q15 / (int32_t)(sampleRate / 1000);  // ~1 ms fade-in
+  gateReleaseShift = samplesToShift(sampleRate / 50);         // ~20 ms envelope release
+  limiterReleaseShift = samplesToShift(sampleRate / 20);      // ~50 ms gain recovery
+
+  buildClipTable();
+  reset();
+
+  DEBUG_PRINT("[MASTER] Initialized: drive ");
+  DEBUG_PRINT(DEFAULT_DRIVE);
+  DEBUG_PRINT("x, limiter look-ahead ");
+  DEBUG_PRINT(lookahead);
+  DEBUG_PRINT(" samples, gate ");
+  DEBUG_PRINT(gateOpenLevel);
+  DEBUG_PRINT("/");
+  DEBUG_PRINTLN(gateCloseLevel);
+}
+
+void MasterBus::buildClipTable() {
+  // Entry i covers an excess of (i << CLIP_TABLE_SHIFT) above the knee.
+  // Output above the knee follows tanh, so it approaches full scale
+  // asymptotically instead of hitting a flat top.
+  const float headroom = (float)(Audio::SAMPLE_MAX - CLIP_KNEE);
+  for (int i = 0; i < CLIP_TABLE_SIZE; i++) {
+    float excess = (float)(i << CLIP_TABLE_SHIFT);
+    float shaped = CLIP_KNEE + headroom * tanhf(excess / headroom);
+    clipTable[i] = (int16_t)constrain((int32_t)shaped, (int32_t)CLIP_KNEE, (int32_t)Audio::SAMPLE_MAX);
+  }
+}
+
+void MasterBus::reset() {
+  memset(delayLine, 0, sizeof(delayLine));
+  delayIndex = 0;
+  limiterGainQ15 = UNITY_Q15;
+  limiterTargetQ15 = UNITY_Q15;
+  holdCounter = 0;
+  gateEnvelope = 0;
+  gateGainQ15 = 0;
+  gateOpen = false;
+}
+
+inline int32_t MasterBus::processGate(int32_t x) {
+  // Peak envelope (Q8): instant attack, exponential release
+  int32_t level = (x < 0 ? -x : x) << 8;
+  if (level > gateEnvelope) {
+    gateEnvelope = level;
+  } else {
+    gateEnvelope -= (gateEnvelope - level) >> gateReleaseShift;
+  }
+
+  // Hysteresis: open above openLevel, close only below closeLevel
+  int32_t openQ8 = (int32_t)gateOpenLevel << 8;
+  if (!gateOpen && gateEnvelope >= openQ8) {
+    gateOpen = true;
+  } else if (gateOpen && gateEnvelope < ((int32_t)gateCloseLevel << 8)) {
+    gateOpen = false;
+  }
+
+  // Target gain: unity when open, 1:2 expander below the open level when
+  // closed (gain proportional to envelope, so quiet tails fade instead of
+  // cutting). Between the two levels the gain depends on the state: unity
+  // while open, attenuated until the envelope reaches openLevel while closed
+  int32_t target = UNITY_Q15;
+  if (!gateOpen) {
+    target = (int32_t)(((int64_t)gateEnvelope * UNITY_Q15) / openQ8);
+    if (target > UNITY_Q15) {
+      target = UNITY_Q15;
+    }
+  }
+
+  // Ramp up quickly (avoid click on open), follow the envelope down
+  if (target > gateGainQ15) {
+    gateGainQ15 += gateAttackStep;
+    if (gateGainQ15 > target) {
+      gateGainQ15 = target;
+    }
+  } else {
+    gateGainQ15 = target;
+  }
+
+  return (x * gateGainQ15) >> 15;
+}
+
+inline int32_t MasterBus::processLimiter(int32_t x) {
+  // Gain this sample will need when it leaves the delay line
+  int32_t level = (x < 0 ? -x : x);
+  int32_t needed = UNITY_Q15;
+  if (level > LIMIT_CEILING) {
+    needed = (int32_t)(((int64_t)LIMIT_CEILING << 15) / level);
+  }
+
+  // New (deeper) peak: ramp down so target is reached exactly when it exits
+  if (needed <= limiterTargetQ15 && needed < UNITY_Q15) {
+    limiterTargetQ15 = needed;
+    limiterAttackStep = (limiterGainQ15 - needed + lookahead - 1) / lookahead;
+    if (limiterAttackStep < 1) {
+      limiterAttackStep = 1;
+    }
+    holdCounter = lookahead;
+  }
+
+  if (limiterGainQ15 > limiterTargetQ15) {
+    // Attack
+    limiterGainQ15 -= limiterAttackStep;
+    if (limiterGainQ15 < limiterTargetQ15) {
+      limiterGainQ15 = limiterTargetQ15;
+    }
+  } else if (holdCounter > 0) {
+    // Hold until the peak has passed
+    holdCounter--;
+  } else if (limiterGainQ15 < UNITY_Q15) {
+    // Release (exponential recovery toward unity)
+    limiterGainQ15 += ((UNITY_Q15 - limiterGainQ15) >> limiterReleaseShift) + 1;
+    if (limiterGainQ15 > UNITY_Q15) {
+      limiterGainQ15 = UNITY_Q15;
+    }
+    limiterTargetQ15 = limiterGainQ15;
+  }
+
+  // Look-ahead delay line
+  int32_t delayed = delayLine[delayIndex];
+  delayLine[delayIndex] = x;
+  if (++delayIndex >= lookahead) {
+    delayIndex = 0;
+  }
+
+  // Driven samples can exceed 16 bits, so multiply in 64-bit
+  return (int32_t)(((int64_t)delayed * limiterGainQ15) >> 15);
+}
+
+inline int16_t MasterBus::softClip(int32_t x) {
+  int32_t level = (x < 0 ? -x : x);
+  if (level <= CLIP_KNEE) {
+    return (int16_t)x;
+  }
+
+  clipCount++;
+
+  // Table lookup with linear interpolation on the excess above the knee
+  int32_t excess = level - CLIP_KNEE;
+  int32_t index = excess >> CLIP_TABLE_SHIFT;
+  int32_t shaped;
+  if (index >= CLIP_TABLE_SIZE - 1) {
+    shaped = clipTable[CLIP_TABLE_SIZE - 1];
+  } else {
+    int32_t frac = excess & ((1 << CLIP_TABLE_SHIFT) - 1);
+    int32_t a = clipTable[index];
+    int32_t b = clipTable[index + 1];
+    shaped = a + (((b - a) * frac) >> CLIP_TABLE_SHIFT);
+  }
+
+  return (int16_t)(x < 0 ? -shaped : shaped);
+}
+
+void MasterBus::processBlock(int16_t* buffer, size_t numSamples) {
+  // Snapshot settings once per block
+  const int32_t drive = driveQ12;
+  const bool useGate = gateEnabled;
+  const bool useLimiter = limiterEnabled;
+  int32_t blockMinGain = UNITY_Q15;
+
+  for (size_t i = 0; i < numSamples; i++) {
+    int32_t x = buffer[i];
+
+    if (useGate) {
+      x = processGate(x);
+    }
+
+    // Drive on 32-bit intermediate (may exceed int16 range here)
+    x = (x * drive) >> 12;
+
+    if (useLimiter) {
+      x = processLimiter(x);
+      if (limiterGainQ15 < blockMinGain) {
+        blockMinGain = limiterGainQ15;
+      }
+    }
+
+    buffer[i] = softClip(x);
+  }
+
+  minGainQ15 = blockMinGain;
+}
+
+void MasterBus::setDrive(float drive) {
+  drive = constrain(drive, 0.25f, 4.0f);
+  driveQ12 = (int32_t)(drive * 4096);
+
+  DEBUG_PRINT("[MASTER] Drive set to ");
+  DEBUG_PRINTLN(drive);
+}
+
+void MasterBus::setLimiterEnabled(bool enabled) {
+  limiterEnabled = enabled;
+  if (!enabled) {
+    // Next enable starts from a clean delay line
+    memset(delayLine, 0, sizeof(delayLine));
+    limiterGainQ15 = UNITY_Q15;
+    limiterTargetQ15 = UNITY_Q15;
+    holdCounter = 0;
+    minGainQ15 = UNITY_Q15;
+  }
+
+  DEBUG_PRINT("[MASTER] Limiter ");
+  DEBUG_PRINTLN(enabled ? "ENABLED" : "DISABLED");
+}
+
+void MasterBus::setGateEnabled(bool enabled) {
+  gateEnabled = enabled;
+
+  DEBUG_PRINT("[MASTER] Gate ");
+  DEBUG_PRINTLN(enabled ? "ENABLED" : "DISABLED");
+}
+
+void MasterBus::setGateThresholds(int16_t openLevel, int16_t closeLevel) {
+  openLevel = constrain(openLevel, (int16_t)1, (int16_t)4000);
+  closeLevel = constrain(closeLevel, (int16_t)1, openLevel);
+  gateOpenLevel = openLevel;
+  gateCloseLevel = closeLevel;
+
+  DEBUG_PRINT("[MASTER] Gate thresholds open/close: ");
+  DEBUG_PRINT(gateOpenLevel);
+  DEBUG_PRINT("/");
+  DEBUG_PRINTLN(gateCloseLevel);
+}
+
+float MasterBus::getLimiterGainReductionDb() const {
+  int32_t gain = minGainQ15;
+  if (gain >= UNITY_Q15 || gain <= 0) {
+    return 0.0f;
+  }
+  return 20.0f * log10f((float)UNITY_Q15 / (float)gain);
+}
@@ -0,0 +1,87 @@
+/*
+ * NoteTable.cpp
+ *
+ * Semitone boundary table and lookup. See NoteTable.h.
+ */
+
+#include "audio/NoteTable.h"
+
+namespace NoteTable {
+    // Lower boundary (-50 cents) of each note from C0, plus the upper
+    // boundary of B8: 440 * 2^((midi - 69.5) / 12)
+    static const float BOUNDARIES[NUM_NOTES + 1] = {
+        15.8861f, 16.8307f, 17.8315f, 18.8919f, 20.0152f, 21.2054f,
+        22.4663f, 23.8023f, 25.2176f, 26.7171f, 28.3058f, 29.9890f,
+        31.7722f, 33.6615f, 35.6631f, 37.7837f, 40.0305f, 42.4108f,
+        44.9327f, 47.6045f, 50.4352f, 53.4343f, 56.6116f, 59.9779f,
+        63.5444f, 67.3229f, 71.3262f, 75.5675f, 80.0609f, 84.8216f,
+        89.8653f, 95.2090f, 100.8704f, 106.8685f, 113.2232f, 119.9559f,
+        127.0888f, 134.6459f, 142.6524f, 151.1349f, 160.1219f, 169.6432f,
+        179.7307f, 190.4180f, 201.7409f, 213.7370f, 226.4465f, 239.9117f,
+        254.1776f, 269.2918f, 285.3047f, 302.2698f, 320.2437f, 339.2864f,
+        359.4614f, 380.8361f, 403.4818f, 427.4741f, 452.8930f, 479.8234f,
+        508.3552f, 538.5836f, 570.6094f, 604.5396f, 640.4874f, 678.5728f,
+        718.9228f, 761.6722f, 806.9636f, 854.9481f, 905.7860f, 959.6468f,
+        1016.7104f, 1077.1671f, 1141.2188f, 1209.0792f, 1280.9748f, 1357.1455f,
+        1437.8456f, 1523.3443f, 1613.9271f, 1709.8962f, 1811.5719f, 1919.2936f,
+        2033.4207f, 2154.3342f, 2282.4376f, 2418.1584f, 2561.9496f, 2714.2911f,
+        2875.6912f, 3046.6887f, 3227.8542f, 3419.7924f, 3623.1439f, 3838.5872f,
+        4066.8415f, 4308.6685f, 4564.8752f, 4836.3168f, 5123.8992f, 5428.5821f,
+        5751.3824f, 6093.3774f, 6455.7085f, 6839.5849f, 7246.2877f, 7677.1744f,
+        8133.6830f,
+    };
+
+    // Boundary → centre ratio (50 cents)
+    static constexpr float HALF_SEMITONE = 1.0293022f;
+
+    static const char* const NOTE_NAMES[12] = {
+        "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+    };
+
+    bool lookup(float frequency, NoteInfo& info) {
+        if (!(frequency >= BOUNDARIES[0]) || frequency >= BOUNDARIES[NUM_NOTES]) {
+            return false;
+        }
+
+        // Last boundary <= frequency
+        int low = 0;
+        int high = NUM_NOTES;
+        while (high - low > 1) {
+            int mid = (low + high) >> 1;
+            if (BOUNDARIES[mid] <= frequency) {
+                low = mid;
+            } else {
+                high = mid;
+            }
+        }
+
+        float lower = BOUNDARIES[low];
+        float upper = BOUNDARIES[low + 1];
+        float centre = lower * HALF_SEMITONE;
+        if (frequency < centre) {
+            info.cents = -50.0f + 50.0f * (frequency - lower) / (centre - lower);
+        } else {
+            info.cents = 50.0f * (frequency - centre) / (upper - centre);
+        }
+
+        info.midiNote = FIRST_MIDI + low;
+        info.noteIndex = info.midiNote % 12;
+        info.octave = info.midiNote / 12 - 1;
+        return true;
+    }
+
+    const char* noteName(int noteIndex) {
+        return (noteIndex >= 0 && noteIndex < 12) ? NOTE_NAMES[noteIndex] : "---";
+    }
+
+    float noteFrequency(int midiNote) {
+        if (midiNote < FIRST_MIDI || midiNote > LAST_MIDI) {
+            return 0.0f;
+        }
+        return BOUNDARIES[midiNote - FIRST_MIDI] * HALF_SEMITONE;
+    }
+
+    void formatNote(const NoteInfo& info, char* buffer, size_t size) {
+        snprintf(buffer, size, "%s%d", NOTE_NAMES[info.noteIndex], info.octave);
+    }
+}
@@ -55,6 +55,12 @@ void Oscillator::setOctaveShift(int shift) {
 void Oscillator::setVolume(float vol) {
   // Constrain to 0.0-1.0 range
   volume = constrain(vol, 0.0f, 1.0f);
+  volumeRamp.cancel();
+}
+
+// Ramp volume over the next block (audio task)
+void Oscillator::rampVolume(float vol, size_t numSamples) {
+  volumeRamp.start(volume, constrain(vol, 0.0f, 1.0f), numSamples);
 }
 
 // Get next audio sample
@@ -108,6 +114,9 @@ int16_t Oscillator::getNextSample(float sampleRate) {
   }
 
   // Apply volume control before returning
+  if (volumeRamp.isActive()) {
+    volume = volumeRamp.next();
+  }
   return (int16_t)(sample * volume);
 }
 
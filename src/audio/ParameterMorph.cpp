@@ -0,0 +1,65 @@
+/*
+ * ParameterMorph.cpp
+ *
+ * Block-rate interpolation between two parameter sets. See ParameterMorph.h.
+ */
+
+#include "audio/ParameterMorph.h"
+
+ParameterMorph::ParameterMorph()
+    : pending(false),
+      mux(portMUX_INITIALIZER_UNLOCKED),
+      position(0.0f),
+      running(false),
+      active(false),
+      targetPosition(0.0f) {
+  memset(&pendingFrom, 0, sizeof(Params));
+  memset(&pendingTo, 0, sizeof(Params));
+  memset(&from, 0, sizeof(Params));
+  memset(&to, 0, sizeof(Params));
+}
+
+void ParameterMorph::start(const Params& a, const Params& b) {
+  portENTER_CRITICAL(&mux);
+  pendingFrom = a;
+  pendingTo = b;
+  pending = true;
+  active = true;
+  portEXIT_CRITICAL(&mux);
+}
+
+bool ParameterMorph::process(Params& out) {
+  if (!active) {
+    running = false;
+    return false;
+  }
+
+  // New endpoints: take them at this block boundary
+  if (pending) {
+    portENTER_CRITICAL(&mux);
+    from = pendingFrom;
+    to = pendingTo;
+    pending = false;
+    portEXIT_CRITICAL(&mux);
+
+    // A fresh morph starts where the control is, not gliding from 0
+    if (!running) {
+      position = targetPosition;
+      running = true;
+    }
+  }
+
+  position += (targetPosition - position) * POSITION_SMOOTHING;
+
+  for (uint8_t i = 0; i < NUM_OSCILLATORS; i++) {
+    out.oscVolume[i] = lerp(from.oscVolume[i], to.oscVolume[i], position);
+  }
+  for (uint8_t i = 0; i < MAX_EFFECTS; i++) {
+    out.effectMix[i] = lerp(from.effectMix[i], to.effectMix[i], position);
+  }
+  out.delayFeedback = lerp(from.delayFeedback, to.delayFeedback, position);
+  out.reverbRoomSize = lerp(from.reverbRoomSize, to.reverbRoomSize, position);
+  out.pitchSmoothing = lerp(from.pitchSmoothing, to.pitchSmoothing, position);
+  out.volumeSmoothing = lerp(from.volumeSmoothing, to.volumeSmoothing, position);
+  return true;
+}
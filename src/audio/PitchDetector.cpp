@@ -0,0 +1,243 @@
+/*
+ * PitchDetector.cpp
+ *
+ * YIN pitch detection on the decimated output stream.
+ * See PitchDetector.h for the design notes.
+ */
+
+#include "audio/PitchDetector.h"
+#include "system/Debug.h"
+
+PitchDetector::PitchDetector(const AudioTap* outputTap)
+    : tap(outputTap),
+      taskHandle(nullptr),
+      tapPosition(0),
+      frequency(0.0f),
+      clarity(0.0f) {
+  reset();
+}
+
+PitchDetector::~PitchDetector() {
+  if (taskHandle != nullptr) {
+    vTaskDelete(taskHandle);
+    taskHandle = nullptr;
+  }
+}
+
+bool PitchDetector::begin() {
+  tapPosition = tap->getWriteCount();
+
+  BaseType_t result = xTaskCreatePinnedToCore(
+      taskFunction,   // Task function
+      "PitchTask",    // Task name
+      3072,           // Stack size (bytes) - buffers are members
+      this,           // Parameter (this pointer)
+      1,              // Priority (below WiFi/async_tcp)
+      &taskHandle,    // Task handle
+      0               // Core ID (0 = protocol core, away from the audio task)
+  );
+
+  if (result != pdPASS) {
+    DEBUG_PRINTLN("[PITCH] Failed to create detection task");
+    taskHandle = nullptr;
+    return false;
+  }
+
+  DEBUG_PRINTF("[PITCH] YIN detector started (%u Hz, lags %d-%d)\n",
+               (unsigned)DETECT_RATE, MIN_LAG, MAX_LAG);
+  return true;
+}
+
+void PitchDetector::taskFunction(void* parameter) {
+  PitchDetector* detector = static_cast<PitchDetector*>(parameter);
+
+  while (true) {
+    detector->poll();
+    vTaskDelay(pdMS_TO_TICKS(POLL_INTERVAL_MS));
+  }
+}
+
+void PitchDetector::reset() {
+  memset(history, 0, sizeof(history));
+  historyCount = 0;
+  samplesSinceEstimate = 0;
+  stage1.reset();
+  stage2.reset();
+  nextLag = 0;
+}
+
+void PitchDetector::poll() {
+  // Drain everything the audio task wrote since the last wake-up
+  while (true) {
+    uint32_t expected = tapPosition;
+    size_t n = tap->read(tapPosition, chunk, READ_CHUNK);
+
+    // Fell behind (skipped ahead or lapped): the history is no longer
+    // contiguous, start over rather than measure across the gap
+    if (tapPosition - n != expected) {
+      reset();
+    }
+    if (n == 0) {
+      break;
+    }
+    ingest(chunk, n);
+  }
+
+  // One slice of the difference function per wake-up
+  if (nextLag == 0 && samplesSinceEstimate >= (uint32_t)WINDOW_SIZE &&
+      historyCount >= (uint32_t)(WINDOW_SIZE + MAX_LAG)) {
+    if (!startEstimate()) {
+      // Below the gate: no pitch, nothing to compute
+      frequency = 0.0f;
+      clarity = 0.0f;
+    }
+  }
+
+  if (nextLag != 0) {
+    computeSlice();
+    if (nextLag > MAX_LAG) {
+      finishEstimate();
+    }
+  }
+}
+
+void PitchDetector::ingest(const int16_t* samples, size_t numSamples) {
+  // The tap advances in whole audio blocks (256/512 samples), so every read
+  // is a multiple of DECIMATION
+  size_t count = numSamples / 2;
+  stage1.process(samples, stage1Out, count);
+  if (DECIMATION == 2) {
+    append(stage1Out, count);
+    return;
+  }
+
+  count /= 2;
+  stage2.process(stage1Out, stage2Out, count);
+  append(stage2Out, count);
+}
+
+void PitchDetector::append(const int16_t* samples, size_t numSamples) {
+  for (size_t i = 0; i < numSamples; i++) {
+    history[historyCount & (HISTORY_SIZE - 1)] = samples[i];
+    historyCount++;
+  }
+  samplesSinceEstimate += numSamples;
+}
+
+bool PitchDetector::startEstimate() {
+  samplesSinceEstimate = 0;
+
+  // Snapshot the newest samples so slices computed on later wake-ups all
+  // see the same signal
+  const int length = WINDOW_SIZE + MAX_LAG;
+  uint32_t start = historyCount - length;
+  int64_t energy = 0;
+  for (int i = 0; i < length; i++) {
+    frame[i] = history[(start + i) & (HISTORY_SIZE - 1)];
+  }
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    energy += (int32_t)frame[i] * frame[i];
+  }
+
+  if (energy < (int64_t)GATE_LEVEL * GATE_LEVEL * WINDOW_SIZE) {
+    return false;
+  }
+
+  diff[0] = 0.0f;
+  nextLag = 1;
+  return true;
+}
+
+void PitchDetector::computeSlice() {
+  int end = nextLag + LAGS_PER_SLICE;
+  if (end > MAX_LAG + 1) {
+    end = MAX_LAG + 1;
+  }
+
+  // d(tau) = sum over the window of (x[i] - x[i + tau])^2
+  for (int tau = nextLag; tau < end; tau++) {
+    float sum = 0.0f;
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+      float delta = (float)(frame[i] - frame[i + tau]);
+      sum += delta * delta;
+    }
+    diff[tau] = sum;
+  }
+
+  nextLag = end;
+}
+
+// Vertex of the parabola through three equally spaced points, relative to
+// the middle one. On the raw difference function: the normalization skews
+// the parabola at short lags.
+static inline float parabolicOffset(float a, float b, float c) {
+  float denominator = a - 2.0f * b + c;
+  return (denominator > 0.0f) ? 0.5f * (a - c) / denominator : 0.0f;
+}
+
+void PitchDetector::finishEstimate() {
+  nextLag = 0;
+
+  // Cumulative mean normalized difference:
+  // d'(tau) = d(tau) * tau / sum(d(1..tau))
+  float runningSum = 0.0f;
+  normalized[0] = 1.0f;
+  for (int tau = 1; tau <= MAX_LAG; tau++) {
+    runningSum += diff[tau];
+    normalized[tau] = (runningSum > 0.0f) ? diff[tau] * tau / runningSum : 1.0f;
+  }
+
+  // First dip below the threshold, then down to its local minimum
+  int best = -1;
+  for (int tau = MIN_LAG; tau <= MAX_LAG; tau++) {
+    if (normalized[tau] < YIN_THRESHOLD) {
+      while (tau + 1 <= MAX_LAG && normalized[tau + 1] < normalized[tau]) {
+        tau++;
+      }
+      best = tau;
+      break;
+    }
+  }
+
+  if (best < 0) {
+    frequency = 0.0f;
+    clarity = 0.0f;
+    return;
+  }
+
+  // High notes have periods of only a few decimated samples, where the
+  // parabola fit is coarse. Refine on the minimum at a multiple of the
+  // period instead (same signal, k times the resolution).
+  float coarse = (float)best;
+  if (best > 1 && best < MAX_LAG) {
+    coarse += parabolicOffset(diff[best - 1], diff[best], diff[best + 1]);
+  }
+
+  int multiple = REFINE_LAG / best;
+  if (multiple < 1) {
+    multiple = 1;
+  }
+  int lag = (int)(coarse * multiple + 0.5f);
+  if (lag > MAX_LAG) {
+    lag = best;
+    multiple = 1;
+  }
+  while (lag > 1 && lag + 1 <= MAX_LAG) {
+    if (diff[lag - 1] < diff[lag]) {
+      lag--;
+    } else if (diff[lag + 1] < diff[lag]) {
+      lag++;
+    } else {
+      break;
+    }
+  }
+
+  float period = (float)lag;
+  if (lag > 1 && lag < MAX_LAG) {
+    period += parabolicOffset(diff[lag - 1], diff[lag], diff[lag + 1]);
+  }
+  period /= multiple;
+
+  clarity = 1.0f - normalized[best];
+  frequency = (float)DETECT_RATE / period;
+}
@@ -11,6 +11,14 @@
 // Fixed base delay for chorus effect (center of modulation)
 static const float BASE_DELAY_MS = 10.0f;
 
+// Parameter table (AudioEffect interface) - order matches getParam/setParam
+const EffectParam ChorusEffect::PARAMS[ChorusEffect::PARAM_COUNT] = {
+    // key      alias    label    unit   min    max     step   displayScale
+    {"rate",    nullptr, "Rate",  "Hz",  0.1f,  10.0f,  0.1f,  1.0f},
+    {"depth",   nullptr, "Depth", "ms",  1.0f,  50.0f,  1.0f,  1.0f},
+    {"mix",     nullptr, "Mix",   "%",   0.0f,  1.0f,   0.01f, 100.0f},
+};
+
 ChorusEffect::ChorusEffect(uint32_t sampleRate)
     : sampleRate(sampleRate),
       lfoDepthMs(7.0f),      // Default 7ms modulation depth (±7ms around base)
@@ -109,6 +117,24 @@ int16_t ChorusEffect::process(int16_t input) {
     return (int16_t)output;
 }
 
+void ChorusEffect::processBlock(int16_t* buffer, size_t numSamples) {
+    // Bypass check once per block instead of once per sample
+    if (!enabled) {
+        return;
+    }
+
+    for (size_t i = 0; i < numSamples; i++) {
+        if (mixRamp.isActive()) {
+            wetDryMix = mixRamp.next();
+        }
+        buffer[i] = process(buffer[i]);
+    }
+}
+
+void ChorusEffect::rampMix(float mix, size_t numSamples) {
+    mixRamp.start(wetDryMix, constrain(mix, 0.0f, 1.0f), numSamples);
+}
+
 void ChorusEffect::setEnabled(bool en) {
     enabled = en;
     DEBUG_PRINT("[CHORUS] ");
@@ -161,6 +187,7 @@ void ChorusEffect::setMix(float mix) {
     mix = constrain(mix, 0.0f, 1.0f);
 
     wetDryMix = mix;
+    mixRamp.cancel();
 
     DEBUG_PRINT("[CHORUS] Mix set to ");
     DEBUG_PRINTLN(wetDryMix);
@@ -206,3 +233,38 @@ void ChorusEffect::setPreset(Preset preset) {
   DEBUG_PRINT("[CHORUS] Preset applied: ");
   DEBUG_PRINTLN((int)preset);
 }
+
+const EffectParam& ChorusEffect::getParamInfo(uint8_t index) const {
+    return PARAMS[index < PARAM_COUNT ? index : 0];
+}
+
+float ChorusEffect::getParam(uint8_t index) const {
+    switch (index) {
+        case 0: return getRate();
+        case 1: return lfoDepthMs;
+        case 2: return wetDryMix;
+        default: return 0.0f;
+    }
+}
+
+void ChorusEffect::setParam(uint8_t index, float value) {
+    switch (index) {
+        case 0: setRate(value); break;
+        case 1: setDepth(value); break;
+        case 2: setMix(value); break;
+        default: break;
+    }
+}
+
+bool ChorusEffect::automateParam(uint8_t index, float value, size_t numSamples) {
+    switch (index) {
+        case 0: lfo.setFrequency(constrain(value, 0.1f, 10.0f)); return true;
+        case 1: lfoDepthMs = constrain(value, 1.0f, 50.0f); return true;
+        case 2: rampMix(value, numSamples); return true;
+        default: return false;
+    }
+}
+
+bool ChorusEffect::isAutomatable(uint8_t index) const {
+    return index < PARAM_COUNT;
+}
@@ -8,6 +8,14 @@
 #include "system/Debug.h"
 #include <string.h>  // for memset
 
+// Parameter table (AudioEffect interface) - order matches getParam/setParam
+const EffectParam DelayEffect::PARAMS[DelayEffect::PARAM_COUNT] = {
+    // key         alias    label    unit   min     max      step   displayScale
+    {"time",       nullptr, "Time",  "ms",  10.0f,  2000.0f, 10.0f, 1.0f},
+    {"feedback",   nullptr, "FB",    "%",   0.0f,   0.95f,   0.01f, 100.0f},
+    {"mix",        nullptr, "Mix",   "%",   0.0f,   1.0f,    0.01f, 100.0f},
+};
+
 DelayEffect::DelayEffect(uint32_t delayTimeMs, uint32_t sampleRate)
     : sampleRate(sampleRate),
       delayTimeMs(delayTimeMs),
@@ -79,6 +87,24 @@ int16_t DelayEffect::process(int16_t input) {
     return (int16_t)output;
 }
 
+void DelayEffect::processBlock(int16_t* buffer, size_t numSamples) {
+    // Bypass check once per block instead of once per sample
+    if (!enabled) {
+        return;
+    }
+
+    for (size_t i = 0; i < numSamples; i++) {
+        if (mixRamp.isActive()) {
+            wetDryMix = mixRamp.next();
+        }
+        buffer[i] = process(buffer[i]);
+    }
+}
+
+void DelayEffect::rampMix(float mix, size_t numSamples) {
+    mixRamp.start(wetDryMix, constrain(mix, 0.0f, 1.0f), numSamples);
+}
+
 void DelayEffect::setEnabled(bool en) {
     enabled = en;
     DEBUG_PRINT("[DELAY] ");
@@ -120,6 +146,7 @@ void DelayEffect::setMix(float mix) {
     mix = constrain(mix, 0.0f, 1.0f);
 
     wetDryMix = mix;
+    mixRamp.cancel();
 
     DEBUG_PRINT("[DELAY] Mix set to ");
     DEBUG_PRINTLN(wetDryMix);
@@ -158,3 +185,38 @@ void DelayEffect::setPreset(Preset preset) {
         break;
   }
 }
+
+const EffectParam& DelayEffect::getParamInfo(uint8_t index) const {
+    return PARAMS[index < PARAM_COUNT ? index : 0];
+}
+
+float DelayEffect::getParam(uint8_t index) const {
+    switch (index) {
+        case 0: return (float)delayTimeMs;
+        case 1: return feedback;
+        case 2: return wetDryMix;
+        default: return 0.0f;
+    }
+}
+
+void DelayEffect::setParam(uint8_t index, float value) {
+    switch (index) {
+        case 0: setDelayTime((uint32_t)value); break;
+        case 1: setFeedback(value); break;
+        case 2: setMix(value); break;
+        default: break;
+    }
+}
+
+// Delay time is not automatable: a new time resizes the buffer
+bool DelayEffect::automateParam(uint8_t index, float value, size_t numSamples) {
+    switch (index) {
+        case 1: automateFeedback(value); return true;
+        case 2: rampMix(value, numSamples); return true;
+        default: return false;
+    }
+}
+
+bool DelayEffect::isAutomatable(uint8_t index) const {
+    return index == 1 || index == 2;
+}
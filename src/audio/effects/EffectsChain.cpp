@@ -6,12 +6,16 @@
 
 #include "audio/effects/EffectsChain.h"
 #include "system/Debug.h"
+#include <strings.h>  // for strncasecmp
 
 EffectsChain::EffectsChain(uint32_t sampleRate)
     : sampleRate(sampleRate),
       delay(300, sampleRate),    // Direct initialization on stack
       chorus(sampleRate),         // Direct initialization on stack
-      reverb(sampleRate) {        // Direct initialization on stack
+      reverb(sampleRate),         // Direct initialization on stack
+      slotOrder(0),
+      profiler(nullptr),
+      stateTracker(nullptr) {
 
     // Configure delay (object already constructed)
     delay.setFeedback(0.5f);
@@ -30,23 +34,167 @@ EffectsChain::EffectsChain(uint32_t sampleRate)
     reverb.setMix(0.3f);
     reverb.setEnabled(false);
 
+    // Register effects (registration order = default slot order)
+    // To add a new effect: add a member, register it here, bump NUM_EFFECTS.
+    effects[0] = &delay;
+    effects[1] = &chorus;
+    effects[2] = &reverb;  // Reverb at the end of chain by default
+
+    resetOrder();
+
     DEBUG_PRINTLN("[CHAIN] EffectsChain initialized with Delay + Chorus + Reverb");
 }
 
-int16_t EffectsChain::process(int16_t input) {
-    int16_t output = input;
+void EffectsChain::processBlock(int16_t* buffer, size_t numSamples) {
+    // Snapshot the order once per block (single atomic read)
+    uint32_t order = slotOrder;
+
+    // Apply effects in slot order
+    // (Each effect handles bypass internally, once per block)
+    for (uint8_t slot = 0; slot < NUM_EFFECTS; slot++) {
+        uint8_t index = (order >> (slot * 8)) & 0xFF;
+        effects[index]->processBlock(buffer, numSamples);
+        DSP_PROFILE_MARK(profiler, DSPProfiler::STAGE_EFFECTS + index);
+    }
+}
+
+AudioEffect* EffectsChain::getEffect(uint8_t index) {
+    if (index >= NUM_EFFECTS) {
+        return nullptr;
+    }
+    return effects[index];
+}
+
+AudioEffect* EffectsChain::findEffect(const char* name) {
+    if (name == nullptr) {
+        return nullptr;
+    }
+    int index = findEffectIndex(name, strlen(name));
+    return (index >= 0) ? effects[index] : nullptr;
+}
+
+AudioEffect* EffectsChain::getSlot(uint8_t slot) {
+    if (slot >= NUM_EFFECTS) {
+        return nullptr;
+    }
+    return effects[(slotOrder >> (slot * 8)) & 0xFF];
+}
+
+int EffectsChain::findEffectIndex(const char* name, size_t len) const {
+    for (uint8_t i = 0; i < NUM_EFFECTS; i++) {
+        const char* effectName = effects[i]->getName();
+        if (strlen(effectName) == len && strncasecmp(name, effectName, len) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool EffectsChain::setOrder(const char* csv) {
+    if (csv == nullptr) {
+        return false;
+    }
+
+    uint8_t order[NUM_EFFECTS];
+    bool used[NUM_EFFECTS] = {false};
+    uint8_t count = 0;
+
+    // Parse listed names (no String allocation - walk the buffer in place)
+    const char* start = csv;
+    while (*start != '\0') {
+        const char* end = start;
+        while (*end != '\0' && *end != ',') {
+            end++;
+        }
+
+        size_t len = end - start;
+        if (len > 0) {
+            int index = findEffectIndex(start, len);
+            if (index < 0 || used[index] || count >= NUM_EFFECTS) {
+                DEBUG_PRINTLN("[CHAIN] ERROR: Invalid effect order");
+                return false;
+            }
+            used[index] = true;
+            order[count++] = (uint8_t)index;
+        }
+
+        start = (*end == ',') ? end + 1 : end;
+    }
+
+    // Append effects that were not listed, keeping their current relative order
+    for (uint8_t slot = 0; slot < NUM_EFFECTS; slot++) {
+        uint8_t index = (slotOrder >> (slot * 8)) & 0xFF;
+        if (!used[index]) {
+            order[count++] = index;
+        }
+    }
+
+    applyOrder(order);
+    return true;
+}
+
+bool EffectsChain::moveEffect(const char* name, uint8_t position) {
+    if (name == nullptr) {
+        return false;
+    }
+
+    int moved = findEffectIndex(name, strlen(name));
+    if (moved < 0) {
+        return false;
+    }
+    if (position >= NUM_EFFECTS) {
+        position = NUM_EFFECTS - 1;
+    }
+
+    // Rebuild order without the moved effect, then insert it at position
+    uint8_t order[NUM_EFFECTS];
+    uint8_t count = 0;
+    for (uint8_t slot = 0; slot < NUM_EFFECTS; slot++) {
+        uint8_t index = (slotOrder >> (slot * 8)) & 0xFF;
+        if (index == moved) {
+            continue;
+        }
+        if (count == position) {
+            order[count++] = (uint8_t)moved;
+        }
+        order[count++] = index;
+    }
+    if (count < NUM_EFFECTS) {
+        order[count++] = (uint8_t)moved;
+    }
+
+    applyOrder(order);
+    return true;
+}
+
+void EffectsChain::resetOrder() {
+    uint8_t order[NUM_EFFECTS];
+    for (uint8_t i = 0; i < NUM_EFFECTS; i++) {
+        order[i] = i;
+    }
+    applyOrder(order);
+}
+
+void EffectsChain::applyOrder(const uint8_t order[NUM_EFFECTS]) {
+    uint32_t packed = 0;
+    for (uint8_t slot = 0; slot < NUM_EFFECTS; slot++) {
+        packed |= (uint32_t)order[slot] << (slot * 8);
+    }
+    slotOrder = packed;  // Single store - audio task picks it up at next block
 
-    // Apply effects in order
-    // (Only process if enabled - effect handles bypass internally)
-    output = delay.process(output);
-    output = chorus.process(output);
-    output = reverb.process(output);  // Reverb at the end of chain
+    if (stateTracker != nullptr) {
+        stateTracker->mark(StateTracker::EFFECT_ORDER);
+    }
 
-    return output;
+    DEBUG_PRINT("[CHAIN] Order: ");
+    for (uint8_t slot = 0; slot < NUM_EFFECTS; slot++) {
+        DEBUG_PRINT(effects[order[slot]]->getName());
+        DEBUG_PRINT(slot < NUM_EFFECTS - 1 ? " -> " : "\n");
+    }
 }
 
 void EffectsChain::setDelayEnabled(bool enabled) {
-    delay.setEnabled(enabled);
+    setEffectEnabled(&delay, enabled);
 }
 
 bool EffectsChain::isDelayEnabled() const {
@@ -54,7 +202,7 @@ bool EffectsChain::isDelayEnabled() const {
 }
 
 void EffectsChain::setChorusEnabled(bool enabled) {
-    chorus.setEnabled(enabled);
+    setEffectEnabled(&chorus, enabled);
 }
 
 bool EffectsChain::isChorusEnabled() const {
@@ -62,17 +210,49 @@ bool EffectsChain::isChorusEnabled() const {
 }
 
 void EffectsChain::setReverbEnabled(bool enabled) {
-    reverb.setEnabled(enabled);
+    setEffectEnabled(&reverb, enabled);
 }
 
 bool EffectsChain::isReverbEnabled() const {
     return reverb.isEnabled();
 }
 
+void EffectsChain::setEffectEnabled(AudioEffect* effect, bool enabled) {
+    if (effect == nullptr) {
+        return;
+    }
+    effect->setEnabled(enabled);
+    markEffect(effect);
+}
+
+void EffectsChain::setEffectParam(AudioEffect* effect, uint8_t index, float value) {
+    if (effect == nullptr || index >= effect->getParamCount()) {
+        return;
+    }
+    effect->setParam(index, value);
+    markEffect(effect);
+}
+
+void EffectsChain::notifyEffectChanged(const AudioEffect* effect) {
+    markEffect(effect);
+}
+
+void EffectsChain::markEffect(const AudioEffect* effect) {
+    if (stateTracker == nullptr) {
+        return;
+    }
+    for (uint8_t i = 0; i < NUM_EFFECTS; i++) {
+        if (effects[i] == effect) {
+            stateTracker->mark(StateTracker::effectBit(i));
+            return;
+        }
+    }
+}
+
 void EffectsChain::reset() {
-    delay.reset();
-    chorus.reset();
-    reverb.reset();
+    for (uint8_t i = 0; i < NUM_EFFECTS; i++) {
+        effects[i]->reset();
+    }
 
     DEBUG_PRINTLN("[CHAIN] All effects reset");
 }
@@ -15,6 +15,15 @@
 constexpr float ReverbEffect::COMB_DELAYS_MS[NUM_COMBS];
 constexpr float ReverbEffect::ALLPASS_DELAYS_MS[NUM_ALLPASSES];
 
+// Parameter table (AudioEffect interface) - order matches getParam/setParam
+// Aliases keep the historical serial commands working (reverb:room:, reverb:damp:)
+const EffectParam ReverbEffect::PARAMS[ReverbEffect::PARAM_COUNT] = {
+    // key         alias    label    unit  min    max    step   displayScale
+    {"roomSize",   "room",  "Room",  "",   0.0f,  1.0f,  0.01f, 1.0f},
+    {"damping",    "damp",  "Damp",  "",   0.0f,  1.0f,  0.01f, 1.0f},
+    {"mix",        nullptr, "Mix",   "%",  0.0f,  1.0f,  0.01f, 100.0f},
+};
+
 ReverbEffect::ReverbEffect(uint32_t sampleRate)
     : sampleRate(sampleRate),
       roomSize(0.5f),
@@ -227,6 +236,24 @@ int16_t ReverbEffect::process(int16_t input) {
     return (int16_t)output;
 }
 
+void ReverbEffect::processBlock(int16_t* buffer, size_t numSamples) {
+    // Bypass check once per block instead of once per sample
+    if (!enabled) {
+        return;
+    }
+
+    for (size_t i = 0; i < numSamples; i++) {
+        if (mixRamp.isActive()) {
+            wetDryMix = mixRamp.next();
+        }
+        buffer[i] = process(buffer[i]);
+    }
+}
+
+void ReverbEffect::rampMix(float mix, size_t numSamples) {
+    mixRamp.start(wetDryMix, constrain(mix, 0.0f, 1.0f), numSamples);
+}
+
 void ReverbEffect::setEnabled(bool en) {
     enabled = en;
     DEBUG_PRINT("[REVERB] ");
@@ -244,6 +271,14 @@ void ReverbEffect::setRoomSize(float size) {
     DEBUG_PRINTLN(roomSize);
 }
 
+void ReverbEffect::automateRoomSize(float size) {
+    size = constrain(size, 0.0f, 1.0f);
+    if (size != roomSize) {
+        roomSize = size;
+        updateCombs();
+    }
+}
+
 void ReverbEffect::setDamping(float damp) {
     // Constrain to valid range
     damp = constrain(damp, 0.0f, 1.0f);
@@ -260,6 +295,7 @@ void ReverbEffect::setMix(float mix) {
     mix = constrain(mix, 0.0f, 1.0f);
 
     wetDryMix = mix;
+    mixRamp.cancel();
 
     DEBUG_PRINT("[REVERB] Mix set to ");
     DEBUG_PRINTLN(wetDryMix);
@@ -317,3 +353,49 @@ void ReverbEffect::reset() {
 
     DEBUG_PRINTLN("[REVERB] Buffers cleared");
 }
+
+const EffectParam& ReverbEffect::getParamInfo(uint8_t index) const {
+    return PARAMS[index < PARAM_COUNT ? index : 0];
+}
+
+float ReverbEffect::getParam(uint8_t index) const {
+    switch (index) {
+        case 0: return roomSize;
+        case 1: return damping;
+        case 2: return wetDryMix;
+        default: return 0.0f;
+    }
+}
+
+void ReverbEffect::setParam(uint8_t index, float value) {
+    switch (index) {
+        case 0: setRoomSize(value); break;
+        case 1: setDamping(value); break;
+        case 2: setMix(value); break;
+        default: break;
+    }
+}
+
+bool ReverbEffect::automateParam(uint8_t index, float value, size_t numSamples) {
+    switch (index) {
+        case 0:
+            automateRoomSize(value);
+            return true;
+        case 1:
+            value = constrain(value, 0.0f, 1.0f);
+            if (value != damping) {
+                damping = value;
+                updateCombs();
+            }
+            return true;
+        case 2:
+            rampMix(value, numSamples);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool ReverbEffect::isAutomatable(uint8_t index) const {
+    return index < PARAM_COUNT;
+}
@@ -14,6 +14,10 @@ GPIOControls::GPIOControls(Theremin* thereminPtr, DisplayManager* displayMgr)
     : theremin(thereminPtr), initialized(false), controlsEnabled(true), firstUpdate(true),
       displayManager(displayMgr),
       notificationManager(nullptr),
+      bus(nullptr),
+      rebootRequested(false),
+      rawInputs(0xFFFF), inputs(0xFFFF), rawChangeTime(0), lastCaptureTime(0),
+      inputsChanged(false), interruptSeen(false), pollFallback(PIN_SWITCH_EXPANDER_INT < 0),
       buttonState(IDLE), buttonPressTime(0), modifierActive(false), modifierWasActive(false),
       modifierWasUsed(false),
       shortPressFlag(false),
@@ -28,15 +32,12 @@ GPIOControls::GPIOControls(Theremin* thereminPtr, DisplayManager* displayMgr)
   // Initialize state tracking
   osc1State.waveform = Oscillator::OFF;
   osc1State.octave = 0;
-  osc1State.lastChangeTime = 0;
 
   osc2State.waveform = Oscillator::OFF;
   osc2State.octave = 0;
-  osc2State.lastChangeTime = 0;
 
   osc3State.waveform = Oscillator::OFF;
   osc3State.octave = 0;
-  osc3State.lastChangeTime = 0;
 
   // Register modifier button indicator overlay
   if (displayManager) {
@@ -50,17 +51,38 @@ GPIOControls::GPIOControls(Theremin* thereminPtr, DisplayManager* displayMgr)
 }
 
 bool GPIOControls::begin() {
-  // Initialize MCP23017 at address 0x20
-  if (!mcp.begin_I2C(PIN_SWITCH_EXPANDER_ADDR)) {
-    DEBUG_PRINTLN("[GPIO] Failed to initialize MCP23017");
-    return false;
-  }
+  {
+    // Register setup as one bus hold (the display may be starting up too)
+    I2CBus::Lock lock(bus, I2CBus::CLIENT_EXPANDER, I2CBus::BOOT_ACQUIRE_TIMEOUT_MS);
+
+    // Initialize MCP23017 at address 0x20
+    if (!lock || !mcp.begin_I2C(PIN_SWITCH_EXPANDER_ADDR)) {
+      DEBUG_PRINTLN("[GPIO] Failed to initialize MCP23017");
+      return false;
+    }
 
-  // Configure all 16 pins as inputs with pullups
-  for (uint8_t pin = 0; pin < 16; pin++) {
-    mcp.pinMode(pin, INPUT_PULLUP);
+    // Configure all 16 pins as inputs with pullups
+    for (uint8_t pin = 0; pin < 16; pin++) {
+      mcp.pinMode(pin, INPUT_PULLUP);
+    }
+
+#if PIN_SWITCH_EXPANDER_INT >= 0
+    // Interrupt on any change, INTA/INTB mirrored (either can be wired),
+    // open-drain active LOW with the ESP32 pullup
+    mcp.setupInterrupts(true, true, LOW);
+    for (uint8_t pin = 0; pin < 16; pin++) {
+      mcp.setupInterruptPin(pin, CHANGE);
+    }
+#endif
   }
 
+#if PIN_SWITCH_EXPANDER_INT >= 0
+  pinMode(PIN_SWITCH_EXPANDER_INT, INPUT_PULLUP);
+  DEBUG_PRINTF("[GPIO] Change interrupt on GPIO %d\n", PIN_SWITCH_EXPANDER_INT);
+#else
+  DEBUG_PRINTLN("[GPIO] No change interrupt wired - polling the expander");
+#endif
+
   // Assign here instead the construction or initialization list, to be sure
   // Theremin is completely initialized with display and everything is needed.
   notificationManager = theremin->getNotificationManager();
@@ -88,14 +110,83 @@ void GPIOControls::update() {
     return;
   }
 
+  unsigned long now = millis();
+
+  // Bus traffic only when the expander reports a change, plus the resync
+  bool interrupt = expanderInterruptPending();
+  unsigned long interval = pollFallback ? POLL_INTERVAL_MS : RESYNC_INTERVAL_MS;
+  if (firstUpdate || interrupt || now - lastCaptureTime >= interval) {
+    captureInputs(now, interrupt);
+  }
+
+  debounceInputs(now);
+  processControls();
+
+  // Outside processControls(): the reboot notice has to reach the display
+  if (rebootRequested) {
+    performSystemReboot();
+  }
+}
+
+bool GPIOControls::expanderInterruptPending() const {
+#if PIN_SWITCH_EXPANDER_INT >= 0
+  return digitalRead(PIN_SWITCH_EXPANDER_INT) == LOW;
+#else
+  return false;
+#endif
+}
+
+void GPIOControls::captureInputs(unsigned long now, bool fromInterrupt) {
+  I2CBus::Lock lock(bus, I2CBus::CLIENT_EXPANDER);
+  if (!lock) {
+    return;  // Bus unavailable: the interrupt stays asserted, retry next loop
+  }
+
+  uint16_t word = mcp.readGPIOAB();
+  lastCaptureTime = now;
+
+  if (fromInterrupt) {
+    interruptSeen = true;
+  } else if (word != rawInputs && !firstUpdate && !pollFallback && !interruptSeen) {
+    // The resync found a change the interrupt never reported
+    DEBUG_PRINTLN("[GPIO] No change interrupt seen - polling the expander");
+    pollFallback = true;
+  }
+
+  if (word != rawInputs) {
+    rawInputs = word;
+    rawChangeTime = now;
+  }
+}
+
+void GPIOControls::debounceInputs(unsigned long now) {
+  inputsChanged = false;
+
+  // Contact bounce re-triggers the interrupt; accept the word once it has
+  // settled (the first read is taken as is)
+  if (rawInputs != inputs && (firstUpdate || now - rawChangeTime > DEBOUNCE_MS)) {
+    inputs = rawInputs;
+    inputsChanged = true;
+  }
+}
+
+void GPIOControls::processControls() {
   // Always update button state first
   updateButton();
 
   // Check for button actions (page navigation)
   if (displayManager) {
     if (wasDoubleClicked()) {
-      // Double-click = previous page
-      displayManager->previousPage();
+      // Double-click = next preset on the Presets page, record/overdub cycle
+      // on the Looper page, previous page elsewhere
+      if (displayManager->getCurrentPageName() == "Presets") {
+        theremin->getPresetManager()->recallNext();
+      } else if (displayManager->getCurrentPageName() == "Looper") {
+        theremin->getAudioEngine()->getLooper()->record();
+        theremin->getAudioEngine()->getStateTracker()->mark(StateTracker::LOOPER);
+      } else {
+        displayManager->previousPage();
+      }
     } else if (wasShortPressed()) {
       // Single click = next page
       displayManager->nextPage();
@@ -126,6 +217,11 @@ void GPIOControls::update() {
   // Update tracking variable for next iteration
   modifierWasActive = modifierActive;
 
+  // Switch handling only when the debounced inputs changed
+  if (!firstUpdate && !inputsChanged) {
+    return;
+  }
+
   // Branch based on modifier button state
   if (isModifierActive()) {
     // Modifier held: switches control secondary functions (effects, smoothing, etc.)
@@ -154,8 +250,6 @@ void GPIOControls::update() {
 void GPIOControls::updateOscillator(int oscNum, OscillatorState& state,
                                     uint8_t pinA, uint8_t pinB, uint8_t pinC,
                                     uint8_t pinUp, uint8_t pinDown) {
-  unsigned long now = millis();
-
   // Read current switch positions
   Oscillator::Waveform currentWaveform = readWaveform(pinA, pinB, pinC);
   int8_t currentOctave = readOctave(pinUp, pinDown);
@@ -183,95 +277,89 @@ void GPIOControls::updateOscillator(int oscNum, OscillatorState& state,
 
   // Check for waveform change FROM SNAPSHOT (force update on first call)
   if (firstUpdate || currentWaveform != *snapshotWaveform) {
-    if (firstUpdate || (now - state.lastChangeTime > DEBOUNCE_MS)) {
-      // Update snapshot
-      *snapshotWaveform = currentWaveform;
-      state.waveform = currentWaveform;
-      state.lastChangeTime = now;
-
-      theremin->getAudioEngine()->setOscillatorWaveform(oscNum, currentWaveform);
-
-      // Convert waveform to short name
-      const char* waveformName;
-      switch (currentWaveform) {
-        case Oscillator::OFF:
-          waveformName = "OFF";
-          break;
-        case Oscillator::SINE:
-          waveformName = "SIN";
-          break;
-        case Oscillator::SQUARE:
-          waveformName = "SQR";
-          break;
-        case Oscillator::TRIANGLE:
-          waveformName = "TRI";
-          break;
-        case Oscillator::SAW:
-          waveformName = "SAW";
-          break;
-        default:
-          waveformName = "???";
-          break;
-      }
+    // Update snapshot
+    *snapshotWaveform = currentWaveform;
+    state.waveform = currentWaveform;
+
+    theremin->getAudioEngine()->setOscillatorWaveform(oscNum, currentWaveform);
+
+    // Convert waveform to short name
+    const char* waveformName;
+    switch (currentWaveform) {
+      case Oscillator::OFF:
+        waveformName = "OFF";
+        break;
+      case Oscillator::SINE:
+        waveformName = "SIN";
+        break;
+      case Oscillator::SQUARE:
+        waveformName = "SQR";
+        break;
+      case Oscillator::TRIANGLE:
+        waveformName = "TRI";
+        break;
+      case Oscillator::SAW:
+        waveformName = "SAW";
+        break;
+      default:
+        waveformName = "???";
+        break;
+    }
 
-      // Format: "OSC1:SIN"
-      String message = "OSC" + String(oscNum) + ":" + String(waveformName);
-      showNotification(message);
+    // Format: "OSC1:SIN"
+    String message = "OSC" + String(oscNum) + ":" + String(waveformName);
+    showNotification(message);
 
-      DEBUG_PRINT("[GPIO] OSC");
-      DEBUG_PRINT(oscNum);
-      DEBUG_PRINT(" waveform: ");
-      DEBUG_PRINTLN(getWaveformName(currentWaveform));
-    }
+    DEBUG_PRINT("[GPIO] OSC");
+    DEBUG_PRINT(oscNum);
+    DEBUG_PRINT(" waveform: ");
+    DEBUG_PRINTLN(getWaveformName(currentWaveform));
   }
 
   // Check for octave change FROM SNAPSHOT
   if (firstUpdate || currentOctave != *snapshotOctave) {
-    if (firstUpdate || (now - state.lastChangeTime > DEBOUNCE_MS)) {
-      // Update snapshot
-      *snapshotOctave = currentOctave;
-      state.octave = currentOctave;
-      state.lastChangeTime = now;
-
-      theremin->getAudioEngine()->setOscillatorOctave(oscNum, currentOctave);
-
-      // Convert octave to short name
-      const char* octaveString;
-      switch (currentOctave) {
-        case 0:
-          octaveString = "0";
-          break;
-        case -1:
-          octaveString = "-1";
-          break;
-        case +1:
-          octaveString = "+1";
-          break;
-        default:
-          octaveString = "???";
-          break;
-      }
+    // Update snapshot
+    *snapshotOctave = currentOctave;
+    state.octave = currentOctave;
+
+    theremin->getAudioEngine()->setOscillatorOctave(oscNum, currentOctave);
+
+    // Convert octave to short name
+    const char* octaveString;
+    switch (currentOctave) {
+      case 0:
+        octaveString = "0";
+        break;
+      case -1:
+        octaveString = "-1";
+        break;
+      case +1:
+        octaveString = "+1";
+        break;
+      default:
+        octaveString = "???";
+        break;
+    }
 
-      // Format: "OSC1:+1"
-      String message = "OSC" + String(oscNum) + ":" + String(octaveString);
-      showNotification(message);
+    // Format: "OSC1:+1"
+    String message = "OSC" + String(oscNum) + ":" + String(octaveString);
+    showNotification(message);
 
-      DEBUG_PRINT("[GPIO] OSC");
-      DEBUG_PRINT(oscNum);
-      DEBUG_PRINT(" octave: ");
-      if (currentOctave > 0) {
-        DEBUG_PRINT("+");
-      }
-      DEBUG_PRINTLN(currentOctave);
+    DEBUG_PRINT("[GPIO] OSC");
+    DEBUG_PRINT(oscNum);
+    DEBUG_PRINT(" octave: ");
+    if (currentOctave > 0) {
+      DEBUG_PRINT("+");
     }
+    DEBUG_PRINTLN(currentOctave);
   }
 }
 
 Oscillator::Waveform GPIOControls::readWaveform(uint8_t pinA, uint8_t pinB, uint8_t pinC) {
-  // Read pins (active LOW with pullup)
-  bool sineActive = (mcp.digitalRead(pinA) == LOW);
-  bool triActive = (mcp.digitalRead(pinB) == LOW);
-  bool squareActive = (mcp.digitalRead(pinC) == LOW);
+  // Pins are active LOW with pullup
+  bool sineActive = isPinActive(pinA);
+  bool triActive = isPinActive(pinB);
+  bool squareActive = isPinActive(pinC);
 
   // If all HIGH (none active) → OFF
   if (!sineActive && !triActive && !squareActive) {
@@ -294,9 +382,9 @@ Oscillator::Waveform GPIOControls::readWaveform(uint8_t pinA, uint8_t pinB, uint
 }
 
 int8_t GPIOControls::readOctave(uint8_t pinUp, uint8_t pinDown) {
-  // Read pins (active LOW with pullup)
-  bool upActive = (mcp.digitalRead(pinUp) == LOW);
-  bool downActive = (mcp.digitalRead(pinDown) == LOW);
+  // Pins are active LOW with pullup
+  bool upActive = isPinActive(pinUp);
+  bool downActive = isPinActive(pinDown);
 
   // Both LOW → center position (0)
   if (upActive && downActive) {
@@ -340,8 +428,8 @@ const char* GPIOControls::getWaveformName(Oscillator::Waveform wf) {
 }
 
 void GPIOControls::updateButton() {
-  // Read button state (active LOW with pullup on MCP23017 pin 8)
-  bool buttonPressed = (mcp.digitalRead(PIN_MULTI_BUTTON) == LOW);
+  // Button state (active LOW with pullup on MCP23017 pin 8)
+  bool buttonPressed = isPinActive(PIN_MULTI_BUTTON);
   unsigned long now = millis();
 
   // Check for double-click timeout while waiting for second click
@@ -407,8 +495,9 @@ void GPIOControls::updateButton() {
       }
       else if (!modifierWasUsed && (now - buttonPressTime >= VERY_LONG_PRESS_THRESHOLD_MS)) {
         // VERY long press - trigger system reboot (only if modifier wasn't actually used)
-        performSystemReboot();
+        // Done by update() once the bus is released
         // Note: ESP.restart() never returns, so no state change needed
+        rebootRequested = true;
       }
       // While held, stay in this state
       break;
@@ -447,334 +536,312 @@ void GPIOControls::updateSecondaryControls() {
 
 // OSC1 Pitch secondary control: Smoothing Presets
 void GPIOControls::osc1PitchSecondaryControl() {
-  unsigned long now = millis();
-
   // OSC1 Octave Switch → Smoothing Preset Control
   // Read OSC1 octave switch position (-1, 0, +1)
   int8_t octaveValue = readOctave(PIN_OSC1_OCT_UP, PIN_OSC1_OCT_DOWN);
 
-  // Track last state for debouncing (static local variables)
-  static unsigned long lastSmoothingChangeTime = 0;
-
   // Check if smoothing preset changed FROM SNAPSHOT (not from last applied)
   if (octaveValue != snapshotSmoothingPreset) {
-    if (now - lastSmoothingChangeTime > DEBOUNCE_MS) {
-      // Update snapshot to new position
-      snapshotSmoothingPreset = octaveValue;
-      lastSmoothingChangeTime = now;
-      modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
-
-      // Map octave position to smoothing preset
-      // -1 (down) → SMOOTH_NONE (0)
-      //  0 (center) → SMOOTH_NORMAL (1)
-      // +1 (up) → SMOOTH_EXTRA (2)
-      Theremin::SmoothingPreset preset = static_cast<Theremin::SmoothingPreset>(octaveValue + 1);
-
-      // Apply to both pitch and volume
-      theremin->setPitchSmoothingPreset(preset);
-      theremin->setVolumeSmoothingPreset(preset);
-
-      // Debug output
-      const char* presetName;
-      switch (preset) {
-        case Theremin::SMOOTH_NONE:
-          presetName = "NONE (instant response)";
-          showNotification("SMT:OFF");
-          break;
-        case Theremin::SMOOTH_NORMAL:
-          presetName = "NORMAL (balanced)";
-          showNotification("SMT:NRM");
-          break;
-        case Theremin::SMOOTH_EXTRA:
-          presetName = "EXTRA (maximum smoothness)";
-          showNotification("SMT:MAX");
-          break;
-        default:
-          presetName = "UNKNOWN";
-          showNotification("SMT:???");
-          break;
-      }
-
-      DEBUG_PRINT("[GPIO] Smoothing preset changed: ");
-      DEBUG_PRINTLN(presetName);
+    // Update snapshot to new position
+    snapshotSmoothingPreset = octaveValue;
+    modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
+
+    // Map octave position to smoothing preset
+    // -1 (down) → SMOOTH_NONE (0)
+    //  0 (center) → SMOOTH_NORMAL (1)
+    // +1 (up) → SMOOTH_EXTRA (2)
+    Theremin::SmoothingPreset preset = static_cast<Theremin::SmoothingPreset>(octaveValue + 1);
+
+    // Apply to both pitch and volume
+    theremin->setPitchSmoothingPreset(preset);
+    theremin->setVolumeSmoothingPreset(preset);
+
+    // Debug output
+    const char* presetName;
+    switch (preset) {
+      case Theremin::SMOOTH_NONE:
+        presetName = "NONE (instant response)";
+        showNotification("SMT:OFF");
+        break;
+      case Theremin::SMOOTH_NORMAL:
+        presetName = "NORMAL (balanced)";
+        showNotification("SMT:NRM");
+        break;
+      case Theremin::SMOOTH_EXTRA:
+        presetName = "EXTRA (maximum smoothness)";
+        showNotification("SMT:MAX");
+        break;
+      default:
+        presetName = "UNKNOWN";
+        showNotification("SMT:???");
+        break;
     }
+
+    DEBUG_PRINT("[GPIO] Smoothing preset changed: ");
+    DEBUG_PRINTLN(presetName);
   }
 }
 
 // OSC2 Pitch secondary control: Frequency Range Presets
 void GPIOControls::osc2PitchSecondaryControl() {
-  unsigned long now = millis();
-
   // OSC2 Octave Switch → Frequency Range Presets
   int8_t octaveValue = readOctave(PIN_OSC2_OCT_UP, PIN_OSC2_OCT_DOWN);
 
-  // Track last state for debouncing
-  static unsigned long lastRangeChangeTime = 0;
-
   if (octaveValue != snapshotFreqRangePreset) {
-    if (now - lastRangeChangeTime > DEBOUNCE_MS) {
-      snapshotFreqRangePreset = octaveValue;
-      lastRangeChangeTime = now;
-      modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
-
-      // Map octave position to frequency range preset
-      // -1 (down) → NARROW (1 octave)
-      //  0 (center) → NORMAL (2 octaves)
-      // +1 (up) → WIDE (3 octaves)
-      Theremin::FrequencyRangePreset preset = static_cast<Theremin::FrequencyRangePreset>(octaveValue + 1);
-
-      theremin->setFrequencyRangePreset(preset);
-
-      // Debug output
-      const char* presetName;
-      switch (preset) {
-        case Theremin::RANGE_NARROW:
-          presetName = "NARROW (1 octave, 250mm)";
-          showNotification("RNG:NRW");
-          break;
-        case Theremin::RANGE_NORMAL:
-          presetName = "NORMAL (2 octaves, 350mm)";
-          showNotification("RNG:NRM");
-          break;
-        case Theremin::RANGE_WIDE:
-          presetName = "WIDE (3 octaves, 450mm)";
-          showNotification("RNG:EXT");
-          break;
-        default:
-          presetName = "UNKNOWN";
-          showNotification("RNG:???");
-          break;
-      }
-
-      DEBUG_PRINT("[GPIO] Frequency range changed: ");
-      DEBUG_PRINTLN(presetName);
+    snapshotFreqRangePreset = octaveValue;
+    modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
+
+    // Map octave position to frequency range preset
+    // -1 (down) → NARROW (1 octave)
+    //  0 (center) → NORMAL (2 octaves)
+    // +1 (up) → WIDE (3 octaves)
+    Theremin::FrequencyRangePreset preset = static_cast<Theremin::FrequencyRangePreset>(octaveValue + 1);
+
+    theremin->setFrequencyRangePreset(preset);
+
+    // Debug output
+    const char* presetName;
+    switch (preset) {
+      case Theremin::RANGE_NARROW:
+        presetName = "NARROW (1 octave, 250mm)";
+        showNotification("RNG:NRW");
+        break;
+      case Theremin::RANGE_NORMAL:
+        presetName = "NORMAL (2 octaves, 350mm)";
+        showNotification("RNG:NRM");
+        break;
+      case Theremin::RANGE_WIDE:
+        presetName = "WIDE (3 octaves, 450mm)";
+        showNotification("RNG:EXT");
+        break;
+      default:
+        presetName = "UNKNOWN";
+        showNotification("RNG:???");
+        break;
     }
+
+    DEBUG_PRINT("[GPIO] Frequency range changed: ");
+    DEBUG_PRINTLN(presetName);
   }
 }
 
 // OSC3 Pitch secondary control: Oscillator Mix Presets
 void GPIOControls::osc3PitchSecondaryControl() {
-  unsigned long now = millis();
-
   // OSC3 Octave Switch → Oscillator Mix Presets
   int8_t octaveValue = readOctave(PIN_OSC3_OCT_UP, PIN_OSC3_OCT_DOWN);
 
-  // Track last state for debouncing
-  static unsigned long lastMixChangeTime = 0;
-
   if (octaveValue != snapshotMixPreset) {
-    if (now - lastMixChangeTime > DEBOUNCE_MS) {
-      snapshotMixPreset = octaveValue;
-      lastMixChangeTime = now;
-      modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
-
-      // Map octave position to oscillator mix preset
-      const char* presetName;
-      switch (octaveValue) {
-        case -1:  // Down position - Equal mix (thickest)
-          theremin->getAudioEngine()->setOscillatorVolume(1, 1.0f);
-          theremin->getAudioEngine()->setOscillatorVolume(2, 1.0f);
-          theremin->getAudioEngine()->setOscillatorVolume(3, 1.0f);
-          presetName = "EQUAL (1.0, 1.0, 1.0)";
-          showNotification("MIX:EQ");
-          break;
-
-        case 0:   // Center - Primary focus (balanced)
-          theremin->getAudioEngine()->setOscillatorVolume(1, 1.0f);
-          theremin->getAudioEngine()->setOscillatorVolume(2, 0.7f);
-          theremin->getAudioEngine()->setOscillatorVolume(3, 0.5f);
-          presetName = "PRIMARY (1.0, 0.7, 0.5)";
-          showNotification("MIX:BAL");
-          break;
-
-        case +1:  // Up position - Gradient (focused)
-          theremin->getAudioEngine()->setOscillatorVolume(1, 1.0f);
-          theremin->getAudioEngine()->setOscillatorVolume(2, 0.5f);
-          theremin->getAudioEngine()->setOscillatorVolume(3, 0.3f);
-          presetName = "GRADIENT (1.0, 0.6, 0.3)";
-          showNotification("MIX:WID");
-          break;
-
-        default:
-          presetName = "UNKNOWN";
-          showNotification("MIX:???");
-          break;
-      }
-
-      DEBUG_PRINT("[GPIO] Oscillator mix: ");
-      DEBUG_PRINTLN(presetName);
+    snapshotMixPreset = octaveValue;
+    modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
+
+    // Map octave position to oscillator mix preset
+    const char* presetName;
+    switch (octaveValue) {
+      case -1:  // Down position - Equal mix (thickest)
+        theremin->getAudioEngine()->setOscillatorVolume(1, 1.0f);
+        theremin->getAudioEngine()->setOscillatorVolume(2, 1.0f);
+        theremin->getAudioEngine()->setOscillatorVolume(3, 1.0f);
+        presetName = "EQUAL (1.0, 1.0, 1.0)";
+        showNotification("MIX:EQ");
+        break;
+
+      case 0:   // Center - Primary focus (balanced)
+        theremin->getAudioEngine()->setOscillatorVolume(1, 1.0f);
+        theremin->getAudioEngine()->setOscillatorVolume(2, 0.7f);
+        theremin->getAudioEngine()->setOscillatorVolume(3, 0.5f);
+        presetName = "PRIMARY (1.0, 0.7, 0.5)";
+        showNotification("MIX:BAL");
+        break;
+
+      case +1:  // Up position - Gradient (focused)
+        theremin->getAudioEngine()->setOscillatorVolume(1, 1.0f);
+        theremin->getAudioEngine()->setOscillatorVolume(2, 0.5f);
+        theremin->getAudioEngine()->setOscillatorVolume(3, 0.3f);
+        presetName = "GRADIENT (1.0, 0.6, 0.3)";
+        showNotification("MIX:WID");
+        break;
+
+      default:
+        presetName = "UNKNOWN";
+        showNotification("MIX:???");
+        break;
     }
+
+    recordOscillatorMix();
+    DEBUG_PRINT("[GPIO] Oscillator mix: ");
+    DEBUG_PRINTLN(presetName);
   }
 }
 
 // Oscillator 1 waveform secondary control: Reverb effect presets
 void GPIOControls::osc1WaveformSecondaryControl() {
-  unsigned long now = millis();
   Oscillator::Waveform waveformValue = readWaveform(PIN_OSC1_WAVE_A, PIN_OSC1_WAVE_B, PIN_OSC1_WAVE_C);
 
-  // Track last state for debouncing (static local variables)
-  static unsigned long lastOsc1ChangeTime = 0;
-
   // Check if preset changed FROM SNAPSHOT
   if (waveformValue != snapshotReverbPreset) {
-    if (now - lastOsc1ChangeTime > DEBOUNCE_MS) {
-      snapshotReverbPreset = waveformValue;
-      lastOsc1ChangeTime = now;
-      modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
-
-      ReverbEffect::Preset preset;
-      const char* presetName;
-      // We use a switch to map since enums are not ordered like we want for
-      // the presets, the physical switch shows sine as first, than square and
-      // than triangle. Saw is not used in the physiical switch.
-      switch (waveformValue) {
-        case Oscillator::Waveform::OFF:
-          preset = ReverbEffect::REVERB_OFF;
-          presetName = "OFF";
-          showNotification("REV:OFF");
-          break;
-        case Oscillator::Waveform::SINE:
-          preset = ReverbEffect::REVERB_SMALL;
-          presetName = "SMALL";
-          showNotification("REV:SML");
-          break;
-        case Oscillator::Waveform::SQUARE:
-          preset = ReverbEffect::REVERB_NORMAL;
-          presetName = "NORMAL";
-          showNotification("REV:NRM");
-          break;
-        case Oscillator::Waveform::TRIANGLE:
-          preset = ReverbEffect::REVERB_MAX;
-          presetName = "MAX";
-          showNotification("REV:MAX");
-          break;
-        default:
-          preset = ReverbEffect::REVERB_OFF;
-          presetName = "UNKNOWN";
-          showNotification("REV:???");
-          break;  // Safe fallback
-      }
+    snapshotReverbPreset = waveformValue;
+    modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
+
+    ReverbEffect::Preset preset;
+    const char* presetName;
+    // We use a switch to map since enums are not ordered like we want for
+    // the presets, the physical switch shows sine as first, than square and
+    // than triangle. Saw is not used in the physiical switch.
+    switch (waveformValue) {
+      case Oscillator::Waveform::OFF:
+        preset = ReverbEffect::REVERB_OFF;
+        presetName = "OFF";
+        showNotification("REV:OFF");
+        break;
+      case Oscillator::Waveform::SINE:
+        preset = ReverbEffect::REVERB_SMALL;
+        presetName = "SMALL";
+        showNotification("REV:SML");
+        break;
+      case Oscillator::Waveform::SQUARE:
+        preset = ReverbEffect::REVERB_NORMAL;
+        presetName = "NORMAL";
+        showNotification("REV:NRM");
+        break;
+      case Oscillator::Waveform::TRIANGLE:
+        preset = ReverbEffect::REVERB_MAX;
+        presetName = "MAX";
+        showNotification("REV:MAX");
+        break;
+      default:
+        preset = ReverbEffect::REVERB_OFF;
+        presetName = "UNKNOWN";
+        showNotification("REV:???");
+        break;  // Safe fallback
+    }
 
-      // Apply preset
-      theremin->getAudioEngine()->getEffectsChain()->getReverb()->setPreset(preset);
+    // Apply preset
+    EffectsChain* chain = theremin->getAudioEngine()->getEffectsChain();
+    chain->getReverb()->setPreset(preset);
+    chain->notifyEffectChanged(chain->getReverb());
+    recordEffect(chain->getReverb());
 
-      DEBUG_PRINT("[GPIO] Reverb preset changed: ");
-      DEBUG_PRINTLN(presetName);
-    }
+    DEBUG_PRINT("[GPIO] Reverb preset changed: ");
+    DEBUG_PRINTLN(presetName);
   }
 }
 
 // Oscillator 2 waveform secondary control: Delay effect presets
 void GPIOControls::osc2WaveformSecondaryControl() {
-  unsigned long now = millis();
   Oscillator::Waveform waveformValue = readWaveform(PIN_OSC2_WAVE_A, PIN_OSC2_WAVE_B, PIN_OSC2_WAVE_C);
 
-  // Track last state for debouncing (static local variables)
-  static unsigned long lastOsc2ChangeTime = 0;
-
   // Check if preset changed FROM SNAPSHOT
   if (waveformValue != snapshotDelayPreset) {
-    if (now - lastOsc2ChangeTime > DEBOUNCE_MS) {
-      snapshotDelayPreset = waveformValue;
-      lastOsc2ChangeTime = now;
-      modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
-
-      DelayEffect::Preset preset;
-      const char* presetName;
-      // We use a switch to map since enums are not ordered like we want for
-      // the presets, the physical switch shows sine as first, than square and
-      // than triangle. Saw is not used in the physiical switch.
-      switch (waveformValue) {
-        case Oscillator::Waveform::OFF:
-          preset = DelayEffect::DELAY_OFF;
-          presetName = "OFF";
-          showNotification("DLY:OFF");
-          break;
-        case Oscillator::Waveform::SINE:
-          preset = DelayEffect::DELAY_SHORT;
-          presetName = "SMALL";
-          showNotification("DLY:SML");
-          break;
-        case Oscillator::Waveform::SQUARE:
-          preset = DelayEffect::DELAY_MEDIUM;
-          presetName = "NORMAL";
-          showNotification("DLY:NRM");
-          break;
-        case Oscillator::Waveform::TRIANGLE:
-          preset = DelayEffect::DELAY_LONG;
-          presetName = "MAX";
-          showNotification("DLY:MAX");
-          break;
-        default:
-          preset = DelayEffect::DELAY_OFF;
-          presetName = "UNKNOWN";
-          showNotification("DLY:???");
-          break;  // Safe fallback
-      }
+    snapshotDelayPreset = waveformValue;
+    modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
+
+    DelayEffect::Preset preset;
+    const char* presetName;
+    // We use a switch to map since enums are not ordered like we want for
+    // the presets, the physical switch shows sine as first, than square and
+    // than triangle. Saw is not used in the physiical switch.
+    switch (waveformValue) {
+      case Oscillator::Waveform::OFF:
+        preset = DelayEffect::DELAY_OFF;
+        presetName = "OFF";
+        showNotification("DLY:OFF");
+        break;
+      case Oscillator::Waveform::SINE:
+        preset = DelayEffect::DELAY_SHORT;
+        presetName = "SMALL";
+        showNotification("DLY:SML");
+        break;
+      case Oscillator::Waveform::SQUARE:
+        preset = DelayEffect::DELAY_MEDIUM;
+        presetName = "NORMAL";
+        showNotification("DLY:NRM");
+        break;
+      case Oscillator::Waveform::TRIANGLE:
+        preset = DelayEffect::DELAY_LONG;
+        presetName = "MAX";
+        showNotification("DLY:MAX");
+        break;
+      default:
+        preset = DelayEffect::DELAY_OFF;
+        presetName = "UNKNOWN";
+        showNotification("DLY:???");
+        break;  // Safe fallback
+    }
 
-      // Apply preset
-      theremin->getAudioEngine()->getEffectsChain()->getDelay()->setPreset(preset);
+    // Apply preset
+    EffectsChain* chain = theremin->getAudioEngine()->getEffectsChain();
+    chain->getDelay()->setPreset(preset);
+    chain->notifyEffectChanged(chain->getDelay());
+    recordEffect(chain->getDelay());
 
-      DEBUG_PRINT("[GPIO] Delay preset changed: ");
-      DEBUG_PRINTLN(presetName);
-    }
+    DEBUG_PRINT("[GPIO] Delay preset changed: ");
+    DEBUG_PRINTLN(presetName);
   }
 }
 
 // Oscillator 3 waveform secondary control: Chorus effect presets
 void GPIOControls::osc3WaveformSecondaryControl() {
-  unsigned long now = millis();
   Oscillator::Waveform waveformValue = readWaveform(PIN_OSC3_WAVE_A, PIN_OSC3_WAVE_B, PIN_OS3_WAVE_C);
 
-  // Track last state for debouncing (static local variables)
-  static unsigned long lastOsc3ChangeTime = 0;
-
   // Check if preset changed FROM SNAPSHOT
   if (waveformValue != snapshotChorusPreset) {
-    if (now - lastOsc3ChangeTime > DEBOUNCE_MS) {
-      snapshotChorusPreset = waveformValue;
-      lastOsc3ChangeTime = now;
-      modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
-
-      ChorusEffect::Preset preset;
-      const char* presetName;
-      // We use a switch to map since enums are not ordered like we want for
-      // the presets, the physical switch shows sine as first, than square and
-      // than triangle. Saw is not used in the physiical switch.
-      switch (waveformValue) {
-        case Oscillator::Waveform::OFF:
-          preset = ChorusEffect::CHORUS_OFF;
-          presetName = "OFF";
-          showNotification("CHR:OFF");
-          break;
-        case Oscillator::Waveform::SINE:
-          preset = ChorusEffect::CHORUS_MIN;
-          presetName = "SMALL";
-          showNotification("CHR:SML");
-          break;
-        case Oscillator::Waveform::SQUARE:
-          preset = ChorusEffect::CHORUS_MEDIUM;
-          presetName = "NORMAL";
-          showNotification("CHR:NRM");
-          break;
-        case Oscillator::Waveform::TRIANGLE:
-          preset = ChorusEffect::CHORUS_MAX;
-          presetName = "MAX";
-          showNotification("CHR:MAX");
-          break;
-        default:
-          preset = ChorusEffect::CHORUS_OFF;
-          presetName = "UNKNOWN";
-          showNotification("CHR:???");
-          break;  // Safe fallback
-      }
+    snapshotChorusPreset = waveformValue;
+    modifierWasUsed = true;  // Mark modifier as used - prevents accidental reboot
+
+    ChorusEffect::Preset preset;
+    const char* presetName;
+    // We use a switch to map since enums are not ordered like we want for
+    // the presets, the physical switch shows sine as first, than square and
+    // than triangle. Saw is not used in the physiical switch.
+    switch (waveformValue) {
+      case Oscillator::Waveform::OFF:
+        preset = ChorusEffect::CHORUS_OFF;
+        presetName = "OFF";
+        showNotification("CHR:OFF");
+        break;
+      case Oscillator::Waveform::SINE:
+        preset = ChorusEffect::CHORUS_MIN;
+        presetName = "SMALL";
+        showNotification("CHR:SML");
+        break;
+      case Oscillator::Waveform::SQUARE:
+        preset = ChorusEffect::CHORUS_MEDIUM;
+        presetName = "NORMAL";
+        showNotification("CHR:NRM");
+        break;
+      case Oscillator::Waveform::TRIANGLE:
+        preset = ChorusEffect::CHORUS_MAX;
+        presetName = "MAX";
+        showNotification("CHR:MAX");
+        break;
+      default:
+        preset = ChorusEffect::CHORUS_OFF;
+        presetName = "UNKNOWN";
+        showNotification("CHR:???");
+        break;  // Safe fallback
+    }
 
-      // Apply preset
-      theremin->getAudioEngine()->getEffectsChain()->getChorus()->setPreset(preset);
+    // Apply preset
+    EffectsChain* chain = theremin->getAudioEngine()->getEffectsChain();
+    chain->getChorus()->setPreset(preset);
+    chain->notifyEffectChanged(chain->getChorus());
+    recordEffect(chain->getChorus());
 
-      DEBUG_PRINT("[GPIO] Chorus preset changed: ");
-      DEBUG_PRINTLN(presetName);
-    }
+    DEBUG_PRINT("[GPIO] Chorus preset changed: ");
+    DEBUG_PRINTLN(presetName);
+  }
+}
+
+void GPIOControls::recordOscillatorMix() {
+  AudioEngine* audio = theremin->getAudioEngine();
+  for (int osc = 1; osc <= 3; osc++) {
+    audio->recordOscillatorVolume(osc, audio->getOscillatorVolume(osc));
+  }
+}
+
+void GPIOControls::recordEffect(const AudioEffect* effect) {
+  for (uint8_t i = 0; i < effect->getParamCount(); i++) {
+    theremin->getAudioEngine()->recordEffectParam(effect, i, effect->getParam(i));
   }
 }
 
@@ -7,6 +7,7 @@
 
 #include "controls/SensorManager.h"
 #include "system/Debug.h"
+#include "system/BootTimeline.h"
 
 // Constructor
 SensorManager::SensorManager()
@@ -22,7 +23,8 @@ SensorManager::SensorManager()
       pitchEnabled(true),
       volumeEnabled(true),
       pitchSmoothingEnabled(true),
-      volumeSmoothingEnabled(true) {
+      volumeSmoothingEnabled(true),
+      bus(nullptr) {
   // Exponential smoothing values initialized to 0, will be set on first reading
   // Cached raw values initialized to 0, will be updated by updateReadings()
   // Sensors enabled by default
@@ -32,7 +34,7 @@ SensorManager::SensorManager()
 
 // Initialize sensors
 bool SensorManager::begin() {
-  // Note: Wire.begin() must be called before this in main.cpp
+  // Note: the bus (I2CBus::begin()) must be started before this in main.cpp
   // since multiple I2C devices share the bus (sensors + MCP23017)
 
   // Configure XSHUT pins
@@ -42,50 +44,80 @@ bool SensorManager::begin() {
   // Disable both sensors initially
   digitalWrite(PIN_SENSOR_PITCH_XSHUT, LOW);
   digitalWrite(PIN_SENSOR_VOLUME_XSHUT, LOW);
+#if ENABLE_FAST_START
+  waitForBootAddress(false);
+#else
   delay(10);
+#endif
 
   // Initialize pitch sensor at custom address to avoid conflict as
   // both sensors default to same I2C address.
-  digitalWrite(PIN_SENSOR_PITCH_XSHUT, HIGH);
-  delay(10);
-  if (!pitchSensor.begin(I2C_ADDR_SENSOR_PITCH)) {
-    DEBUG_PRINTLN("[SENSOR] ERROR: Pitch sensor failed to initialize!");
+  if (!beginSensor(pitchSensor, PIN_SENSOR_PITCH_XSHUT, I2C_ADDR_SENSOR_PITCH, "Pitch")) {
     return false;
   }
-  DEBUG_PRINTLN("[SENSOR] Pitch sensor initialized at 0x30");
-  delay(50);  // Let Serial transmit before continuing
-
-  // Configure high-speed timing budget for reduced latency
-  // Configure high-speed timing budget for reduced latency
-  // 20ms vs 33ms default - reduces reading time by ~13ms per sensor
-  pitchSensor.setMeasurementTimingBudgetMicroSeconds(20000);
-  DEBUG_PRINTLN("[SENSOR] Pitch sensor timing budget set to 20ms");
-  delay(50);  // Let Serial transmit before continuing
 
   // Initialize volume sensor at default address 0x29
-  digitalWrite(PIN_SENSOR_VOLUME_XSHUT, HIGH);
-  delay(10);
-  if (!volumeSensor.begin(I2C_ADDR_SENSOR_VOLUME)) {
-    DEBUG_PRINTLN("[SENSOR] ERROR: Volume sensor failed to initialize!");
+  if (!beginSensor(volumeSensor, PIN_SENSOR_VOLUME_XSHUT, I2C_ADDR_SENSOR_VOLUME, "Volume")) {
     return false;
   }
-  DEBUG_PRINTLN("[SENSOR] Volume sensor initialized at 0x29");
-  delay(50);  // Let Serial transmit before continuing
 
-  // Configure high-speed timing budget for reduced latency
-  volumeSensor.setMeasurementTimingBudgetMicroSeconds(20000);
-  DEBUG_PRINTLN("[SENSOR] Volume sensor timing budget set to 20ms");
-  delay(50);  // Let Serial transmit before continuing
+  return true;
+}
+
+bool SensorManager::beginSensor(Adafruit_VL53L0X& sensor, uint8_t xshutPin, uint8_t address,
+                                const char* name) {
+  digitalWrite(xshutPin, HIGH);
+#if ENABLE_FAST_START
+  if (!waitForBootAddress(true)) {
+    DEBUG_PRINTF("[SENSOR] WARNING: %s sensor not answering after XSHUT\n", name);
+  }
+#else
+  delay(10);
+#endif
+
+  // The driver's init and calibration run as one long bus hold
+  {
+    I2CBus::Lock lock(bus, I2CBus::CLIENT_SENSORS, I2CBus::BOOT_ACQUIRE_TIMEOUT_MS);
+    if (!lock || !sensor.begin(address)) {
+      DEBUG_PRINTF("[SENSOR] ERROR: %s sensor failed to initialize!\n", name);
+      return false;
+    }
+    DEBUG_PRINTF("[SENSOR] %s sensor initialized at 0x%02X\n", name, address);
+    BOOT_DELAY(50);  // Let Serial transmit before continuing
+
+    // Configure high-speed timing budget for reduced latency
+    // 20ms vs 33ms default - reduces reading time by ~13ms per sensor
+    sensor.setMeasurementTimingBudgetMicroSeconds(20000);
+  }
+  DEBUG_PRINTF("[SENSOR] %s sensor timing budget set to 20ms\n", name);
+  BOOT_DELAY(50);  // Let Serial transmit before continuing
 
   return true;
 }
 
+bool SensorManager::waitForBootAddress(bool present) {
+  uint32_t start = millis();
+  do {
+    {
+      // An absent sensor is the expected answer half the time: leave the
+      // result at OK so probing never counts toward bus recovery
+      I2CBus::Lock lock(bus, I2CBus::CLIENT_SENSORS);
+      if (lock && I2CBus::probe(SENSOR_BOOT_ADDR) == present) {
+        return true;
+      }
+    }
+    delayMicroseconds(200);
+  } while (millis() - start < XSHUT_READY_TIMEOUT_MS);
+  return false;
+}
+
 // Update sensor readings - reads both sensors and caches results
 void SensorManager::updateReadings() {
   // Read both sensors sequentially and cache results
   // This ensures each sensor is only read once per update cycle
   cachedPitchRaw = readPitchRaw();
   cachedVolumeRaw = readVolumeRaw();
+  BootTimeline::mark(BootTimeline::FIRST_SENSOR_SAMPLE);
 }
 
 // Get smoothed pitch distance (uses cached raw value)
@@ -129,14 +161,31 @@ int SensorManager::applyExponentialSmoothing(float& smoothedValue, int newReadin
   return (int)smoothedValue;
 }
 
+// VL53L0X API status to bus result (only bus-level failures count as errors)
+static I2CBus::Result toBusResult(VL53L0X_Error status) {
+  if (status == VL53L0X_ERROR_NONE) {
+    return I2CBus::RESULT_OK;
+  }
+  return (status == VL53L0X_ERROR_TIME_OUT) ? I2CBus::RESULT_TIMEOUT : I2CBus::RESULT_ERROR;
+}
+
 int SensorManager::readPitchRaw() {
-  pitchSensor.rangingTest(&pitchMeasure, false);
+  // The whole ranging call holds the bus (the driver polls for completion)
+  I2CBus::Lock lock(bus, I2CBus::CLIENT_SENSORS);
+  if (!lock) {
+    return cachedPitchRaw;  // Bus unavailable: keep the last reading
+  }
+  lock.setResult(toBusResult(pitchSensor.rangingTest(&pitchMeasure, false)));
   // Return measured distance, or max distance if out of range
   return (pitchMeasure.RangeStatus != 4) ? pitchMeasure.RangeMilliMeter : pitchMaxDist;
 }
 
 int SensorManager::readVolumeRaw() {
-  volumeSensor.rangingTest(&volumeMeasure, false);
+  I2CBus::Lock lock(bus, I2CBus::CLIENT_SENSORS);
+  if (!lock) {
+    return cachedVolumeRaw;
+  }
+  lock.setResult(toBusResult(volumeSensor.rangingTest(&volumeMeasure, false)));
   // Return measured distance, or min distance (silent) if out of range
   return (volumeMeasure.RangeStatus != 4) ? volumeMeasure.RangeMilliMeter : VOLUME_MIN_DIST;
 }
@@ -14,6 +14,8 @@
 #include "system/PinConfig.h"
 #include "system/PerformanceMonitor.h"
 #include "system/DisplayManager.h"
+#include "system/I2CBus.h"
+#include "system/BootTimeline.h"
 
 #if ENABLE_NETWORK
 #include "system/NetworkManager.h"
@@ -26,6 +28,9 @@
 // Main loop timing
 static const int UPDATE_INTERVAL_MS = 5; // ms update interval in the main loop
 
+// Shared I2C bus (sensors, MCP23017, display) - arbitrates and counts traffic
+I2CBus i2cBus;
+
 // Create display manager instance (must be created before others)
 DisplayManager display;
 
@@ -50,38 +55,51 @@ GPIOMonitor gpioMonitor(PIN_SWITCH_EXPANDER_ADDR);
 #endif
 
 void setup() {
-  // Initialize debug output
-  Serial.begin(115200);
-  delay(500);  // Increased delay to let Serial stabilize
+  BootTimeline::mark(BootTimeline::SETUP_START);
 
-  // Clear startup banner to separate from bootloader output
-  DEBUG_PRINTLN("\n\n========================================");
-  DEBUG_PRINTLN("   ESP32 Theremin Starting...");
-  DEBUG_PRINTLN("========================================\n");
-  DEBUG_FLUSH();  // Ensure banner is sent before continuing
-  delay(100);
+  // Initialize debug output
+  {
+    BootTimeline::Phase phase("serial");
+    Serial.begin(115200);
+    BOOT_DELAY(500);  // Increased delay to let Serial stabilize
+
+    // Clear startup banner to separate from bootloader output
+    DEBUG_PRINTLN("\n\n========================================");
+    DEBUG_PRINTLN("   ESP32 Theremin Starting...");
+    DEBUG_PRINTLN("========================================\n");
+    DEBUG_FLUSH();  // Ensure banner is sent before continuing
+    BOOT_DELAY(100);
+  }
 
   // Initialize I2C bus (shared by sensors, MCP23017, and display)
-  Wire.begin(PIN_SENSOR_I2C_SDA, PIN_SENSOR_I2C_SCL);
-
-  // Lower clock and timeout to try and fight i2c interferences for frozen sensors wheny touchng gnd (i.e. inserting a jack)
-  Wire.setClock(100000);
-  Wire.setTimeOut(1000);
-
-  DEBUG_PRINTLN("[I2C] Bus initialized on SDA=21, SCL=22");
-  delay(50);
-
-  // Initialize display
-  if (display.begin()) {
-    DEBUG_PRINTLN("[Display] SSD1306 initialized successfully");
-  } else {
-    DEBUG_PRINTLN("[Display] WARNING: Failed to initialize");
-    DEBUG_PRINTLN("[Display] Check wiring and I2C address (0x3C or 0x3D)");
+  // Clock from I2C_CLOCK_HZ (platformio.ini); bus errors such as frozen
+  // sensors when touching gnd (i.e. inserting a jack) are recovered by I2CBus
+  {
+    BootTimeline::Phase phase("i2c");
+    i2cBus.begin(PIN_SENSOR_I2C_SDA, PIN_SENSOR_I2C_SCL);
+    display.setBus(&i2cBus);
+    theremin.setI2CBus(&i2cBus);
+    BOOT_DELAY(50);
   }
-  delay(100);
 
-  // Display a loading screen during boot.
-  display.showLoadingScreen();
+  // Initialize display and show a loading screen during boot.
+  #if ENABLE_FAST_START
+    // On a helper task, next to the audio and sensor init below
+    display.beginAsync();
+  #else
+    {
+      BootTimeline::Phase phase("display");
+      if (display.begin()) {
+        DEBUG_PRINTLN("[Display] SSD1306 initialized successfully");
+      } else {
+        DEBUG_PRINTLN("[Display] WARNING: Failed to initialize");
+        DEBUG_PRINTLN("[Display] Check wiring and I2C address (0x3C or 0x3D)");
+      }
+      delay(100);
+
+      display.showLoadingScreen();
+    }
+  #endif
 
   #if ENABLE_GPIO_MONITOR
     // Initialize GPIO monitor for MCP23017 debugging
@@ -93,11 +111,25 @@ void setup() {
       DEBUG_PRINTLN("[GPIO] WARNING: Monitor failed to initialize");
       DEBUG_PRINTLN("[GPIO] Check MCP23017 wiring and I2C address (0x20)");
     }
-    delay(100);
+    BOOT_DELAY(100);
   #endif
 
   // Initialize theremin (sensors + audio)
-  if (!theremin.begin()) {
+  bool thereminReady;
+  {
+    BootTimeline::Phase phase("theremin");
+    thereminReady = theremin.begin();
+  }
+
+  #if ENABLE_FAST_START
+    // The display belongs to the loop from here on
+    if (!display.waitForBegin()) {
+      DEBUG_PRINTLN("[Display] WARNING: Failed to initialize");
+      DEBUG_PRINTLN("[Display] Check wiring and I2C address (0x3C or 0x3D)");
+    }
+  #endif
+
+  if (!thereminReady) {
     DEBUG_PRINTLN("\n[FATAL] Theremin initialization failed!");
     DEBUG_PRINTLN("System halted.");
     while (1) {
@@ -107,11 +139,14 @@ void setup() {
 
   DEBUG_PRINTLN("=== Ready to Play! ===\n");
   DEBUG_FLUSH();  // Ensure initialization messages are sent
-  delay(100);
+  BOOT_DELAY(100);
 
   // Initialize performance monitoring and register display page
-  performanceMonitor.setDisplay(&display);
-  performanceMonitor.begin();
+  {
+    BootTimeline::Phase phase("perfmon");
+    performanceMonitor.setDisplay(&display);
+    performanceMonitor.begin();
+  }
 
   // Run system test (if enabled)
   #if ENABLE_STARTUP_TEST
@@ -140,6 +175,8 @@ void setup() {
     }
 
     // Start network if not disabled
+    // Non-blocking: WiFi, portal and web server come up on NetTask (Core 0)
+    // while the instrument is already playing
     if (!theremin.getAudioEngine()->getSpecialState(1) || resetWiFi || forceWiFiConfig) {
       DEBUG_PRINTLN("[NETWORK] Enabling network.");
       network.begin("Theremin-Setup", "admin", "theremin", 15, 0, resetWiFi, forceWiFiConfig);
@@ -149,7 +186,12 @@ void setup() {
       // Play startup sound (if enabled)
   #if ENABLE_STARTUP_SOUND
     theremin.getAudioEngine()->playStartupSound();
-    delay(500);
+    BOOT_DELAY(500);
+  #endif
+
+  BootTimeline::mark(BootTimeline::SETUP_DONE);
+  #if !ENABLE_NETWORK
+    BootTimeline::print();
   #endif
 }
 
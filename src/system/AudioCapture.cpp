@@ -0,0 +1,480 @@
+#include "system/AudioCapture.h"
+#include "system/Debug.h"
+#include <LittleFS.h>
+#include <esp_heap_caps.h>
+
+// IMA-ADPCM step sizes and step index adjustments
+static const int16_t ADPCM_STEPS[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767
+};
+static const int8_t ADPCM_INDEX_STEP[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+static const size_t PCM_HEADER_SIZE = 44;    // RIFF + fmt (16) + data
+static const size_t ADPCM_HEADER_SIZE = 60;  // RIFF + fmt (20) + fact + data
+
+// One 4-bit code; predictor and index follow the decoder
+static uint8_t encodeAdpcmSample(int16_t sample, int32_t& predictor, int8_t& index) {
+    int32_t step = ADPCM_STEPS[index];
+    int32_t diff = sample - predictor;
+    uint8_t code = 0;
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+
+    int32_t delta = step >> 3;
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+        delta += step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 2;
+        diff -= step;
+        delta += step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 1;
+        delta += step;
+    }
+
+    predictor = constrain(predictor + ((code & 8) ? -delta : delta), -32768, 32767);
+    index = constrain(index + ADPCM_INDEX_STEP[code], 0, 88);
+    return code;
+}
+
+static void put16(uint8_t* p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+static void put32(uint8_t* p, uint32_t value) {
+    put16(p, value & 0xFFFF);
+    put16(p + 2, value >> 16);
+}
+
+AudioCapture::AudioCapture(StateTracker* tracker)
+    : stateTracker(tracker),
+      taskHandle(nullptr),
+      ring(nullptr),
+      writeCount(0),
+      readCount(0),
+      capturing(false),
+      droppedBlocks(0),
+      request(REQUEST_NONE),
+      pendingSink(SINK_NONE),
+      activeSink(SINK_NONE),
+      format(FORMAT_PCM16),
+      lastError(ERROR_NONE),
+      fileLimit(0),
+      fileBytes(0),
+      writeFill(0),
+      capturedSamples(0),
+      adpcmIndex(0),
+      lastStatus(0),
+      packetsWritten(0),
+      packetsRead(0) {
+    memset(writeBuffer, 0, sizeof(writeBuffer));
+}
+
+AudioCapture::~AudioCapture() {
+    if (taskHandle != nullptr) {
+        vTaskDelete(taskHandle);
+        taskHandle = nullptr;
+    }
+    if (file) {
+        file.close();
+    }
+    if (ring != nullptr) {
+        heap_caps_free(ring);
+        ring = nullptr;
+    }
+}
+
+bool AudioCapture::begin() {
+    // Core 0, priority 1: flash writes and encoding never compete with the audio task
+    BaseType_t result = xTaskCreatePinnedToCore(
+        taskFunction,   // Task function
+        "CaptureTask",  // Task name
+        4096,           // Stack size (bytes) - LittleFS needs some
+        this,           // Parameter (this pointer)
+        1,              // Priority (below WiFi/async_tcp)
+        &taskHandle,    // Task handle
+        0               // Core ID (0 = protocol core)
+    );
+
+    if (result != pdPASS) {
+        DEBUG_PRINTLN("[CAPTURE] Failed to create capture task");
+        taskHandle = nullptr;
+        return false;
+    }
+
+    DEBUG_PRINTLN("[CAPTURE] Capture task started on Core 0");
+    return true;
+}
+
+bool AudioCapture::start(Sink sink, Format fmt) {
+    if (sink == SINK_NONE || activeSink != SINK_NONE || request != REQUEST_NONE || taskHandle == nullptr) {
+        return false;
+    }
+
+    if (ring == nullptr) {
+        const size_t bytes = RING_SAMPLES * sizeof(int16_t);
+        if (psramFound()) {
+            ring = (int16_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        }
+        if (ring == nullptr) {
+            ring = (int16_t*)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        }
+        if (ring == nullptr) {
+            DEBUG_PRINTLN("[CAPTURE] ERROR: No memory for the capture ring");
+            lastError = ERROR_NO_MEMORY;
+            markChanged();
+            return false;
+        }
+    }
+
+    pendingSink = sink;
+    format = fmt;
+    request = REQUEST_START;
+    return true;
+}
+
+void AudioCapture::stop() {
+    request = REQUEST_STOP;
+}
+
+const AudioCapture::StreamPacket* AudioCapture::peekPacket() const {
+    if (activeSink != SINK_STREAM || packetsRead == packetsWritten) {
+        return nullptr;
+    }
+    return &packets[packetsRead % STREAM_SLOTS];
+}
+
+void AudioCapture::releasePacket() {
+    if (packetsRead != packetsWritten) {
+        packetsRead = packetsRead + 1;
+    }
+}
+
+void AudioCapture::taskFunction(void* parameter) {
+    AudioCapture* capture = static_cast<AudioCapture*>(parameter);
+
+    while (true) {
+        uint8_t req = capture->request.exchange(REQUEST_NONE);
+        if (req != REQUEST_NONE) {
+            capture->handleRequest(req);
+        }
+
+        if (capture->activeSink == SINK_NONE) {
+            vTaskDelay(pdMS_TO_TICKS(IDLE_POLL_MS));
+            continue;
+        }
+
+        capture->drain(false);
+
+        // Duration and dropped count for the web UI
+        if (millis() - capture->lastStatus >= STATUS_INTERVAL_MS) {
+            capture->lastStatus = millis();
+            capture->markChanged();
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(DRAIN_INTERVAL_MS));
+    }
+}
+
+void AudioCapture::handleRequest(uint8_t req) {
+    if (req == REQUEST_START && activeSink == SINK_NONE) {
+        open();
+    } else if (req == REQUEST_STOP && activeSink != SINK_NONE) {
+        capturing = false;
+        drain(true);
+        if (activeSink != SINK_NONE) {  // Not already ended by a full filesystem
+            close();
+        }
+    }
+}
+
+void AudioCapture::open() {
+    lastError = ERROR_NONE;
+    droppedBlocks = 0;
+    capturedSamples = 0;
+    fileBytes = 0;
+    writeFill = 0;
+    adpcmIndex = 0;
+    packetsWritten = 0;
+    packetsRead = 0;
+
+    // Nothing is written while not capturing, so the ring is ours to reset
+    readCount = writeCount;
+
+    if (pendingSink == SINK_FILE && !openFile()) {
+        if (lastError == ERROR_NONE) {
+            lastError = ERROR_FILE;
+        }
+        DEBUG_PRINTF("[CAPTURE] ERROR: Cannot create %s\n", FILE_PATH);
+        markChanged();
+        return;
+    }
+
+    activeSink = pendingSink;
+    lastStatus = millis();
+    capturing = true;
+
+    DEBUG_PRINTF("[CAPTURE] Started (%s, %s)\n", (activeSink == SINK_FILE) ? FILE_PATH : "stream",
+                 (format == FORMAT_ADPCM) ? "IMA-ADPCM" : "PCM");
+    markChanged();
+}
+
+void AudioCapture::close() {
+    capturing = false;
+    if (activeSink == SINK_FILE) {
+        closeFile();
+    }
+    activeSink = SINK_NONE;
+
+    DEBUG_PRINTF("[CAPTURE] Stopped: %lu samples, %lu blocks dropped\n", (unsigned long)capturedSamples,
+                 (unsigned long)droppedBlocks);
+    markChanged();
+}
+
+void AudioCapture::drain(bool final) {
+    const size_t size = (format == FORMAT_ADPCM) ? ADPCM_BLOCK_SAMPLES : PCM_CHUNK_SAMPLES;
+
+    while (activeSink != SINK_NONE) {
+        uint32_t available = writeCount - readCount;
+        if (available == 0) {
+            return;
+        }
+
+        if (activeSink == SINK_STREAM) {
+            // Only whole packets; the loop task behind = leave it in the ring
+            // (once the ring is full, the audio task drops blocks)
+            if (available < size || packetsWritten - packetsRead >= STREAM_SLOTS) {
+                return;
+            }
+        } else if (available < size && !final) {
+            return;
+        }
+
+        size_t count = (available < size) ? available : size;
+        readRing(chunk, count);
+        if (!emit(chunk, count)) {
+            DEBUG_PRINTLN("[CAPTURE] LittleFS full - capture ended");
+            close();
+            return;
+        }
+    }
+}
+
+void AudioCapture::readRing(int16_t* dst, size_t numSamples) {
+    uint32_t pos = readCount;
+    for (size_t i = 0; i < numSamples; i++) {
+        dst[i] = ring[(pos + i) & RING_MASK];
+    }
+    // Release the space after the copy
+    readCount = pos + numSamples;
+}
+
+bool AudioCapture::emit(const int16_t* samples, size_t numSamples) {
+    if (format == FORMAT_ADPCM) {
+        // Last block of a file: hold the final sample (players stop at the
+        // sample count in the fact chunk)
+        for (size_t i = numSamples; i < ADPCM_BLOCK_SAMPLES; i++) {
+            chunk[i] = samples[numSamples - 1];
+        }
+    }
+
+    if (activeSink == SINK_STREAM) {
+        StreamPacket& packet = packets[packetsWritten % STREAM_SLOTS];
+        packet.position = capturedSamples;
+        packet.dropped = droppedBlocks;
+        packet.sampleCount = numSamples;
+        packet.format = format;
+        if (format == FORMAT_ADPCM) {
+            encodeAdpcmBlock(chunk, packet.data);
+            packet.bytes = ADPCM_BLOCK_BYTES;
+        } else {
+            memcpy(packet.data, samples, numSamples * sizeof(int16_t));
+            packet.bytes = numSamples * sizeof(int16_t);
+        }
+        // Publish after the data
+        packetsWritten = packetsWritten + 1;
+    } else if (format == FORMAT_ADPCM) {
+        uint8_t block[ADPCM_BLOCK_BYTES];
+        encodeAdpcmBlock(chunk, block);
+        if (!appendFile(block, sizeof(block))) {
+            return false;
+        }
+    } else if (!appendFile((const uint8_t*)samples, numSamples * sizeof(int16_t))) {
+        return false;
+    }
+
+    capturedSamples = capturedSamples + numSamples;
+    return true;
+}
+
+void AudioCapture::encodeAdpcmBlock(const int16_t* samples, uint8_t* out) {
+    // Block header: first sample verbatim, step index; then 4-bit codes,
+    // low nibble first (the WAV IMA-ADPCM mono layout)
+    int32_t predictor = samples[0];
+    int8_t index = adpcmIndex;
+    put16(out, (uint16_t)samples[0]);
+    out[2] = index;
+    out[3] = 0;
+
+    uint8_t* codes = out + 4;
+    for (size_t i = 1; i < ADPCM_BLOCK_SAMPLES; i += 2) {
+        uint8_t low = encodeAdpcmSample(samples[i], predictor, index);
+        uint8_t high = encodeAdpcmSample(samples[i + 1], predictor, index);
+        *codes++ = low | (high << 4);
+    }
+
+    adpcmIndex = index;
+}
+
+// ============================================================================
+// FILE SINK
+// ============================================================================
+
+bool AudioCapture::openFile() {
+    // Mounted by NetworkManager when the network is enabled (then a no-op)
+    if (!LittleFS.begin(false)) {
+        return false;
+    }
+
+    if (LittleFS.exists(FILE_PATH)) {
+        LittleFS.remove(FILE_PATH);
+    }
+
+    // Keep some room for the rest of the filesystem
+    size_t freeBytes = LittleFS.totalBytes() - LittleFS.usedBytes();
+    if (freeBytes < FILE_RESERVE_BYTES + WRITE_SIZE) {
+        lastError = ERROR_FULL;
+        return false;
+    }
+    fileLimit = freeBytes - FILE_RESERVE_BYTES;
+
+    file = LittleFS.open(FILE_PATH, FILE_WRITE);
+    if (!file) {
+        return false;
+    }
+
+    // Placeholder header at the start of the first block (sizes patched on close)
+    fillHeader(writeBuffer, 0);
+    writeFill = headerSize();
+    fileBytes = writeFill;
+    return true;
+}
+
+bool AudioCapture::appendFile(const uint8_t* data, size_t len) {
+    if (fileBytes + len > fileLimit) {
+        lastError = ERROR_FULL;
+        return false;
+    }
+
+    // Whole blocks only: LittleFS rewrites a partly written block on every
+    // small write, so small writes cost far more flash time
+    const size_t total = len;
+    while (len > 0) {
+        size_t count = WRITE_SIZE - writeFill;
+        if (count > len) {
+            count = len;
+        }
+        memcpy(writeBuffer + writeFill, data, count);
+        writeFill += count;
+        data += count;
+        len -= count;
+
+        if (writeFill == WRITE_SIZE) {
+            if (file.write(writeBuffer, WRITE_SIZE) != WRITE_SIZE) {
+                // Keep what made it to flash
+                writeFill = 0;
+                fileBytes = file.size();
+                lastError = ERROR_FULL;
+                return false;
+            }
+            writeFill = 0;
+        }
+    }
+
+    fileBytes = fileBytes + total;
+    return true;
+}
+
+void AudioCapture::closeFile() {
+    // Last partial block
+    if (writeFill > 0) {
+        file.write(writeBuffer, writeFill);
+        writeFill = 0;
+    }
+
+    // Whole samples/blocks only (after a failed write the tail may be partial)
+    const size_t align = (format == FORMAT_ADPCM) ? ADPCM_BLOCK_BYTES : sizeof(int16_t);
+    uint32_t dataBytes = (fileBytes > headerSize()) ? fileBytes - headerSize() : 0;
+    dataBytes -= dataBytes % align;
+
+    uint8_t header[ADPCM_HEADER_SIZE];
+    fillHeader(header, dataBytes);
+    file.seek(0);
+    file.write(header, headerSize());
+    file.close();
+
+    DEBUG_PRINTF("[CAPTURE] %s: %lu bytes\n", FILE_PATH, (unsigned long)fileBytes);
+}
+
+size_t AudioCapture::headerSize() const {
+    return (format == FORMAT_ADPCM) ? ADPCM_HEADER_SIZE : PCM_HEADER_SIZE;
+}
+
+void AudioCapture::fillHeader(uint8_t* header, uint32_t dataBytes) const {
+    const bool adpcm = (format == FORMAT_ADPCM);
+    const size_t size = headerSize();
+
+    memcpy(header, "RIFF", 4);
+    put32(header + 4, size - 8 + dataBytes);
+    memcpy(header + 8, "WAVE", 4);
+    memcpy(header + 12, "fmt ", 4);
+    put32(header + 16, adpcm ? 20 : 16);
+    put16(header + 20, adpcm ? 0x0011 : 0x0001);  // IMA-ADPCM / PCM
+    put16(header + 22, 1);                         // Mono
+    put32(header + 24, Audio::SAMPLE_RATE);
+
+    if (adpcm) {
+        // Samples in the file: whole blocks, without the padding of the last one
+        uint32_t samples = (dataBytes / ADPCM_BLOCK_BYTES) * ADPCM_BLOCK_SAMPLES;
+        if (samples > capturedSamples) {
+            samples = capturedSamples;
+        }
+        put32(header + 28, (uint32_t)((uint64_t)Audio::SAMPLE_RATE * ADPCM_BLOCK_BYTES / ADPCM_BLOCK_SAMPLES));
+        put16(header + 32, ADPCM_BLOCK_BYTES);
+        put16(header + 34, 4);                     // Bits per sample
+        put16(header + 36, 2);                     // Extra format bytes
+        put16(header + 38, ADPCM_BLOCK_SAMPLES);
+        memcpy(header + 40, "fact", 4);
+        put32(header + 44, 4);
+        put32(header + 48, samples);
+        memcpy(header + 52, "data", 4);
+        put32(header + 56, dataBytes);
+    } else {
+        put32(header + 28, Audio::SAMPLE_RATE * 2);
+        put16(header + 32, 2);                     // Block align
+        put16(header + 34, 16);                    // Bits per sample
+        memcpy(header + 36, "data", 4);
+        put32(header + 40, dataBytes);
+    }
+}
+
+void AudioCapture::markChanged() {
+    if (stateTracker != nullptr) {
+        stateTracker->mark(StateTracker::CAPTURE);
+    }
+}
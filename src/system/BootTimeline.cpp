@@ -0,0 +1,123 @@
+/*
+ * BootTimeline.cpp
+ *
+ * Boot milestone recorder. See BootTimeline.h.
+ */
+
+#include "system/BootTimeline.h"
+#include "system/Debug.h"
+
+namespace BootTimeline {
+
+    // 0 = not reached. Each slot has a single writer (the first task to get
+    // there); a milestone at exactly 0 ms is stored as 1 ms.
+    static volatile uint32_t times[NUM_MILESTONES] = {0};
+
+    static const char* const NAMES[NUM_MILESTONES] = {
+        "setup", "audio", "sensor", "loop", "wifi", "web"
+    };
+
+    static const char* const LABELS[NUM_MILESTONES] = {
+        "setup() start",
+        "First audio buffer",
+        "First sensor sample",
+        "setup() done",
+        "WiFi up",
+        "Web server up"
+    };
+
+    struct PhaseRecord {
+        const char* name;
+        uint32_t startUs;
+        uint32_t durationUs;
+    };
+
+    static PhaseRecord phases[MAX_PHASES];
+    static volatile int phaseCount = 0;
+    static portMUX_TYPE phaseMux = portMUX_INITIALIZER_UNLOCKED;
+
+    void mark(Milestone milestone) {
+        if (milestone < 0 || milestone >= NUM_MILESTONES || times[milestone] != 0) {
+            return;
+        }
+        uint32_t now = millis();
+        times[milestone] = (now == 0) ? 1 : now;
+    }
+
+    uint32_t get(Milestone milestone) {
+        if (milestone < 0 || milestone >= NUM_MILESTONES) {
+            return 0;
+        }
+        return times[milestone];
+    }
+
+    const char* name(Milestone milestone) {
+        if (milestone < 0 || milestone >= NUM_MILESTONES) {
+            return "?";
+        }
+        return NAMES[milestone];
+    }
+
+    void recordPhase(const char* name, uint32_t startUs, uint32_t endUs) {
+        // Claim a slot under the lock; the display init runs on its own task
+        portENTER_CRITICAL(&phaseMux);
+        int index = phaseCount;
+        if (index < MAX_PHASES) {
+            phases[index].name = name;
+            phases[index].startUs = startUs;
+            phases[index].durationUs = endUs - startUs;
+            phaseCount = index + 1;
+        }
+        portEXIT_CRITICAL(&phaseMux);
+    }
+
+    int getPhaseCount() {
+        return phaseCount;
+    }
+
+    const char* getPhaseName(int index) {
+        return (index >= 0 && index < phaseCount) ? phases[index].name : "?";
+    }
+
+    uint32_t getPhaseStartUs(int index) {
+        return (index >= 0 && index < phaseCount) ? phases[index].startUs : 0;
+    }
+
+    uint32_t getPhaseDurationUs(int index) {
+        return (index >= 0 && index < phaseCount) ? phases[index].durationUs : 0;
+    }
+
+    void print() {
+        DEBUG_PRINTLN("\n========== BOOT TIMELINE ==========");
+        for (int i = 0; i < NUM_MILESTONES; i++) {
+            if (times[i] != 0) {
+                DEBUG_PRINTF("%-20s %6lu ms\n", LABELS[i], (unsigned long)times[i]);
+            } else {
+                DEBUG_PRINTF("%-20s      -\n", LABELS[i]);
+            }
+        }
+
+        // Phases by start time (nested phases follow their parent)
+        int count = phaseCount;
+        if (count > 0) {
+            DEBUG_PRINTLN("-----------------------------------");
+            DEBUG_PRINTLN("Phase               Start     Time");
+            bool printed[MAX_PHASES] = {false};
+            for (int n = 0; n < count; n++) {
+                int next = -1;
+                for (int i = 0; i < count; i++) {
+                    if (!printed[i] && (next < 0 || phases[i].startUs < phases[next].startUs)) {
+                        next = i;
+                    }
+                }
+                printed[next] = true;
+                DEBUG_PRINTF("%-16s %6lu ms %5lu.%lu ms\n", phases[next].name,
+                             (unsigned long)(phases[next].startUs / 1000),
+                             (unsigned long)(phases[next].durationUs / 1000),
+                             (unsigned long)(phases[next].durationUs / 100 % 10));
+            }
+        }
+        DEBUG_PRINTLN("===================================\n");
+    }
+
+}  // namespace BootTimeline
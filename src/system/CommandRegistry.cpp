@@ -0,0 +1,1403 @@
+/*
+ * CommandRegistry.cpp
+ *
+ * Command table, handlers and argument parsing. See CommandRegistry.h.
+ */
+
+#include "system/CommandRegistry.h"
+#include "system/Theremin.h"
+#include "system/Debug.h"
+#include "system/PerformanceMonitor.h"
+#include "system/BootTimeline.h"
+#include <algorithm>
+#include <stdlib.h>
+#include <strings.h>  // for strcasecmp
+
+// ============================================================================
+// STATUS REPORTS (serial console)
+// ============================================================================
+
+static const char* getWaveformName(Oscillator::Waveform wf) {
+  switch (wf) {
+    case Oscillator::OFF: return "OFF";
+    case Oscillator::SQUARE: return "SQUARE";
+    case Oscillator::SINE: return "SINE";
+    case Oscillator::TRIANGLE: return "TRIANGLE";
+    case Oscillator::SAW: return "SAWTOOTH";
+    default: return "UNKNOWN";
+  }
+}
+
+static void printOscillatorStatus(Theremin* theremin, int oscNum) {
+  DEBUG_PRINT("Oscillator ");
+  DEBUG_PRINT(oscNum);
+  DEBUG_PRINTLN(":");
+
+  // Get current state from AudioEngine
+  Oscillator::Waveform waveform = theremin->getAudioEngine()->getOscillatorWaveform(oscNum);
+  int octave = theremin->getAudioEngine()->getOscillatorOctave(oscNum);
+  float volume = theremin->getAudioEngine()->getOscillatorVolume(oscNum);
+
+  // Display waveform
+  DEBUG_PRINT("  Waveform:     ");
+  DEBUG_PRINTLN(getWaveformName(waveform));
+
+  // Display octave shift
+  DEBUG_PRINT("  Octave Shift: ");
+  if (octave > 0) {
+    DEBUG_PRINT("+");
+  }
+  DEBUG_PRINTLN(octave);
+
+  // Display volume as percentage
+  DEBUG_PRINT("  Volume:       ");
+  DEBUG_PRINT((int)(volume * 100));
+  DEBUG_PRINTLN("%");
+}
+
+static void printStatus(Theremin* theremin) {
+  DEBUG_PRINTLN("\n========== OSCILLATOR STATUS ==========");
+  printOscillatorStatus(theremin, 1);
+  printOscillatorStatus(theremin, 2);
+  printOscillatorStatus(theremin, 3);
+  DEBUG_PRINTLN("=======================================\n");
+
+  // Audio deadline statistics (histogram percentiles, max, underruns)
+  // and per-core load / task stacks / heap
+  PerformanceMonitor* perfMon = theremin->getAudioEngine()->getPerformanceMonitor();
+  if (perfMon != nullptr) {
+    perfMon->printAudioStats();
+    perfMon->printSystemStats();
+  }
+
+  // Shared I2C bus load and error counters
+  if (theremin->getI2CBus() != nullptr) {
+    theremin->getI2CBus()->printStats();
+  }
+}
+
+static void printSensorsStatus(Theremin* theremin) {
+  DEBUG_PRINTLN("\n========== SENSOR STATUS ==========");
+  DEBUG_PRINT("Pitch sensor:  ");
+  DEBUG_PRINTLN(theremin->getSensorManager()->isPitchEnabled() ? "ENABLED" : "DISABLED");
+  DEBUG_PRINT("Volume sensor: ");
+  DEBUG_PRINTLN(theremin->getSensorManager()->isVolumeEnabled() ? "ENABLED" : "DISABLED");
+  DEBUG_PRINT("\nPitch smoothing:  ");
+  DEBUG_PRINTLN(theremin->getSensorManager()->isPitchSmoothingEnabled() ? "ENABLED" : "DISABLED");
+  DEBUG_PRINT("Volume smoothing: ");
+  DEBUG_PRINTLN(theremin->getSensorManager()->isVolumeSmoothingEnabled() ? "ENABLED" : "DISABLED");
+  DEBUG_PRINTLN("===================================\n");
+}
+
+static void printEffectsStatus(Theremin* theremin) {
+  EffectsChain* fx = theremin->getAudioEngine()->getEffectsChain();
+
+  DEBUG_PRINTLN("\n========== EFFECTS STATUS ==========");
+
+  // Walk slots in processing order; parameters come from each effect's table
+  DEBUG_PRINT("Order:   ");
+  for (uint8_t slot = 0; slot < fx->getEffectCount(); slot++) {
+    DEBUG_PRINT(fx->getSlot(slot)->getName());
+    DEBUG_PRINT(slot < fx->getEffectCount() - 1 ? " -> " : "\n");
+  }
+
+  for (uint8_t slot = 0; slot < fx->getEffectCount(); slot++) {
+    AudioEffect* effect = fx->getSlot(slot);
+
+    DEBUG_PRINT("\n");
+    DEBUG_PRINT(effect->getName());
+    DEBUG_PRINT(": ");
+    DEBUG_PRINTLN(effect->isEnabled() ? "ENABLED" : "DISABLED");
+
+    for (uint8_t p = 0; p < effect->getParamCount(); p++) {
+      const EffectParam& info = effect->getParamInfo(p);
+      DEBUG_PRINT("  ");
+      DEBUG_PRINT(info.key);
+      DEBUG_PRINT(": ");
+      DEBUG_PRINT(effect->getParam(p));
+      DEBUG_PRINT("  (");
+      DEBUG_PRINT(info.minValue);
+      DEBUG_PRINT("-");
+      DEBUG_PRINT(info.maxValue);
+      DEBUG_PRINTLN(")");
+    }
+  }
+
+  DEBUG_PRINTLN("====================================\n");
+}
+
+static void printHelp() {
+  DEBUG_PRINTLN("\n========== OSCILLATOR CONTROL COMMANDS ==========");
+  DEBUG_PRINTLN("Waveform:");
+  DEBUG_PRINTLN("  osc1:off         - Turn off oscillator 1");
+  DEBUG_PRINTLN("  osc1:square      - Set oscillator 1 to square wave");
+  DEBUG_PRINTLN("  osc1:sine        - Set oscillator 1 to sine wave");
+  DEBUG_PRINTLN("  osc1:triangle    - Set oscillator 1 to triangle wave");
+  DEBUG_PRINTLN("  osc1:sawtooth    - Set oscillator 1 to sawtooth wave");
+  DEBUG_PRINTLN("\nOctave Shift:");
+  DEBUG_PRINTLN("  osc1:octave:-1   - Shift oscillator 1 down one octave");
+  DEBUG_PRINTLN("  osc1:octave:0    - Reset oscillator 1 to base octave");
+  DEBUG_PRINTLN("  osc1:octave:1    - Shift oscillator 1 up one octave");
+  DEBUG_PRINTLN("\nVolume:");
+  DEBUG_PRINTLN("  osc1:vol:0.0     - Set oscillator 1 to 0% volume (silent)");
+  DEBUG_PRINTLN("  osc1:vol:0.5     - Set oscillator 1 to 50% volume");
+  DEBUG_PRINTLN("  osc1:vol:1.0     - Set oscillator 1 to 100% volume");
+  DEBUG_PRINTLN("\nStatus:");
+  DEBUG_PRINTLN("  status           - Show status of all oscillators + audio deadline and I2C bus stats");
+  DEBUG_PRINTLN("  perf:reset       - Clear audio deadline stats (histogram, max, underruns)");
+  DEBUG_PRINTLN("  status:osc1      - Show status of oscillator 1");
+  DEBUG_PRINTLN("  boot             - Show boot timeline (ms to first sound, WiFi, web server)");
+  DEBUG_PRINTLN("\nBatch Commands:");
+  DEBUG_PRINTLN("  osc1:sine;osc1:octave:1;osc1:vol:0.8");
+  DEBUG_PRINTLN("  - Execute multiple commands separated by ';'");
+  DEBUG_PRINTLN("\nSensor Control:");
+  DEBUG_PRINTLN("  sensors:pitch:on           - Enable pitch sensor");
+  DEBUG_PRINTLN("  sensors:pitch:off          - Disable pitch sensor");
+  DEBUG_PRINTLN("  sensors:volume:on          - Enable volume sensor");
+  DEBUG_PRINTLN("  sensors:volume:off         - Disable volume sensor");
+  DEBUG_PRINTLN("  sensors:enable             - Enable both sensors (alias)");
+  DEBUG_PRINTLN("  sensors:disable            - Disable both sensors (alias)");
+  DEBUG_PRINTLN("  sensors:status             - Show sensor enable states");
+  DEBUG_PRINTLN("\nSensor Smoothing:");
+  DEBUG_PRINTLN("  sensors:volume:smooth:on   - Enable volume smoothing (default)");
+  DEBUG_PRINTLN("  sensors:volume:smooth:off  - Instant response (for testing reverb)");
+  DEBUG_PRINTLN("  sensors:pitch:smooth:on    - Enable pitch smoothing (default)");
+  DEBUG_PRINTLN("  sensors:pitch:smooth:off   - Instant response");
+  DEBUG_PRINTLN("\nSmoothing Presets (Coordinated Sensor + Audio Levels):");
+  DEBUG_PRINTLN("  smooth:pitch:none          - Raw/instant response (no smoothing)");
+  DEBUG_PRINTLN("  smooth:pitch:normal        - Balanced (default: sensor α=0.35, audio=0.80)");
+  DEBUG_PRINTLN("  smooth:pitch:extra         - Maximum smoothness (sensor α=0.20, audio=0.50)");
+  DEBUG_PRINTLN("  smooth:volume:none         - Raw/instant response (no smoothing)");
+  DEBUG_PRINTLN("  smooth:volume:normal       - Balanced (default: sensor α=0.35, audio=0.80)");
+  DEBUG_PRINTLN("  smooth:volume:extra        - Maximum smoothness (sensor α=0.20, audio=0.50)");
+  DEBUG_PRINTLN("\nAudio Control:");
+  DEBUG_PRINTLN("  audio:freq:440       - Set frequency to 440 Hz");
+  DEBUG_PRINTLN("  audio:amp:75         - Set amplitude to 75%");
+  DEBUG_PRINTLN("  audio:status         - Show current audio values");
+  DEBUG_PRINTLN("\nAudio Channel Routing (PCM5102 Stereo Output):");
+  DEBUG_PRINTLN("  audio:channel:stereo   - Both channels (L+R, default)");
+  DEBUG_PRINTLN("  audio:channel:left     - Left channel only (right muted)");
+  DEBUG_PRINTLN("  audio:channel:right    - Right channel only (left muted)");
+  DEBUG_PRINTLN("  audio:channel:status   - Show current channel mode");
+  DEBUG_PRINTLN("  Note: Use for dual-output setup (e.g., L=internal speaker, R=line out)");
+  DEBUG_PRINTLN("\nAudio Quality:");
+  DEBUG_PRINTLN("  audio:quality:standard - Render oscillators at output rate (default)");
+  DEBUG_PRINTLN("  audio:quality:high     - 2x oversampled oscillators (less aliasing, ~2x osc CPU)");
+  DEBUG_PRINTLN("\nAudio Smoothing (Second-Level):");
+  DEBUG_PRINTLN("  audio:pitch:smooth:0.80   - Set pitch smoothing (0.0=very smooth, 1.0=instant)");
+  DEBUG_PRINTLN("  audio:volume:smooth:0.80  - Set volume smoothing (0.0=very smooth, 1.0=instant)");
+  DEBUG_PRINTLN("  Note: This is the audio-level smoothing, applied AFTER sensor smoothing");
+  DEBUG_PRINTLN("\nMaster Bus (after effects):");
+  DEBUG_PRINTLN("  master:drive:2.0        - Output drive/makeup gain (0.25-4.0, default 2.0)");
+  DEBUG_PRINTLN("  master:limiter:on|off   - Look-ahead peak limiter (1.5 ms latency)");
+  DEBUG_PRINTLN("  master:gate:on|off      - Output gate/expander");
+  DEBUG_PRINTLN("  master:gate:100:60      - Gate open/close thresholds (hysteresis)");
+  DEBUG_PRINTLN("  master:status           - Show master bus settings and meters");
+  DEBUG_PRINTLN("\nPresets (slots 1-8, stored in flash):");
+  DEBUG_PRINTLN("  preset:save:1           - Store the current sound in slot 1");
+  DEBUG_PRINTLN("  preset:save:1:warm      - Store and name it (up to 11 chars)");
+  DEBUG_PRINTLN("  preset:load:1           - Recall slot 1 (switches at a buffer boundary)");
+  DEBUG_PRINTLN("  preset:next             - Recall the next stored preset");
+  DEBUG_PRINTLN("  preset:delete:1         - Erase slot 1");
+  DEBUG_PRINTLN("  preset:list             - List the bank");
+  DEBUG_PRINTLN("  Note: saving writes flash - do it between phrases");
+  DEBUG_PRINTLN("  morph:1:3               - Morph between presets 1 and 3");
+  DEBUG_PRINTLN("  morph:pos:0.5           - Morph position (0.0 = first, 1.0 = second)");
+  DEBUG_PRINTLN("  morph:source:sensor     - Volume hand sets the position (manual = web/serial)");
+  DEBUG_PRINTLN("  morph:off               - Stop morphing (keeps the current sound)");
+  DEBUG_PRINTLN("\nAutomation (records volume/effect moves, then loops them):");
+  DEBUG_PRINTLN("  automation:record       - Start recording (clears the lane)");
+  DEBUG_PRINTLN("  automation:stop         - End recording and loop it, or stop playback");
+  DEBUG_PRINTLN("  automation:play         - Loop the recorded moves again");
+  DEBUG_PRINTLN("  automation:length:4000  - Fixed loop length in ms (0 = set by the recording)");
+  DEBUG_PRINTLN("  automation:clear        - Erase the lane");
+  DEBUG_PRINTLN("  automation:status       - Show lane state");
+  DEBUG_PRINTLN("\nLooper (records the output, then plays it under you):");
+  DEBUG_PRINTLN("  looper:rec              - Record / close loop / overdub / back to play");
+  DEBUG_PRINTLN("  looper:play             - Play the loop from the start");
+  DEBUG_PRINTLN("  looper:stop             - Stop (closes a recording)");
+  DEBUG_PRINTLN("  looper:undo             - Remove the last overdub");
+  DEBUG_PRINTLN("  looper:clear            - Erase the loop");
+  DEBUG_PRINTLN("  looper:feedback:0.8     - Old loop kept per overdub pass");
+  DEBUG_PRINTLN("  looper:level:0.7        - Loop playback level");
+  DEBUG_PRINTLN("  looper:format:ulaw      - pcm or ulaw (twice as long), only while empty");
+  DEBUG_PRINTLN("  looper:status           - Show looper state");
+  DEBUG_PRINTLN("\nCapture (records the output to /capture.wav on LittleFS):");
+  DEBUG_PRINTLN("  capture:start           - Start (16-bit PCM)");
+  DEBUG_PRINTLN("  capture:start:adpcm     - Start (IMA-ADPCM, 4x longer)");
+  DEBUG_PRINTLN("  capture:stop            - Stop and complete the file");
+  DEBUG_PRINTLN("  capture:status          - Length, size and dropped blocks");
+  DEBUG_PRINTLN("\nEffects Control:");
+  DEBUG_PRINTLN("  delay:on             - Enable delay effect");
+  DEBUG_PRINTLN("  delay:off            - Disable delay effect");
+  DEBUG_PRINTLN("  delay:time:300       - Set delay time to 300ms");
+  DEBUG_PRINTLN("  delay:feedback:0.5   - Set feedback to 50%");
+  DEBUG_PRINTLN("  delay:mix:0.3        - Set wet/dry mix to 30%");
+  DEBUG_PRINTLN("\n  chorus:on            - Enable chorus effect");
+  DEBUG_PRINTLN("  chorus:off           - Disable chorus effect");
+  DEBUG_PRINTLN("  chorus:rate:2.0      - Set LFO rate to 2.0 Hz");
+  DEBUG_PRINTLN("  chorus:depth:15      - Set modulation depth to 15ms");
+  DEBUG_PRINTLN("  chorus:mix:0.4       - Set wet/dry mix to 40%");
+  DEBUG_PRINTLN("\n  reverb:on            - Enable reverb effect");
+  DEBUG_PRINTLN("  reverb:off           - Disable reverb effect");
+  DEBUG_PRINTLN("  reverb:room:0.5      - Set room size (0.0-1.0)");
+  DEBUG_PRINTLN("  reverb:damp:0.5      - Set damping (0.0=bright, 1.0=dark)");
+  DEBUG_PRINTLN("  reverb:mix:0.3       - Set wet/dry mix to 30%");
+  DEBUG_PRINTLN("\n  <effect>:<param>:<value> - Any parameter listed by effects:status");
+  DEBUG_PRINTLN("  effects:order:reverb,delay,chorus - Set processing order");
+  DEBUG_PRINTLN("  effects:order:reset  - Restore default order (delay -> chorus -> reverb)");
+  DEBUG_PRINTLN("\n  effects:status       - Show all effect states");
+  DEBUG_PRINTLN("  effects:reset        - Clear all effect buffers");
+  DEBUG_PRINTLN("\nNote: Replace 'osc1' with 'osc2' or 'osc3' for other oscillators");
+  DEBUG_PRINTLN("      Abbreviations: 'tri'=triangle, 'saw'=sawtooth, 'oct'=octave, 'vol'=volume");
+  DEBUG_PRINTLN("      When sensors disabled, manual audio: commands persist");
+  DEBUG_PRINTLN("      When sensors enabled, they override manual settings");
+  DEBUG_PRINTLN("      Web UI commands work here too, arguments in order (setvolume:1:0.5)");
+  DEBUG_PRINTLN("=================================================\n");
+}
+
+// ============================================================================
+// ARGUMENT HELPERS
+// ============================================================================
+
+static bool validOscillator(int oscNum) {
+  if (oscNum < 1 || oscNum > 3) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Oscillator number must be 1-3");
+    return false;
+  }
+  return true;
+}
+
+// 1-based slot as typed/shown -> 0-based
+static bool validPresetSlot(int slot) {
+  if (slot < 1 || slot > PresetManager::NUM_SLOTS) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Preset slot must be 1-8");
+    return false;
+  }
+  return true;
+}
+
+static int parseWaveform(const char* name) {
+  if (strcasecmp(name, "off") == 0) {
+    return Oscillator::OFF;
+  }
+  if (strcasecmp(name, "square") == 0) {
+    return Oscillator::SQUARE;
+  }
+  if (strcasecmp(name, "sine") == 0) {
+    return Oscillator::SINE;
+  }
+  if (strcasecmp(name, "triangle") == 0 || strcasecmp(name, "tri") == 0) {
+    return Oscillator::TRIANGLE;
+  }
+  if (strcasecmp(name, "sawtooth") == 0 || strcasecmp(name, "saw") == 0) {
+    return Oscillator::SAW;
+  }
+  return -1;  // Invalid
+}
+
+static bool parseSmoothingPreset(const char* name, Theremin::SmoothingPreset& preset) {
+  if (strcasecmp(name, "none") == 0) {
+    preset = Theremin::SMOOTH_NONE;
+  } else if (strcasecmp(name, "normal") == 0) {
+    preset = Theremin::SMOOTH_NORMAL;
+  } else if (strcasecmp(name, "extra") == 0) {
+    preset = Theremin::SMOOTH_EXTRA;
+  } else {
+    DEBUG_PRINTLN("[CTRL] ERROR: Smoothing preset must be none, normal or extra");
+    return false;
+  }
+  return true;
+}
+
+static const char* smoothingPresetName(Theremin::SmoothingPreset preset) {
+  switch (preset) {
+    case Theremin::SMOOTH_NONE: return "NONE (raw/instant response)";
+    case Theremin::SMOOTH_EXTRA: return "EXTRA (maximum smoothness)";
+    default: return "NORMAL (balanced)";
+  }
+}
+
+// ============================================================================
+// HANDLERS - system
+// ============================================================================
+
+static bool cmdHelp(Theremin* theremin, const CommandArgs& args) {
+  printHelp();
+  return true;
+}
+
+static bool cmdStatus(Theremin* theremin, const CommandArgs& args) {
+  printStatus(theremin);
+  printSensorsStatus(theremin);
+  printEffectsStatus(theremin);
+  return true;
+}
+
+static bool cmdOscillatorStatus(Theremin* theremin, const CommandArgs& args) {
+  if (!validOscillator(args.getInt(0))) {
+    return false;
+  }
+  printOscillatorStatus(theremin, args.getInt(0));
+  return true;
+}
+
+static bool cmdPerfReset(Theremin* theremin, const CommandArgs& args) {
+  PerformanceMonitor* perfMon = theremin->getAudioEngine()->getPerformanceMonitor();
+  if (perfMon != nullptr) {
+    perfMon->resetAudioStats();
+    DEBUG_PRINTLN("[CTRL] Audio deadline statistics cleared");
+  }
+  return true;
+}
+
+static bool cmdBoot(Theremin* theremin, const CommandArgs& args) {
+  BootTimeline::print();
+  return true;
+}
+
+static bool cmdRestart(Theremin* theremin, const CommandArgs& args) {
+  DEBUG_PRINTLN("[CTRL] System reset command received. Restarting...");
+  ESP.restart();
+  return true;
+}
+
+// ============================================================================
+// HANDLERS - sensors and smoothing
+// ============================================================================
+
+static bool cmdPitchSensor(Theremin* theremin, const CommandArgs& args) {
+  theremin->getSensorManager()->setPitchEnabled(args.getBool(0));
+  DEBUG_PRINTLN(args.getBool(0) ? "[CTRL] Pitch sensor enabled" : "[CTRL] Pitch sensor disabled");
+  return true;
+}
+
+static bool cmdVolumeSensor(Theremin* theremin, const CommandArgs& args) {
+  theremin->getSensorManager()->setVolumeEnabled(args.getBool(0));
+  DEBUG_PRINTLN(args.getBool(0) ? "[CTRL] Volume sensor enabled" : "[CTRL] Volume sensor disabled");
+  return true;
+}
+
+static void setBothSensors(Theremin* theremin, bool enabled) {
+  theremin->getSensorManager()->setPitchEnabled(enabled);
+  theremin->getSensorManager()->setVolumeEnabled(enabled);
+  DEBUG_PRINTLN(enabled ? "[CTRL] Both sensors enabled" : "[CTRL] Both sensors disabled");
+}
+
+static bool cmdSensorsEnable(Theremin* theremin, const CommandArgs& args) {
+  setBothSensors(theremin, true);
+  return true;
+}
+
+static bool cmdSensorsDisable(Theremin* theremin, const CommandArgs& args) {
+  setBothSensors(theremin, false);
+  return true;
+}
+
+// setSensorEnabled (keyboard view): sensor = pitch, volume or both
+static bool cmdSetSensorEnabled(Theremin* theremin, const CommandArgs& args) {
+  const char* sensor = args.getString(0);
+  bool enabled = args.getBool(1);
+  SensorManager* sensors = theremin->getSensorManager();
+
+  if (strcasecmp(sensor, "pitch") == 0) {
+    sensors->setPitchEnabled(enabled);
+  } else if (strcasecmp(sensor, "volume") == 0) {
+    sensors->setVolumeEnabled(enabled);
+  } else if (strcasecmp(sensor, "both") == 0) {
+    sensors->setPitchEnabled(enabled);
+    sensors->setVolumeEnabled(enabled);
+  } else {
+    DEBUG_PRINTF("[CTRL] ERROR: Unknown sensor: %s\n", sensor);
+    return false;
+  }
+  DEBUG_PRINTF("[CTRL] Sensor %s %s\n", sensor, enabled ? "enabled" : "disabled");
+  return true;
+}
+
+static bool cmdSensorsStatus(Theremin* theremin, const CommandArgs& args) {
+  printSensorsStatus(theremin);
+  return true;
+}
+
+static bool cmdPitchSensorSmoothing(Theremin* theremin, const CommandArgs& args) {
+  theremin->getSensorManager()->setPitchSmoothingEnabled(args.getBool(0));
+  DEBUG_PRINTLN(args.getBool(0) ? "[CTRL] Pitch smoothing enabled - smooth transitions"
+                                : "[CTRL] Pitch smoothing disabled - instant response");
+  return true;
+}
+
+static bool cmdVolumeSensorSmoothing(Theremin* theremin, const CommandArgs& args) {
+  theremin->getSensorManager()->setVolumeSmoothingEnabled(args.getBool(0));
+  DEBUG_PRINTLN(args.getBool(0) ? "[CTRL] Volume smoothing enabled - smooth transitions"
+                                : "[CTRL] Volume smoothing disabled - instant response");
+  return true;
+}
+
+static bool cmdPitchSmoothingPreset(Theremin* theremin, const CommandArgs& args) {
+  Theremin::SmoothingPreset preset;
+  if (!parseSmoothingPreset(args.getString(0), preset)) {
+    return false;
+  }
+  theremin->setPitchSmoothingPreset(preset);
+  DEBUG_PRINTF("[CTRL] Pitch smoothing preset: %s\n", smoothingPresetName(preset));
+  return true;
+}
+
+static bool cmdVolumeSmoothingPreset(Theremin* theremin, const CommandArgs& args) {
+  Theremin::SmoothingPreset preset;
+  if (!parseSmoothingPreset(args.getString(0), preset)) {
+    return false;
+  }
+  theremin->setVolumeSmoothingPreset(preset);
+  DEBUG_PRINTF("[CTRL] Volume smoothing preset: %s\n", smoothingPresetName(preset));
+  return true;
+}
+
+// setSmoothing (web UI): target = pitch or volume, value = preset index
+static bool cmdSetSmoothing(Theremin* theremin, const CommandArgs& args) {
+  int value = args.getInt(1);
+  if (value < Theremin::SMOOTH_NONE || value > Theremin::SMOOTH_EXTRA) {
+    DEBUG_PRINTF("[CTRL] ERROR: Invalid smoothing preset: %d\n", value);
+    return false;
+  }
+  Theremin::SmoothingPreset preset = (Theremin::SmoothingPreset)value;
+  const char* target = args.getString(0);
+  if (strcasecmp(target, "pitch") == 0) {
+    theremin->setPitchSmoothingPreset(preset);
+  } else if (strcasecmp(target, "volume") == 0) {
+    theremin->setVolumeSmoothingPreset(preset);
+  } else {
+    DEBUG_PRINTF("[CTRL] ERROR: Unknown smoothing target: %s\n", target);
+    return false;
+  }
+  DEBUG_PRINTF("[CTRL] %s smoothing preset: %s\n", target, smoothingPresetName(preset));
+  return true;
+}
+
+static bool cmdSetRange(Theremin* theremin, const CommandArgs& args) {
+  int value = args.getInt(0);
+  if (value < Theremin::RANGE_NARROW || value > Theremin::RANGE_WIDE) {
+    DEBUG_PRINTF("[CTRL] ERROR: Invalid frequency range preset: %d\n", value);
+    return false;
+  }
+  theremin->setFrequencyRangePreset((Theremin::FrequencyRangePreset)value);
+  DEBUG_PRINTF("[CTRL] Frequency range preset -> %d\n", value);
+  return true;
+}
+
+// ============================================================================
+// HANDLERS - audio
+// ============================================================================
+
+static bool cmdFrequency(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->setFrequency(args.getInt(0));
+  DEBUG_PRINTF("[CTRL] Manual frequency set to %ld Hz\n", (long)args.getInt(0));
+  return true;
+}
+
+static bool cmdAmplitude(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->setAmplitude(args.getInt(0));
+  DEBUG_PRINTF("[CTRL] Manual amplitude set to %ld%%\n", (long)args.getInt(0));
+  return true;
+}
+
+static bool cmdFrequencyRange(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->setFrequencyRange(args.getInt(0), args.getInt(1));
+  DEBUG_PRINTF("[CTRL] Frequency range set to %ld-%ld Hz\n", (long)args.getInt(0), (long)args.getInt(1));
+  return true;
+}
+
+static bool cmdPlayNote(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->playMIDINote(args.getInt(0));
+  return true;
+}
+
+static bool cmdStopNote(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->stopNote();
+  return true;
+}
+
+static bool cmdAudioPitchSmoothing(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->setPitchSmoothingFactor(args.getFloat(0));
+  DEBUG_PRINTF("[CTRL] Audio pitch smoothing factor set to %.2f\n", args.getFloat(0));
+  return true;
+}
+
+static bool cmdAudioVolumeSmoothing(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->setVolumeSmoothingFactor(args.getFloat(0));
+  DEBUG_PRINTF("[CTRL] Audio volume smoothing factor set to %.2f\n", args.getFloat(0));
+  return true;
+}
+
+static bool cmdAudioStatus(Theremin* theremin, const CommandArgs& args) {
+  DEBUG_PRINTLN("\n========== AUDIO STATUS ==========");
+  DEBUG_PRINT("Frequency: ");
+  DEBUG_PRINT(theremin->getAudioEngine()->getFrequency());
+  DEBUG_PRINTLN(" Hz");
+  DEBUG_PRINT("Amplitude: ");
+  DEBUG_PRINT(theremin->getAudioEngine()->getAmplitude());
+  DEBUG_PRINTLN("%");
+  DEBUG_PRINTLN("\nAudio-Level Smoothing:");
+  DEBUG_PRINT("  Pitch:  0.80 (default)");
+  DEBUG_PRINTLN("  Volume: 0.80 (default)");
+  DEBUG_PRINTLN("  Note: Lower = smoother, Higher = more responsive");
+  DEBUG_PRINTLN("==================================\n");
+  return true;
+}
+
+static bool cmdChannel(Theremin* theremin, const CommandArgs& args) {
+  const char* mode = args.getString(0);
+  if (strcasecmp(mode, "stereo") == 0) {
+    theremin->getAudioEngine()->setChannelMode(AudioEngine::STEREO_BOTH);
+    DEBUG_PRINTLN("[CTRL] Channel mode: STEREO (L+R)");
+  } else if (strcasecmp(mode, "left") == 0) {
+    theremin->getAudioEngine()->setChannelMode(AudioEngine::LEFT_ONLY);
+    DEBUG_PRINTLN("[CTRL] Channel mode: LEFT ONLY");
+  } else if (strcasecmp(mode, "right") == 0) {
+    theremin->getAudioEngine()->setChannelMode(AudioEngine::RIGHT_ONLY);
+    DEBUG_PRINTLN("[CTRL] Channel mode: RIGHT ONLY");
+  } else {
+    DEBUG_PRINTLN("[CTRL] ERROR: Channel mode must be stereo, left or right");
+    return false;
+  }
+  return true;
+}
+
+static bool cmdChannelStatus(Theremin* theremin, const CommandArgs& args) {
+  DEBUG_PRINTLN("\n========== CHANNEL STATUS ==========");
+  DEBUG_PRINT("Channel Mode: ");
+  switch (theremin->getAudioEngine()->getChannelMode()) {
+    case AudioEngine::STEREO_BOTH:
+      DEBUG_PRINTLN("STEREO (L+R)");
+      break;
+    case AudioEngine::LEFT_ONLY:
+      DEBUG_PRINTLN("LEFT ONLY");
+      break;
+    case AudioEngine::RIGHT_ONLY:
+      DEBUG_PRINTLN("RIGHT ONLY");
+      break;
+  }
+  DEBUG_PRINTLN("====================================\n");
+  return true;
+}
+
+// audio:quality:<standard|high>
+static bool cmdQuality(Theremin* theremin, const CommandArgs& args) {
+  const char* preset = args.getString(0);
+  if (strcasecmp(preset, "standard") == 0) {
+    theremin->getAudioEngine()->setQualityPreset(AudioEngine::QUALITY_STANDARD);
+  } else if (strcasecmp(preset, "high") == 0) {
+    theremin->getAudioEngine()->setQualityPreset(AudioEngine::QUALITY_HIGH);
+  } else {
+    DEBUG_PRINTLN("[CTRL] ERROR: Quality must be standard or high");
+    return false;
+  }
+  return true;
+}
+
+// setQuality (web UI): 0 = standard, 1 = high
+static bool cmdSetQuality(Theremin* theremin, const CommandArgs& args) {
+  int value = args.getInt(0);
+  if (value != 0 && value != 1) {
+    DEBUG_PRINTF("[CTRL] ERROR: Invalid quality preset: %d\n", value);
+    return false;
+  }
+  theremin->getAudioEngine()->setQualityPreset(value == 1 ? AudioEngine::QUALITY_HIGH : AudioEngine::QUALITY_STANDARD);
+  return true;
+}
+
+// ============================================================================
+// HANDLERS - master bus
+// ============================================================================
+
+static bool cmdMasterDrive(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getMasterBus()->setDrive(args.getFloat(0));
+  return true;
+}
+
+static bool cmdLimiter(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getMasterBus()->setLimiterEnabled(args.getBool(0));
+  return true;
+}
+
+static bool cmdGateOn(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getMasterBus()->setGateEnabled(true);
+  return true;
+}
+
+static bool cmdGateOff(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getMasterBus()->setGateEnabled(false);
+  return true;
+}
+
+static bool cmdGateThresholds(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getMasterBus()->setGateThresholds(args.getInt(0), args.getInt(1));
+  return true;
+}
+
+static bool cmdMasterStatus(Theremin* theremin, const CommandArgs& args) {
+  MasterBus* master = theremin->getAudioEngine()->getMasterBus();
+  DEBUG_PRINTLN("\n========== MASTER BUS ==========");
+  DEBUG_PRINT("Drive:    ");
+  DEBUG_PRINT(master->getDrive());
+  DEBUG_PRINTLN("x");
+  DEBUG_PRINT("Limiter:  ");
+  DEBUG_PRINT(master->isLimiterEnabled() ? "ON" : "OFF");
+  DEBUG_PRINT("  (GR ");
+  DEBUG_PRINT(master->getLimiterGainReductionDb());
+  DEBUG_PRINTLN(" dB)");
+  DEBUG_PRINT("Gate:     ");
+  DEBUG_PRINT(master->isGateEnabled() ? "ON" : "OFF");
+  DEBUG_PRINT("  open/close ");
+  DEBUG_PRINT(master->getGateOpenLevel());
+  DEBUG_PRINT("/");
+  DEBUG_PRINT(master->getGateCloseLevel());
+  DEBUG_PRINTLN(master->isGateOpen() ? "  [OPEN]" : "  [CLOSED]");
+  DEBUG_PRINT("Soft clip: ");
+  DEBUG_PRINT(master->getClipCount());
+  DEBUG_PRINTLN(" samples shaped");
+  DEBUG_PRINTLN("================================\n");
+  return true;
+}
+
+// ============================================================================
+// HANDLERS - presets (flash writes and recalls run on the loop task:
+// handlers post requests, so they work from any front end)
+// ============================================================================
+
+static bool cmdPresetList(Theremin* theremin, const CommandArgs& args) {
+  theremin->getPresetManager()->printList();
+  return true;
+}
+
+static bool cmdPresetNext(Theremin* theremin, const CommandArgs& args) {
+  theremin->getPresetManager()->requestRecallNext();
+  return true;
+}
+
+static bool cmdPresetSave(Theremin* theremin, const CommandArgs& args) {
+  int slot = args.getInt(0);
+  if (!validPresetSlot(slot)) {
+    return false;
+  }
+  theremin->getPresetManager()->requestSave(slot - 1, args.getString(1));
+  return true;
+}
+
+static bool cmdPresetLoad(Theremin* theremin, const CommandArgs& args) {
+  int slot = args.getInt(0);
+  if (!validPresetSlot(slot)) {
+    return false;
+  }
+  if (!theremin->getPresetManager()->isUsed(slot - 1)) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Preset slot is empty");
+    return false;
+  }
+  theremin->getPresetManager()->requestRecall(slot - 1);
+  return true;
+}
+
+static bool cmdPresetDelete(Theremin* theremin, const CommandArgs& args) {
+  int slot = args.getInt(0);
+  if (!validPresetSlot(slot)) {
+    return false;
+  }
+  if (!theremin->getPresetManager()->isUsed(slot - 1)) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Preset slot is empty");
+    return false;
+  }
+  theremin->getPresetManager()->requestRemove(slot - 1);
+  return true;
+}
+
+static bool cmdMorphStart(Theremin* theremin, const CommandArgs& args) {
+  int from = args.getInt(0);
+  int to = args.getInt(1);
+  PresetManager* presets = theremin->getPresetManager();
+  if (!validPresetSlot(from) || !validPresetSlot(to)) {
+    return false;
+  }
+  if (!presets->isUsed(from - 1) || !presets->isUsed(to - 1)) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Both preset slots must be stored");
+    return false;
+  }
+  presets->requestStartMorph(from - 1, to - 1);
+  return true;
+}
+
+static bool cmdMorphStop(Theremin* theremin, const CommandArgs& args) {
+  theremin->getPresetManager()->requestStopMorph();
+  return true;
+}
+
+// Frequent (web slider): no logging
+static bool cmdMorphPosition(Theremin* theremin, const CommandArgs& args) {
+  PresetManager* presets = theremin->getPresetManager();
+  if (presets->getMorphSource() != PresetManager::MORPH_MANUAL) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Morph follows the sensor (morph:source:manual first)");
+    return false;
+  }
+  presets->setMorphPosition(args.getFloat(0));
+  return true;
+}
+
+static bool cmdMorphSource(Theremin* theremin, const CommandArgs& args) {
+  const char* source = args.getString(0);
+  if (strcasecmp(source, "sensor") == 0) {
+    theremin->getPresetManager()->setMorphSource(PresetManager::MORPH_SENSOR);
+  } else if (strcasecmp(source, "manual") == 0) {
+    theremin->getPresetManager()->setMorphSource(PresetManager::MORPH_MANUAL);
+  } else {
+    DEBUG_PRINTLN("[CTRL] ERROR: Morph source must be sensor or manual");
+    return false;
+  }
+  return true;
+}
+
+// ============================================================================
+// HANDLERS - automation
+// ============================================================================
+
+static void markAutomation(Theremin* theremin) {
+  theremin->getAudioEngine()->getStateTracker()->mark(StateTracker::AUTOMATION);
+}
+
+static bool cmdAutomationRecord(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getAutomation()->startRecording();
+  markAutomation(theremin);
+  DEBUG_PRINTLN("[CTRL] Automation recording (move a volume or effect control)");
+  return true;
+}
+
+static bool cmdAutomationPlay(Theremin* theremin, const CommandArgs& args) {
+  if (!theremin->getAudioEngine()->getAutomation()->startPlayback()) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Nothing recorded");
+    return false;
+  }
+  markAutomation(theremin);
+  return true;
+}
+
+static bool cmdAutomationStop(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getAutomation()->stop();
+  markAutomation(theremin);
+  return true;
+}
+
+static bool cmdAutomationClear(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getAutomation()->clear();
+  markAutomation(theremin);
+  return true;
+}
+
+// 0 = the next recording sets the length
+static bool cmdAutomationLength(Theremin* theremin, const CommandArgs& args) {
+  int32_t ms = args.getInt(0);
+  if (ms < 0 || ms > 600000) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Loop length must be 0-600000 ms");
+    return false;
+  }
+  theremin->getAudioEngine()->getAutomation()->setLoopLength((uint32_t)((uint64_t)ms * Audio::SAMPLE_RATE / 1000));
+  markAutomation(theremin);
+  return true;
+}
+
+static bool cmdAutomationStatus(Theremin* theremin, const CommandArgs& args) {
+  static const char* const STATE_NAMES[] = {"idle", "recording", "playing"};
+  AutomationLane* lane = theremin->getAudioEngine()->getAutomation();
+  DEBUG_PRINTLN("\n========== AUTOMATION ==========");
+  DEBUG_PRINTF("State:       %s\n", STATE_NAMES[lane->getState()]);
+  DEBUG_PRINTF("Events:      %u / %u\n", lane->getEventCount(), AutomationLane::MAX_EVENTS);
+  DEBUG_PRINTF("Loop length: %lu ms\n", (unsigned long)((uint64_t)lane->getLoopLength() * 1000 / Audio::SAMPLE_RATE));
+  DEBUG_PRINTF("Dropped:     %lu\n", (unsigned long)lane->getDropped());
+  DEBUG_PRINTLN("================================\n");
+  return true;
+}
+
+// ============================================================================
+// HANDLERS - looper
+// ============================================================================
+
+static void markLooper(Theremin* theremin) {
+  theremin->getAudioEngine()->getStateTracker()->mark(StateTracker::LOOPER);
+}
+
+// Record, close the loop, overdub, back to play (one button)
+static bool cmdLooperRecord(Theremin* theremin, const CommandArgs& args) {
+  if (!theremin->getAudioEngine()->getLooper()->record()) {
+    DEBUG_PRINTLN("[CTRL] ERROR: No memory for the looper");
+    return false;
+  }
+  markLooper(theremin);
+  return true;
+}
+
+static bool cmdLooperPlay(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getLooper()->play();
+  markLooper(theremin);
+  return true;
+}
+
+static bool cmdLooperStop(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getLooper()->stop();
+  markLooper(theremin);
+  return true;
+}
+
+static bool cmdLooperUndo(Theremin* theremin, const CommandArgs& args) {
+  if (!theremin->getAudioEngine()->getLooper()->undo()) {
+    DEBUG_PRINTLN("[CTRL] ERROR: No overdub to undo");
+    return false;
+  }
+  markLooper(theremin);
+  return true;
+}
+
+static bool cmdLooperClear(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getLooper()->clear();
+  markLooper(theremin);
+  return true;
+}
+
+static bool cmdLooperFeedback(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getLooper()->setFeedback(args.getFloat(0));
+  markLooper(theremin);
+  return true;
+}
+
+static bool cmdLooperLevel(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getLooper()->setLevel(args.getFloat(0));
+  markLooper(theremin);
+  return true;
+}
+
+static bool cmdLooperFormat(Theremin* theremin, const CommandArgs& args) {
+  const char* name = args.getString(0);
+  Looper::Format format;
+  if (strcasecmp(name, "pcm") == 0) {
+    format = Looper::FORMAT_PCM16;
+  } else if (strcasecmp(name, "ulaw") == 0) {
+    format = Looper::FORMAT_ULAW;
+  } else {
+    DEBUG_PRINTLN("[CTRL] ERROR: Format must be pcm or ulaw");
+    return false;
+  }
+  if (!theremin->getAudioEngine()->getLooper()->setFormat(format)) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Clear the loop before changing format");
+    return false;
+  }
+  markLooper(theremin);
+  return true;
+}
+
+static bool cmdLooperStatus(Theremin* theremin, const CommandArgs& args) {
+  static const char* const STATE_NAMES[] = {"empty", "recording", "playing", "overdubbing", "stopped"};
+  Looper* looper = theremin->getAudioEngine()->getLooper();
+  DEBUG_PRINTLN("\n========== LOOPER ==========");
+  DEBUG_PRINTF("State:    %s%s\n", STATE_NAMES[looper->getState()], looper->canUndo() ? " (undo available)" : "");
+  DEBUG_PRINTF("Format:   %s\n", looper->getFormat() == Looper::FORMAT_ULAW ? "u-law 8-bit" : "PCM 16-bit");
+  DEBUG_PRINTF("Length:   %lu / %lu ms\n",
+               (unsigned long)((uint64_t)looper->getLengthSamples() * 1000 / Audio::SAMPLE_RATE),
+               (unsigned long)((uint64_t)looper->getCapacitySamples() * 1000 / Audio::SAMPLE_RATE));
+  DEBUG_PRINT("Feedback: ");
+  DEBUG_PRINTLN(looper->getFeedback());
+  DEBUG_PRINT("Level:    ");
+  DEBUG_PRINTLN(looper->getLevel());
+  if (looper->getMemoryBytes() > 0) {
+    DEBUG_PRINTF("Memory:   %lu KB %s\n", (unsigned long)(looper->getMemoryBytes() / 1024),
+                 looper->isPsram() ? "PSRAM" : "internal");
+  } else {
+    DEBUG_PRINTLN("Memory:   not allocated");
+  }
+  DEBUG_PRINTLN("============================\n");
+  return true;
+}
+
+// ============================================================================
+// HANDLERS - capture (the WebSocket stream is started per client by
+// WebUIManager, "setAudioStream")
+// ============================================================================
+
+static bool parseCaptureFormat(const char* name, AudioCapture::Format& format) {
+  if (*name == '\0' || strcasecmp(name, "pcm") == 0) {
+    format = AudioCapture::FORMAT_PCM16;
+  } else if (strcasecmp(name, "adpcm") == 0) {
+    format = AudioCapture::FORMAT_ADPCM;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool cmdCaptureStart(Theremin* theremin, const CommandArgs& args) {
+  AudioCapture::Format format;
+  if (!parseCaptureFormat(args.getString(0), format)) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Format must be pcm or adpcm");
+    return false;
+  }
+  if (!theremin->getAudioCapture()->start(AudioCapture::SINK_FILE, format)) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Capture already running (or no memory)");
+    return false;
+  }
+  DEBUG_PRINTF("[CTRL] Capturing to %s\n", AudioCapture::FILE_PATH);
+  return true;
+}
+
+static bool cmdCaptureStop(Theremin* theremin, const CommandArgs& args) {
+  AudioCapture* capture = theremin->getAudioCapture();
+  if (capture->getSink() != AudioCapture::SINK_FILE) {
+    DEBUG_PRINTLN("[CTRL] ERROR: No file capture running");
+    return false;
+  }
+  capture->stop();
+  return true;
+}
+
+static bool cmdCaptureStatus(Theremin* theremin, const CommandArgs& args) {
+  static const char* const SINK_NAMES[] = {"idle", "file", "stream"};
+  static const char* const ERROR_NAMES[] = {"none", "no memory", "file not writable", "filesystem full"};
+  AudioCapture* capture = theremin->getAudioCapture();
+  DEBUG_PRINTLN("\n========== CAPTURE ==========");
+  DEBUG_PRINTF("State:    %s\n", SINK_NAMES[capture->getSink()]);
+  DEBUG_PRINTF("Format:   %s\n", capture->getFormat() == AudioCapture::FORMAT_ADPCM ? "IMA-ADPCM" : "PCM 16-bit");
+  DEBUG_PRINTF("Length:   %lu ms\n",
+               (unsigned long)((uint64_t)capture->getCapturedSamples() * 1000 / Audio::SAMPLE_RATE));
+  DEBUG_PRINTF("File:     %s, %lu bytes\n", AudioCapture::FILE_PATH, (unsigned long)capture->getFileBytes());
+  DEBUG_PRINTF("Dropped:  %lu blocks\n", (unsigned long)capture->getDroppedBlocks());
+  DEBUG_PRINTF("Error:    %s\n", ERROR_NAMES[capture->getError()]);
+  DEBUG_PRINTLN("=============================\n");
+  return true;
+}
+
+// ============================================================================
+// HANDLERS - effects
+// ============================================================================
+
+static AudioEffect* findEffect(Theremin* theremin, const char* name) {
+  AudioEffect* effect = theremin->getAudioEngine()->getEffectsChain()->findEffect(name);
+  if (effect == nullptr) {
+    DEBUG_PRINTF("[CTRL] ERROR: Unknown effect: %s\n", name);
+  }
+  return effect;
+}
+
+static bool cmdEnableEffect(Theremin* theremin, const CommandArgs& args) {
+  AudioEffect* effect = findEffect(theremin, args.getString(0));
+  if (effect == nullptr) {
+    return false;
+  }
+  theremin->getAudioEngine()->getEffectsChain()->setEffectEnabled(effect, args.getBool(1));
+  DEBUG_PRINTF("[CTRL] %s effect %s\n", effect->getName(), args.getBool(1) ? "enabled" : "disabled");
+  return true;
+}
+
+// Value defaults to the current one (web UI sliders always send it)
+static bool cmdEffectParam(Theremin* theremin, const CommandArgs& args) {
+  AudioEffect* effect = findEffect(theremin, args.getString(0));
+  if (effect == nullptr) {
+    return false;
+  }
+  int index = effect->findParam(args.getString(1));
+  if (index < 0) {
+    DEBUG_PRINTF("[CTRL] ERROR: Unknown %s parameter: %s\n", effect->getName(), args.getString(1));
+    return false;
+  }
+  float value = args.getFloat(2, effect->getParam(index));
+  theremin->getAudioEngine()->getEffectsChain()->setEffectParam(effect, index, value);
+  theremin->getAudioEngine()->recordEffectParam(effect, index, effect->getParam(index));
+  DEBUG_PRINTF("[CTRL] %s %s set to %.2f\n", effect->getName(), effect->getParamInfo(index).key,
+               effect->getParam(index));
+  return true;
+}
+
+// Comma-separated list (the web UI array is joined by the front end);
+// no list = default order
+static bool cmdEffectOrder(Theremin* theremin, const CommandArgs& args) {
+  EffectsChain* fx = theremin->getAudioEngine()->getEffectsChain();
+  if (!args.has(0)) {
+    fx->resetOrder();
+    DEBUG_PRINTLN("[CTRL] Effects order reset to default");
+    return true;
+  }
+  if (!fx->setOrder(args.getString(0))) {
+    DEBUG_PRINTLN("[CTRL] ERROR: Unknown or duplicate effect in order list");
+    return false;
+  }
+  DEBUG_PRINTLN("[CTRL] Effects order updated");
+  return true;
+}
+
+static bool cmdEffectOrderReset(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getEffectsChain()->resetOrder();
+  DEBUG_PRINTLN("[CTRL] Effects order reset to default");
+  return true;
+}
+
+static bool cmdEffectsStatus(Theremin* theremin, const CommandArgs& args) {
+  printEffectsStatus(theremin);
+  return true;
+}
+
+static bool cmdEffectsReset(Theremin* theremin, const CommandArgs& args) {
+  theremin->getAudioEngine()->getEffectsChain()->reset();
+  DEBUG_PRINTLN("[CTRL] All effects reset");
+  return true;
+}
+
+// ============================================================================
+// HANDLERS - oscillators
+// ============================================================================
+
+static bool cmdOscWaveform(Theremin* theremin, const CommandArgs& args) {
+  if (!validOscillator(args.getInt(0))) {
+    return false;
+  }
+  int waveform = parseWaveform(args.getString(1));
+  if (waveform < 0) {
+    DEBUG_PRINTF("[CTRL] ERROR: Unknown waveform: %s\n", args.getString(1));
+    return false;
+  }
+  theremin->getAudioEngine()->setOscillatorWaveform(args.getInt(0), (Oscillator::Waveform)waveform);
+  return true;
+}
+
+static bool cmdOscOctave(Theremin* theremin, const CommandArgs& args) {
+  if (!validOscillator(args.getInt(0))) {
+    return false;
+  }
+  theremin->getAudioEngine()->setOscillatorOctave(args.getInt(0), args.getInt(1));
+  return true;
+}
+
+static bool cmdOscVolume(Theremin* theremin, const CommandArgs& args) {
+  if (!validOscillator(args.getInt(0))) {
+    return false;
+  }
+  theremin->getAudioEngine()->setOscillatorVolume(args.getInt(0), args.getFloat(1));
+  theremin->getAudioEngine()->recordOscillatorVolume(args.getInt(0), constrain(args.getFloat(1), 0.0f, 1.0f));
+  return true;
+}
+
+// ============================================================================
+// COMMAND TABLE - one line per command, any order (sorted at startup).
+// Serial names use ':' paths, web UI names are camelCase; both can be typed
+// on the serial console.
+// ============================================================================
+
+static const Command COMMANDS[] = {
+    // System
+    {"help", "", cmdHelp},
+    {"?", "", cmdHelp},
+    {"system:help", "", cmdHelp},
+    {"status", "", cmdStatus},
+    {"system:status", "", cmdStatus},
+    {"status:osc#", "i:osc", cmdOscillatorStatus},
+    {"perf:reset", "", cmdPerfReset},
+    {"boot", "", cmdBoot},
+    {"system:boot", "", cmdBoot},
+    {"system:restart", "", cmdRestart},
+
+    // Sensors and smoothing
+    {"sensors:pitch", "b:enabled", cmdPitchSensor},
+    {"sensors:volume", "b:enabled", cmdVolumeSensor},
+    {"sensors:enable", "", cmdSensorsEnable},
+    {"sensors:disable", "", cmdSensorsDisable},
+    {"sensors:status", "", cmdSensorsStatus},
+    {"sensors:pitch:smooth", "b:enabled", cmdPitchSensorSmoothing},
+    {"sensors:volume:smooth", "b:enabled", cmdVolumeSensorSmoothing},
+    {"setSensorEnabled", "s:sensor b:enabled", cmdSetSensorEnabled},
+    {"smooth:pitch", "s:preset", cmdPitchSmoothingPreset},
+    {"smooth:volume", "s:preset", cmdVolumeSmoothingPreset},
+    {"setSmoothing", "s:target i:value", cmdSetSmoothing},
+    {"setRange", "i:value", cmdSetRange},
+
+    // Audio
+    {"audio:freq", "i:value", cmdFrequency},
+    {"audio:amp", "i:value", cmdAmplitude},
+    {"setAmplitude", "i:value", cmdAmplitude},
+    {"setFrequencyRange", "i:minFreq i:maxFreq", cmdFrequencyRange},
+    {"playNote", "i:note", cmdPlayNote},
+    {"stopNote", "", cmdStopNote},
+    {"audio:pitch:smooth", "f:value", cmdAudioPitchSmoothing},
+    {"audio:volume:smooth", "f:value", cmdAudioVolumeSmoothing},
+    {"audio:status", "", cmdAudioStatus},
+    {"audio:channel", "s:mode", cmdChannel},
+    {"audio:channel:status", "", cmdChannelStatus},
+    {"audio:quality", "s:preset", cmdQuality},
+    {"setQuality", "i:value", cmdSetQuality},
+
+    // Master bus
+    {"master:drive", "f:value", cmdMasterDrive},
+    {"master:limiter", "b:enabled", cmdLimiter},
+    {"master:gate:on", "", cmdGateOn},
+    {"master:gate:off", "", cmdGateOff},
+    {"master:gate", "i:open i:close", cmdGateThresholds},
+    {"master:status", "", cmdMasterStatus},
+
+    // Presets and morph
+    {"preset:list", "", cmdPresetList},
+    {"preset:next", "", cmdPresetNext},
+    {"preset:save", "i:slot s:name?", cmdPresetSave},
+    {"savePreset", "i:slot s:name?", cmdPresetSave},
+    {"preset:load", "i:slot", cmdPresetLoad},
+    {"loadPreset", "i:slot", cmdPresetLoad},
+    {"preset:delete", "i:slot", cmdPresetDelete},
+    {"deletePreset", "i:slot", cmdPresetDelete},
+    {"morph", "i:from i:to", cmdMorphStart},
+    {"startMorph", "i:from i:to", cmdMorphStart},
+    {"morph:off", "", cmdMorphStop},
+    {"stopMorph", "", cmdMorphStop},
+    {"morph:pos", "f:value", cmdMorphPosition},
+    {"setMorph", "f:value", cmdMorphPosition},
+    {"morph:source", "s:value", cmdMorphSource},
+    {"setMorphSource", "s:value", cmdMorphSource},
+
+    // Automation lane
+    {"automation:record", "", cmdAutomationRecord},
+    {"recordAutomation", "", cmdAutomationRecord},
+    {"automation:play", "", cmdAutomationPlay},
+    {"playAutomation", "", cmdAutomationPlay},
+    {"automation:stop", "", cmdAutomationStop},
+    {"stopAutomation", "", cmdAutomationStop},
+    {"automation:clear", "", cmdAutomationClear},
+    {"clearAutomation", "", cmdAutomationClear},
+    {"automation:length", "i:value", cmdAutomationLength},
+    {"setAutomationLength", "i:value", cmdAutomationLength},
+    {"automation:status", "", cmdAutomationStatus},
+
+    // Looper
+    {"looper:rec", "", cmdLooperRecord},
+    {"looperRecord", "", cmdLooperRecord},
+    {"looper:play", "", cmdLooperPlay},
+    {"looperPlay", "", cmdLooperPlay},
+    {"looper:stop", "", cmdLooperStop},
+    {"looperStop", "", cmdLooperStop},
+    {"looper:undo", "", cmdLooperUndo},
+    {"looperUndo", "", cmdLooperUndo},
+    {"looper:clear", "", cmdLooperClear},
+    {"looperClear", "", cmdLooperClear},
+    {"looper:feedback", "f:value", cmdLooperFeedback},
+    {"setLooperFeedback", "f:value", cmdLooperFeedback},
+    {"looper:level", "f:value", cmdLooperLevel},
+    {"setLooperLevel", "f:value", cmdLooperLevel},
+    {"looper:format", "s:format", cmdLooperFormat},
+    {"setLooperFormat", "s:format", cmdLooperFormat},
+    {"looper:status", "", cmdLooperStatus},
+
+    // Capture to LittleFS
+    {"capture:start", "s:format?", cmdCaptureStart},
+    {"startCapture", "s:format?", cmdCaptureStart},
+    {"capture:stop", "", cmdCaptureStop},
+    {"stopCapture", "", cmdCaptureStop},
+    {"capture:status", "", cmdCaptureStatus},
+
+    // Effects (serial shorthand <effect>:on|off and <effect>:<param>:<value>
+    // maps to enableEffect/setEffectParam, see SerialControls)
+    {"enableEffect", "s:effect b:value", cmdEnableEffect},
+    {"setEffectParam", "s:effect s:param f:value?", cmdEffectParam},
+    {"effects:order", "s:order?", cmdEffectOrder},
+    {"setEffectOrder", "s:order", cmdEffectOrder},
+    {"effects:order:reset", "", cmdEffectOrderReset},
+    {"effects:status", "", cmdEffectsStatus},
+    {"effects:reset", "", cmdEffectsReset},
+
+    // Oscillators ('#' = oscillator number: osc1:sine, osc2:vol:0.5)
+    {"osc#", "i:osc s:value", cmdOscWaveform},
+    {"setWaveform", "i:osc s:value", cmdOscWaveform},
+    {"osc#:octave", "i:osc i:value", cmdOscOctave},
+    {"osc#:oct", "i:osc i:value", cmdOscOctave},
+    {"setOctave", "i:osc i:value", cmdOscOctave},
+    {"osc#:volume", "i:osc f:value", cmdOscVolume},
+    {"osc#:vol", "i:osc f:value", cmdOscVolume},
+    {"setVolume", "i:osc f:value", cmdOscVolume},
+};
+
+static const uint8_t NUM_COMMANDS = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+static uint8_t sortedIndex[NUM_COMMANDS];
+
+// ============================================================================
+// REGISTRY
+// ============================================================================
+
+CommandRegistry::CommandRegistry(Theremin* thereminPtr)
+    : theremin(thereminPtr), table(COMMANDS), count(NUM_COMMANDS), sorted(sortedIndex) {
+  for (uint8_t i = 0; i < count; i++) {
+    sorted[i] = i;
+  }
+  std::sort(sorted, sorted + count, [](uint8_t a, uint8_t b) {
+    return strcasecmp(COMMANDS[a].name, COMMANDS[b].name) < 0;
+  });
+}
+
+const Command* CommandRegistry::find(const char* name) const {
+  int low = 0;
+  int high = count - 1;
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    const Command* command = &table[sorted[mid]];
+    int order = strcasecmp(name, command->name);
+    if (order == 0) {
+      return command;
+    }
+    if (order < 0) {
+      high = mid - 1;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return nullptr;
+}
+
+CommandRegistry::Result CommandRegistry::dispatch(const char* name, CommandInput& input) {
+  const Command* command = find(name);
+  if (command == nullptr) {
+    return CMD_UNKNOWN;
+  }
+  return execute(command, input);
+}
+
+CommandRegistry::Result CommandRegistry::execute(const Command* command, CommandInput& input) {
+  CommandArgs args;
+  uint8_t index = 0;
+  const char* spec = command->args;
+
+  // "<type>:<name>[?]" items separated by spaces
+  while (*spec != '\0') {
+    if (*spec == ' ') {
+      spec++;
+      continue;
+    }
+    char type = spec[0];
+    const char* keyStart = spec + 2;
+    size_t keyLength = strcspn(keyStart, " ?");
+    bool optional = (keyStart[keyLength] == '?');
+    spec = keyStart + keyLength + (optional ? 1 : 0);
+
+    if (index >= CommandArgs::MAX_ARGS) {
+      break;
+    }
+
+    char key[16];
+    if (keyLength >= sizeof(key)) {
+      keyLength = sizeof(key) - 1;
+    }
+    memcpy(key, keyStart, keyLength);
+    key[keyLength] = '\0';
+
+    CommandInput::Status status = CommandInput::ARG_INVALID;
+    CommandArgs::Value& value = args.values[index];
+    bool flag = false;
+    switch (type) {
+      case 'i': status = input.readInt(index, key, value.i); break;
+      case 'f': status = input.readFloat(index, key, value.f); break;
+      case 's': status = input.readString(index, key, value.s); break;
+      case 'b':
+        status = input.readBool(index, key, flag);
+        value.i = flag ? 1 : 0;
+        break;
+      default: break;
+    }
+
+    if (status == CommandInput::ARG_OK) {
+      args.present |= (1 << index);
+    } else if (status == CommandInput::ARG_INVALID || !optional) {
+      printUsage(command);
+      return CMD_BAD_ARGS;
+    }
+    index++;
+  }
+
+  // Positional front ends: nothing left over
+  if (input.count() > index) {
+    printUsage(command);
+    return CMD_BAD_ARGS;
+  }
+
+  return command->handler(theremin, args) ? CMD_OK : CMD_FAILED;
+}
+
+void CommandRegistry::printUsage(const Command* command) {
+  DEBUG_PRINT("[CTRL] Usage: ");
+  DEBUG_PRINT(command->name);
+
+  // The first argument of a '#' command is part of the name
+  bool skipFirst = (strchr(command->name, '#') != nullptr);
+  const char* spec = command->args;
+  while (*spec != '\0') {
+    if (*spec == ' ') {
+      spec++;
+      continue;
+    }
+    const char* keyStart = spec + 2;
+    size_t keyLength = strcspn(keyStart, " ?");
+    bool optional = (keyStart[keyLength] == '?');
+    spec = keyStart + keyLength + (optional ? 1 : 0);
+
+    if (skipFirst) {
+      skipFirst = false;
+      continue;
+    }
+    DEBUG_PRINT(optional ? "[:<" : ":<");
+    for (size_t i = 0; i < keyLength; i++) {
+      DEBUG_PRINT(keyStart[i]);
+    }
+    DEBUG_PRINT(optional ? ">]" : ">");
+  }
+  DEBUG_PRINTLN();
+}
+
+CommandInput::Status CommandRegistry::parseInt(const char* text, int32_t& out) {
+  char* end;
+  long value = strtol(text, &end, 10);
+  if (end == text || *end != '\0') {
+    return CommandInput::ARG_INVALID;
+  }
+  out = (int32_t)value;
+  return CommandInput::ARG_OK;
+}
+
+CommandInput::Status CommandRegistry::parseFloat(const char* text, float& out) {
+  char* end;
+  float value = strtof(text, &end);
+  if (end == text || *end != '\0') {
+    return CommandInput::ARG_INVALID;
+  }
+  out = value;
+  return CommandInput::ARG_OK;
+}
+
+CommandInput::Status CommandRegistry::parseBool(const char* text, bool& out) {
+  if (strcasecmp(text, "on") == 0 || strcasecmp(text, "true") == 0 || strcmp(text, "1") == 0) {
+    out = true;
+  } else if (strcasecmp(text, "off") == 0 || strcasecmp(text, "false") == 0 || strcmp(text, "0") == 0) {
+    out = false;
+  } else {
+    return CommandInput::ARG_INVALID;
+  }
+  return CommandInput::ARG_OK;
+}
+
+// ============================================================================
+// TOKEN INPUT
+// ============================================================================
+
+CommandInput::Status TokenInput::readInt(uint8_t index, const char* key, int32_t& out) {
+  return (index < tokenCount) ? CommandRegistry::parseInt(tokens[index], out) : ARG_MISSING;
+}
+
+CommandInput::Status TokenInput::readFloat(uint8_t index, const char* key, float& out) {
+  return (index < tokenCount) ? CommandRegistry::parseFloat(tokens[index], out) : ARG_MISSING;
+}
+
+CommandInput::Status TokenInput::readBool(uint8_t index, const char* key, bool& out) {
+  return (index < tokenCount) ? CommandRegistry::parseBool(tokens[index], out) : ARG_MISSING;
+}
+
+CommandInput::Status TokenInput::readString(uint8_t index, const char* key, const char*& out) {
+  if (index >= tokenCount) {
+    return ARG_MISSING;
+  }
+  out = tokens[index];
+  return ARG_OK;
+}
@@ -0,0 +1,74 @@
+/*
+ * DSPProfiler.cpp
+ *
+ * Implementation of per-stage CCOUNT profiling.
+ */
+
+#include "system/DSPProfiler.h"
+
+static const char* const STAGE_NAMES[DSPProfiler::STAGE_COUNT] = {
+  "osc", "delay", "chorus", "reverb", "master", "routing"
+};
+
+DSPProfiler::DSPProfiler()
+    : lastCycles(0) {
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    blockCycles[i] = 0;
+  }
+  reset();
+}
+
+void DSPProfiler::endBlock() {
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    uint32_t cycles = blockCycles[i];
+    blockCycles[i] = 0;
+
+    // avg += (cycles - avg) / 16, in integer form
+    uint32_t avg = avgCycles[i];
+    avgCycles[i] = avg - (avg >> 4) + (cycles >> 4);
+
+    if (cycles > peakCycles[i]) {
+      peakCycles[i] = cycles;
+    }
+  }
+}
+
+float DSPProfiler::cyclesToUs(uint32_t cycles) {
+  return (float)cycles / (float)ESP.getCpuFreqMHz();
+}
+
+float DSPProfiler::getAverageUs(int stage) const {
+  if (stage < 0 || stage >= STAGE_COUNT) {
+    return 0.0f;
+  }
+  return cyclesToUs(avgCycles[stage]);
+}
+
+float DSPProfiler::getPeakUs(int stage) const {
+  if (stage < 0 || stage >= STAGE_COUNT) {
+    return 0.0f;
+  }
+  return cyclesToUs(peakCycles[stage]);
+}
+
+float DSPProfiler::getTotalUs() const {
+  uint32_t total = 0;
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    total += avgCycles[i];
+  }
+  return cyclesToUs(total);
+}
+
+const char* DSPProfiler::getStageName(int stage) {
+  if (stage < 0 || stage >= STAGE_COUNT) {
+    return "?";
+  }
+  return STAGE_NAMES[stage];
+}
+
+void DSPProfiler::reset() {
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    avgCycles[i] = 0;
+    peakCycles[i] = 0;
+  }
+}
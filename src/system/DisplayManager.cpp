@@ -6,14 +6,28 @@
 
 #include "system/DisplayManager.h"
 #include "system/Debug.h"
+#include "system/BootTimeline.h"
 #include <algorithm>  // for std::sort
 
 const GFXfont* DisplayManager::SMALL_FONT = &TomThumb;
 
 DisplayManager::DisplayManager()
-    : display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET),
+    // Same clock during and after display(): the library would otherwise
+    // drop the shared bus back to 100 kHz after every direct transfer
+    : display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET, I2C_CLOCK_HZ, I2C_CLOCK_HZ),
+      bus(nullptr),
       currentPageIndex(0),
-      initialized(false) {
+      initialized(false),
+      dirtyRows(0),
+      flushPending(false),
+      forceFullFrame(true),
+      flushTaskHandle(nullptr),
+      initDone(nullptr),
+      lastFrameTime(0),
+      framesSent(0),
+      framesSkipped(0),
+      bytesSent(0) {
+    memset(shadow, 0, sizeof(shadow));
 }
 
 void DisplayManager::showLoadingScreen() {
@@ -32,30 +46,109 @@ void DisplayManager::showLoadingScreen() {
 
   display.setCursor(x, y);
   display.print(text);
-  display.display();
+  {
+    I2CBus::Lock lock(bus, I2CBus::CLIENT_DISPLAY, I2CBus::BOOT_ACQUIRE_TIMEOUT_MS);
+    if (lock) {
+      display.display();
+    }
+  }
+
+  // Drawn outside update(): resend everything on the first frame
+  invalidate();
 }
 
 bool DisplayManager::begin() {
     DEBUG_PRINTLN("DisplayManager: Initializing SSD1306 display...");
 
-    // Initialize display with I2C address from PinConfig
-    if (!display.begin(SSD1306_SWITCHCAPVCC, PIN_DISPLAY_I2C_ADDR)) {
-        DEBUG_PRINTLN("DisplayManager: ERROR - SSD1306 allocation failed!");
-        DEBUG_PRINTF("DisplayManager: Check I2C address (trying 0x%02X)\n", PIN_DISPLAY_I2C_ADDR);
-        initialized = false;
-        return false;
+    {
+        // Init sequence and first clear as one bus hold (may run next to
+        // the sensor init, see beginAsync())
+        I2CBus::Lock lock(bus, I2CBus::CLIENT_DISPLAY, I2CBus::BOOT_ACQUIRE_TIMEOUT_MS);
+
+        // Initialize display with I2C address from PinConfig
+        if (!lock || !display.begin(SSD1306_SWITCHCAPVCC, PIN_DISPLAY_I2C_ADDR)) {
+            DEBUG_PRINTLN("DisplayManager: ERROR - SSD1306 allocation failed!");
+            DEBUG_PRINTF("DisplayManager: Check I2C address (trying 0x%02X)\n", PIN_DISPLAY_I2C_ADDR);
+            initialized = false;
+            return false;
+        }
+
+        // Clear display
+        display.clearDisplay();
+        display.display();
     }
 
     DEBUG_PRINTLN("DisplayManager: Display initialized successfully");
 
-    // Clear display
-    display.clearDisplay();
-    display.display();
-
     initialized = true;
+
+    // I2C transfers off the loop task (Core 0, same low priority as the
+    // other background tasks)
+    BaseType_t result = xTaskCreatePinnedToCore(
+        flushTaskFunction,  // Task function
+        "DisplayTask",      // Task name
+        3072,               // Stack size (bytes)
+        this,               // Parameter (this pointer)
+        1,                  // Priority (low)
+        &flushTaskHandle,   // Task handle
+        0                   // Core ID (0 = protocol core)
+    );
+    if (result != pdPASS) {
+        // Still works, just flushes synchronously from update()
+        DEBUG_PRINTLN("DisplayManager: WARNING - flush task not created, flushing inline");
+        flushTaskHandle = nullptr;
+    }
+
     return true;
 }
 
+void DisplayManager::beginAsync() {
+    if (initDone == nullptr) {
+        initDone = xSemaphoreCreateBinary();
+    }
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        initTaskFunction,   // Task function
+        "DisplayInit",      // Task name
+        3072,               // Stack size (bytes)
+        this,               // Parameter (this pointer)
+        1,                  // Priority (low)
+        nullptr,            // Deletes itself
+        0                   // Core ID (0 = protocol core)
+    );
+    if (result != pdPASS) {
+        // Fall back to the synchronous path
+        DEBUG_PRINTLN("DisplayManager: WARNING - init task not created, initializing inline");
+        if (begin()) {
+            showLoadingScreen();
+        }
+        xSemaphoreGive(initDone);
+    }
+}
+
+void DisplayManager::initTaskFunction(void* parameter) {
+    DisplayManager* manager = static_cast<DisplayManager*>(parameter);
+
+    {
+        BootTimeline::Phase phase("display");
+        if (manager->begin()) {
+            manager->showLoadingScreen();
+        }
+    }
+
+    xSemaphoreGive(manager->initDone);
+    vTaskDelete(NULL);
+}
+
+bool DisplayManager::waitForBegin() {
+    // Every step of begin() is bounded (bus wait, Wire timeout), so this
+    // cannot hang; waiting it out keeps update() off a half-built panel
+    if (initDone != nullptr) {
+        xSemaphoreTake(initDone, portMAX_DELAY);
+    }
+    return initialized;
+}
+
 void DisplayManager::registerPage(String name, PageDrawCallback drawFunc, String title, int weight) {
     pages.emplace_back(name, drawFunc, title, weight);
 
@@ -104,11 +197,50 @@ void DisplayManager::previousPage() {
                  getCurrentPageName().c_str(), currentPageIndex + 1, pages.size());
 }
 
+bool DisplayManager::showPage(const String& name) {
+    for (size_t i = 0; i < pages.size(); i++) {
+        if (pages[i].name == name) {
+            currentPageIndex = i;
+            return true;
+        }
+    }
+    return false;
+}
+
 void DisplayManager::update() {
     if (!initialized || pages.empty()) {
         return;
     }
 
+    // Frame cap
+    uint32_t now = millis();
+    if (now - lastFrameTime < FRAME_INTERVAL_MS) {
+        return;
+    }
+
+    // Previous frame still on the bus: skip this one (the next frame
+    // carries every change since the last transfer)
+    if (flushPending) {
+        framesSkipped++;
+        return;
+    }
+    lastFrameTime = now;
+
+    renderFrame();
+
+    if (!collectDirtyRows()) {
+        return;  // Nothing changed on screen - no bus traffic
+    }
+
+    if (flushTaskHandle != nullptr) {
+        flushPending = true;
+        xTaskNotifyGive(flushTaskHandle);
+    } else {
+        flushRows();
+    }
+}
+
+void DisplayManager::renderFrame() {
     // Clear display
     display.clearDisplay();
 
@@ -155,7 +287,109 @@ void DisplayManager::update() {
         display.print(indicator);
         display.setFont();  // Reset to default font
     }
+}
+
+bool DisplayManager::collectDirtyRows() {
+    const uint8_t* buffer = display.getBuffer();
+    dirtyRows = 0;
+
+    for (int row = 0; row < PAGE_ROWS; row++) {
+        const uint8_t* current = buffer + row * SCREEN_WIDTH;
+        uint8_t* shown = shadow + row * SCREEN_WIDTH;
+
+        int first = -1;
+        int last = -1;
+        if (forceFullFrame) {
+            first = 0;
+            last = SCREEN_WIDTH - 1;
+        } else {
+            for (int x = 0; x < SCREEN_WIDTH; x++) {
+                if (current[x] != shown[x]) {
+                    if (first < 0) first = x;
+                    last = x;
+                }
+            }
+        }
+
+        if (first >= 0) {
+            memcpy(shown + first, current + first, last - first + 1);
+            rowFirst[row] = first;
+            rowLast[row] = last;
+            dirtyRows |= (1 << row);
+        }
+    }
+
+    forceFullFrame = false;
+    return dirtyRows != 0;
+}
+
+uint8_t DisplayManager::sendCommands(const uint8_t* commands, size_t count) {
+    Wire.beginTransmission(PIN_DISPLAY_I2C_ADDR);
+    Wire.write((uint8_t)0x00);  // Control byte: command stream
+    Wire.write(commands, count);
+    return Wire.endTransmission();
+}
+
+void DisplayManager::flushRows() {
+    // Sent straight through Wire (not display(), which pushes the whole
+    // 1 KB buffer), one page row per bus lock: the display is the lowest
+    // priority client, so sensor and expander reads wait at most one row
+    for (int row = 0; row < PAGE_ROWS; row++) {
+        if (!(dirtyRows & (1 << row))) {
+            continue;
+        }
+
+        I2CBus::Lock lock(bus, I2CBus::CLIENT_DISPLAY);
+        if (!lock) {
+            // Bus unavailable: the panel no longer matches the shadow copy
+            forceFullFrame = true;
+            continue;
+        }
+        I2CBus::Result result = flushRow(row);
+        lock.setResult(result);
+        if (result != I2CBus::RESULT_OK) {
+            forceFullFrame = true;
+        }
+    }
+
+    framesSent++;
+}
 
-    // Push to display
-    display.display();
+I2CBus::Result DisplayManager::flushRow(int row) {
+    const uint8_t window[] = {
+        SSD1306_PAGEADDR, (uint8_t)row, (uint8_t)row,
+        SSD1306_COLUMNADDR, rowFirst[row], rowLast[row]
+    };
+    uint8_t status = sendCommands(window, sizeof(window));
+    if (status != 0) {
+        return I2CBus::fromWire(status);
+    }
+
+    const uint8_t* data = shadow + row * SCREEN_WIDTH + rowFirst[row];
+    size_t remaining = rowLast[row] - rowFirst[row] + 1;
+    while (remaining > 0) {
+        size_t chunk = remaining > DATA_CHUNK ? DATA_CHUNK : remaining;
+        Wire.beginTransmission(PIN_DISPLAY_I2C_ADDR);
+        Wire.write((uint8_t)0x40);  // Control byte: data stream
+        Wire.write(data, chunk);
+        status = Wire.endTransmission();
+        if (status != 0) {
+            return I2CBus::fromWire(status);
+        }
+        data += chunk;
+        remaining -= chunk;
+        bytesSent += chunk;
+    }
+
+    return I2CBus::RESULT_OK;
+}
+
+void DisplayManager::flushTaskFunction(void* parameter) {
+    DisplayManager* manager = static_cast<DisplayManager*>(parameter);
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        manager->flushRows();
+        manager->flushPending = false;
+    }
 }
@@ -0,0 +1,200 @@
+/*
+ * I2CBus.cpp
+ *
+ * Shared I2C bus setup, priority arbitration, statistics and recovery.
+ * See I2CBus.h for the design notes.
+ */
+
+#include "system/I2CBus.h"
+#include "system/Debug.h"
+
+static const char* const CLIENT_NAMES[I2CBus::NUM_CLIENTS] = {
+  "sensors", "expander", "display"
+};
+
+I2CBus::I2CBus()
+    : mutex(nullptr),
+      sdaPin(-1),
+      sclPin(-1),
+      clockHz(I2C_CLOCK_HZ),
+      acquiredAt(0),
+      nackCount(0),
+      timeoutCount(0),
+      errorCount(0),
+      recoveryCount(0),
+      consecutiveErrors(0),
+      windowStart(0),
+      windowBusyUs(0),
+      utilization(0),
+      waitMux(portMUX_INITIALIZER_UNLOCKED) {
+  for (int i = 0; i < NUM_CLIENTS; i++) {
+    waiting[i] = 0;
+    transactions[i] = 0;
+  }
+}
+
+void I2CBus::begin(int sda, int scl, uint32_t clock) {
+  sdaPin = sda;
+  sclPin = scl;
+  clockHz = clock;
+
+  Wire.begin(sdaPin, sclPin);
+  Wire.setClock(clockHz);
+  Wire.setTimeOut(TIMEOUT_MS);
+
+  if (mutex == nullptr) {
+    mutex = xSemaphoreCreateMutex();
+  }
+  windowStart = millis();
+
+  DEBUG_PRINTF("[I2C] Bus initialized on SDA=%d, SCL=%d at %lu kHz\n",
+               sdaPin, sclPin, (unsigned long)(clockHz / 1000));
+}
+
+void I2CBus::setWaiting(Client client, bool add) {
+  portENTER_CRITICAL(&waitMux);
+  if (add) {
+    waiting[client]++;
+  } else {
+    waiting[client]--;
+  }
+  portEXIT_CRITICAL(&waitMux);
+}
+
+bool I2CBus::shouldYield(Client client) const {
+  for (int c = 0; c < client; c++) {
+    if (waiting[c] > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool I2CBus::acquire(Client client, uint32_t timeoutMs) {
+  if (mutex == nullptr) {
+    return true;  // Not started yet (boot-time device setup)
+  }
+
+  setWaiting(client, true);
+
+  // Step aside while a higher-priority client is queued; otherwise wait
+  // for the current holder in short steps so a higher-priority arrival is
+  // noticed
+  uint32_t start = millis();
+  bool taken = false;
+  while (!taken && millis() - start < timeoutMs) {
+    if (shouldYield(client)) {
+      vTaskDelay(1);
+      continue;
+    }
+    taken = (xSemaphoreTake(mutex, 1) == pdTRUE);
+  }
+
+  setWaiting(client, false);
+
+  if (taken) {
+    acquiredAt = micros();
+  }
+  return taken;
+}
+
+void I2CBus::release(Client client, Result result) {
+  if (mutex == nullptr) {
+    return;
+  }
+
+  // Still holding the bus: the statistics have a single writer
+  transactions[client]++;
+
+  switch (result) {
+    case RESULT_OK:      break;
+    case RESULT_NACK:    nackCount++; break;
+    case RESULT_TIMEOUT: timeoutCount++; break;
+    default:             errorCount++; break;
+  }
+
+  if (result == RESULT_OK) {
+    consecutiveErrors = 0;
+  } else if (++consecutiveErrors >= RECOVERY_THRESHOLD) {
+    recover();
+    consecutiveErrors = 0;
+  }
+
+  // Time the bus was held, averaged over STATS_WINDOW_MS
+  windowBusyUs += micros() - acquiredAt;
+  uint32_t now = millis();
+  uint32_t elapsed = now - windowStart;
+  if (elapsed >= STATS_WINDOW_MS) {
+    uint32_t percent = windowBusyUs / (elapsed * 10);
+    utilization = (percent > 100) ? 100 : (uint8_t)percent;
+    windowBusyUs = 0;
+    windowStart = now;
+  }
+
+  xSemaphoreGive(mutex);
+}
+
+bool I2CBus::probe(uint8_t address) {
+  Wire.beginTransmission(address);
+  return Wire.endTransmission() == 0;
+}
+
+I2CBus::Result I2CBus::fromWire(uint8_t code) {
+  switch (code) {
+    case 0:  return RESULT_OK;
+    case 2:                      // Address NACK
+    case 3:  return RESULT_NACK; // Data NACK
+    case 5:  return RESULT_TIMEOUT;
+    default: return RESULT_ERROR;
+  }
+}
+
+void I2CBus::recover() {
+  DEBUG_PRINTF("[I2C] %u consecutive errors - recovering bus\n", (unsigned)consecutiveErrors);
+
+  Wire.end();
+
+  // A slave interrupted mid-byte may hold SDA low: clock it out (at most
+  // nine pulses), then issue a STOP so every device sees an idle bus
+  pinMode(sdaPin, INPUT_PULLUP);
+  pinMode(sclPin, OUTPUT_OPEN_DRAIN);
+  digitalWrite(sclPin, HIGH);
+  delayMicroseconds(5);
+  for (int i = 0; i < 9 && digitalRead(sdaPin) == LOW; i++) {
+    digitalWrite(sclPin, LOW);
+    delayMicroseconds(5);
+    digitalWrite(sclPin, HIGH);
+    delayMicroseconds(5);
+  }
+
+  pinMode(sdaPin, OUTPUT_OPEN_DRAIN);
+  digitalWrite(sdaPin, LOW);
+  delayMicroseconds(5);
+  digitalWrite(sdaPin, HIGH);
+  delayMicroseconds(5);
+
+  Wire.begin(sdaPin, sclPin);
+  Wire.setClock(clockHz);
+  Wire.setTimeOut(TIMEOUT_MS);
+
+  recoveryCount++;
+}
+
+const char* I2CBus::clientName(Client client) {
+  return (client >= 0 && client < NUM_CLIENTS) ? CLIENT_NAMES[client] : "?";
+}
+
+void I2CBus::printStats() const {
+  DEBUG_PRINTLN("\n========== I2C BUS ==========");
+  DEBUG_PRINTF("Clock:        %lu kHz\n", (unsigned long)(clockHz / 1000));
+  DEBUG_PRINTF("Utilization:  %u%%\n", (unsigned)utilization);
+  DEBUG_PRINTLN("Transactions:");
+  for (int i = 0; i < NUM_CLIENTS; i++) {
+    DEBUG_PRINTF("  %-9s %lu\n", CLIENT_NAMES[i], (unsigned long)transactions[i]);
+  }
+  DEBUG_PRINTF("Errors:       %lu NACK, %lu timeout, %lu other\n",
+               (unsigned long)nackCount, (unsigned long)timeoutCount,
+               (unsigned long)errorCount);
+  DEBUG_PRINTF("Recoveries:   %lu\n", (unsigned long)recoveryCount);
+  DEBUG_PRINTLN("=============================\n");
+}
@@ -11,6 +11,7 @@
 
   #include "system/Debug.h"
   #include "system/Theremin.h"
+  #include "system/BootTimeline.h"
   #include <LittleFS.h>
 
 // Constructor
@@ -23,7 +24,14 @@ NetworkManager::NetworkManager(DisplayManager* disp, Theremin* thmn)
       isInitialized(false),
       mdnsInitialized(false),
       apName("Theremin-Setup"),
-      mdnsHostname("theremin") {
+      mdnsHostname("theremin"),
+      connectTimeoutMs(15000),
+      resetCredentials(false),
+      forcePortal(false),
+      taskHandle(nullptr),
+      state(NET_OFF),
+      stateStart(0),
+      portalButtonReleased(false) {
   // Register network status display page using lambda (consistent with Theremin pattern)
   if (display) {
     display->registerPage(
@@ -34,6 +42,10 @@ NetworkManager::NetworkManager(DisplayManager* disp, Theremin* thmn)
 
 // Destructor
 NetworkManager::~NetworkManager() {
+  if (taskHandle != nullptr) {
+    vTaskDelete(taskHandle);
+    taskHandle = nullptr;
+  }
   if (webUI) {
     delete webUI;
     webUI = nullptr;
@@ -45,52 +57,86 @@ void NetworkManager::setTheremin(Theremin* thmn) {
   theremin = thmn;
 }
 
-// Initialize all network services
+// Start network bring-up (NetTask does the work)
 bool NetworkManager::begin(const char* apName, const char* otaUser, const char* otaPass,
                            uint8_t connectTimeout, uint16_t portalTimeout, bool resetCredentials,
                            bool forcePortal) {
+  (void)portalTimeout;  // Portal closes on button press or after PORTAL_MAX_DURATION_MS
+
   DEBUG_PRINTLN("\n[Network] Initializing NetworkManager...");
 
-  // Store configuration
+  // Store configuration for the task
   this->apName = apName;
-
-  // Setup WiFi connection
-  setupWiFi(connectTimeout, portalTimeout, resetCredentials, forcePortal);
-
-  // Setup mDNS if connected to WiFi
-  if (WiFi.isConnected()) {
-    setupMDNS(mdnsHostname.c_str());
+  this->otaUser = otaUser;
+  this->otaPass = otaPass;
+  this->connectTimeoutMs = (uint32_t)connectTimeout * 1000;
+  this->resetCredentials = resetCredentials;
+  this->forcePortal = forcePortal;
+
+  setState(NET_STARTING);
+
+  // Core 0 next to the WiFi stack, low priority: never competes with the
+  // audio task, and setup() carries on to start playing right away
+  BaseType_t result = xTaskCreatePinnedToCore(
+      taskFunction,   // Task function
+      "NetTask",      // Task name
+      8192,           // Stack size (bytes) - WiFiManager portal + WebUI setup
+      this,           // Parameter (this pointer)
+      1,              // Priority (low)
+      &taskHandle,    // Task handle
+      0               // Core ID (0 = protocol core)
+  );
+
+  if (result != pdPASS) {
+    DEBUG_PRINTLN("[Network] ERROR: Failed to create network task");
+    taskHandle = nullptr;
+    setState(NET_OFF);
+    return false;
   }
 
-  // Setup OTA
-  setupOTA(otaUser, otaPass);
+  DEBUG_PRINTLN("[Network] Bring-up continues in the background");
+  return true;
+}
 
-  // Initialize WebUI if Theremin is available
-  if (theremin) {
-    DEBUG_PRINTLN("[Network] Initializing WebUI...");
-    webUI = new WebUIManager(&server, theremin);
-    webUI->begin();
-  } else {
-    DEBUG_PRINTLN("[Network] WARNING: Theremin not set, WebUI disabled");
-    DEBUG_PRINTLN("[Network] Call setTheremin() before begin() to enable WebUI");
-  }
+void NetworkManager::taskFunction(void* parameter) {
+  NetworkManager* network = static_cast<NetworkManager*>(parameter);
 
-  // Setup static file serving
-  setupStaticFiles();
+  while (network->state != NET_RUNNING && network->state != NET_OFF) {
+    network->step();
+    vTaskDelay(pdMS_TO_TICKS(STEP_INTERVAL_MS));
+  }
 
-  // Start the web server
-  server.begin();
-  DEBUG_PRINTLN("[Network] AsyncWebServer started on port 80");
+  // Bring-up finished: the server and WebUI run on their own tasks
+  network->taskHandle = nullptr;
+  vTaskDelete(NULL);
+}
 
-  isInitialized = true;
-  DEBUG_PRINTLN("[Network] NetworkManager initialized successfully\n");
+void NetworkManager::setState(NetState newState) {
+  state = newState;
+  stateStart = millis();
+}
 
-  return true;
+void NetworkManager::step() {
+  switch (state) {
+    case NET_STARTING:
+      startWiFi();
+      break;
+    case NET_CONNECTING:
+      pollConnect();
+      break;
+    case NET_PORTAL:
+      pollPortal();
+      break;
+    case NET_SERVICES:
+      startServices();
+      break;
+    default:
+      break;
+  }
 }
 
-// Setup WiFi connection with WiFiManager
-void NetworkManager::setupWiFi(uint8_t connectTimeout, uint16_t portalTimeout, bool resetCredentials,
-                                bool forcePortal) {
+// First step: saved network, captive portal, or straight to AP
+void NetworkManager::startWiFi() {
   DEBUG_PRINTLN("[WiFi] Configuring WiFiManager...");
 
   // Reset saved WiFi credentials if requested
@@ -111,109 +157,101 @@ void NetworkManager::setupWiFi(uint8_t connectTimeout, uint16_t portalTimeout, b
   });
 
   if (forcePortal) {
-    // FORCE PORTAL MODE: Button pressed during boot
-    // Show captive portal for WiFi configuration with button exit option
-    DEBUG_PRINTLN("[WiFi] Force portal mode - button pressed during boot");
-    DEBUG_PRINTLN("[WiFi] Starting non-blocking captive portal...");
-
-    // Update display to show WiFi config message (Option B)
-    if (display) {
-      Adafruit_SSD1306& oled = display->getDisplay();
-      oled.clearDisplay();
-      oled.setTextSize(1);
-      oled.setTextColor(SSD1306_WHITE);
-      oled.setCursor(0, 0);
-      oled.println("WiFi Setup...");
-      oled.println("");
-      oled.println("Connect to:");
-      oled.println("192.168.4.1");
-      oled.println("");
-      oled.println("Push btn to exit");
-      oled.println("and start local AP");
-      oled.println("for Web UI");
-      oled.display();
-    }
+    startPortal();
+    return;
+  }
 
-    // Configure non-blocking portal
-    wifiManager.setConfigPortalBlocking(false);
-    wifiManager.setConfigPortalTimeout(0);  // No automatic timeout
-    wifiManager.setConnectTimeout(connectTimeout);
+  if (!wifiManager.getWiFiIsSaved()) {
+    DEBUG_PRINTLN("[WiFi] No saved network");
+    startAccessPoint();
+    return;
+  }
 
-    // Start the config portal
-    wifiManager.startConfigPortal(apName.c_str());
+  // Join the saved network; pollConnect() waits for it without blocking
+  DEBUG_PRINT("[WiFi] Attempting to connect");
+  if (connectTimeoutMs > 0) {
+    DEBUG_PRINTF(" (timeout: %lus)", (unsigned long)(connectTimeoutMs / 1000));
+  }
+  DEBUG_PRINTLN("...");
 
-    // Monitor loop - check button and portal status
-    unsigned long startTime = millis();
-    unsigned long maxDuration = 300000;  // 5 minutes maximum
-    bool portalActive = true;
+  WiFi.mode(WIFI_STA);
+  WiFi.begin();
+  setState(NET_CONNECTING);
+}
 
-    DEBUG_PRINTLN("[WiFi] Portal active - press button to exit");
+// FORCE PORTAL MODE: button pressed during boot
+void NetworkManager::startPortal() {
+  DEBUG_PRINTLN("[WiFi] Force portal mode - button pressed during boot");
+  DEBUG_PRINTLN("[WiFi] Starting non-blocking captive portal...");
 
-    while (portalActive && (millis() - startTime < maxDuration)) {
-      // Process WiFiManager events
-      wifiManager.process();
+  // Instructions on the Network page (the display keeps running)
+  if (display) {
+    display->showPage("Network");
+  }
 
-      // Check if WiFi connected (user configured via portal)
-      if (WiFi.isConnected()) {
-        DEBUG_PRINTLN("[WiFi] WiFi configured via portal");
-        portalActive = false;
-        break;
-      }
+  wifiManager.setConfigPortalBlocking(false);
+  wifiManager.setConfigPortalTimeout(0);  // Closed by pollPortal()
+  wifiManager.setConnectTimeout(connectTimeoutMs / 1000);
+  wifiManager.startConfigPortal(apName.c_str());
 
-      // Check button state (via Theremin instance)
-      if (theremin && theremin->getMCP().digitalRead(PIN_MULTI_BUTTON) == LOW) {
-        DEBUG_PRINTLN("[WiFi] Button pressed - exiting portal");
-        wifiManager.stopConfigPortal();
-        portalActive = false;
-        delay(500);  // Debounce
-        break;
-      }
+  portalButtonReleased = false;
+  setState(NET_PORTAL);
+  DEBUG_PRINTLN("[WiFi] Portal active - press button to exit");
+}
 
-      delay(100);  // Check every 100ms
-    }
+void NetworkManager::pollConnect() {
+  if (WiFi.isConnected()) {
+    onWiFiUp();
+    return;
+  }
 
-    // Check for timeout
-    if (millis() - startTime >= maxDuration) {
-      DEBUG_PRINTLN("[WiFi] Config portal timed out after 5 minutes");
-      wifiManager.stopConfigPortal();
-    }
+  if (millis() - stateStart >= connectTimeoutMs) {
+    DEBUG_PRINTLN("[WiFi] Failed to connect to WiFi");
+    startAccessPoint();
+  }
+}
 
-    // Restore loading screen
-    if (display) {
-      display->showLoadingScreen();
-    }
+void NetworkManager::pollPortal() {
+  // Process WiFiManager events
+  wifiManager.process();
 
-    // If not connected, start AP mode
-    if (!WiFi.isConnected()) {
-      DEBUG_PRINTLN("[WiFi] Starting AP mode without portal...");
-      WiFi.mode(WIFI_AP);
-      WiFi.softAP(apName.c_str());
-    }
-  } else {
-    // NORMAL MODE: Non-blocking WiFi setup
-    // Try to connect, fallback to AP mode without blocking portal
-    DEBUG_PRINTLN("[WiFi] Normal mode - non-blocking WiFi setup");
-
-    wifiManager.setConnectTimeout(connectTimeout);
-    wifiManager.setConfigPortalTimeout(0);  // No portal timeout
-
-    DEBUG_PRINT("[WiFi] Attempting to connect");
-    if (connectTimeout > 0) {
-      DEBUG_PRINT(" (timeout: ");
-      DEBUG_PRINT(connectTimeout);
-      DEBUG_PRINT("s)");
-    }
-    DEBUG_PRINTLN("...");
+  // Check if WiFi connected (user configured via portal)
+  if (WiFi.isConnected()) {
+    DEBUG_PRINTLN("[WiFi] WiFi configured via portal");
+    onWiFiUp();
+    return;
+  }
 
-    if (!wifiManager.autoConnect(apName.c_str())) {
-      DEBUG_PRINTLN("[WiFi] Failed to connect to WiFi");
-      DEBUG_PRINTLN("[WiFi] Starting AP mode for web access...");
+  // Button (debounced state from GPIOControls, no bus access from this
+  // task). It is still held from boot: wait for a release first.
+  bool pressed = theremin && theremin->getGPIOControls()->isButtonPressed();
+  if (!pressed) {
+    portalButtonReleased = true;
+  } else if (portalButtonReleased) {
+    DEBUG_PRINTLN("[WiFi] Button pressed - exiting portal");
+    wifiManager.stopConfigPortal();
+    startAccessPoint();
+    return;
+  }
 
-      // Start AP mode without captive portal
-      WiFi.mode(WIFI_AP);
-      WiFi.softAP(apName.c_str());
-    }
+  if (millis() - stateStart >= PORTAL_MAX_DURATION_MS) {
+    DEBUG_PRINTLN("[WiFi] Config portal timed out after 5 minutes");
+    wifiManager.stopConfigPortal();
+    startAccessPoint();
   }
+}
+
+// Fallback: local access point for the web interface (no portal)
+void NetworkManager::startAccessPoint() {
+  DEBUG_PRINTLN("[WiFi] Starting AP mode for web access...");
+  WiFi.disconnect();
+  WiFi.mode(WIFI_AP);
+  WiFi.softAP(apName.c_str());
+  onWiFiUp();
+}
+
+void NetworkManager::onWiFiUp() {
+  BootTimeline::mark(BootTimeline::WIFI_UP);
 
   // Print connection status
   if (WiFi.isConnected()) {
@@ -231,6 +269,9 @@ void NetworkManager::setupWiFi(uint8_t connectTimeout, uint16_t portalTimeout, b
     DEBUG_PRINT("[WiFi] Signal: ");
     DEBUG_PRINT(WiFi.RSSI());
     DEBUG_PRINTLN(" dBm");
+
+    // Setup mDNS if connected to WiFi
+    setupMDNS(mdnsHostname.c_str());
   }
   else {
     DEBUG_PRINTLN("[WiFi] Running in Access Point mode");
@@ -240,6 +281,38 @@ void NetworkManager::setupWiFi(uint8_t connectTimeout, uint16_t portalTimeout, b
     DEBUG_PRINTLN(WiFi.softAPIP());
     DEBUG_PRINTLN("[WiFi] Connect to this AP to access the web interface");
   }
+
+  setState(NET_SERVICES);
+}
+
+// Last step: OTA, WebUI, static files, server
+void NetworkManager::startServices() {
+  // Setup OTA
+  setupOTA(otaUser.c_str(), otaPass.c_str());
+
+  // Initialize WebUI if Theremin is available
+  if (theremin) {
+    DEBUG_PRINTLN("[Network] Initializing WebUI...");
+    webUI = new WebUIManager(&server, theremin);
+    webUI->begin();
+  } else {
+    DEBUG_PRINTLN("[Network] WARNING: Theremin not set, WebUI disabled");
+    DEBUG_PRINTLN("[Network] Call setTheremin() before begin() to enable WebUI");
+  }
+
+  // Setup static file serving
+  setupStaticFiles();
+
+  // Start the web server
+  server.begin();
+  BootTimeline::mark(BootTimeline::WEB_SERVER_UP);
+  DEBUG_PRINTLN("[Network] AsyncWebServer started on port 80");
+
+  // Published last: update() starts calling the WebUI from the loop task
+  isInitialized = true;
+  setState(NET_RUNNING);
+  DEBUG_PRINTLN("[Network] NetworkManager initialized successfully\n");
+  BootTimeline::print();
 }
 
 // Setup mDNS service
@@ -315,11 +388,123 @@ void NetworkManager::setupStaticFiles() {
 
   DEBUG_PRINTLN("[Network] LittleFS mounted successfully");
 
-  // Serve all static files from root directory
+  // Precompressed web UI (npm run build writes name.gz files)
+  int gzipAssets = registerGzipAssets();
+
+  // Latest audio capture as a download (rewritten by every capture, never cached)
+  this->server.on(AudioCapture::FILE_PATH, HTTP_GET, [this](AsyncWebServerRequest* request) {
+    AudioCapture* capture = theremin ? theremin->getAudioCapture() : nullptr;
+    if (capture && capture->getSink() == AudioCapture::SINK_FILE) {
+      request->send(409, "text/plain", "Capture in progress - stop it first");
+      return;
+    }
+    if (!LittleFS.exists(AudioCapture::FILE_PATH)) {
+      request->send(404, "text/plain", "No capture yet");
+      return;
+    }
+    AsyncWebServerResponse* response = request->beginResponse(LittleFS, AudioCapture::FILE_PATH, "audio/wav", true);
+    response->addHeader("Cache-Control", "no-store");
+    request->send(response);
+  });
+
+  // Anything else (uncompressed files, an older data/ image)
   // Automatically handles MIME types, subdirectories, and caching
   this->server.serveStatic("/", LittleFS, "/").setDefaultFile("index.html");
 
-  DEBUG_PRINTLN("[Network] Static file serving enabled");
+  DEBUG_PRINTF("[Network] Static file serving enabled (%d gzip assets)\n", gzipAssets);
+}
+
+// MIME type from the file extension (name without ".gz")
+static const char* assetContentType(const String& path) {
+  if (path.endsWith(".html")) return "text/html";
+  if (path.endsWith(".js")) return "application/javascript";
+  if (path.endsWith(".css")) return "text/css";
+  if (path.endsWith(".svg")) return "image/svg+xml";
+  if (path.endsWith(".json")) return "application/json";
+  if (path.endsWith(".ico")) return "image/x-icon";
+  if (path.endsWith(".png")) return "image/png";
+  return "application/octet-stream";
+}
+
+// Vite names bundles "name.<hash>.ext": the name changes with the content,
+// so the file itself never does
+static bool assetIsContentHashed(const String& path) {
+  int lastDot = path.lastIndexOf('.');
+  return lastDot > 0 && path.lastIndexOf('.', lastDot - 1) > path.lastIndexOf('/');
+}
+
+// Register one GET route per "name.gz" in the LittleFS root:
+// - Body streamed from flash as is, with Content-Encoding: gzip (no
+//   decompression, no RAM copy of the file)
+// - Hashed bundles are cached by the browser for a year; index.html is
+//   revalidated on every load, so a new build is picked up at once
+// - ETag from the gzip trailer (CRC-32 + length of the original), read once
+//   here; a matching If-None-Match gets an empty 304
+int NetworkManager::registerGzipAssets() {
+  File root = LittleFS.open("/");
+  if (!root || !root.isDirectory()) {
+    return 0;
+  }
+
+  int count = 0;
+  File entry = root.openNextFile();
+  while (entry) {
+    String name = entry.name();
+    if (!name.startsWith("/")) {
+      name = "/" + name;
+    }
+
+    // Smallest gzip member is 18 bytes (10 header + 8 trailer)
+    if (!entry.isDirectory() && name.endsWith(".gz") && entry.size() >= 18) {
+      uint8_t trailer[8];
+      entry.seek(entry.size() - sizeof(trailer));
+      if (entry.read(trailer, sizeof(trailer)) == sizeof(trailer)) {
+        uint32_t crc = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+        uint32_t length = trailer[4] | (trailer[5] << 8) | (trailer[6] << 16) | ((uint32_t)trailer[7] << 24);
+        char etagBuffer[24];
+        snprintf(etagBuffer, sizeof(etagBuffer), "\"%08lx-%lx\"", (unsigned long)crc, (unsigned long)length);
+
+        String gzipPath = name;
+        String url = name.substring(0, name.length() - 3);
+        String etag = etagBuffer;
+        const char* contentType = assetContentType(url);
+        const char* cacheControl = assetIsContentHashed(url) ? "public, max-age=31536000, immutable"
+                                                             : "no-cache";
+
+        ArRequestHandlerFunction handler = [gzipPath, etag, contentType,
+                                            cacheControl](AsyncWebServerRequest* request) {
+          // If-None-Match may list several tags
+          if (request->hasHeader("If-None-Match") &&
+              request->header("If-None-Match").indexOf(etag) >= 0) {
+            AsyncWebServerResponse* response = request->beginResponse(304);
+            response->addHeader("ETag", etag);
+            response->addHeader("Cache-Control", cacheControl);
+            request->send(response);
+            return;
+          }
+
+          AsyncWebServerResponse* response = request->beginResponse(LittleFS, gzipPath, contentType);
+          response->addHeader("Content-Encoding", "gzip");
+          response->addHeader("Vary", "Accept-Encoding");
+          response->addHeader("ETag", etag);
+          response->addHeader("Cache-Control", cacheControl);
+          request->send(response);
+        };
+
+        this->server.on(url.c_str(), HTTP_GET, handler);
+        if (url == "/index.html") {
+          this->server.on("/", HTTP_GET, handler);
+        }
+        count++;
+      }
+    }
+
+    entry.close();
+    entry = root.openNextFile();
+  }
+  root.close();
+
+  return count;
 }
 
 // Check if connected to WiFi
@@ -339,7 +524,13 @@ IPAddress NetworkManager::getIP() const {
 
 // Get current WiFi mode
 String NetworkManager::getMode() const {
-  if (!isInitialized) {
+  if (state == NET_PORTAL) {
+    return "Portal";
+  }
+  if (state == NET_STARTING || state == NET_CONNECTING) {
+    return "Connecting";
+  }
+  if (state == NET_OFF) {
     return "Off";
   }
 
@@ -416,6 +607,20 @@ void NetworkManager::renderNetworkPage(Adafruit_SSD1306& display) {
     display.println("Connect to AP");
     display.println("to configure");
   }
+  else if (mode == "Portal") {
+    // Captive portal (button held at boot)
+    display.println("Setup portal, join:");
+    display.print("  ");
+    display.println(apName);
+    display.println("  192.168.4.1");
+    display.println("Push btn to exit");
+    display.println("(local AP + Web UI)");
+  }
+  else if (mode == "Connecting") {
+    display.println("");
+    display.println("Connecting...");
+    display.println("(playing already)");
+  }
   else {
     // Network disabled
     display.println("");
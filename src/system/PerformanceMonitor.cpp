@@ -9,18 +9,87 @@
 #include "system/DisplayManager.h"
 #include "system/Debug.h"
 #include "audio/AudioEngine.h"
+#include <esp_heap_caps.h>
+
+#if !configGENERATE_RUN_TIME_STATS
+#include <esp_freertos_hooks.h>
+#endif
+
+// Tasks whose stack high-water marks are tracked (FreeRTOS task names)
+static const char* const TRACKED_TASK_NAMES[PerformanceMonitor::NUM_TRACKED_TASKS] = {
+  "AudioTask",   // AudioEngine (Core 1)
+  "async_tcp",   // AsyncTCP - runs all web server / WebSocket callbacks
+  "loopTask"     // Arduino loop()
+};
+static const char* const TRACKED_TASK_LABELS[PerformanceMonitor::NUM_TRACKED_TASKS] = {
+  "Audio", "Web", "Loop"
+};
+
+#if configGENERATE_RUN_TIME_STATS
+// Task snapshot buffer for uxTaskGetSystemState() (static - no heap use
+// while measuring the heap)
+static const UBaseType_t MAX_TASK_SNAPSHOT = 32;
+static TaskStatus_t taskSnapshot[MAX_TASK_SNAPSHOT];
+#else
+// Fallback when the framework is built without run-time stats: the idle hook
+// is called back-to-back while a core has nothing else to do, so the time
+// between consecutive calls (when short) is idle time.
+static const uint32_t IDLE_GAP_MAX_US = 100;
+static volatile uint32_t idleTimeUs[2] = {0, 0};
+static volatile uint32_t lastIdleCallUs[2] = {0, 0};
+
+static inline bool accountIdle(int core) {
+  uint32_t now = micros();
+  uint32_t gap = now - lastIdleCallUs[core];
+  if (gap < IDLE_GAP_MAX_US) {
+    idleTimeUs[core] += gap;
+  }
+  lastIdleCallUs[core] = now;
+  return false;  // Call again immediately (keep accounting while idle)
+}
+
+static bool idleHookCore0() { return accountIdle(0); }
+static bool idleHookCore1() { return accountIdle(1); }
+#endif
 
 PerformanceMonitor::PerformanceMonitor(DisplayManager* displayMgr)
     : display(displayMgr),
+      looper(nullptr),
       lastAudioWarn(0),
       lastRamWarn(0),
+      audioWarnUs((uint32_t)(AudioEngine::getMaxAudioTimeMs() * 1000.0f * AUDIO_WARN_RATIO)),
       latestAudioWorkTimeUs(0),
-      lastStatusReport(0) {
+      latestOscWorkTimeUs(0),
+      latestOscOversampled(false),
+      lastStatusReport(0),
+      lastSystemStats(0),
+      lastStackWarn(0),
+      lastTotalTime(0),
+      largestFreeBlock(0),
+      minFreeHeap(0),
+      heapFragmentation(0) {
+  resetAudioStats();
+  for (int i = 0; i < NUM_CORES; i++) {
+    coreLoad[i] = 0.0f;
+    lastIdleTime[i] = 0;
+  }
+  for (int i = 0; i < NUM_TRACKED_TASKS; i++) {
+    taskHandles[i] = NULL;
+    taskStackFree[i] = -1;
+  }
 }
 
 void PerformanceMonitor::begin() {
-  DEBUG_PRINTLN("[PERF] Watchdog monitoring active");
+  DEBUG_PRINT("[PERF] Watchdog monitoring active - output ");
+  printOutputConfig();
+  DEBUG_PRINTLN();
   lastStatusReport = millis();
+
+#if !configGENERATE_RUN_TIME_STATS
+  esp_register_freertos_idle_hook_for_cpu(idleHookCore0, 0);
+  esp_register_freertos_idle_hook_for_cpu(idleHookCore1, 1);
+  DEBUG_PRINTLN("[PERF] CPU load: idle-hook accounting (no FreeRTOS run-time stats)");
+#endif
 }
 
 void PerformanceMonitor::setDisplay(DisplayManager* displayMgr) {
@@ -32,6 +101,18 @@ void PerformanceMonitor::setDisplay(DisplayManager* displayMgr) {
       this->drawPerformancePage(oled);
     }, "System", 99);
 
+    // CPU per core, task stacks, heap fragmentation
+    display->registerPage("Tasks", [this](Adafruit_SSD1306& oled) {
+      this->drawSystemPage(oled);
+    }, "Tasks & Heap", 97);
+
+#if ENABLE_DSP_PROFILING
+    // Per-stage DSP breakdown (just before the performance page)
+    display->registerPage("DSP", [this](Adafruit_SSD1306& oled) {
+      this->drawDSPPage(oled);
+    }, "DSP Stages", 98);
+#endif
+
     // Register performance warning overlay (appears on all pages)
     display->registerOverlay([this](Adafruit_SSD1306& oled) {
       if (!this->isSystemOK()) {
@@ -51,6 +132,9 @@ void PerformanceMonitor::update() {
   // Check RAM
   checkRAM();
 
+  // CPU load, stack high-water marks, heap fragmentation
+  updateSystemStats();
+
   // Print periodic status report
   printStatus();
 }
@@ -63,12 +147,30 @@ void PerformanceMonitor::recordAudioWork(uint32_t workTimeUs) {
   // Track latest timing for status report
   latestAudioWorkTimeUs = workTimeUs;
 
+  // Histogram + max (every block - spikes are never lost between reports)
+  uint32_t bin = workTimeUs / HIST_BIN_US;
+  if (bin >= HIST_BINS) {
+    bin = HIST_BINS - 1;
+  }
+  histogram[bin]++;
+  if (workTimeUs > maxAudioWorkTimeUs) {
+    maxAudioWorkTimeUs = workTimeUs;
+  }
+
+  // Rolling window: halve all counts periodically so recent blocks dominate
+  if (++histogramBlocks >= HIST_DECAY_BLOCKS) {
+    for (int i = 0; i < HIST_BINS; i++) {
+      histogram[i] >>= 1;
+    }
+    histogramBlocks = 0;
+  }
+
   // Check if audio processing is taking too long
   // Audio buffer duration is calculated dynamically from buffer configuration
   // - Audio task must finish computation before next buffer needed
   // - If CPU work exceeds max time, audio will start dropping samples (distortion)
   // - Current typical values: ~0.3ms (2-3% of available time)
-  if (workTimeUs > AUDIO_WARN_US) {
+  if (workTimeUs > audioWarnUs) {
     // Throttle warnings (don't spam console)
     uint32_t now = millis();
     if (now - lastAudioWarn > WARN_THROTTLE_MS) {
@@ -91,6 +193,206 @@ void PerformanceMonitor::recordAudioWork(uint32_t workTimeUs) {
   }
 }
 
+void PerformanceMonitor::recordOscillatorWork(uint32_t renderTimeUs, bool oversampled) {
+  latestOscWorkTimeUs = renderTimeUs;
+  latestOscOversampled = oversampled;
+}
+
+void PerformanceMonitor::recordI2SWrite(uint32_t blockedUs, bool underrun) {
+  if (underrun) {
+    underrunCount++;
+  }
+
+  // Exponential average (1/16) and minimum
+  blockedAvgUs = blockedAvgUs - (blockedAvgUs >> 4) + (blockedUs >> 4);
+  if (blockedUs < blockedMinUs) {
+    blockedMinUs = blockedUs;
+  }
+}
+
+uint32_t PerformanceMonitor::getAudioPercentileUs(uint8_t percent) const {
+  // Snapshot counts (audio task keeps writing; a slightly stale view is fine)
+  uint32_t counts[HIST_BINS];
+  uint32_t total = 0;
+  for (int i = 0; i < HIST_BINS; i++) {
+    counts[i] = histogram[i];
+    total += counts[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  // First bin where the cumulative count reaches the percentile
+  uint32_t target = (total * percent + 99) / 100;
+  uint32_t cumulative = 0;
+  for (int i = 0; i < HIST_BINS; i++) {
+    cumulative += counts[i];
+    if (cumulative >= target) {
+      return (i + 1) * HIST_BIN_US;
+    }
+  }
+  return HIST_BINS * HIST_BIN_US;
+}
+
+void PerformanceMonitor::resetAudioStats() {
+  for (int i = 0; i < HIST_BINS; i++) {
+    histogram[i] = 0;
+  }
+  histogramBlocks = 0;
+  maxAudioWorkTimeUs = 0;
+  underrunCount = 0;
+  blockedAvgUs = 0;
+  blockedMinUs = UINT32_MAX;
+}
+
+void PerformanceMonitor::printAudioStats() {
+  float maxTimeMs = AudioEngine::getMaxAudioTimeMs();
+  uint32_t blockedMin = blockedMinUs;
+
+  DEBUG_PRINTLN("\n========== AUDIO DEADLINE ==========");
+  DEBUG_PRINT("Output:    ");
+  printOutputConfig();
+  DEBUG_PRINT(", ");
+  DEBUG_PRINT(maxTimeMs);
+  DEBUG_PRINTLN(" ms per block");
+  DEBUG_PRINTF("Compute:   p50 %lu us  p95 %lu us  p99 %lu us  max %lu us\n",
+               (unsigned long)getAudioPercentileUs(50), (unsigned long)getAudioPercentileUs(95),
+               (unsigned long)getAudioPercentileUs(99), (unsigned long)maxAudioWorkTimeUs);
+  DEBUG_PRINTF("i2s_write: avg %lu us blocked, min %lu us\n",
+               (unsigned long)blockedAvgUs, (unsigned long)(blockedMin == UINT32_MAX ? 0 : blockedMin));
+  DEBUG_PRINT("Underruns: ");
+  DEBUG_PRINTLN(underrunCount);
+  DEBUG_PRINTLN("Note: percentiles are 100 us bins over the last ~10-20 s (perf:reset clears)");
+  DEBUG_PRINTLN("====================================\n");
+}
+
+void PerformanceMonitor::updateSystemStats() {
+  uint32_t now = millis();
+  if (now - lastSystemStats < SYSTEM_STATS_INTERVAL_MS) {
+    return;
+  }
+  lastSystemStats = now;
+
+  updateCoreLoad();
+
+  // Stack high-water marks (bytes on ESP-IDF: StackType_t is uint8_t)
+  for (int i = 0; i < NUM_TRACKED_TASKS; i++) {
+    if (taskHandles[i] == NULL) {
+      taskHandles[i] = xTaskGetHandle(TRACKED_TASK_NAMES[i]);  // Task may start later
+    }
+    if (taskHandles[i] != NULL) {
+      taskStackFree[i] = (int32_t)uxTaskGetStackHighWaterMark(taskHandles[i]);
+
+      if (taskStackFree[i] < (int32_t)STACK_WARN_BYTES && now - lastStackWarn > WARN_THROTTLE_MS) {
+        DEBUG_PRINTF("[WARN] STACK LOW: %s has %ld bytes left\n",
+                     TRACKED_TASK_NAMES[i], (long)taskStackFree[i]);
+        lastStackWarn = now;
+      }
+    }
+  }
+
+  // Heap: a large free total is no help if it is split into small pieces
+  uint32_t freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  largestFreeBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  minFreeHeap = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+  heapFragmentation = (freeHeap > 0) ? (uint8_t)(100 - (uint64_t)largestFreeBlock * 100 / freeHeap) : 0;
+}
+
+void PerformanceMonitor::updateCoreLoad() {
+#if configGENERATE_RUN_TIME_STATS
+  // Idle task run time vs total run time since the previous sample
+  uint32_t totalTime = 0;
+  UBaseType_t count = uxTaskGetSystemState(taskSnapshot, MAX_TASK_SNAPSHOT, &totalTime);
+  uint32_t totalDelta = totalTime - lastTotalTime;
+  lastTotalTime = totalTime;
+
+  for (int core = 0; core < NUM_CORES; core++) {
+    TaskHandle_t idle = xTaskGetIdleTaskHandleForCPU(core);
+    for (UBaseType_t i = 0; i < count; i++) {
+      if (taskSnapshot[i].xHandle == idle) {
+        uint32_t idleDelta = taskSnapshot[i].ulRunTimeCounter - lastIdleTime[core];
+        lastIdleTime[core] = taskSnapshot[i].ulRunTimeCounter;
+        if (totalDelta > 0) {
+          float idlePct = (float)idleDelta * 100.0f / (float)totalDelta;
+          coreLoad[core] = constrain(100.0f - idlePct, 0.0f, 100.0f);
+        }
+        break;
+      }
+    }
+  }
+#else
+  // Idle time accumulated by the idle hooks vs wall time since the previous sample
+  uint32_t totalTime = micros();
+  uint32_t totalDelta = totalTime - lastTotalTime;
+  lastTotalTime = totalTime;
+
+  for (int core = 0; core < NUM_CORES; core++) {
+    uint32_t idle = idleTimeUs[core];
+    uint32_t idleDelta = idle - lastIdleTime[core];
+    lastIdleTime[core] = idle;
+    if (totalDelta > 0) {
+      float idlePct = (float)idleDelta * 100.0f / (float)totalDelta;
+      coreLoad[core] = constrain(100.0f - idlePct, 0.0f, 100.0f);
+    }
+  }
+#endif
+}
+
+const char* PerformanceMonitor::getTaskLabel(int index) const {
+  if (index < 0 || index >= NUM_TRACKED_TASKS) {
+    return "?";
+  }
+  return TRACKED_TASK_LABELS[index];
+}
+
+int32_t PerformanceMonitor::getTaskStackFree(int index) const {
+  if (index < 0 || index >= NUM_TRACKED_TASKS) {
+    return -1;
+  }
+  return taskStackFree[index];
+}
+
+void PerformanceMonitor::printSystemStats() {
+  DEBUG_PRINTLN("\n========== SYSTEM ==========");
+  DEBUG_PRINTF("CPU:   core0 %.0f%%  core1 %.0f%%\n", coreLoad[0], coreLoad[1]);
+  DEBUG_PRINTLN("Stack high-water (free bytes):");
+  for (int i = 0; i < NUM_TRACKED_TASKS; i++) {
+    DEBUG_PRINTF("  %-10s %ld\n", TRACKED_TASK_NAMES[i], (long)taskStackFree[i]);
+  }
+  DEBUG_PRINTF("Heap:  %lu free, largest block %lu, min ever %lu\n",
+               (unsigned long)ESP.getFreeHeap(), (unsigned long)largestFreeBlock,
+               (unsigned long)minFreeHeap);
+  DEBUG_PRINTF("Fragmentation: %u%%\n", (unsigned)heapFragmentation);
+  DEBUG_PRINTF("Looper: %lu KB (%s)\n", (unsigned long)(getLooperBytes() / 1024),
+               isLooperInPsram() ? "PSRAM" : "internal");
+  DEBUG_PRINTLN("============================\n");
+}
+
+uint32_t PerformanceMonitor::getLooperBytes() const {
+  return (looper != nullptr) ? looper->getMemoryBytes() : 0;
+}
+
+bool PerformanceMonitor::isLooperInPsram() const {
+  return looper != nullptr && looper->isPsram();
+}
+
+void PerformanceMonitor::drawSystemPage(Adafruit_SSD1306& oled) {
+  oled.setFont();
+  oled.setTextSize(1);
+  oled.setTextColor(SSD1306_WHITE);
+
+  oled.printf("CPU0:%3.0f%%  CPU1:%3.0f%%\n", coreLoad[0], coreLoad[1]);
+
+  // Free stack (bytes) at the deepest point each task has reached
+  for (int i = 0; i < NUM_TRACKED_TASKS; i++) {
+    oled.printf("%-6s stk: %ld B\n", TRACKED_TASK_LABELS[i], (long)taskStackFree[i]);
+  }
+
+  oled.printf("Blk:%luK Min:%luK\n", (unsigned long)(largestFreeBlock / 1024),
+              (unsigned long)(minFreeHeap / 1024));
+  oled.printf("Frag:%u%% Loop:%luK\n", (unsigned)heapFragmentation,
+              (unsigned long)(getLooperBytes() / 1024));
+}
 
 void PerformanceMonitor::checkRAM() {
   uint32_t freeHeap = ESP.getFreeHeap();
@@ -131,7 +433,20 @@ void PerformanceMonitor::printStatus() {
     DEBUG_PRINT((uint32_t)(maxTimeMs * 10) % 10);
     DEBUG_PRINT("ms (");
     DEBUG_PRINT((latestAudioWorkTimeUs * 100) / maxTimeUs);
-    DEBUG_PRINT("%) / RAM: ");
+    DEBUG_PRINT("%, osc ");
+    DEBUG_PRINT(latestOscWorkTimeUs / 1000);
+    DEBUG_PRINT(".");
+    DEBUG_PRINT((latestOscWorkTimeUs % 1000) / 100);
+    DEBUG_PRINT(latestOscOversampled ? "ms 2x" : "ms");
+    DEBUG_PRINT(", p99 ");
+    DEBUG_PRINT(getAudioPercentileUs(99));
+    DEBUG_PRINT("us, max ");
+    DEBUG_PRINT(maxAudioWorkTimeUs);
+    DEBUG_PRINT("us, xrun ");
+    DEBUG_PRINT(underrunCount);
+    DEBUG_PRINT(") @ ");
+    printOutputConfig();
+    DEBUG_PRINT(" / RAM: ");
     DEBUG_PRINT(freeHeap / 1024);
     DEBUG_PRINT(".");
     DEBUG_PRINT((freeHeap % 1024) / 102);
@@ -141,6 +456,17 @@ void PerformanceMonitor::printStatus() {
   }
 }
 
+void PerformanceMonitor::printOutputConfig() {
+  // e.g. "44100Hz/32bit/APLL"
+  DEBUG_PRINT(Audio::SAMPLE_RATE);
+  DEBUG_PRINT("Hz/");
+  DEBUG_PRINT(Audio::I2S_FRAME_BITS);
+  DEBUG_PRINT("bit");
+  if (Audio::I2S_USE_APLL) {
+    DEBUG_PRINT("/APLL");
+  }
+}
+
 void PerformanceMonitor::drawPerformancePage(Adafruit_SSD1306& oled) {
   // Title and separator are auto-drawn by DisplayManager
   // Cursor already positioned at CONTENT_START_Y by DisplayManager
@@ -148,10 +474,11 @@ void PerformanceMonitor::drawPerformancePage(Adafruit_SSD1306& oled) {
   oled.setTextSize(1);
   oled.setTextColor(SSD1306_WHITE);
 
-  // Status line
+  // Status line (+ I2S underruns since boot)
   oled.print("Status: ");
-  oled.println(isSystemOK() ? "OK" : "WARN");
-  oled.println();
+  oled.print(isSystemOK() ? "OK" : "WARN");
+  oled.print("  Xrun:");
+  oled.println(underrunCount);
 
   // Audio timing line
   oled.print("Audio:  ");
@@ -161,10 +488,44 @@ void PerformanceMonitor::drawPerformancePage(Adafruit_SSD1306& oled) {
   float maxTimeMs = AudioEngine::getMaxAudioTimeMs();
   oled.print(maxTimeMs, 1);  // 1 decimal place
   oled.println("ms");
-  oled.println();
+
+  // Tail of the compute-time distribution (what actually risks a dropout)
+  oled.print("p99/max:");
+  oled.print(getAudioPercentileUs(99) / 1000.0f, 1);
+  oled.print("/");
+  oled.print(maxAudioWorkTimeUs / 1000.0f, 1);
+  oled.println("ms");
+
+  // Oscillator render share (2x = oversampled quality preset) + avg i2s_write wait
+  oled.print(latestOscOversampled ? "Osc2x:" : "Osc:  ");
+  oled.print(getOscillatorTimeMs(), 1);
+  oled.print("ms I2S:");
+  oled.print(blockedAvgUs / 1000.0f, 1);
+  oled.println("ms");
+
+  // Output configuration (CPU figures above depend on it)
+  oled.print("Out:    ");
+  oled.print(Audio::SAMPLE_RATE);
+  oled.print("Hz ");
+  oled.print(Audio::I2S_FRAME_BITS);
+  oled.println(Audio::I2S_USE_APLL ? "b APLL" : "b");
 
   // RAM line
   oled.print("RAM:    ");
   oled.print(getFreeRAMKB());
   oled.println(" KB free");
 }
+
+#if ENABLE_DSP_PROFILING
+void PerformanceMonitor::drawDSPPage(Adafruit_SSD1306& oled) {
+  oled.setFont();
+  oled.setTextSize(1);
+  oled.setTextColor(SSD1306_WHITE);
+
+  // One line per stage: name, average, peak (µs per block)
+  for (int i = 0; i < DSPProfiler::STAGE_COUNT; i++) {
+    oled.printf("%-8s%5.0f %5.0fus\n", DSPProfiler::getStageName(i),
+                dspProfiler.getAverageUs(i), dspProfiler.getPeakUs(i));
+  }
+}
+#endif
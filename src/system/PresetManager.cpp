@@ -0,0 +1,577 @@
+/*
+ * PresetManager.cpp
+ *
+ * Preset bank in NVS with click-free recall. See PresetManager.h.
+ */
+
+#include "system/PresetManager.h"
+#include "system/Theremin.h"
+#include "system/Debug.h"
+
+static const char* const NVS_NAMESPACE = "presets";
+
+PresetManager::PresetManager(Theremin* theremin)
+    : theremin(theremin),
+      display(nullptr),
+      activeSlot(-1),
+      swapPending(false),
+      swapSlot(-1),
+      morphFrom(0),
+      morphTo(0),
+      morphSource(MORPH_MANUAL),
+      requestType(REQUEST_NONE),
+      requestSlot(0),
+      requestSlot2(0),
+      mux(portMUX_INITIALIZER_UNLOCKED) {
+  memset(slots, 0, sizeof(slots));
+  memset(used, 0, sizeof(used));
+  memset(&swapData, 0, sizeof(swapData));
+  memset(&morphStart, 0, sizeof(morphStart));
+  memset(&morphEnd, 0, sizeof(morphEnd));
+  requestName[0] = '\0';
+}
+
+void PresetManager::begin() {
+  int count = 0;
+  for (uint8_t i = 0; i < NUM_SLOTS; i++) {
+    used[i] = load(i, slots[i]);
+    if (used[i]) {
+      count++;
+    }
+  }
+  DEBUG_PRINTF("[PRESET] %d of %u slots in use\n", count, (unsigned)NUM_SLOTS);
+}
+
+void PresetManager::setDisplay(DisplayManager* disp) {
+  display = disp;
+
+  if (display) {
+    // Register presets page (weight 6 - after the settings pages)
+    display->registerPage("Presets", [this](Adafruit_SSD1306& oled) {
+      this->drawPresetsPage(oled);
+    }, "Presets", 6);
+  }
+}
+
+void PresetManager::update() {
+  AudioEngine* audio = theremin->getAudioEngine();
+
+  // Recall: apply once the audio task has faded out and stopped rendering.
+  // holdSwap() keeps it silent until endSwap(), whatever apply() takes.
+  if (swapPending) {
+    if (!audio->holdSwap()) {
+      audio->beginSwap();  // No-op while fading out; re-mutes after a timeout
+      return;
+    }
+    if (swapSlot < 0) {
+      // Morph start: discrete settings now, continuous ones from the next block
+      apply(swapData);
+      audio->getMorph()->start(morphStart, morphEnd);
+      DEBUG_PRINTF("[PRESET] Morphing %u <-> %u\n", (unsigned)(morphFrom + 1), (unsigned)(morphTo + 1));
+    } else {
+      audio->getMorph()->stop();
+      apply(swapData);
+      activeSlot = swapSlot;
+      DEBUG_PRINTF("[PRESET] Recalled %d: %s\n", swapSlot + 1, swapData.name);
+    }
+    audio->endSwap();
+    swapPending = false;
+    markChanged();
+  }
+
+  // Morph position from the volume hand (near = first preset)
+  if (morphSource == MORPH_SENSOR && audio->getMorph()->isActive()) {
+    SensorManager* sensors = theremin->getSensorManager();
+    float position = (float)(sensors->getVolumeDistance() - SensorManager::VOLUME_MIN_DIST) /
+                     (float)(SensorManager::VOLUME_MAX_DIST - SensorManager::VOLUME_MIN_DIST);
+    audio->getMorph()->setPosition(position);
+  }
+
+  // Requests from other tasks
+  if (requestType == REQUEST_NONE) {
+    return;
+  }
+  portENTER_CRITICAL(&mux);
+  RequestType type = requestType;
+  uint8_t slot = requestSlot;
+  uint8_t slot2 = requestSlot2;
+  char name[NAME_LENGTH];
+  memcpy(name, requestName, NAME_LENGTH);
+  requestType = REQUEST_NONE;
+  portEXIT_CRITICAL(&mux);
+
+  switch (type) {
+    case REQUEST_SAVE:   save(slot, name); break;
+    case REQUEST_RECALL: recall(slot); break;
+    case REQUEST_REMOVE: remove(slot); break;
+    case REQUEST_MORPH:  startMorph(slot, slot2); break;
+    case REQUEST_MORPH_STOP: stopMorph(); break;
+    case REQUEST_NEXT:   recallNext(); break;
+    default: break;
+  }
+}
+
+bool PresetManager::save(uint8_t slot, const char* name) {
+  if (slot >= NUM_SLOTS) {
+    return false;
+  }
+
+  Record record;
+  capture(record.data);
+
+  // Name: given, else the stored one, else "Preset N"
+  if (name != nullptr && name[0] != '\0') {
+    strlcpy(record.data.name, name, NAME_LENGTH);
+  } else if (used[slot]) {
+    memcpy(record.data.name, slots[slot].name, NAME_LENGTH);
+  } else {
+    snprintf(record.data.name, NAME_LENGTH, "Preset %u", (unsigned)(slot + 1));
+  }
+
+  activeSlot = slot;
+
+  // Identical to what is stored: no flash write
+  if (used[slot] && memcmp(&record.data, &slots[slot], sizeof(PresetData)) == 0) {
+    DEBUG_PRINTF("[PRESET] Slot %u unchanged, not written\n", (unsigned)(slot + 1));
+    markChanged();
+    return true;
+  }
+
+  record.header.magic = RECORD_MAGIC;
+  record.header.version = RECORD_VERSION;
+  record.header.payloadSize = sizeof(PresetData);
+  record.header.crc = crc16((const uint8_t*)&record.data, sizeof(PresetData));
+
+  char key[4];
+  slotKey(slot, key);
+  bool stored = false;
+  if (prefs.begin(NVS_NAMESPACE, false)) {
+    stored = (prefs.putBytes(key, &record, sizeof(record)) == sizeof(record));
+    prefs.end();
+  }
+  if (!stored) {
+    DEBUG_PRINTF("[PRESET] Failed to write slot %u\n", (unsigned)(slot + 1));
+    return false;
+  }
+
+  portENTER_CRITICAL(&mux);
+  slots[slot] = record.data;
+  used[slot] = true;
+  portEXIT_CRITICAL(&mux);
+
+  DEBUG_PRINTF("[PRESET] Saved %u: %s\n", (unsigned)(slot + 1), record.data.name);
+  markChanged();
+  return true;
+}
+
+bool PresetManager::recall(uint8_t slot) {
+  if (slot >= NUM_SLOTS || !used[slot]) {
+    return false;
+  }
+
+  beginSwap(slots[slot], slot);
+  return true;
+}
+
+void PresetManager::beginSwap(const PresetData& data, int slot) {
+  // Applied by update() once the output is muted (a newer request replaces
+  // a pending one)
+  swapData = data;
+  swapSlot = slot;
+  if (!swapPending) {
+    swapPending = true;
+    theremin->getAudioEngine()->beginSwap();
+  }
+}
+
+bool PresetManager::startMorph(uint8_t from, uint8_t to) {
+  if (from >= NUM_SLOTS || to >= NUM_SLOTS || !used[from] || !used[to]) {
+    return false;
+  }
+  const PresetData& a = slots[from];
+  const PresetData& b = slots[to];
+
+  // Discrete settings from the first preset; an oscillator it has OFF
+  // takes the second one's waveform so it can fade in
+  PresetData base = a;
+  for (uint8_t i = 0; i < NUM_OSCILLATORS; i++) {
+    if (base.waveform[i] == Oscillator::OFF) {
+      base.waveform[i] = b.waveform[i];
+      base.octave[i] = b.octave[i];
+    }
+  }
+  base.effectEnabled = a.effectEnabled | b.effectEnabled;
+
+  toMorphParams(a, morphStart);
+  toMorphParams(b, morphEnd);
+  morphFrom = from;
+  morphTo = to;
+
+  beginSwap(base, -1);
+  return true;
+}
+
+void PresetManager::stopMorph() {
+  ParameterMorph* morph = theremin->getAudioEngine()->getMorph();
+  if (!morph->isActive()) {
+    return;
+  }
+  morph->stop();
+  DEBUG_PRINTLN("[PRESET] Morph stopped");
+
+  // Volumes, mixes and smoothing were moved by the morph: resend them
+  theremin->getAudioEngine()->getStateTracker()->mark(
+      StateTracker::OSC_MASK | StateTracker::EFFECT_MASK | StateTracker::PRESETS);
+}
+
+bool PresetManager::isMorphing() const {
+  return theremin->getAudioEngine()->getMorph()->isActive();
+}
+
+void PresetManager::setMorphPosition(float position) {
+  if (morphSource == MORPH_MANUAL) {
+    theremin->getAudioEngine()->getMorph()->setPosition(position);
+  }
+}
+
+float PresetManager::getMorphPosition() const {
+  return theremin->getAudioEngine()->getMorph()->getPosition();
+}
+
+void PresetManager::setMorphSource(MorphSource source) {
+  morphSource = source;
+  DEBUG_PRINTF("[PRESET] Morph source: %s\n", (source == MORPH_SENSOR) ? "volume sensor" : "manual");
+  markChanged();
+}
+
+bool PresetManager::recallNext() {
+  int start = (activeSlot < 0) ? 0 : activeSlot + 1;
+  for (uint8_t n = 0; n < NUM_SLOTS; n++) {
+    uint8_t slot = (start + n) % NUM_SLOTS;
+    if (used[slot]) {
+      return recall(slot);
+    }
+  }
+  return false;
+}
+
+bool PresetManager::remove(uint8_t slot) {
+  if (slot >= NUM_SLOTS || !used[slot]) {
+    return false;
+  }
+
+  char key[4];
+  slotKey(slot, key);
+  if (prefs.begin(NVS_NAMESPACE, false)) {
+    prefs.remove(key);
+    prefs.end();
+  }
+
+  portENTER_CRITICAL(&mux);
+  used[slot] = false;
+  memset(&slots[slot], 0, sizeof(PresetData));
+  portEXIT_CRITICAL(&mux);
+
+  if (activeSlot == slot) {
+    activeSlot = -1;
+  }
+
+  DEBUG_PRINTF("[PRESET] Deleted slot %u\n", (unsigned)(slot + 1));
+  markChanged();
+  return true;
+}
+
+void PresetManager::requestSave(uint8_t slot, const char* name) {
+  post(REQUEST_SAVE, slot, name);
+}
+
+void PresetManager::requestRecall(uint8_t slot) {
+  post(REQUEST_RECALL, slot, nullptr);
+}
+
+void PresetManager::requestRemove(uint8_t slot) {
+  post(REQUEST_REMOVE, slot, nullptr);
+}
+
+void PresetManager::requestRecallNext() {
+  post(REQUEST_NEXT, 0, nullptr);
+}
+
+void PresetManager::requestStartMorph(uint8_t from, uint8_t to) {
+  post(REQUEST_MORPH, from, nullptr, to);
+}
+
+void PresetManager::requestStopMorph() {
+  post(REQUEST_MORPH_STOP, 0, nullptr);
+}
+
+void PresetManager::post(RequestType type, uint8_t slot, const char* name, uint8_t slot2) {
+  portENTER_CRITICAL(&mux);
+  requestSlot = slot;
+  requestSlot2 = slot2;
+  if (name != nullptr) {
+    strlcpy(requestName, name, NAME_LENGTH);
+  } else {
+    requestName[0] = '\0';
+  }
+  requestType = type;
+  portEXIT_CRITICAL(&mux);
+}
+
+bool PresetManager::isUsed(uint8_t slot) const {
+  return slot < NUM_SLOTS && used[slot];
+}
+
+bool PresetManager::getName(uint8_t slot, char* out, size_t len) const {
+  if (len == 0) {
+    return false;
+  }
+  out[0] = '\0';
+  if (slot >= NUM_SLOTS) {
+    return false;
+  }
+
+  portENTER_CRITICAL(&mux);
+  bool inUse = used[slot];
+  if (inUse) {
+    strlcpy(out, slots[slot].name, len);
+  }
+  portEXIT_CRITICAL(&mux);
+  return inUse;
+}
+
+void PresetManager::printList() const {
+  DEBUG_PRINTLN("\n========== PRESETS ==========");
+  for (uint8_t i = 0; i < NUM_SLOTS; i++) {
+    DEBUG_PRINTF("%c%u: %s\n", (activeSlot == i) ? '>' : ' ', (unsigned)(i + 1),
+                 used[i] ? slots[i].name : "-");
+  }
+  DEBUG_PRINTLN("=============================\n");
+}
+
+void PresetManager::capture(PresetData& data) {
+  AudioEngine* audio = theremin->getAudioEngine();
+  memset(&data, 0, sizeof(data));
+
+  for (uint8_t i = 0; i < NUM_OSCILLATORS; i++) {
+    data.waveform[i] = (uint8_t)audio->getOscillatorWaveform(i + 1);
+    data.octave[i] = (int8_t)audio->getOscillatorOctave(i + 1);
+    data.volume[i] = (uint8_t)constrain(lroundf(audio->getOscillatorVolume(i + 1) * 100.0f), 0L, 100L);
+  }
+
+  EffectsChain* chain = audio->getEffectsChain();
+  if (chain != nullptr) {
+    uint8_t count = chain->getEffectCount();
+    if (count > MAX_EFFECTS) {
+      count = MAX_EFFECTS;
+    }
+    for (uint8_t e = 0; e < count; e++) {
+      AudioEffect* effect = chain->getEffect(e);
+      if (effect->isEnabled()) {
+        data.effectEnabled |= (1 << e);
+      }
+
+      uint8_t params = effect->getParamCount();
+      if (params > MAX_PARAMS) {
+        params = MAX_PARAMS;
+      }
+      for (uint8_t p = 0; p < params; p++) {
+        const EffectParam& info = effect->getParamInfo(p);
+        float span = info.maxValue - info.minValue;
+        float norm = (span > 0.0f) ? (effect->getParam(p) - info.minValue) / span : 0.0f;
+        data.effectParam[e][p] = (uint16_t)lroundf(constrain(norm, 0.0f, 1.0f) * 65535.0f);
+      }
+
+      // Slot order as registration indices
+      AudioEffect* slotEffect = chain->getSlot(e);
+      for (uint8_t r = 0; r < count; r++) {
+        if (chain->getEffect(r) == slotEffect) {
+          data.effectOrder[e] = r;
+          break;
+        }
+      }
+    }
+  }
+
+  data.pitchSmoothing = (uint8_t)theremin->getPitchSmoothingPreset();
+  data.volumeSmoothing = (uint8_t)theremin->getVolumeSmoothingPreset();
+  data.frequencyRange = (uint8_t)theremin->getFrequencyRangePreset();
+  data.quality = (uint8_t)audio->getQualityPreset();
+  data.channelMode = (uint8_t)audio->getChannelMode();
+}
+
+void PresetManager::apply(const PresetData& data) {
+  AudioEngine* audio = theremin->getAudioEngine();
+
+  for (uint8_t i = 0; i < NUM_OSCILLATORS; i++) {
+    audio->setOscillatorWaveform(i + 1, (Oscillator::Waveform)constrain(data.waveform[i], 0, (int)Oscillator::SAW));
+    audio->setOscillatorOctave(i + 1, constrain(data.octave[i], -1, 1));
+    audio->setOscillatorVolume(i + 1, constrain(data.volume[i], 0, 100) / 100.0f);
+  }
+
+  // Effects: safe to resize buffers and reorder slots, the swap is held so
+  // the audio task is not running them
+  EffectsChain* chain = audio->getEffectsChain();
+  if (chain != nullptr) {
+    uint8_t count = chain->getEffectCount();
+    if (count > MAX_EFFECTS) {
+      count = MAX_EFFECTS;
+    }
+    for (uint8_t e = 0; e < count; e++) {
+      AudioEffect* effect = chain->getEffect(e);
+      uint8_t params = effect->getParamCount();
+      if (params > MAX_PARAMS) {
+        params = MAX_PARAMS;
+      }
+      for (uint8_t p = 0; p < params; p++) {
+        const EffectParam& info = effect->getParamInfo(p);
+        float value = info.minValue + (info.maxValue - info.minValue) * (data.effectParam[e][p] / 65535.0f);
+        chain->setEffectParam(effect, p, value);
+      }
+      chain->setEffectEnabled(effect, (data.effectEnabled & (1 << e)) != 0);
+    }
+
+    // Placing each effect at its position in turn rebuilds the permutation
+    for (uint8_t pos = 0; pos < count; pos++) {
+      if (data.effectOrder[pos] < count) {
+        chain->moveEffect(chain->getEffect(data.effectOrder[pos])->getName(), pos);
+      }
+    }
+    // Tails carry on after the fade-in (a new delay time clears its own line)
+  }
+
+  theremin->setPitchSmoothingPreset((Theremin::SmoothingPreset)constrain(data.pitchSmoothing, 0, (int)Theremin::SMOOTH_EXTRA));
+  theremin->setVolumeSmoothingPreset((Theremin::SmoothingPreset)constrain(data.volumeSmoothing, 0, (int)Theremin::SMOOTH_EXTRA));
+  theremin->setFrequencyRangePreset((Theremin::FrequencyRangePreset)constrain(data.frequencyRange, 0, (int)Theremin::RANGE_WIDE));
+  audio->setQualityPreset((AudioEngine::QualityPreset)constrain(data.quality, 0, (int)AudioEngine::QUALITY_HIGH));
+  audio->setChannelMode((AudioEngine::ChannelMode)constrain(data.channelMode, 0, (int)AudioEngine::RIGHT_ONLY));
+}
+
+void PresetManager::toMorphParams(const PresetData& data, ParameterMorph::Params& params) {
+  memset(&params, 0, sizeof(params));
+
+  // An oscillator that is OFF in this preset is silent at this end
+  for (uint8_t i = 0; i < NUM_OSCILLATORS && i < ParameterMorph::NUM_OSCILLATORS; i++) {
+    if (data.waveform[i] != Oscillator::OFF) {
+      params.oscVolume[i] = data.volume[i] / 100.0f;
+    }
+  }
+
+  // Likewise a disabled effect is fully dry at this end
+  EffectsChain* chain = theremin->getAudioEngine()->getEffectsChain();
+  if (chain != nullptr) {
+    for (uint8_t e = 0; e < chain->getEffectCount() && e < MAX_EFFECTS && e < ParameterMorph::MAX_EFFECTS; e++) {
+      AudioEffect* effect = chain->getEffect(e);
+      if (data.effectEnabled & (1 << e)) {
+        params.effectMix[e] = storedParam(data, e, "mix");
+      }
+      if (effect == chain->getDelay()) {
+        params.delayFeedback = storedParam(data, e, "feedback");
+      } else if (effect == chain->getReverb()) {
+        params.reverbRoomSize = storedParam(data, e, "roomSize");
+      }
+    }
+  }
+
+  params.pitchSmoothing = Theremin::audioSmoothingFactor((Theremin::SmoothingPreset)data.pitchSmoothing);
+  params.volumeSmoothing = Theremin::audioSmoothingFactor((Theremin::SmoothingPreset)data.volumeSmoothing);
+}
+
+float PresetManager::storedParam(const PresetData& data, uint8_t effectIndex, const char* key) {
+  EffectsChain* chain = theremin->getAudioEngine()->getEffectsChain();
+  if (chain == nullptr || effectIndex >= chain->getEffectCount() || effectIndex >= MAX_EFFECTS) {
+    return 0.0f;
+  }
+  AudioEffect* effect = chain->getEffect(effectIndex);
+  int p = effect->findParam(key);
+  if (p < 0 || p >= MAX_PARAMS) {
+    return 0.0f;
+  }
+  const EffectParam& info = effect->getParamInfo(p);
+  return info.minValue + (info.maxValue - info.minValue) * (data.effectParam[effectIndex][p] / 65535.0f);
+}
+
+void PresetManager::slotKey(uint8_t slot, char* key) {
+  key[0] = 'p';
+  key[1] = '0' + slot;
+  key[2] = '\0';
+}
+
+bool PresetManager::load(uint8_t slot, PresetData& data) {
+  char key[4];
+  slotKey(slot, key);
+
+  Record record;
+  size_t length = 0;
+  if (prefs.begin(NVS_NAMESPACE, true)) {
+    if (prefs.isKey(key) && prefs.getBytesLength(key) == sizeof(record)) {
+      length = prefs.getBytes(key, &record, sizeof(record));
+    }
+    prefs.end();
+  }
+
+  if (length != sizeof(record)) {
+    return false;
+  }
+  if (record.header.magic != RECORD_MAGIC ||
+      record.header.version != RECORD_VERSION ||
+      record.header.payloadSize != sizeof(PresetData) ||
+      record.header.crc != crc16((const uint8_t*)&record.data, sizeof(PresetData))) {
+    DEBUG_PRINTF("[PRESET] Slot %u invalid, ignored\n", (unsigned)(slot + 1));
+    return false;
+  }
+
+  data = record.data;
+  data.name[NAME_LENGTH - 1] = '\0';
+  return true;
+}
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+uint16_t PresetManager::crc16(const uint8_t* data, size_t length) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+void PresetManager::markChanged() {
+  theremin->getAudioEngine()->getStateTracker()->mark(StateTracker::PRESETS);
+}
+
+void PresetManager::drawPresetsPage(Adafruit_SSD1306& oled) {
+  oled.setFont();
+  oled.setTextSize(1);
+  oled.setTextColor(SSD1306_WHITE);
+
+  // Cursor already positioned at CONTENT_START_Y by DisplayManager
+  int16_t top = oled.getCursorY();
+
+  // Two columns of four slots, active slot marked
+  for (uint8_t i = 0; i < NUM_SLOTS; i++) {
+    oled.setCursor((i < NUM_SLOTS / 2) ? 0 : 64, top + (i % (NUM_SLOTS / 2)) * 10);
+    oled.print((activeSlot == i) ? '>' : ' ');
+    oled.print(i + 1);
+    oled.print(' ');
+    if (used[i]) {
+      char shortName[8];
+      strlcpy(shortName, slots[i].name, sizeof(shortName));
+      oled.print(shortName);
+    } else {
+      oled.print('-');
+    }
+  }
+
+  oled.setCursor(0, top + (NUM_SLOTS / 2) * 10);
+  if (swapPending) {
+    oled.print("Loading...");
+  } else if (isMorphing()) {
+    oled.printf("Morph %u>%u %3d%%", (unsigned)(morphFrom + 1), (unsigned)(morphTo + 1),
+                (int)(getMorphPosition() * 100.0f + 0.5f));
+  } else {
+    oled.print("2x click: next");
+  }
+}
@@ -0,0 +1,240 @@
+#include "system/SpectrumAnalyzer.h"
+#include "system/Debug.h"
+#include <cmath>
+
+// Full-scale sine magnitude after the Hann window (coherent gain 0.5), the
+// 1/N stage scaling and the 8-bit input headroom shift: 32768 * 256 / 4
+static const float FULL_SCALE_DB = 20.0f * log10f(32768.0f * 256.0f / 4.0f);
+
+SpectrumAnalyzer::SpectrumAnalyzer(const AudioTap* outputTap)
+    : tap(outputTap),
+      display(nullptr),
+      taskHandle(nullptr),
+      activeUntil(0),
+      frameSeq(0) {
+    memset(frames, 0, sizeof(frames));
+
+    // Window and twiddle tables (Q15), computed once
+    for (int n = 0; n < FFT_SIZE; n++) {
+        float w = 0.5f * (1.0f - cosf(2.0f * PI * n / FFT_SIZE));
+        hann[n] = (int16_t)(w * 32767.0f);
+    }
+    for (int k = 0; k < FFT_SIZE / 2; k++) {
+        cosTable[k] = (int16_t)(cosf(2.0f * PI * k / FFT_SIZE) * 32767.0f);
+        sinTable[k] = (int16_t)(sinf(2.0f * PI * k / FFT_SIZE) * 32767.0f);
+    }
+
+    DEBUG_PRINTLN("[Scope] SpectrumAnalyzer initialized");
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer() {
+    if (taskHandle != nullptr) {
+        vTaskDelete(taskHandle);
+        taskHandle = nullptr;
+    }
+}
+
+bool SpectrumAnalyzer::begin() {
+    // Core 0, priority 1: never competes with the audio task on Core 1
+    BaseType_t result = xTaskCreatePinnedToCore(
+        taskFunction,   // Task function
+        "ScopeTask",    // Task name
+        3072,           // Stack size (bytes) - work buffers are members
+        this,           // Parameter (this pointer)
+        1,              // Priority (below WiFi/async_tcp)
+        &taskHandle,    // Task handle
+        0               // Core ID (0 = protocol core)
+    );
+
+    if (result != pdPASS) {
+        DEBUG_PRINTLN("[Scope] Failed to create analysis task");
+        taskHandle = nullptr;
+        return false;
+    }
+
+    DEBUG_PRINTLN("[Scope] Analysis task started on Core 0");
+    return true;
+}
+
+void SpectrumAnalyzer::setDisplay(DisplayManager* disp) {
+    display = disp;
+
+    if (display) {
+        display->registerPage("Spectrum", [this](Adafruit_SSD1306& oled) {
+            this->drawSpectrumPage(oled);
+        }, "Spectrum", 50);
+
+        DEBUG_PRINTLN("[Scope] Display page registered");
+    }
+}
+
+void SpectrumAnalyzer::keepAlive(uint32_t durationMs) {
+    activeUntil = millis() + durationMs;
+}
+
+bool SpectrumAnalyzer::isActive() const {
+    return (int32_t)(activeUntil - millis()) > 0;
+}
+
+bool SpectrumAnalyzer::copyFrame(Frame& out, uint32_t& seq) const {
+    uint32_t s = frameSeq;
+    if (s == 0) {
+        return false;
+    }
+
+    memcpy(&out, &frames[s & 1], sizeof(Frame));
+
+    // The writer only fills frames[(frameSeq + 1) & 1]; if it published
+    // during the copy, our buffer may be the one it is filling now
+    if (frameSeq != s) {
+        return false;
+    }
+
+    seq = s;
+    return true;
+}
+
+void SpectrumAnalyzer::taskFunction(void* parameter) {
+    SpectrumAnalyzer* analyzer = static_cast<SpectrumAnalyzer*>(parameter);
+
+    while (true) {
+        if (!analyzer->isActive()) {
+            vTaskDelay(pdMS_TO_TICKS(IDLE_POLL_MS));
+            continue;
+        }
+
+        analyzer->analyze();
+        vTaskDelay(pdMS_TO_TICKS(FRAME_INTERVAL_MS));
+    }
+}
+
+void SpectrumAnalyzer::analyze() {
+    // Latest window; lapped by the writer = skip this frame
+    if (!tap->readLatest(window, WINDOW_SIZE)) {
+        return;
+    }
+
+    Frame& frame = frames[(frameSeq + 1) & 1];
+    computeSpectrum(frame);
+    computeScope(frame);
+
+    frameSeq = frameSeq + 1;
+}
+
+void SpectrumAnalyzer::computeSpectrum(Frame& frame) {
+    // Most recent FFT_SIZE samples, windowed, with 8 bits of headroom so
+    // the per-stage halving does not quantize the noise floor away
+    const int16_t* input = window + WINDOW_SIZE - FFT_SIZE;
+    for (int n = 0; n < FFT_SIZE; n++) {
+        re[n] = ((int32_t)input[n] * hann[n]) >> 7;
+        im[n] = 0;
+    }
+
+    fft();
+
+    for (int k = 0; k < NUM_BINS; k++) {
+        float power = (float)re[k] * re[k] + (float)im[k] * im[k];
+        if (power < 1.0f) {
+            frame.bins[k] = 0;
+            continue;
+        }
+        float db = 10.0f * log10f(power) - FULL_SCALE_DB;
+        int value = (int)((db + BIN_DB_OFFSET) * 2.0f);
+        frame.bins[k] = (uint8_t)constrain(value, 0, 255);
+    }
+}
+
+void SpectrumAnalyzer::computeScope(Frame& frame) {
+    int32_t peak = 0;
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+        int32_t s = abs((int32_t)window[i]);
+        if (s > peak) peak = s;
+    }
+    frame.peak = (uint16_t)peak;
+
+    // Rising zero crossing in the first part of the window keeps periodic
+    // waveforms still; free-run on the latest samples if there is none
+    const int searchLength = WINDOW_SIZE - (SCOPE_POINTS - 1) * SCOPE_STEP - 1;
+    int trigger = searchLength;
+    for (int i = 1; i < searchLength; i++) {
+        if (window[i - 1] < 0 && window[i] >= 0) {
+            trigger = i;
+            break;
+        }
+    }
+
+    for (int i = 0; i < SCOPE_POINTS; i++) {
+        frame.scope[i] = (int8_t)(window[trigger + i * SCOPE_STEP] >> 8);
+    }
+}
+
+void SpectrumAnalyzer::fft() {
+    // Bit-reversal permutation
+    for (int i = 0; i < FFT_SIZE; i++) {
+        int j = 0;
+        for (int b = 0; b < FFT_BITS; b++) {
+            j |= ((i >> b) & 1) << (FFT_BITS - 1 - b);
+        }
+        if (j > i) {
+            int32_t t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    // Radix-2 decimation-in-time butterflies, halved every stage (1/N overall)
+    for (int len = 2; len <= FFT_SIZE; len <<= 1) {
+        int half = len >> 1;
+        int step = FFT_SIZE / len;
+        for (int start = 0; start < FFT_SIZE; start += len) {
+            for (int j = 0; j < half; j++) {
+                int32_t wr = cosTable[j * step];
+                int32_t wi = -sinTable[j * step];
+                int a = start + j;
+                int b = a + half;
+
+                int32_t tr = (int32_t)(((int64_t)re[b] * wr - (int64_t)im[b] * wi) >> 15);
+                int32_t ti = (int32_t)(((int64_t)re[b] * wi + (int64_t)im[b] * wr) >> 15);
+
+                re[b] = (re[a] - tr) >> 1;
+                im[b] = (im[a] - ti) >> 1;
+                re[a] = (re[a] + tr) >> 1;
+                im[a] = (im[a] + ti) >> 1;
+            }
+        }
+    }
+}
+
+void SpectrumAnalyzer::drawSpectrumPage(Adafruit_SSD1306& oled) {
+    // Title and separator are auto-drawn by DisplayManager
+    keepAlive();
+
+    static Frame frame;  // Loop task only - keep it off the stack
+    uint32_t seq;
+    if (!copyFrame(frame, seq)) {
+        oled.setFont();
+        oled.setTextSize(1);
+        oled.println("Starting...");
+        return;
+    }
+
+    // -90..0 dBFS over the content area, one bin per column
+    const int height = DisplayManager::SCREEN_HEIGHT - DisplayManager::CONTENT_START_Y;
+    const int floorValue = (BIN_DB_OFFSET - 90) * 2;
+    for (int x = 0; x < NUM_BINS && x < DisplayManager::SCREEN_WIDTH; x++) {
+        int h = ((int)frame.bins[x] - floorValue) * height / (90 * 2);
+        h = constrain(h, 0, height);
+        if (h > 0) {
+            oled.drawFastVLine(x, DisplayManager::SCREEN_HEIGHT - h, h, SSD1306_WHITE);
+        }
+    }
+
+    // Output close to full scale: the master bus soft clip is working hard
+    if (frame.peak >= 32000) {
+        oled.setFont();
+        oled.setTextSize(1);
+        oled.setTextColor(SSD1306_WHITE);
+        oled.setCursor(DisplayManager::SCREEN_WIDTH - 4 * DisplayManager::CHAR_WIDTH - 4,
+                       DisplayManager::CONTENT_START_Y);
+        oled.print("CLIP");
+    }
+}
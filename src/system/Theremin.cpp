@@ -7,15 +7,31 @@
 
 #include "system/Theremin.h"
 #include "system/Debug.h"
+#include "system/BootTimeline.h"
 
 // Constructor
 Theremin::Theremin(PerformanceMonitor* perfMon, DisplayManager* displayMgr)
-    : sensors(), audio(perfMon), serialControls(this), gpioControls(this, displayMgr), display(displayMgr), notifications(nullptr), tunerManager(nullptr), debugEnabled(false),
+    : sensors(), audio(perfMon), serialControls(this), gpioControls(this, displayMgr), display(displayMgr), notifications(nullptr), tunerManager(nullptr), spectrumAnalyzer(nullptr), audioCapture(nullptr), pitchDetector(nullptr), presetManager(nullptr), commandRegistry(nullptr), i2cBus(nullptr), debugEnabled(false),
       currentPitchSmoothingPreset(SMOOTH_NORMAL),
       currentVolumeSmoothingPreset(SMOOTH_NORMAL),
       currentFrequencyRangePreset(RANGE_NORMAL) {
-  // Create TunerManager (always created)
+  // Create TunerManager (always created), fed by the output pitch detector
+  pitchDetector = new PitchDetector(audio.getOutputTap());
   tunerManager = new TunerManager(&audio);
+  tunerManager->setPitchDetector(pitchDetector);
+
+  // Create SpectrumAnalyzer (idle until the scope view or its page is shown)
+  spectrumAnalyzer = new SpectrumAnalyzer(audio.getOutputTap());
+
+  // Create AudioCapture (idle until a capture is started)
+  audioCapture = new AudioCapture(audio.getStateTracker());
+  audio.setCapture(audioCapture);
+
+  // Create PresetManager (slots are loaded in begin())
+  presetManager = new PresetManager(this);
+
+  // Command table for the serial console and the web UI
+  commandRegistry = new CommandRegistry(this);
 
   // Create NotificationManager if display is available
   if (display) {
@@ -24,6 +40,12 @@ Theremin::Theremin(PerformanceMonitor* perfMon, DisplayManager* displayMgr)
     // Register TunerManager display page
     tunerManager->setDisplay(display);
 
+    // Register spectrum page (weight 50 - after the settings pages)
+    spectrumAnalyzer->setDisplay(display);
+
+    // Register presets page (weight 6 - after the settings pages)
+    presetManager->setDisplay(display);
+
     // Register splash page (weight 0 - first page)
     display->registerPage("Splash", [this](Adafruit_SSD1306& oled) {
       this->drawSplashPage(oled);
@@ -48,6 +70,11 @@ Theremin::Theremin(PerformanceMonitor* perfMon, DisplayManager* displayMgr)
     display->registerPage("Smooth", [this](Adafruit_SSD1306& oled) {
       this->drawSmoothPage(oled);
     }, "Smooth", 5);
+
+    // Register looper page with title (weight 7 - after presets)
+    display->registerPage("Looper", [this](Adafruit_SSD1306& oled) {
+      this->drawLooperPage(oled);
+    }, "Looper", 7);
   }
 }
 
@@ -56,12 +83,43 @@ Theremin::Theremin(PerformanceMonitor* perfMon, DisplayManager* displayMgr)
 // but included as C++ best practice (RAII) for proper resource cleanup.
 // See Theremin.h for detailed explanation.
 Theremin::~Theremin() {
-  // Clean up tuner manager (if allocated)
+  // Clean up tuner manager first (it reads the pitch detector)
   if (tunerManager != nullptr) {
     delete tunerManager;
     tunerManager = nullptr;
   }
 
+  // Clean up pitch detector (stops its task)
+  if (pitchDetector != nullptr) {
+    delete pitchDetector;
+    pitchDetector = nullptr;
+  }
+
+  // Clean up spectrum analyzer (stops its task)
+  if (spectrumAnalyzer != nullptr) {
+    delete spectrumAnalyzer;
+    spectrumAnalyzer = nullptr;
+  }
+
+  // Clean up audio capture (stops its task)
+  if (audioCapture != nullptr) {
+    audio.setCapture(nullptr);
+    delete audioCapture;
+    audioCapture = nullptr;
+  }
+
+  // Clean up command registry
+  if (commandRegistry != nullptr) {
+    delete commandRegistry;
+    commandRegistry = nullptr;
+  }
+
+  // Clean up preset manager
+  if (presetManager != nullptr) {
+    delete presetManager;
+    presetManager = nullptr;
+  }
+
   // Clean up notification manager (if allocated)
   if (notifications != nullptr) {
     delete notifications;
@@ -71,27 +129,54 @@ Theremin::~Theremin() {
   DEBUG_PRINTLN("[THEREMIN] Theremin destroyed");
 }
 
+void Theremin::setI2CBus(I2CBus* bus) {
+  i2cBus = bus;
+  sensors.setBus(bus);
+  gpioControls.setBus(bus);
+}
+
 // Initialize theremin
 bool Theremin::begin() {
   DEBUG_PRINTLN("\n=== ESP32 Theremin Initializing ===");
 
+  // Initialize audio first: I2S has no bus in common with the sensors, so
+  // the audio task is already filling buffers while the I2C devices start
+  {
+    BootTimeline::Phase phase("audio");
+    audio.begin();
+  }
+
   // Initialize sensors
-  if (!sensors.begin()) {
-    DEBUG_PRINTLN("[ERROR] Sensor initialization failed!");
-    return false;
+  {
+    BootTimeline::Phase phase("sensors");
+    if (!sensors.begin()) {
+      DEBUG_PRINTLN("[ERROR] Sensor initialization failed!");
+      return false;
+    }
+  }
+
+  // Start analysis and capture tasks (Core 0, read the audio output)
+  {
+    BootTimeline::Phase phase("analysis");
+    pitchDetector->begin();
+    spectrumAnalyzer->begin();
+    audioCapture->begin();
   }
 
-  // Initialize audio
-  audio.begin();
+  // Load the preset bank (NVS, cached in RAM)
+  presetManager->begin();
 
   // Initialize serial controls
   serialControls.begin();
 
   // Initialize GPIO controls
-  if (gpioControls.begin()) {
-    DEBUG_PRINTLN("[INIT] Physical GPIO controls enabled");
-  } else {
-    DEBUG_PRINTLN("[INIT] Physical GPIO controls unavailable - serial only");
+  {
+    BootTimeline::Phase phase("controls");
+    if (gpioControls.begin()) {
+      DEBUG_PRINTLN("[INIT] Physical GPIO controls enabled");
+    } else {
+      DEBUG_PRINTLN("[INIT] Physical GPIO controls unavailable - serial only");
+    }
   }
 
   DEBUG_PRINTLN("=== Initialization Complete ===\n");
@@ -120,6 +205,9 @@ void Theremin::update() {
   serialControls.update();
   gpioControls.update();
 
+  // Finish a preset recall, handle preset requests from the web UI
+  presetManager->update();
+
   // Update sensor readings (reads both sensors once and caches results)
   // Always read hardware, even if sensors are disabled
   sensors.updateReadings();
@@ -209,18 +297,28 @@ void Theremin::printDebugInfo(int pitchDist, int volumeDist, int freq, int ampli
   loopCounter++;
 }
 
+// Audio-level smoothing factor per preset (shared by pitch and volume)
+float Theremin::audioSmoothingFactor(SmoothingPreset preset) {
+  switch (preset) {
+    case SMOOTH_NONE:  return 1.0f;   // Instant
+    case SMOOTH_EXTRA: return 0.50f;  // More smooth
+    default:           return 0.80f;  // Balanced
+  }
+}
+
 // Set pitch smoothing preset (coordinates both sensor and audio levels)
 void Theremin::setPitchSmoothingPreset(SmoothingPreset preset) {
   DEBUG_PRINT("[THEREMIN] Setting pitch smoothing preset: ");
   DEBUG_PRINTLN((int)preset);
 
   currentPitchSmoothingPreset = preset;
+  audio.getStateTracker()->mark(StateTracker::PITCH_SMOOTHING);
 
   switch (preset) {
     case SMOOTH_NONE:
       // Sensor: disabled, Audio: instant
       sensors.setPitchSmoothingEnabled(false);
-      audio.setPitchSmoothingFactor(1.0f);  // Instant
+      audio.setPitchSmoothingFactor(audioSmoothingFactor(preset));  // Instant
       DEBUG_PRINTLN("[THEREMIN] Pitch smoothing: NONE (raw response)");
       break;
 
@@ -228,7 +326,7 @@ void Theremin::setPitchSmoothingPreset(SmoothingPreset preset) {
       // Sensor: α=0.35, Audio: factor=0.80 (default balanced)
       sensors.setPitchSmoothingEnabled(true);
       sensors.setPitchSmoothingAlpha(0.35f);
-      audio.setPitchSmoothingFactor(0.80f);
+      audio.setPitchSmoothingFactor(audioSmoothingFactor(preset));
       DEBUG_PRINTLN("[THEREMIN] Pitch smoothing: NORMAL (balanced)");
       break;
 
@@ -236,7 +334,7 @@ void Theremin::setPitchSmoothingPreset(SmoothingPreset preset) {
       // Sensor: α=0.20 (more smooth), Audio: factor=0.50 (more smooth)
       sensors.setPitchSmoothingEnabled(true);
       sensors.setPitchSmoothingAlpha(0.20f);
-      audio.setPitchSmoothingFactor(0.50f);
+      audio.setPitchSmoothingFactor(audioSmoothingFactor(preset));
       DEBUG_PRINTLN("[THEREMIN] Pitch smoothing: EXTRA (maximum smooth)");
       break;
   }
@@ -248,12 +346,13 @@ void Theremin::setVolumeSmoothingPreset(SmoothingPreset preset) {
   DEBUG_PRINTLN((int)preset);
 
   currentVolumeSmoothingPreset = preset;
+  audio.getStateTracker()->mark(StateTracker::VOLUME_SMOOTHING);
 
   switch (preset) {
     case SMOOTH_NONE:
       // Sensor: disabled, Audio: instant
       sensors.setVolumeSmoothingEnabled(false);
-      audio.setVolumeSmoothingFactor(1.0f);  // Instant
+      audio.setVolumeSmoothingFactor(audioSmoothingFactor(preset));  // Instant
       DEBUG_PRINTLN("[THEREMIN] Volume smoothing: NONE (raw response)");
       break;
 
@@ -261,7 +360,7 @@ void Theremin::setVolumeSmoothingPreset(SmoothingPreset preset) {
       // Sensor: α=0.35, Audio: factor=0.80 (default balanced)
       sensors.setVolumeSmoothingEnabled(true);
       sensors.setVolumeSmoothingAlpha(0.35f);
-      audio.setVolumeSmoothingFactor(0.80f);
+      audio.setVolumeSmoothingFactor(audioSmoothingFactor(preset));
       DEBUG_PRINTLN("[THEREMIN] Volume smoothing: NORMAL (balanced)");
       break;
 
@@ -269,7 +368,7 @@ void Theremin::setVolumeSmoothingPreset(SmoothingPreset preset) {
       // Sensor: α=0.20 (more smooth), Audio: factor=0.50 (more smooth)
       sensors.setVolumeSmoothingEnabled(true);
       sensors.setVolumeSmoothingAlpha(0.20f);
-      audio.setVolumeSmoothingFactor(0.50f);
+      audio.setVolumeSmoothingFactor(audioSmoothingFactor(preset));
       DEBUG_PRINTLN("[THEREMIN] Volume smoothing: EXTRA (maximum smooth)");
       break;
   }
@@ -316,6 +415,7 @@ void Theremin::setFrequencyRangePreset(FrequencyRangePreset preset) {
   DEBUG_PRINTLN((int)preset);
 
   currentFrequencyRangePreset = preset;
+  audio.getStateTracker()->mark(StateTracker::FREQUENCY_RANGE);
 
   switch (preset) {
     case RANGE_NARROW:
@@ -387,45 +487,39 @@ void Theremin::drawEffectsPage(Adafruit_SSD1306& oled) {
   }
 
   // Cursor already positioned at CONTENT_START_Y by DisplayManager
-  int lineHeight = 8;  // Spacing between lines
-
-  // Delay Effect
-  DelayEffect* delay = effects->getDelay();
-  oled.print("DLY: ");
-  oled.println(delay->isEnabled() ? "ON " : "OFF");
-  oled.print("Time: ");
-  oled.print(delay->getDelayTime());
-  oled.print("ms FB: ");
-  oled.print((int)(delay->getFeedback() * 100));
-  oled.print("% Mix:");
-  oled.print((int)(delay->getMix() * 100));
-  oled.println("%");
-  oled.println();
+  // One block per effect, in processing (slot) order:
+  //   DLY: ON
+  //   Time: 300ms FB: 50% Mix: 30%
+  for (uint8_t slot = 0; slot < effects->getEffectCount(); slot++) {
+    AudioEffect* effect = effects->getSlot(slot);
 
-  // Chorus Effect
-  ChorusEffect* chorus = effects->getChorus();
-  oled.print("Chr: ");
-  oled.println(chorus->isEnabled() ? "ON " : "OFF");
-  oled.print("Rate: ");
-  oled.print(chorus->getRate(), 1);  // 1 decimal place
-  oled.print("Hz Depth: ");
-  oled.print((int)chorus->getDepth());
-  oled.print("ms Mix: ");
-  oled.print((int)(chorus->getMix() * 100));
-  oled.println("%");
-  oled.println();
+    oled.print(effect->getShortName());
+    oled.print(": ");
+    oled.println(effect->isEnabled() ? "ON " : "OFF");
+
+    for (uint8_t p = 0; p < effect->getParamCount(); p++) {
+      const EffectParam& info = effect->getParamInfo(p);
+      float shown = effect->getParam(p) * info.displayScale;
+
+      oled.print(info.label);
+      oled.print(": ");
+      // Fractional steps (e.g. 0.1 Hz, 0.01 room) get one decimal place
+      if (info.step * info.displayScale < 1.0f) {
+        oled.print(shown, 1);
+      } else {
+        oled.print((int)shown);
+      }
+      oled.print(info.unit);
+      if (p < effect->getParamCount() - 1) {
+        oled.print(" ");
+      }
+    }
+    oled.println();
 
-  // Reverb Effect
-  ReverbEffect* reverb = effects->getReverb();
-  oled.print("REV: ");
-  oled.println(reverb->isEnabled() ? "ON " : "OFF");
-  oled.print("Room: ");
-  oled.print(reverb->getRoomSize(), 1);  // 1 decimal place
-  oled.print(" Damp: ");
-  oled.print(reverb->getDamping(), 1);   // 1 decimal place
-  oled.print(" Mix: ");
-  oled.print((int)(reverb->getMix() * 100));
-  oled.print("%");
+    if (slot < effects->getEffectCount() - 1) {
+      oled.println();
+    }
+  }
 
   // Reset to default font
   oled.setFont();
@@ -508,6 +602,29 @@ void Theremin::drawSmoothPage(Adafruit_SSD1306& oled) {
   oled.setFont();
 }
 
+// Draw looper page showing loop state and length
+void Theremin::drawLooperPage(Adafruit_SSD1306& oled) {
+  static const char* const STATE_NAMES[] = {"EMPTY", "RECORDING", "PLAYING", "OVERDUB", "STOPPED"};
+  const Looper* looper = audio.getLooper();
+
+  oled.setFont();
+  oled.setTextSize(1);
+  oled.setTextColor(SSD1306_WHITE);
+
+  // Cursor already positioned at CONTENT_START_Y by DisplayManager
+  oled.println(STATE_NAMES[looper->getState()]);
+  oled.printf("Loop: %.1f s\n", looper->getLengthSamples() / (float)Audio::SAMPLE_RATE);
+  if (looper->getMemoryBytes() > 0) {
+    oled.printf("Max:  %.1f s %s\n", looper->getCapacitySamples() / (float)Audio::SAMPLE_RATE,
+                looper->getFormat() == Looper::FORMAT_ULAW ? "ulaw" : "pcm");
+  } else {
+    oled.println();
+  }
+  oled.printf("Fb %d%%  Lvl %d%%\n", (int)(looper->getFeedback() * 100.0f + 0.5f),
+              (int)(looper->getLevel() * 100.0f + 0.5f));
+  oled.print(looper->canUndo() ? "2x click: rec (undo)" : "2x click: rec");
+}
+
 // Draw oscillators page showing oscillator configurations
 void Theremin::drawOscillatorsPage(Adafruit_SSD1306& oled) {
   // Use small font for compact display
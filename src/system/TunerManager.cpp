@@ -1,17 +1,13 @@
 #include "system/TunerManager.h"
 #include "system/Debug.h"
-#include <cmath>
-
-// Note names lookup table
-const char* TunerManager::NOTE_NAMES[12] = {
-    "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
-};
 
 TunerManager::TunerManager(AudioEngine* engine)
     : audioEngine(engine),
+      pitchDetector(nullptr),
       display(nullptr),
       currentNote("---"),
       currentNoteName("---"),
+      currentNoteIndex(-1),
       currentOctave(0),
       currentFrequency(0.0f),
       cents(0),
@@ -40,8 +36,14 @@ void TunerManager::update() {
     if (now - lastUpdate >= UPDATE_INTERVAL) {
         lastUpdate = now;
 
-        // Get current frequency from audio engine
-        float frequency = static_cast<float>(audioEngine->getFrequency());
+        // Measured output pitch (0 = silence/no clear pitch), or the
+        // engine target frequency if the detector is not running
+        float frequency;
+        if (pitchDetector && pitchDetector->isRunning()) {
+            frequency = pitchDetector->getFrequency();
+        } else {
+            frequency = static_cast<float>(audioEngine->getFrequency());
+        }
 
         // Calculate tuner data
         calculateTunerData(frequency);
@@ -49,10 +51,13 @@ void TunerManager::update() {
 }
 
 void TunerManager::calculateTunerData(float frequency) {
-    // Handle invalid/low frequencies
-    if (frequency < 20.0f) {
-        currentNote = "---";
+    NoteTable::NoteInfo info;
+
+    // Handle invalid/low frequencies (and anything outside the note table)
+    if (frequency < 20.0f || !NoteTable::lookup(frequency, info)) {
+        strcpy(currentNote, "---");
         currentNoteName = "---";
+        currentNoteIndex = -1;
         currentOctave = 0;
         currentFrequency = 0.0f;
         cents = 0;
@@ -62,34 +67,19 @@ void TunerManager::calculateTunerData(float frequency) {
 
     currentFrequency = frequency;
 
-    // A4 = 440 Hz = MIDI note 69
-    const float A4 = 440.0f;
-    const int A4_MIDI = 69;
-
-    // Calculate MIDI note number using logarithmic formula
-    // halfSteps = 12 * log2(f / 440)
-    float halfSteps = 12.0f * log2f(frequency / A4);
-    int midiNote = round(A4_MIDI + halfSteps);
-
-    // Calculate cents deviation (how far off from perfect pitch)
-    // 100 cents = 1 semitone
-    float exactNote = A4_MIDI + halfSteps;
-    cents = round((exactNote - midiNote) * 100);
-
-    // Constrain cents to ±50 range (beyond that, it's closer to another note)
-    if (cents < -50) cents = -50;
-    if (cents > 50) cents = 50;
+    // Nearest note from the semitone table, cents interpolated within it
+    cents = (int)lroundf(info.cents);
+    cents = constrain(cents, -50, 50);
 
     // Determine if in tune (within ±10 cents threshold)
     inTune = (abs(cents) <= 10);
 
-    // Extract note name and octave
-    int noteIndex = midiNote % 12;
-    currentNoteName = NOTE_NAMES[noteIndex];
-    currentOctave = (midiNote / 12) - 1;
+    currentNoteIndex = info.noteIndex;
+    currentNoteName = NoteTable::noteName(info.noteIndex);
+    currentOctave = info.octave;
 
-    // Build full note string (e.g., "C#4")
-    currentNote = currentNoteName + String(currentOctave);
+    // Full note string (e.g., "C#4") into the fixed buffer
+    NoteTable::formatNote(info, currentNote, sizeof(currentNote));
 }
 
 void TunerManager::drawTunerPage(Adafruit_SSD1306& oled) {
@@ -117,7 +107,7 @@ void TunerManager::drawTunerPage(Adafruit_SSD1306& oled) {
 
     // Calculate centered position for note name
     // Each character is 12 pixels wide at textSize(2)
-    int16_t noteWidth = currentNoteName.length() * 12;
+    int16_t noteWidth = strlen(currentNoteName) * 12;
     int16_t noteX = (128 - noteWidth) / 2;  // Center on 128-pixel screen
 
     // Draw left indicator at fixed position if needed
@@ -144,16 +134,14 @@ void TunerManager::drawTunerPage(Adafruit_SSD1306& oled) {
     oled.setTextSize(1);
     oled.println();
 
-    // Build the complete string to calculate its width
-    String freqCentsLine = String(currentFrequency, 1) + " Hz / ";
-    if (cents > 0) {
-        freqCentsLine += "+";
-    }
-    freqCentsLine += String(cents);
+    // Build the complete line to calculate its width
+    char freqCentsLine[24];
+    snprintf(freqCentsLine, sizeof(freqCentsLine), "%.1f Hz / %s%d",
+             currentFrequency, cents > 0 ? "+" : "", cents);
 
     // Center the line on screen
     // Each character is 6 pixels wide at textSize(1)
-    int16_t lineWidth = freqCentsLine.length() * 6;
+    int16_t lineWidth = strlen(freqCentsLine) * 6;
     int16_t lineX = (128 - lineWidth) / 2;  // Center on 128-pixel screen
     int16_t lineY = oled.getCursorY();
 
@@ -0,0 +1,108 @@
+/*
+ * WebSocketDelivery.cpp
+ *
+ * Per-client send policy of the WebSocket interface. See WebSocketDelivery.h.
+ */
+
+#include "system/WebSocketDelivery.h"
+
+#ifdef ENABLE_NETWORK
+
+#include "system/Debug.h"
+
+WebSocketDelivery::WebSocketDelivery() : telemetryDropped(0) {
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    clients[i] = {0, false, 0};
+  }
+}
+
+WebSocketDelivery::ClientState* WebSocketDelivery::findClient(uint32_t clientId) {
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    if (clients[i].id == clientId) {
+      return &clients[i];
+    }
+  }
+  return nullptr;
+}
+
+void WebSocketDelivery::addClient(uint32_t clientId) {
+  if (clientId == 0 || findClient(clientId)) {
+    return;
+  }
+  // Same size as the library's client limit, so only a stale entry can
+  // fill it (WebUIManager drops those on the next tick)
+  ClientState* state = findClient(0);
+  if (state) {
+    *state = {clientId, false, 0};
+  } else {
+    DEBUG_PRINTF("[WebUI] Client #%u not tracked (table full)\n", clientId);
+  }
+}
+
+void WebSocketDelivery::removeClient(uint32_t clientId) {
+  ClientState* state = clientId ? findClient(clientId) : nullptr;
+  if (state) {
+    *state = {0, false, 0};
+  }
+}
+
+bool WebSocketDelivery::queueTelemetry(AsyncWebSocketClient* client, const AsyncWebSocketSharedBuffer& buffer,
+                                       size_t queueDepth) {
+  if (client->status() != WS_CONNECTED) {
+    return false;
+  }
+
+  // Behind: skip this frame, the client gets the newest one once it has
+  // caught up (telemetry frames are snapshots, nothing accumulates; a
+  // skipped audio packet shows as a gap in the packet positions). Nothing
+  // at all while a resync is pending: a client sending about one message
+  // per frame would otherwise never drain and never get its resync.
+  ClientState* state = findClient(client->id());
+  if (client->queueLen() >= queueDepth || (state && state->resyncPending)) {
+    if (state) {
+      state->telemetrySkipped++;
+    }
+    telemetryDropped++;
+    return false;
+  }
+
+  client->binary(buffer);
+  return true;
+}
+
+bool WebSocketDelivery::queueReliable(AsyncWebSocketClient* client, const AsyncWebSocketSharedBuffer& buffer) {
+  if (client->status() != WS_CONNECTED) {
+    return false;
+  }
+
+  ClientState* state = findClient(client->id());
+
+  // Already out of sync: the complete state it will get covers this message
+  if (state && state->resyncPending) {
+    return false;
+  }
+
+  // Too far behind to queue more: coalesce everything from now on into one
+  // complete state, sent once the queue has drained (takeResync())
+  if (client->queueLen() >= RELIABLE_QUEUE_DEPTH) {
+    if (state) {
+      state->resyncPending = true;
+    }
+    DEBUG_PRINTF("[WebUI] Client #%u behind, resync when drained\n", client->id());
+    return false;
+  }
+
+  client->text(buffer);
+  return true;
+}
+
+bool WebSocketDelivery::takeResync(AsyncWebSocketClient* client) {
+  ClientState* state = findClient(client->id());
+  if (!state || !state->resyncPending || client->queueLen() != 0) {
+    return false;
+  }
+  state->resyncPending = false;
+  return true;
+}
+
+#endif  // ENABLE_NETWORK
@@ -11,6 +11,7 @@
 #include "system/Debug.h"
 #include "audio/Oscillator.h"
 #include "system/PerformanceMonitor.h"
+#include "system/BootTimeline.h"
 #include "controls/SensorManager.h"
 
 // Static pointer for event handler callback, we use it as we cannot pass [this]
@@ -18,8 +19,18 @@
 static WebUIManager* g_webUIInstance = nullptr;
 
 WebUIManager::WebUIManager(AsyncWebServer* srv, Theremin* thmn)
-    : server(srv), ws("/ws"), theremin(thmn), lastUpdate(0) {
+    : server(srv), ws("/ws"), theremin(thmn), lastState(0), lastTelemetry(0),
+      lastPerformance(0), lastSentVersion(0), clientEvents(nullptr), lastScopeSeq(0) {
   g_webUIInstance = this;
+  for (int i = 0; i < NUM_MESSAGE_TYPES; i++) {
+    telemetrySeq[i] = 0;
+  }
+  for (int i = 0; i < MAX_SCOPE_CLIENTS; i++) {
+    scopeClients[i] = 0;
+  }
+  for (int i = 0; i < MAX_STREAM_CLIENTS; i++) {
+    streamClients[i] = 0;
+  }
 }
 
 void WebUIManager::begin() {
@@ -38,9 +49,20 @@ void WebUIManager::begin() {
     }
   });
 
+  // Connect/disconnect and per-connection commands, handed to the loop task
+  clientEvents = xQueueCreate(CLIENT_EVENT_QUEUE_SIZE, sizeof(ClientEvent));
+  if (!clientEvents) {
+    DEBUG_PRINTLN("[WebUI] ERROR: Failed to create client event queue");
+    return;
+  }
+
   // Register WebSocket endpoint
   server->addHandler(&ws);
 
+  // Telemetry send buffers, allocated once (reused for the whole session)
+  telemetryPool.begin(Telemetry::MAX_PACKET_SIZE);
+  audioPool.begin(sizeof(Telemetry::AudioPacket) + AudioCapture::STREAM_PACKET_BYTES);
+
   DEBUG_PRINTLN("[WebUI] WebSocket endpoint registered at /ws");
 }
 
@@ -51,11 +73,17 @@ void WebUIManager::onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketClient
     case WS_EVT_CONNECT:
       DEBUG_PRINTF("[WebUI] Client #%u connected from %s\n", client->id(),
                    client->remoteIP().toString().c_str());
-      g_webUIInstance->sendFullState(client);
+      // Tracked (and sent the full state) by the loop task. A client that
+      // cannot be tracked would get nothing, so let it reconnect
+      if (!g_webUIInstance->postClientEvent(client->id(), CLIENT_CONNECT)) {
+        DEBUG_PRINTF("[WebUI] Client #%u: event queue full, closing\n", client->id());
+        client->close();
+      }
       break;
 
     case WS_EVT_DISCONNECT:
-      DEBUG_PRINTF("[WebUI] Client #%u disconnected\n", client->id());
+      // A lost event is caught by the loop task (ws.client() no longer finds it)
+      g_webUIInstance->postClientEvent(client->id(), CLIENT_DISCONNECT);
       break;
 
     case WS_EVT_DATA: {
@@ -76,6 +104,94 @@ void WebUIManager::onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketClient
   }
 }
 
+// Named CommandRegistry arguments from a JSON command
+// ({"cmd":"setVolume","osc":1,"value":0.5}); strings point into the document
+class JsonCommandInput : public CommandInput {
+ public:
+  explicit JsonCommandInput(JsonObjectConst obj) : obj(obj) { list[0] = '\0'; }
+
+  Status readInt(uint8_t index, const char* key, int32_t& out) override {
+    JsonVariantConst value = obj[key];
+    if (value.isNull()) {
+      return ARG_MISSING;
+    }
+    if (value.is<const char*>()) {
+      return CommandRegistry::parseInt(value.as<const char*>(), out);
+    }
+    if (!value.is<float>() && !value.is<bool>()) {
+      return ARG_INVALID;
+    }
+    out = value.as<int32_t>();
+    return ARG_OK;
+  }
+
+  Status readFloat(uint8_t index, const char* key, float& out) override {
+    JsonVariantConst value = obj[key];
+    if (value.isNull()) {
+      return ARG_MISSING;
+    }
+    if (value.is<const char*>()) {
+      return CommandRegistry::parseFloat(value.as<const char*>(), out);
+    }
+    if (!value.is<float>()) {
+      return ARG_INVALID;
+    }
+    out = value.as<float>();
+    return ARG_OK;
+  }
+
+  Status readBool(uint8_t index, const char* key, bool& out) override {
+    JsonVariantConst value = obj[key];
+    if (value.isNull()) {
+      return ARG_MISSING;
+    }
+    if (value.is<const char*>()) {
+      return CommandRegistry::parseBool(value.as<const char*>(), out);
+    }
+    if (value.is<bool>()) {
+      out = value.as<bool>();
+    } else if (value.is<float>()) {
+      out = value.as<float>() != 0.0f;
+    } else {
+      return ARG_INVALID;
+    }
+    return ARG_OK;
+  }
+
+  // An array of strings is passed as a comma-separated list ("order")
+  Status readString(uint8_t index, const char* key, const char*& out) override {
+    JsonVariantConst value = obj[key];
+    if (value.isNull()) {
+      return ARG_MISSING;
+    }
+    if (value.is<const char*>()) {
+      out = value.as<const char*>();
+      return ARG_OK;
+    }
+    if (!value.is<JsonArrayConst>()) {
+      return ARG_INVALID;
+    }
+    size_t length = 0;
+    for (JsonVariantConst item : value.as<JsonArrayConst>()) {
+      const char* name = item.as<const char*>();
+      if (name == nullptr) {
+        return ARG_INVALID;
+      }
+      int written = snprintf(list + length, sizeof(list) - length, "%s%s", length ? "," : "", name);
+      if (written < 0 || (size_t)written >= sizeof(list) - length) {
+        return ARG_INVALID;
+      }
+      length += written;
+    }
+    out = list;
+    return ARG_OK;
+  }
+
+ private:
+  JsonObjectConst obj;
+  char list[64];
+};
+
 void WebUIManager::handleWebSocketMessage(AsyncWebSocketClient* client, uint8_t* data, size_t len) {
   // Null-terminate the data for JSON parsing
   data[len] = 0;
@@ -94,422 +210,740 @@ void WebUIManager::handleWebSocketMessage(AsyncWebSocketClient* client, uint8_t*
     return;
   }
 
-  // Route command to appropriate handler
-  if (strncmp(cmd, "setWaveform", 11) == 0 || strncmp(cmd, "setOctave", 9) == 0 ||
-      strncmp(cmd, "setVolume", 9) == 0) {
-    handleOscillatorCommand(doc);
-  } else if (strncmp(cmd, "setEffectParam", 14) == 0 || strncmp(cmd, "enableEffect", 12) == 0) {
-    handleEffectCommand(doc);
-  } else if (strncmp(cmd, "setSmoothing", 12) == 0 || strncmp(cmd, "setRange", 8) == 0) {
-    handleSystemCommand(doc);
-  } else if (strcmp(cmd, "playNote") == 0) {
-    // Play MIDI note (keyboard view)
-    uint8_t midiNote = doc["note"] | 60;  // Default to middle C
-    AudioEngine* audio = theremin->getAudioEngine();
-    audio->playMIDINote(midiNote);
-    DEBUG_PRINTF("[WebUI] Play MIDI note %d\n", midiNote);
-  } else if (strcmp(cmd, "stopNote") == 0) {
-    // Stop current note (keyboard view)
-    AudioEngine* audio = theremin->getAudioEngine();
-    audio->stopNote();
-    DEBUG_PRINTLN("[WebUI] Stop note");
-  } else if (strcmp(cmd, "setSensorEnabled") == 0) {
-    // Enable/disable sensors (keyboard view)
-    const char* sensor = doc["sensor"];
-    bool enabled = doc["enabled"] | true;
-
-    SensorManager* sensors = theremin->getSensorManager();
-
-    if (strcmp(sensor, "pitch") == 0) {
-      sensors->setPitchEnabled(enabled);
-      DEBUG_PRINTF("[WebUI] Pitch sensor %s\n", enabled ? "enabled" : "disabled");
-    } else if (strcmp(sensor, "volume") == 0) {
-      sensors->setVolumeEnabled(enabled);
-      DEBUG_PRINTF("[WebUI] Volume sensor %s\n", enabled ? "enabled" : "disabled");
-    } else if (strcmp(sensor, "both") == 0) {
-      sensors->setPitchEnabled(enabled);
-      sensors->setVolumeEnabled(enabled);
-      DEBUG_PRINTF("[WebUI] Both sensors %s\n", enabled ? "enabled" : "disabled");
-    }
-  } else if (strcmp(cmd, "setAmplitude") == 0) {
-    // Set amplitude (keyboard view)
-    int amplitude = doc["value"] | 50;  // Default to 50%
-    AudioEngine* audio = theremin->getAudioEngine();
-    audio->setAmplitude(amplitude);
-    DEBUG_PRINTF("[WebUI] Amplitude set to %d%%\n", amplitude);
-  } else if (strcmp(cmd, "setFrequencyRange") == 0) {
-    // Set frequency range (keyboard view)
-    int minFreq = doc["minFreq"] | 220;
-    int maxFreq = doc["maxFreq"] | 880;
-    AudioEngine* audio = theremin->getAudioEngine();
-    audio->setFrequencyRange(minFreq, maxFreq);
-    DEBUG_PRINTF("[WebUI] Frequency range set to %d-%d Hz\n", minFreq, maxFreq);
-  } else {
+  // Front-end commands (they act on this connection, applied by the loop task)
+  if (strcmp(cmd, "getState") == 0) {
+    // Client missed a delta (version gap) - resend everything to that client
+    postClientEvent(client->id(), CLIENT_GET_STATE);
+    return;
+  }
+  if (strcmp(cmd, "setScope") == 0) {
+    // Scope view opened/closed: subscribe this client to spectrum frames
+    postClientEvent(client->id(), CLIENT_SCOPE, doc["enabled"] | false);
+    return;
+  }
+  if (strcmp(cmd, "setAudioStream") == 0) {
+    // Record/listen in the browser: subscribe this client to audio packets
+    // (the format is the one asked by the first listener)
+    const char* format = doc["format"] | "pcm";
+    postClientEvent(client->id(), CLIENT_AUDIO_STREAM, doc["enabled"] | false,
+                    strcmp(format, "adpcm") == 0 ? AudioCapture::FORMAT_ADPCM : AudioCapture::FORMAT_PCM16);
+    return;
+  }
+
+  // Everything else: shared command table, arguments by name
+  JsonCommandInput input(doc.as<JsonObjectConst>());
+  if (theremin->getCommandRegistry()->dispatch(cmd, input) == CommandRegistry::CMD_UNKNOWN) {
     DEBUG_PRINTF("[WebUI] Unknown command: %s\n", cmd);
   }
 }
 
-void WebUIManager::handleOscillatorCommand(JsonDocument& doc) {
-  const char* cmd = doc["cmd"];
-  int oscNum = doc["osc"] | 1;  // Default to oscillator 1
-
-  if (oscNum < 1 || oscNum > 3) {
-    DEBUG_PRINTF("[WebUI] Invalid oscillator number: %d\n", oscNum);
-    return;
+bool WebUIManager::postClientEvent(uint32_t clientId, ClientEventType type, bool enabled,
+                                   AudioCapture::Format format) {
+  ClientEvent event = {clientId, type, enabled, format};
+  // Never wait: this runs on the async_tcp task
+  if (!clientEvents || xQueueSend(clientEvents, &event, 0) != pdTRUE) {
+    DEBUG_PRINTF("[WebUI] Client #%u: event dropped (queue full)\n", clientId);
+    return false;
   }
+  return true;
+}
 
-  AudioEngine* audio = theremin->getAudioEngine();
+void WebUIManager::processClientEvents() {
+  ClientEvent event;
+  while (clientEvents && xQueueReceive(clientEvents, &event, 0) == pdTRUE) {
+    switch (event.type) {
+      case CLIENT_CONNECT: {
+        delivery.addClient(event.clientId);
+        AsyncWebSocketClient* client = ws.client(event.clientId);
+        if (client) {
+          sendFullState(client);
+        }
+        break;
+      }
+
+      case CLIENT_DISCONNECT: {
+        WebSocketDelivery::ClientState* state = delivery.findClient(event.clientId);
+        DEBUG_PRINTF("[WebUI] Client #%u disconnected (%lu telemetry frames skipped)\n", event.clientId,
+                     state ? (unsigned long)state->telemetrySkipped : 0UL);
+        forgetClient(event.clientId);
+        break;
+      }
 
-  if (strcmp(cmd, "setWaveform") == 0) {
-    const char* waveformStr = doc["value"];
-    Oscillator::Waveform wf = Oscillator::OFF;
+      case CLIENT_GET_STATE: {
+        AsyncWebSocketClient* client = ws.client(event.clientId);
+        if (client) {
+          sendCompleteState(client);
+        }
+        break;
+      }
+
+      case CLIENT_SCOPE:
+        setScopeClient(event.clientId, event.enabled);
+        DEBUG_PRINTF("[WebUI] Client #%u scope %s\n", event.clientId, event.enabled ? "on" : "off");
+        break;
+
+      case CLIENT_AUDIO_STREAM:
+        setStreamClient(event.clientId, event.enabled, event.format);
+        DEBUG_PRINTF("[WebUI] Client #%u audio stream %s\n", event.clientId, event.enabled ? "on" : "off");
+        break;
+    }
+  }
+}
 
-    if (strcmp(waveformStr, "OFF") == 0)
-      wf = Oscillator::OFF;
-    else if (strcmp(waveformStr, "SINE") == 0)
-      wf = Oscillator::SINE;
-    else if (strcmp(waveformStr, "SQUARE") == 0)
-      wf = Oscillator::SQUARE;
-    else if (strcmp(waveformStr, "TRIANGLE") == 0)
-      wf = Oscillator::TRIANGLE;
-    else if (strcmp(waveformStr, "SAW") == 0)
-      wf = Oscillator::SAW;
+void WebUIManager::sendFullState(AsyncWebSocketClient* client) {
+  DEBUG_PRINTF("[WebUI] Sending full state to client #%u\n", client->id());
 
-    audio->setOscillatorWaveform(oscNum, wf);
-    DEBUG_PRINTF("[WebUI] Osc %d waveform -> %s\n", oscNum, waveformStr);
-    sendOscillatorState(oscNum);
+  // Effect parameter descriptors first (static, only needed once per client)
+  sendEffectSchema(client);
 
-  } else if (strcmp(cmd, "setOctave") == 0) {
-    int octave = doc["value"] | 0;
-    audio->setOscillatorOctave(oscNum, octave);
-    DEBUG_PRINTF("[WebUI] Osc %d octave -> %d\n", oscNum, octave);
-    sendOscillatorState(oscNum);
+  // Send complete state as a single batched message
+  sendCompleteState(client);
+}
 
-  } else if (strcmp(cmd, "setVolume") == 0) {
-    float volume = doc["value"] | 1.0f;
-    audio->setOscillatorVolume(oscNum, volume);
-    DEBUG_PRINTF("[WebUI] Osc %d volume -> %.2f\n", oscNum, volume);
-    sendOscillatorState(oscNum);
+// Waveform name used by the JSON protocol
+static const char* waveformName(Oscillator::Waveform wf) {
+  switch (wf) {
+    case Oscillator::SINE:
+      return "SINE";
+    case Oscillator::SQUARE:
+      return "SQUARE";
+    case Oscillator::TRIANGLE:
+      return "TRIANGLE";
+    case Oscillator::SAW:
+      return "SAW";
+    default:
+      return "OFF";
   }
 }
 
-void WebUIManager::handleEffectCommand(JsonDocument& doc) {
-  const char* cmd = doc["cmd"];
-  const char* effectName = doc["effect"];
+void WebUIManager::addOscillatorValues(JsonObject obj, int oscNum, uint32_t changes) {
+  AudioEngine* audio = theremin->getAudioEngine();
 
-  if (!effectName) {
-    DEBUG_PRINTLN("[WebUI] Missing 'effect' field");
-    return;
+  // Each getter takes the audio mutex - only read the fields that changed
+  if (changes & StateTracker::oscBit(oscNum, StateTracker::OSC_WAVEFORM)) {
+    obj["waveform"] = waveformName(audio->getOscillatorWaveform(oscNum));
   }
+  if (changes & StateTracker::oscBit(oscNum, StateTracker::OSC_OCTAVE)) {
+    obj["octave"] = audio->getOscillatorOctave(oscNum);
+  }
+  if (changes & StateTracker::oscBit(oscNum, StateTracker::OSC_VOLUME)) {
+    obj["volume"] = audio->getOscillatorVolume(oscNum);
+  }
+}
 
-  EffectsChain* effects = theremin->getAudioEngine()->getEffectsChain();
+void WebUIManager::addEffectValues(JsonObject obj, AudioEffect* effect) {
+  // Keys come from the effect's parameter table ("time", "roomSize", ...)
+  obj["enabled"] = effect->isEnabled();
+  for (uint8_t i = 0; i < effect->getParamCount(); i++) {
+    obj[effect->getParamInfo(i).key] = effect->getParam(i);
+  }
+}
 
-  if (strcmp(cmd, "enableEffect") == 0) {
-    bool enabled = doc["value"] | false;
+void WebUIManager::sendEffectSchema(AsyncWebSocketClient* client) {
+  EffectsChain* effects = theremin->getAudioEngine()->getEffectsChain();
 
-    if (strcmp(effectName, "delay") == 0) {
-      effects->setDelayEnabled(enabled);
-      DEBUG_PRINTF("[WebUI] Delay %s\n", enabled ? "enabled" : "disabled");
-    } else if (strcmp(effectName, "chorus") == 0) {
-      effects->setChorusEnabled(enabled);
-      DEBUG_PRINTF("[WebUI] Chorus %s\n", enabled ? "enabled" : "disabled");
-    } else if (strcmp(effectName, "reverb") == 0) {
-      effects->setReverbEnabled(enabled);
-      DEBUG_PRINTF("[WebUI] Reverb %s\n", enabled ? "enabled" : "disabled");
+  // Parameter descriptors, sent once on connect so the UI can build its
+  // controls without a hard-coded list of effects
+  JsonDocument doc;
+  doc["type"] = "effectSchema";
+  JsonArray list = doc["effects"].to<JsonArray>();
+  for (uint8_t i = 0; i < effects->getEffectCount(); i++) {
+    AudioEffect* effect = effects->getEffect(i);
+    JsonObject effectObj = list.add<JsonObject>();
+    effectObj["name"] = effect->getName();
+
+    JsonArray params = effectObj["params"].to<JsonArray>();
+    for (uint8_t p = 0; p < effect->getParamCount(); p++) {
+      const EffectParam& info = effect->getParamInfo(p);
+      JsonObject paramObj = params.add<JsonObject>();
+      paramObj["name"] = info.key;
+      paramObj["label"] = info.label;
+      paramObj["unit"] = info.unit;
+      paramObj["min"] = info.minValue;
+      paramObj["max"] = info.maxValue;
+      paramObj["step"] = info.step;
     }
+  }
 
-    sendEffectState(effectName);
+  sendJson(doc, client);
+}
 
-  } else if (strcmp(cmd, "setEffectParam") == 0) {
-    const char* param = doc["param"];
-    if (!param) {
-      DEBUG_PRINTLN("[WebUI] Missing 'param' field");
-      return;
-    }
+// Clamp a µs/byte count into a 16-bit telemetry field
+static inline uint16_t clampU16(uint32_t value) {
+  return value > 0xFFFF ? 0xFFFF : (uint16_t)value;
+}
 
-    if (strcmp(effectName, "delay") == 0) {
-      DelayEffect* delay = effects->getDelay();
-      if (strcmp(param, "time") == 0) {
-        uint32_t time = doc["value"] | 300;
-        delay->setDelayTime(time);
-        DEBUG_PRINTF("[WebUI] Delay time -> %u ms\n", time);
-      } else if (strcmp(param, "feedback") == 0) {
-        float feedback = doc["value"] | 0.5f;
-        delay->setFeedback(feedback);
-        DEBUG_PRINTF("[WebUI] Delay feedback -> %.2f\n", feedback);
-      } else if (strcmp(param, "mix") == 0) {
-        float mix = doc["value"] | 0.3f;
-        delay->setMix(mix);
-        DEBUG_PRINTF("[WebUI] Delay mix -> %.2f\n", mix);
-      }
-      sendEffectState("delay");
-
-    } else if (strcmp(effectName, "chorus") == 0) {
-      ChorusEffect* chorus = effects->getChorus();
-      if (strcmp(param, "rate") == 0) {
-        float rate = doc["value"] | 1.0f;
-        chorus->setRate(rate);
-        DEBUG_PRINTF("[WebUI] Chorus rate -> %.2f Hz\n", rate);
-      } else if (strcmp(param, "depth") == 0) {
-        float depth = doc["value"] | 0.5f;
-        chorus->setDepth(depth);
-        DEBUG_PRINTF("[WebUI] Chorus depth -> %.2f\n", depth);
-      } else if (strcmp(param, "mix") == 0) {
-        float mix = doc["value"] | 0.5f;
-        chorus->setMix(mix);
-        DEBUG_PRINTF("[WebUI] Chorus mix -> %.2f\n", mix);
-      }
-      sendEffectState("chorus");
-
-    } else if (strcmp(effectName, "reverb") == 0) {
-      ReverbEffect* reverb = effects->getReverb();
-      if (strcmp(param, "roomSize") == 0) {
-        float size = doc["value"] | 0.5f;
-        reverb->setRoomSize(size);
-        DEBUG_PRINTF("[WebUI] Reverb room size -> %.2f\n", size);
-      } else if (strcmp(param, "damping") == 0) {
-        float damping = doc["value"] | 0.5f;
-        reverb->setDamping(damping);
-        DEBUG_PRINTF("[WebUI] Reverb damping -> %.2f\n", damping);
-      } else if (strcmp(param, "mix") == 0) {
-        float mix = doc["value"] | 0.3f;
-        reverb->setMix(mix);
-        DEBUG_PRINTF("[WebUI] Reverb mix -> %.2f\n", mix);
-      }
-      sendEffectState("reverb");
+void WebUIManager::fillHeader(Telemetry::Header& header, Telemetry::MessageType type) {
+  header.version = Telemetry::PROTOCOL_VERSION;
+  header.type = type;
+  header.seq = telemetrySeq[type]++;
+}
+
+void WebUIManager::sendBinary(const void* packet, size_t len, AsyncWebSocketClient* client) {
+  AsyncWebSocketSharedBuffer* buffer = fillTelemetryBuffer(packet, len);
+  if (!buffer) {
+    return;
+  }
+
+  if (client) {
+    delivery.queueTelemetry(client, *buffer);
+    return;
+  }
+  for (int i = 0; i < WebSocketDelivery::MAX_CLIENTS; i++) {
+    uint32_t id = delivery.getClientId(i);
+    AsyncWebSocketClient* each = id ? ws.client(id) : nullptr;
+    if (each) {
+      delivery.queueTelemetry(each, *buffer);
     }
   }
 }
 
-void WebUIManager::handleSystemCommand(JsonDocument& doc) {
-  const char* cmd = doc["cmd"];
+AsyncWebSocketSharedBuffer* WebUIManager::fillTelemetryBuffer(const void* packet, size_t len) {
+  AsyncWebSocketSharedBuffer* buffer = telemetryPool.acquire();
+  if (!buffer) {
+    // All buffers still queued: clients are behind, the next frame supersedes this one
+    delivery.countDropped();
+    return nullptr;
+  }
+
+  // Within the reserved capacity - no allocation
+  const uint8_t* bytes = static_cast<const uint8_t*>(packet);
+  (*buffer)->assign(bytes, bytes + len);
+  return buffer;
+}
 
-  if (strcmp(cmd, "setSmoothing") == 0) {
-    const char* target = doc["target"];
-    int preset = doc["value"] | 1;
+void WebUIManager::sendJson(JsonDocument& doc, AsyncWebSocketClient* client) {
+  // Serialized once, straight into the buffer every client queues
+  size_t len = measureJson(doc);
+  AsyncWebSocketSharedBuffer buffer = std::make_shared<std::vector<uint8_t>>(len + 1);
+  serializeJson(doc, reinterpret_cast<char*>(buffer->data()), len + 1);
+  buffer->resize(len);  // Drop the terminator, keeps the capacity
 
-    if (strcmp(target, "pitch") == 0) {
-      theremin->setPitchSmoothingPreset((Theremin::SmoothingPreset)preset);
-      DEBUG_PRINTF("[WebUI] Pitch smoothing preset -> %d\n", preset);
-    } else if (strcmp(target, "volume") == 0) {
-      theremin->setVolumeSmoothingPreset((Theremin::SmoothingPreset)preset);
-      DEBUG_PRINTF("[WebUI] Volume smoothing preset -> %d\n", preset);
+  if (client) {
+    delivery.queueReliable(client, buffer);
+    return;
+  }
+  for (int i = 0; i < WebSocketDelivery::MAX_CLIENTS; i++) {
+    uint32_t id = delivery.getClientId(i);
+    AsyncWebSocketClient* each = id ? ws.client(id) : nullptr;
+    if (each) {
+      delivery.queueReliable(each, buffer);
+    }
+  }
+}
+
+void WebUIManager::resyncClients() {
+  for (int i = 0; i < WebSocketDelivery::MAX_CLIENTS; i++) {
+    uint32_t id = delivery.getClientId(i);
+    if (id == 0) {
+      continue;
+    }
+    AsyncWebSocketClient* client = ws.client(id);
+    if (!client) {
+      forgetClient(id);  // Gone without a disconnect event
+      continue;
     }
+    // Fell behind on configuration and has caught up since
+    if (delivery.takeResync(client)) {
+      sendCompleteState(client);
+    }
+  }
+}
+
+void WebUIManager::forgetClient(uint32_t clientId) {
+  setScopeClient(clientId, false);
+  setStreamClient(clientId, false, AudioCapture::FORMAT_PCM16);
+  delivery.removeClient(clientId);
+}
 
-    // Broadcast updated system state
-    sendSystemState();
+void WebUIManager::sendSensorState(AsyncWebSocketClient* client) {
+  SensorManager* sensors = theremin->getSensorManager();
 
-  } else if (strcmp(cmd, "setRange") == 0) {
-    int preset = doc["value"] | 1;
-    theremin->setFrequencyRangePreset((Theremin::FrequencyRangePreset)preset);
-    DEBUG_PRINTF("[WebUI] Frequency range preset -> %d\n", preset);
+  Telemetry::SensorPacket packet;
+  fillHeader(packet.header, Telemetry::MSG_SENSOR);
+  packet.pitch = sensors->getPitchDistance();
+  packet.volume = sensors->getVolumeDistance();
 
-    // Broadcast updated system state
-    sendSystemState();
-  }
+  sendBinary(&packet, sizeof(packet), client);
 }
 
-void WebUIManager::sendFullState(AsyncWebSocketClient* client) {
-  DEBUG_PRINTF("[WebUI] Sending full state to client #%u\n", client->id());
+void WebUIManager::sendPerformanceState(AsyncWebSocketClient* client) {
+  PerformanceMonitor* perfMon = theremin->getAudioEngine()->getPerformanceMonitor();
+  if (!perfMon) {
+    return;
+  }
 
-  // Send complete state as a single batched message
-  sendCompleteState(client);
+  Telemetry::PerformancePacket packet;
+  fillHeader(packet.header, Telemetry::MSG_PERFORMANCE);
+  packet.uptimeMs = millis();
+  packet.freeHeap = ESP.getFreeHeap();
+  packet.largestBlock = perfMon->getLargestFreeBlock();
+  packet.minFreeHeap = perfMon->getMinFreeHeap();
+  packet.underruns = perfMon->getUnderrunCount();
+  packet.sampleRate = Audio::SAMPLE_RATE;
+  packet.audioTimeUs = clampU16((uint32_t)(perfMon->getAudioTimeMs() * 1000.0f));
+  packet.maxAudioTimeUs = clampU16((uint32_t)(AudioEngine::getMaxAudioTimeMs() * 1000.0f));
+  packet.oscTimeUs = clampU16((uint32_t)(perfMon->getOscillatorTimeMs() * 1000.0f));
+  packet.p50Us = clampU16(perfMon->getAudioPercentileUs(50));
+  packet.p95Us = clampU16(perfMon->getAudioPercentileUs(95));
+  packet.p99Us = clampU16(perfMon->getAudioPercentileUs(99));
+  packet.maxUs = clampU16(perfMon->getAudioMaxUs());
+  packet.blockedAvgUs = clampU16(perfMon->getI2SBlockedAvgUs());
+  for (int i = 0; i < Telemetry::NUM_STACKS; i++) {
+    int32_t stackFree = perfMon->getTaskStackFree(i);
+    packet.stackFree[i] = (int16_t)(stackFree > 0x7FFF ? 0x7FFF : stackFree);
+  }
+  packet.cpu0 = (uint8_t)perfMon->getCoreLoad(0);
+  packet.cpu1 = (uint8_t)perfMon->getCoreLoad(1);
+  packet.fragmentation = perfMon->getHeapFragmentation();
+  packet.i2sBits = Audio::I2S_FRAME_BITS;
+  packet.flags = (perfMon->isOversampling() ? Telemetry::PERF_FLAG_OVERSAMPLED : 0) |
+                 (Audio::I2S_USE_APLL ? Telemetry::PERF_FLAG_APLL : 0);
+  I2CBus* bus = theremin->getI2CBus();
+  packet.i2cLoad = bus ? bus->getUtilizationPercent() : 0;
+
+  sendBinary(&packet, sizeof(packet), client);
 }
 
-void WebUIManager::sendOscillatorState(int oscNum, AsyncWebSocketClient* client) {
-  AudioEngine* audio = theremin->getAudioEngine();
+void WebUIManager::sendTunerState(AsyncWebSocketClient* client) {
+  TunerManager* tuner = theremin->getTunerManager();
+  if (!tuner) {
+    return;
+  }
 
-  JsonDocument doc;
-  doc["type"] = "oscillator";
-  doc["osc"] = oscNum;
+  Telemetry::TunerPacket packet;
+  fillHeader(packet.header, Telemetry::MSG_TUNER);
+  packet.frequency = tuner->getCurrentFrequency();
+  packet.noteIndex = (int8_t)tuner->getNoteIndex();
+  packet.octave = (int8_t)tuner->getCurrentOctave();
+  packet.cents = (int8_t)tuner->getCents();
+  packet.flags = (tuner->hasValidData() ? Telemetry::TUNER_FLAG_VALID : 0) |
+                 (tuner->isInTune() ? Telemetry::TUNER_FLAG_IN_TUNE : 0);
 
-  // Get waveform as string
-  Oscillator::Waveform wf = audio->getOscillatorWaveform(oscNum);
-  const char* wfStr = "OFF";
-  switch (wf) {
-    case Oscillator::SINE:
-      wfStr = "SINE";
-      break;
-    case Oscillator::SQUARE:
-      wfStr = "SQUARE";
-      break;
-    case Oscillator::TRIANGLE:
-      wfStr = "TRIANGLE";
-      break;
-    case Oscillator::SAW:
-      wfStr = "SAW";
-      break;
-    default:
-      wfStr = "OFF";
-      break;
+  sendBinary(&packet, sizeof(packet), client);
+}
+
+void WebUIManager::setScopeClient(uint32_t clientId, bool enabled) {
+  int freeSlot = -1;
+  for (int i = 0; i < MAX_SCOPE_CLIENTS; i++) {
+    if (scopeClients[i] == clientId) {
+      if (!enabled) {
+        scopeClients[i] = 0;
+      }
+      return;
+    }
+    if (scopeClients[i] == 0 && freeSlot < 0) {
+      freeSlot = i;
+    }
   }
-  doc["waveform"] = wfStr;
-  doc["octave"] = audio->getOscillatorOctave(oscNum);
-  doc["volume"] = audio->getOscillatorVolume(oscNum);
 
-  broadcastUpdate("oscillator", doc);
+  if (enabled && freeSlot >= 0) {
+    scopeClients[freeSlot] = clientId;
+  }
 }
 
-void WebUIManager::sendEffectState(const char* effectName, AsyncWebSocketClient* client) {
-  EffectsChain* effects = theremin->getAudioEngine()->getEffectsChain();
+bool WebUIManager::hasScopeClients() const {
+  for (int i = 0; i < MAX_SCOPE_CLIENTS; i++) {
+    if (scopeClients[i] != 0) {
+      return true;
+    }
+  }
+  return false;
+}
 
-  JsonDocument doc;
-  doc["type"] = "effect";
-  doc["effect"] = effectName;
+void WebUIManager::sendSpectrumFrame() {
+  SpectrumAnalyzer* analyzer = theremin->getSpectrumAnalyzer();
+  if (!analyzer) {
+    return;
+  }
 
-  if (strcmp(effectName, "delay") == 0) {
-    DelayEffect* delay = effects->getDelay();
-    doc["enabled"] = delay->isEnabled();
-    doc["time"] = delay->getDelayTime();
-    doc["feedback"] = delay->getFeedback();
-    doc["mix"] = delay->getMix();
+  // Keep the analysis task running while someone is watching
+  analyzer->keepAlive();
 
-  } else if (strcmp(effectName, "chorus") == 0) {
-    ChorusEffect* chorus = effects->getChorus();
-    doc["enabled"] = chorus->isEnabled();
-    doc["rate"] = chorus->getRate();
-    doc["depth"] = chorus->getDepth();
-    doc["mix"] = chorus->getMix();
+  // Only new frames (the analyzer runs at its own rate)
+  if (analyzer->getFrameSeq() == lastScopeSeq) {
+    return;
+  }
 
-  } else if (strcmp(effectName, "reverb") == 0) {
-    ReverbEffect* reverb = effects->getReverb();
-    doc["enabled"] = reverb->isEnabled();
-    doc["roomSize"] = reverb->getRoomSize();
-    doc["damping"] = reverb->getDamping();
-    doc["mix"] = reverb->getMix();
+  Telemetry::SpectrumPacket packet;
+  static SpectrumAnalyzer::Frame frame;  // Loop task only - keep it off the stack
+  uint32_t frameSeq;
+  if (!analyzer->copyFrame(frame, frameSeq)) {
+    return;  // Replaced during the copy - take the next one
+  }
+  lastScopeSeq = frameSeq;
+
+  static_assert(Telemetry::SPECTRUM_BINS == SpectrumAnalyzer::NUM_BINS, "Spectrum bin count mismatch");
+  static_assert(Telemetry::SCOPE_POINTS == SpectrumAnalyzer::SCOPE_POINTS, "Scope point count mismatch");
+
+  fillHeader(packet.header, Telemetry::MSG_SPECTRUM);
+  packet.sampleRate = Audio::SAMPLE_RATE;
+  packet.binCount = Telemetry::SPECTRUM_BINS;
+  packet.scopeCount = Telemetry::SCOPE_POINTS;
+  packet.scopeStep = SpectrumAnalyzer::SCOPE_STEP;
+  packet.reserved = 0;
+  packet.peak = frame.peak;
+  packet.frameSeq = (uint16_t)frameSeq;
+  memcpy(packet.bins, frame.bins, sizeof(packet.bins));
+  memcpy(packet.scope, frame.scope, sizeof(packet.scope));
+
+  // One copy shared by every subscribed client
+  AsyncWebSocketSharedBuffer* buffer = fillTelemetryBuffer(&packet, sizeof(packet));
+  if (!buffer) {
+    return;
   }
 
-  broadcastUpdate("effect", doc);
+  for (int i = 0; i < MAX_SCOPE_CLIENTS; i++) {
+    if (scopeClients[i] == 0) {
+      continue;
+    }
+    AsyncWebSocketClient* client = ws.client(scopeClients[i]);
+    if (client) {
+      delivery.queueTelemetry(client, *buffer);
+    } else {
+      scopeClients[i] = 0;  // Gone without a disconnect event
+    }
+  }
 }
 
-void WebUIManager::sendSensorState(AsyncWebSocketClient* client) {
-  SensorManager* sensors = theremin->getSensorManager();
+void WebUIManager::setStreamClient(uint32_t clientId, bool enabled, AudioCapture::Format format) {
+  AudioCapture* capture = theremin->getAudioCapture();
+  if (!capture) {
+    return;
+  }
+  const bool wasStreaming = hasStreamClients();
+
+  int freeSlot = -1;
+  int slot = -1;
+  for (int i = 0; i < MAX_STREAM_CLIENTS; i++) {
+    if (streamClients[i] == clientId) {
+      slot = i;
+    } else if (streamClients[i] == 0 && freeSlot < 0) {
+      freeSlot = i;
+    }
+  }
 
-  JsonDocument doc;
-  doc["type"] = "sensor";
-  doc["pitch"] = sensors->getPitchDistance();
-  doc["volume"] = sensors->getVolumeDistance();
+  if (!enabled) {
+    if (slot < 0) {
+      return;
+    }
+    streamClients[slot] = 0;
+    if (!hasStreamClients()) {
+      capture->stop();  // Last listener gone
+    }
+    return;
+  }
 
-  String output;
-  serializeJson(doc, output);
+  if (slot >= 0) {
+    return;
+  }
+  if (freeSlot < 0) {
+    DEBUG_PRINTLN("[WebUI] Audio stream: too many listeners");
+    return;
+  }
+  if (!wasStreaming && !capture->start(AudioCapture::SINK_STREAM, format)) {
+    DEBUG_PRINTLN("[WebUI] Audio stream unavailable (a capture is running)");
+    return;
+  }
+  streamClients[freeSlot] = clientId;
+}
 
-  if (client) {
-    client->text(output);
-  } else {
-    ws.textAll(output);
+bool WebUIManager::hasStreamClients() const {
+  for (int i = 0; i < MAX_STREAM_CLIENTS; i++) {
+    if (streamClients[i] != 0) {
+      return true;
+    }
   }
+  return false;
 }
 
-void WebUIManager::sendPerformanceState(AsyncWebSocketClient* client) {
-  JsonDocument doc;
-  doc["type"] = "performance";
-  doc["cpu"] = 0.0;  // CPU usage calculation would require additional monitoring
-  doc["ram"] = ESP.getFreeHeap();
-  doc["uptime"] = millis();
+void WebUIManager::sendAudioStream() {
+  AudioCapture* capture = theremin->getAudioCapture();
+  if (!capture) {
+    return;
+  }
+
+  // Everything the capture task has ready (a few packets per tick)
+  const AudioCapture::StreamPacket* packet;
+  while ((packet = capture->peekPacket()) != nullptr) {
+    AsyncWebSocketSharedBuffer* buffer = audioPool.acquire();
+
+    if (buffer) {
+      Telemetry::AudioPacket header;
+      fillHeader(header.header, Telemetry::MSG_AUDIO);
+      header.sampleRate = Audio::SAMPLE_RATE;
+      header.position = packet->position;
+      header.dropped = packet->dropped;
+      header.sampleCount = packet->sampleCount;
+      header.format = (packet->format == AudioCapture::FORMAT_ADPCM) ? Telemetry::AUDIO_FORMAT_IMA_ADPCM
+                                                                     : Telemetry::AUDIO_FORMAT_PCM16;
+      header.reserved = 0;
+
+      // Within the reserved capacity - no allocation
+      const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+      (*buffer)->assign(headerBytes, headerBytes + sizeof(header));
+      (*buffer)->insert((*buffer)->end(), packet->data, packet->data + packet->bytes);
+    } else {
+      delivery.countDropped();  // All buffers still queued: clients are behind
+    }
+    capture->releasePacket();
+
+    if (!buffer) {
+      continue;
+    }
+    for (int i = 0; i < MAX_STREAM_CLIENTS; i++) {
+      if (streamClients[i] == 0) {
+        continue;
+      }
+      AsyncWebSocketClient* client = ws.client(streamClients[i]);
+      if (client) {
+        delivery.queueTelemetry(client, *buffer, AUDIO_QUEUE_DEPTH);
+      } else {
+        setStreamClient(streamClients[i], false, AudioCapture::FORMAT_PCM16);  // Gone without a disconnect event
+      }
+    }
+  }
+}
 
-  // Add audio task time if PerformanceMonitor is available
+void WebUIManager::addPerformanceValues(JsonObject obj) {
   PerformanceMonitor* perfMon = theremin->getAudioEngine()->getPerformanceMonitor();
-  if (perfMon) {
-    doc["audioTime"] = perfMon->getAudioTimeMs();
-  } else {
-    doc["audioTime"] = 0.0;
+
+  obj["ram"] = ESP.getFreeHeap();
+  obj["uptime"] = millis();
+
+  // Maximum audio time (calculated from buffer configuration)
+  obj["maxAudioTime"] = AudioEngine::getMaxAudioTimeMs();
+
+  // Output configuration the CPU figures refer to
+  obj["sampleRate"] = Audio::SAMPLE_RATE;
+  obj["i2sBits"] = Audio::I2S_FRAME_BITS;
+  obj["apll"] = Audio::I2S_USE_APLL;
+
+  if (!perfMon) {
+    obj["cpu"] = 0.0;
+    obj["audioTime"] = 0.0;
+    return;
   }
 
-  // Add maximum audio time (calculated from buffer configuration)
-  doc["maxAudioTime"] = AudioEngine::getMaxAudioTimeMs();
+  // CPU load per core (idle-task run time) - "cpu" is the average of both
+  obj["cpu"] = (perfMon->getCoreLoad(0) + perfMon->getCoreLoad(1)) / 2.0f;
+  obj["cpu0"] = perfMon->getCoreLoad(0);
+  obj["cpu1"] = perfMon->getCoreLoad(1);
 
-  String output;
-  serializeJson(doc, output);
+  // Stack high-water marks (free bytes, -1 = task not running)
+  JsonObject stack = obj["stack"].to<JsonObject>();
+  for (int i = 0; i < PerformanceMonitor::NUM_TRACKED_TASKS; i++) {
+    stack[perfMon->getTaskLabel(i)] = perfMon->getTaskStackFree(i);
+  }
 
-  if (client) {
-    client->text(output);
-  } else {
-    ws.textAll(output);
+  // Heap shape, not just the total
+  JsonObject heap = obj["heap"].to<JsonObject>();
+  heap["free"] = ESP.getFreeHeap();
+  heap["largestBlock"] = perfMon->getLargestFreeBlock();
+  heap["minFree"] = perfMon->getMinFreeHeap();
+  heap["fragmentation"] = perfMon->getHeapFragmentation();
+  heap["looper"] = perfMon->getLooperBytes();
+  heap["looperPsram"] = perfMon->isLooperInPsram();
+
+  // Audio task time and oscillator render share
+  // (compare QUALITY_STANDARD vs oversampled HIGH)
+  obj["audioTime"] = perfMon->getAudioTimeMs();
+  obj["oscTime"] = perfMon->getOscillatorTimeMs();
+  obj["oversampled"] = perfMon->isOversampling();
+
+  // Audio deadline statistics (µs)
+  JsonObject deadline = obj["deadline"].to<JsonObject>();
+  deadline["p50"] = perfMon->getAudioPercentileUs(50);
+  deadline["p95"] = perfMon->getAudioPercentileUs(95);
+  deadline["p99"] = perfMon->getAudioPercentileUs(99);
+  deadline["max"] = perfMon->getAudioMaxUs();
+  deadline["underruns"] = perfMon->getUnderrunCount();
+  deadline["blockedAvg"] = perfMon->getI2SBlockedAvgUs();
+  deadline["blockedMin"] = perfMon->getI2SBlockedMinUs();
+
+  // Shared I2C bus (sensors, expander, display)
+  I2CBus* bus = theremin->getI2CBus();
+  if (bus) {
+    JsonObject i2c = obj["i2c"].to<JsonObject>();
+    i2c["clock"] = bus->getClockHz();
+    i2c["load"] = bus->getUtilizationPercent();
+    i2c["nack"] = bus->getNackCount();
+    i2c["timeout"] = bus->getTimeoutCount();
+    i2c["errors"] = bus->getErrorCount();
+    i2c["recoveries"] = bus->getRecoveryCount();
+  }
+
+  // Boot timeline (ms since power-on, 0 = not reached)
+  JsonObject boot = obj["boot"].to<JsonObject>();
+  for (int i = 0; i < BootTimeline::NUM_MILESTONES; i++) {
+    BootTimeline::Milestone milestone = (BootTimeline::Milestone)i;
+    boot[BootTimeline::name(milestone)] = BootTimeline::get(milestone);
+  }
+
+  // Init phase durations (µs)
+  JsonObject bootPhases = obj["bootPhases"].to<JsonObject>();
+  for (int i = 0; i < BootTimeline::getPhaseCount(); i++) {
+    bootPhases[BootTimeline::getPhaseName(i)] = BootTimeline::getPhaseDurationUs(i);
+  }
+
+  // Per-stage breakdown (µs per block), only when built with profiling
+  DSPProfiler* profiler = perfMon->getDSPProfiler();
+  if (profiler) {
+    JsonObject dsp = obj["dsp"].to<JsonObject>();
+    for (int i = 0; i < DSPProfiler::STAGE_COUNT; i++) {
+      JsonObject stage = dsp[DSPProfiler::getStageName(i)].to<JsonObject>();
+      stage["avg"] = profiler->getAverageUs(i);
+      stage["peak"] = profiler->getPeakUs(i);
+    }
   }
 }
 
-void WebUIManager::sendSystemState(AsyncWebSocketClient* client) {
+void WebUIManager::addSystemValues(JsonObject obj, uint32_t changes) {
   AudioEngine* audio = theremin->getAudioEngine();
 
-  JsonDocument doc;
-  doc["type"] = "system";
-  doc["pitchSmoothing"] = (int)theremin->getPitchSmoothingPreset();
-  doc["volumeSmoothing"] = (int)theremin->getVolumeSmoothingPreset();
-  doc["frequencyRange"] = (int)theremin->getFrequencyRangePreset();
-  doc["minFrequency"] = audio->getMinFrequency();
-  doc["maxFrequency"] = audio->getMaxFrequency();
+  if (changes & StateTracker::PITCH_SMOOTHING) {
+    obj["pitchSmoothing"] = (int)theremin->getPitchSmoothingPreset();
+  }
+  if (changes & StateTracker::VOLUME_SMOOTHING) {
+    obj["volumeSmoothing"] = (int)theremin->getVolumeSmoothingPreset();
+  }
+  if (changes & StateTracker::FREQUENCY_RANGE) {
+    obj["frequencyRange"] = (int)theremin->getFrequencyRangePreset();
+  }
+  if (changes & StateTracker::QUALITY) {
+    obj["quality"] = (int)audio->getQualityPreset();
+  }
+  if (changes & StateTracker::FREQUENCY_BOUNDS) {
+    obj["minFrequency"] = audio->getMinFrequency();
+    obj["maxFrequency"] = audio->getMaxFrequency();
+  }
+}
 
-  String output;
-  serializeJson(doc, output);
+void WebUIManager::addConfigValues(JsonDocument& doc, uint32_t changes) {
+  EffectsChain* effects = theremin->getAudioEngine()->getEffectsChain();
 
-  if (client) {
-    client->text(output);
-  } else {
-    ws.textAll(output);
+  // Oscillators ("1".."3"), only those with a changed field
+  if (changes & StateTracker::OSC_MASK) {
+    JsonObject oscillators = doc["oscillators"].to<JsonObject>();
+    for (int i = 1; i <= 3; i++) {
+      uint32_t oscBits = StateTracker::oscBit(i, StateTracker::OSC_WAVEFORM) |
+                         StateTracker::oscBit(i, StateTracker::OSC_OCTAVE) |
+                         StateTracker::oscBit(i, StateTracker::OSC_VOLUME);
+      if (changes & oscBits) {
+        char key[2] = {(char)('0' + i), '\0'};
+        addOscillatorValues(oscillators[key].to<JsonObject>(), i, changes);
+      }
+    }
+  }
+
+  // Effects (generic - one object per changed effect, by registration index)
+  if (changes & StateTracker::EFFECT_MASK) {
+    JsonObject effectsObj = doc["effects"].to<JsonObject>();
+    for (uint8_t i = 0; i < effects->getEffectCount(); i++) {
+      if (changes & StateTracker::effectBit(i)) {
+        AudioEffect* effect = effects->getEffect(i);
+        addEffectValues(effectsObj[effect->getName()].to<JsonObject>(), effect);
+      }
+    }
+  }
+
+  if (changes & StateTracker::EFFECT_ORDER) {
+    JsonArray orderArr = doc["effectsOrder"].to<JsonArray>();
+    for (uint8_t slot = 0; slot < effects->getEffectCount(); slot++) {
+      orderArr.add(effects->getSlot(slot)->getName());
+    }
+  }
+
+  if (changes & StateTracker::SYSTEM_MASK) {
+    addSystemValues(doc["system"].to<JsonObject>(), changes);
+  }
+
+  if (changes & StateTracker::PRESETS) {
+    PresetManager* presets = theremin->getPresetManager();
+    JsonObject bank = doc["presets"].to<JsonObject>();
+    bank["active"] = presets->getActiveSlot() + 1;  // 0 = none
+    JsonArray slots = bank["slots"].to<JsonArray>();
+    char name[PresetManager::NAME_LENGTH];
+    for (uint8_t i = 0; i < PresetManager::NUM_SLOTS; i++) {
+      JsonObject entry = slots.add<JsonObject>();
+      entry["slot"] = i + 1;
+      entry["used"] = presets->getName(i, name, sizeof(name));
+      entry["name"] = name;  // Copied by ArduinoJson
+    }
+
+    JsonObject morph = bank["morph"].to<JsonObject>();
+    morph["active"] = presets->isMorphing();
+    morph["from"] = presets->getMorphFrom() + 1;
+    morph["to"] = presets->getMorphTo() + 1;
+    morph["source"] = (presets->getMorphSource() == PresetManager::MORPH_SENSOR) ? "sensor" : "manual";
+    morph["position"] = presets->getMorphPosition();
+  }
+
+  if (changes & StateTracker::AUTOMATION) {
+    static const char* const STATE_NAMES[] = {"idle", "recording", "playing"};
+    AutomationLane* lane = theremin->getAudioEngine()->getAutomation();
+    JsonObject automation = doc["automation"].to<JsonObject>();
+    automation["state"] = STATE_NAMES[lane->getState()];
+    automation["events"] = lane->getEventCount();
+    automation["lengthMs"] = (uint32_t)((uint64_t)lane->getLoopLength() * 1000 / Audio::SAMPLE_RATE);
+    automation["dropped"] = lane->getDropped();
+  }
+
+  if (changes & StateTracker::LOOPER) {
+    static const char* const STATE_NAMES[] = {"empty", "recording", "playing", "overdubbing", "stopped"};
+    Looper* looper = theremin->getAudioEngine()->getLooper();
+    JsonObject loop = doc["looper"].to<JsonObject>();
+    loop["state"] = STATE_NAMES[looper->getState()];
+    loop["format"] = (looper->getFormat() == Looper::FORMAT_ULAW) ? "ulaw" : "pcm";
+    loop["lengthMs"] = (uint32_t)((uint64_t)looper->getLengthSamples() * 1000 / Audio::SAMPLE_RATE);
+    loop["maxMs"] = (uint32_t)((uint64_t)looper->getCapacitySamples() * 1000 / Audio::SAMPLE_RATE);
+    loop["feedback"] = looper->getFeedback();
+    loop["level"] = looper->getLevel();
+    loop["canUndo"] = looper->canUndo();
+    loop["memory"] = looper->getMemoryBytes();
+    loop["psram"] = looper->isPsram();
+  }
+
+  if (changes & StateTracker::CAPTURE) {
+    static const char* const SINK_NAMES[] = {"idle", "file", "stream"};
+    static const char* const ERROR_NAMES[] = {"", "no memory", "file not writable", "filesystem full"};
+    AudioCapture* capture = theremin->getAudioCapture();
+    JsonObject captureObj = doc["capture"].to<JsonObject>();
+    captureObj["state"] = SINK_NAMES[capture->getSink()];
+    captureObj["format"] = (capture->getFormat() == AudioCapture::FORMAT_ADPCM) ? "adpcm" : "pcm";
+    captureObj["durationMs"] = (uint32_t)((uint64_t)capture->getCapturedSamples() * 1000 / Audio::SAMPLE_RATE);
+    captureObj["bytes"] = capture->getFileBytes();
+    captureObj["dropped"] = capture->getDroppedBlocks();
+    captureObj["error"] = ERROR_NAMES[capture->getError()];
+    captureObj["file"] = AudioCapture::FILE_PATH;
   }
 }
 
-void WebUIManager::broadcastUpdate(const char* type, JsonDocument& doc) {
-  String output;
-  serializeJson(doc, output);
-  ws.textAll(output);
+void WebUIManager::sendStateDelta(uint32_t changes) {
+  StateTracker* tracker = theremin->getAudioEngine()->getStateTracker();
+
+  // "from" lets a client notice it missed a delta (its version < from)
+  // and ask for the complete state again
+  JsonDocument doc;
+  doc["type"] = "delta";
+  doc["from"] = lastSentVersion;
+  lastSentVersion = tracker->getVersion();
+  doc["version"] = lastSentVersion;
+  addConfigValues(doc, changes);
+
+  sendJson(doc);
 }
 
 void WebUIManager::sendCompleteState(AsyncWebSocketClient* client) {
   AudioEngine* audio = theremin->getAudioEngine();
-  EffectsChain* effects = audio->getEffectsChain();
   SensorManager* sensors = theremin->getSensorManager();
-  PerformanceMonitor* perfMon = audio->getPerformanceMonitor();
 
   JsonDocument doc;
   doc["type"] = "complete";
+  doc["version"] = audio->getStateTracker()->getVersion();
 
-  // Oscillators
-  JsonObject oscillators = doc["oscillators"].to<JsonObject>();
-  for (int i = 1; i <= 3; i++) {
-    JsonObject osc = oscillators[String(i)].to<JsonObject>();
-
-    Oscillator::Waveform wf = audio->getOscillatorWaveform(i);
-    const char* wfStr = "OFF";
-    switch (wf) {
-      case Oscillator::SINE: wfStr = "SINE"; break;
-      case Oscillator::SQUARE: wfStr = "SQUARE"; break;
-      case Oscillator::TRIANGLE: wfStr = "TRIANGLE"; break;
-      case Oscillator::SAW: wfStr = "SAW"; break;
-      default: wfStr = "OFF"; break;
-    }
-
-    osc["waveform"] = wfStr;
-    osc["octave"] = audio->getOscillatorOctave(i);
-    osc["volume"] = audio->getOscillatorVolume(i);
-  }
-
-  // Effects
-  JsonObject effectsObj = doc["effects"].to<JsonObject>();
-
-  // Delay
-  DelayEffect* delay = effects->getDelay();
-  JsonObject delayObj = effectsObj["delay"].to<JsonObject>();
-  delayObj["enabled"] = delay->isEnabled();
-  delayObj["time"] = delay->getDelayTime();
-  delayObj["feedback"] = delay->getFeedback();
-  delayObj["mix"] = delay->getMix();
-
-  // Chorus
-  ChorusEffect* chorus = effects->getChorus();
-  JsonObject chorusObj = effectsObj["chorus"].to<JsonObject>();
-  chorusObj["enabled"] = chorus->isEnabled();
-  chorusObj["rate"] = chorus->getRate();
-  chorusObj["depth"] = chorus->getDepth();
-  chorusObj["mix"] = chorus->getMix();
-
-  // Reverb
-  ReverbEffect* reverb = effects->getReverb();
-  JsonObject reverbObj = effectsObj["reverb"].to<JsonObject>();
-  reverbObj["enabled"] = reverb->isEnabled();
-  reverbObj["roomSize"] = reverb->getRoomSize();
-  reverbObj["damping"] = reverb->getDamping();
-  reverbObj["mix"] = reverb->getMix();
+  // Configuration (oscillators, effects, order, system presets)
+  addConfigValues(doc, StateTracker::ALL);
 
   // Sensor
   JsonObject sensor = doc["sensor"].to<JsonObject>();
@@ -517,25 +951,7 @@ void WebUIManager::sendCompleteState(AsyncWebSocketClient* client) {
   sensor["volume"] = sensors->getVolumeDistance();
 
   // Performance
-  JsonObject performance = doc["performance"].to<JsonObject>();
-  performance["cpu"] = 0.0;
-  performance["ram"] = ESP.getFreeHeap();
-  performance["uptime"] = millis();
-
-  if (perfMon) {
-    performance["audioTime"] = perfMon->getAudioTimeMs();
-  } else {
-    performance["audioTime"] = 0.0;
-  }
-  performance["maxAudioTime"] = AudioEngine::getMaxAudioTimeMs();
-
-  // System
-  JsonObject system = doc["system"].to<JsonObject>();
-  system["pitchSmoothing"] = (int)theremin->getPitchSmoothingPreset();
-  system["volumeSmoothing"] = (int)theremin->getVolumeSmoothingPreset();
-  system["frequencyRange"] = (int)theremin->getFrequencyRangePreset();
-  system["minFrequency"] = audio->getMinFrequency();
-  system["maxFrequency"] = audio->getMaxFrequency();
+  addPerformanceValues(doc["performance"].to<JsonObject>());
 
   // Tuner
   TunerManager* tuner = theremin->getTunerManager();
@@ -550,31 +966,60 @@ void WebUIManager::sendCompleteState(AsyncWebSocketClient* client) {
   }
 
   // Send the complete state
-  String output;
-  serializeJson(doc, output);
-
-  if (client) {
-    client->text(output);
-  } else {
-    ws.textAll(output);
-  }
+  sendJson(doc, client);
 }
 
 void WebUIManager::update() {
   // Clean up dead connections
   ws.cleanupClients();
 
-  // Periodic state broadcasts
+  // Connects, disconnects and per-connection commands since the last tick
+  processClientEvents();
+
+  // Clients that fell behind on configuration, once they have caught up
+  // (before this tick's sends, which would refill their queues); also
+  // drops clients gone without a disconnect event
+  resyncClients();
+
+  // Only broadcast if there are connected clients
+  if (ws.count() == 0) {
+    return;
+  }
+
   unsigned long now = millis();
-  if (now - lastUpdate >= UPDATE_INTERVAL) {
-    lastUpdate = now;
 
-    // Only broadcast if there are connected clients
-    if (ws.count() > 0) {
-      // Broadcast complete state as a single batched message
-      sendCompleteState();
+  // High-rate telemetry (binary, no JSON/String building)
+  if (now - lastTelemetry >= TELEMETRY_INTERVAL) {
+    lastTelemetry = now;
+    sendSensorState();
+    sendTunerState();
+  }
+
+  if (now - lastPerformance >= PERFORMANCE_INTERVAL) {
+    lastPerformance = now;
+    sendPerformanceState();
+  }
+
+  // Scope/spectrum frames, only while a client has the scope view open
+  if (hasScopeClients()) {
+    sendSpectrumFrame();
+  }
+
+  // Audio stream packets, as soon as the capture task has them
+  if (hasStreamClients()) {
+    sendAudioStream();
+  }
+
+  // Configuration: only the fields that changed since the previous tick
+  // (several changes in one tick go out as one message)
+  if (now - lastState >= STATE_INTERVAL) {
+    lastState = now;
+    uint32_t changes = theremin->getAudioEngine()->getStateTracker()->take();
+    if (changes != 0) {
+      sendStateDelta(changes);
     }
   }
+
 }
 
 #endif  // ENABLE_NETWORK
@@ -0,0 +1,72 @@
+/*
+ * ESPAsyncWebServer.h (host test stub)
+ *
+ * The part of the ESPAsyncWebServer API WebSocketDelivery uses, with a
+ * simulated transport: a client keeps what is queued to it until the test
+ * "sends" it with drain(), which releases the buffer references like the
+ * library does once a message is on the wire.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <memory>
+#include <vector>
+
+typedef std::shared_ptr<std::vector<uint8_t>> AsyncWebSocketSharedBuffer;
+
+enum AwsClientStatus { WS_DISCONNECTED, WS_CONNECTED, WS_DISCONNECTING };
+
+class AsyncWebSocketClient {
+ public:
+  explicit AsyncWebSocketClient(uint32_t id) : clientId(id), clientStatus(WS_CONNECTED), textsSent(0), binariesSent(0) {}
+
+  uint32_t id() const { return clientId; }
+  AwsClientStatus status() const { return clientStatus; }
+  size_t queueLen() const { return queue.size(); }
+
+  bool text(AsyncWebSocketSharedBuffer buffer) {
+    queue.push_back({buffer, true});
+    return true;
+  }
+
+  bool binary(AsyncWebSocketSharedBuffer buffer) {
+    queue.push_back({buffer, false});
+    return true;
+  }
+
+  // Stub transport
+
+  /**
+   * Send up to count queued messages (all by default)
+   */
+  void drain(size_t count = SIZE_MAX) {
+    while (count-- > 0 && !queue.empty()) {
+      if (queue.front().isText) {
+        textsSent++;
+      } else {
+        binariesSent++;
+      }
+      queue.pop_front();
+    }
+  }
+
+  void setStatus(AwsClientStatus status) { clientStatus = status; }
+
+  size_t getTextsSent() const { return textsSent; }
+  size_t getBinariesSent() const { return binariesSent; }
+
+ private:
+  struct Message {
+    AsyncWebSocketSharedBuffer buffer;
+    bool isText;
+  };
+
+  uint32_t clientId;
+  AwsClientStatus clientStatus;
+  std::deque<Message> queue;
+  size_t textsSent;
+  size_t binariesSent;
+};
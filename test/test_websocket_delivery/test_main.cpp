@@ -0,0 +1,266 @@
+/*
+ * WebSocketDelivery host tests (pio test -e native)
+ *
+ * Simulated clients on the stub transport (test/stubs/ESPAsyncWebServer.h):
+ * buffer pool reuse, per-client queue-depth drops, resync-on-drain (also
+ * for a client sending one message per tick), and a load run with fast,
+ * slow and stalled clients.
+ */
+
+#include <unity.h>
+#include "system/WebSocketDelivery.h"
+
+static AsyncWebSocketSharedBuffer message() {
+  return std::make_shared<std::vector<uint8_t>>(16);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// A buffer comes back only once every client holding it has sent it
+void test_pool_reuses_buffer_once_sent() {
+  WebSocketDelivery delivery;
+  WebSocketDelivery::BufferPool<2> pool;
+  pool.begin(64);
+  AsyncWebSocketClient a(1), b(2);
+  delivery.addClient(1);
+  delivery.addClient(2);
+
+  AsyncWebSocketSharedBuffer* first = pool.acquire();
+  TEST_ASSERT_NOT_NULL(first);
+  TEST_ASSERT_TRUE(delivery.queueTelemetry(&a, *first));
+  TEST_ASSERT_TRUE(delivery.queueTelemetry(&b, *first));
+
+  AsyncWebSocketSharedBuffer* second = pool.acquire();
+  TEST_ASSERT_NOT_NULL(second);
+  TEST_ASSERT_TRUE(first != second);
+  delivery.queueTelemetry(&a, *second);
+
+  // Both still queued somewhere
+  TEST_ASSERT_NULL(pool.acquire());
+
+  a.drain();
+  TEST_ASSERT_TRUE(pool.acquire() == second);  // first still held by b
+  b.drain();
+  TEST_ASSERT_TRUE(pool.acquire() == first);
+
+  // Reuse keeps the reserved capacity
+  TEST_ASSERT_TRUE((*first)->capacity() >= 64);
+}
+
+// Telemetry is skipped (and counted) for a client that is behind only
+void test_telemetry_skipped_when_behind() {
+  WebSocketDelivery delivery;
+  AsyncWebSocketClient slow(1), fast(2);
+  delivery.addClient(1);
+  delivery.addClient(2);
+
+  for (size_t i = 0; i < WebSocketDelivery::TELEMETRY_QUEUE_DEPTH; i++) {
+    TEST_ASSERT_TRUE(delivery.queueTelemetry(&slow, message()));
+  }
+  TEST_ASSERT_FALSE(delivery.queueTelemetry(&slow, message()));
+  TEST_ASSERT_TRUE(delivery.queueTelemetry(&fast, message()));
+
+  TEST_ASSERT_EQUAL_UINT32(WebSocketDelivery::TELEMETRY_QUEUE_DEPTH, slow.queueLen());
+  TEST_ASSERT_EQUAL_UINT32(1, delivery.findClient(1)->telemetrySkipped);
+  TEST_ASSERT_EQUAL_UINT32(0, delivery.findClient(2)->telemetrySkipped);
+  TEST_ASSERT_EQUAL_UINT32(1, delivery.getTelemetryDropped());
+
+  // Caught up: frames go out again
+  slow.drain(1);
+  TEST_ASSERT_TRUE(delivery.queueTelemetry(&slow, message()));
+}
+
+// A larger depth (audio stream) lets more frames queue
+void test_custom_queue_depth() {
+  WebSocketDelivery delivery;
+  AsyncWebSocketClient client(1);
+  delivery.addClient(1);
+
+  for (int i = 0; i < 8; i++) {
+    TEST_ASSERT_TRUE(delivery.queueTelemetry(&client, message(), 8));
+  }
+  TEST_ASSERT_FALSE(delivery.queueTelemetry(&client, message(), 8));
+}
+
+// A client too far behind for a configuration message is resynced once,
+// only after its queue has drained
+void test_resync_on_drain() {
+  WebSocketDelivery delivery;
+  AsyncWebSocketClient client(1);
+  delivery.addClient(1);
+
+  for (size_t i = 0; i < WebSocketDelivery::RELIABLE_QUEUE_DEPTH; i++) {
+    TEST_ASSERT_TRUE(delivery.queueReliable(&client, message()));
+  }
+  TEST_ASSERT_FALSE(delivery.queueReliable(&client, message()));
+  TEST_ASSERT_TRUE(delivery.findClient(1)->resyncPending);
+
+  // Nothing more is queued while out of sync, even with room again
+  client.drain(4);
+  TEST_ASSERT_FALSE(delivery.queueReliable(&client, message()));
+  TEST_ASSERT_FALSE(delivery.takeResync(&client));
+
+  client.drain();
+  TEST_ASSERT_TRUE(delivery.takeResync(&client));
+  TEST_ASSERT_FALSE(delivery.takeResync(&client));
+  TEST_ASSERT_TRUE(delivery.queueReliable(&client, message()));
+}
+
+// A client that sends one message per tick while telemetry comes every
+// tick: once flagged it gets no telemetry either, so its queue empties and
+// the resync goes out instead of every configuration message being lost
+void test_resync_when_draining_at_telemetry_rate() {
+  WebSocketDelivery delivery;
+  AsyncWebSocketClient client(1);
+  delivery.addClient(1);
+  int resyncs = 0;
+
+  for (int tick = 0; tick < 400; tick++) {
+    if (delivery.takeResync(&client)) {
+      TEST_ASSERT_TRUE(delivery.queueReliable(&client, message()));
+      resyncs++;
+    }
+    delivery.queueTelemetry(&client, message());
+    if (tick % 10 == 0) {
+      delivery.queueReliable(&client, message());
+    }
+    if (tick >= 200) {
+      client.drain(1);  // Stalled, then exactly one message per tick
+    }
+  }
+
+  TEST_ASSERT_EQUAL_INT(1, resyncs);
+  TEST_ASSERT_FALSE(delivery.findClient(1)->resyncPending);
+  TEST_ASSERT_TRUE(client.queueLen() < WebSocketDelivery::RELIABLE_QUEUE_DEPTH);
+}
+
+// Clients that are not connected any more get nothing
+void test_disconnected_client_skipped() {
+  WebSocketDelivery delivery;
+  AsyncWebSocketClient client(1);
+  delivery.addClient(1);
+  client.setStatus(WS_DISCONNECTING);
+
+  TEST_ASSERT_FALSE(delivery.queueTelemetry(&client, message()));
+  TEST_ASSERT_FALSE(delivery.queueReliable(&client, message()));
+  TEST_ASSERT_EQUAL_UINT32(0, client.queueLen());
+  TEST_ASSERT_EQUAL_UINT32(0, delivery.getTelemetryDropped());
+}
+
+void test_client_table() {
+  WebSocketDelivery delivery;
+  for (uint32_t id = 1; id <= WebSocketDelivery::MAX_CLIENTS; id++) {
+    delivery.addClient(id);
+  }
+  delivery.addClient(3);  // Already tracked
+  delivery.addClient(99);  // Full
+  TEST_ASSERT_NULL(delivery.findClient(99));
+
+  delivery.removeClient(3);
+  TEST_ASSERT_NULL(delivery.findClient(3));
+  delivery.addClient(99);
+  TEST_ASSERT_NOT_NULL(delivery.findClient(99));
+}
+
+// Load: telemetry every tick and a configuration message every 10 ticks,
+// broadcast like WebUIManager does, to fast clients (send everything each
+// tick), a slow one (one message every 4 ticks) and one stalled for 200
+// ticks. The slow and stalled clients must not cost the fast ones a single
+// message, nor exhaust the pool.
+void test_load_slow_clients_do_not_hold_up_others() {
+  static const int TICKS = 2000;
+  static const int POOL_SIZE = 8;
+  static const int CLIENTS = 5;  // 0-2 fast, 3 slow, 4 stalled
+
+  WebSocketDelivery delivery;
+  WebSocketDelivery::BufferPool<POOL_SIZE> pool;
+  pool.begin(272);
+
+  AsyncWebSocketClient* clients[CLIENTS];
+  for (int c = 0; c < CLIENTS; c++) {
+    clients[c] = new AsyncWebSocketClient(c + 1);
+    delivery.addClient(c + 1);
+  }
+  AsyncWebSocketClient* slow = clients[3];
+  AsyncWebSocketClient* stalled = clients[4];
+
+  int poolExhausted = 0;
+  int reliableSent = 0;
+  int resyncs = 0;
+  size_t slowMaxQueue = 0;
+
+  for (int tick = 0; tick < TICKS; tick++) {
+    // resyncClients() at the start of the tick: complete state to clients
+    // that have caught up
+    for (int c = 0; c < CLIENTS; c++) {
+      if (delivery.takeResync(clients[c])) {
+        delivery.queueReliable(clients[c], message());
+        resyncs++;
+      }
+    }
+
+    AsyncWebSocketSharedBuffer* buffer = pool.acquire();
+    if (buffer) {
+      for (int c = 0; c < CLIENTS; c++) {
+        delivery.queueTelemetry(clients[c], *buffer);
+      }
+    } else {
+      poolExhausted++;
+    }
+
+    if (tick % 10 == 0) {
+      AsyncWebSocketSharedBuffer json = message();
+      for (int c = 0; c < CLIENTS; c++) {
+        delivery.queueReliable(clients[c], json);
+      }
+      reliableSent++;
+    }
+
+    for (int c = 0; c < 3; c++) {
+      clients[c]->drain();
+    }
+    if (tick % 4 == 0) {
+      slow->drain(1);
+    }
+    if (tick >= 200) {
+      stalled->drain();
+    }
+    if (slow->queueLen() > slowMaxQueue) {
+      slowMaxQueue = slow->queueLen();
+    }
+  }
+
+  TEST_ASSERT_EQUAL_INT(0, poolExhausted);
+  for (int c = 0; c < 3; c++) {
+    TEST_ASSERT_EQUAL_UINT32(TICKS, clients[c]->getBinariesSent());
+    TEST_ASSERT_EQUAL_UINT32(reliableSent, clients[c]->getTextsSent());
+    TEST_ASSERT_EQUAL_UINT32(0, delivery.findClient(c + 1)->telemetrySkipped);
+  }
+
+  // Slow client: frames skipped, configuration kept, queue bounded
+  TEST_ASSERT_TRUE(delivery.findClient(4)->telemetrySkipped > 0);
+  TEST_ASSERT_FALSE(delivery.findClient(4)->resyncPending);
+  TEST_ASSERT_TRUE(slowMaxQueue < WebSocketDelivery::RELIABLE_QUEUE_DEPTH);
+
+  // Stalled client: flagged once, one complete state after it drained
+  TEST_ASSERT_EQUAL_INT(1, resyncs);
+  TEST_ASSERT_FALSE(delivery.findClient(5)->resyncPending);
+
+  for (int c = 0; c < CLIENTS; c++) {
+    delete clients[c];
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_pool_reuses_buffer_once_sent);
+  RUN_TEST(test_telemetry_skipped_when_behind);
+  RUN_TEST(test_custom_queue_depth);
+  RUN_TEST(test_resync_on_drain);
+  RUN_TEST(test_resync_when_draining_at_telemetry_rate);
+  RUN_TEST(test_disconnected_client_skipped);
+  RUN_TEST(test_client_table);
+  RUN_TEST(test_load_slow_clients_do_not_hold_up_others);
+  return UNITY_END();
+}
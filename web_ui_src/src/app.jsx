@@ -6,8 +6,12 @@ import { Dashboard } from './views/Dashboard';
 import { Oscillators } from './views/Oscillators';
 import { Effects } from './views/Effects';
 import { Sensors } from './views/Sensors';
+import { Presets } from './views/Presets';
+import { Looper } from './views/Looper';
+import { Capture } from './views/Capture';
 import Tuner from './views/Tuner';
 import Keyboard from './views/Keyboard';
+import Scope from './views/Scope';
 import { Header } from './components/Header';
 import './styles.css';
 
@@ -19,8 +23,12 @@ const VIEWS = [
   { id: 'oscillators', label: 'Oscillators', component: Oscillators },
   { id: 'effects', label: 'Effects', component: Effects },
   { id: 'sensors', label: 'Sensors', component: Sensors },
+  { id: 'presets', label: 'Presets', component: Presets },
+  { id: 'looper', label: 'Looper', component: Looper },
+  { id: 'capture', label: 'Capture', component: Capture },
   { id: 'tuner', label: 'Tuner', component: Tuner },
-  { id: 'keyboard', label: 'Keyboard', component: Keyboard }
+  { id: 'keyboard', label: 'Keyboard', component: Keyboard },
+  { id: 'scope', label: 'Scope', component: Scope }
 ];
 
 /**
@@ -6,7 +6,8 @@ import { CommandSlider } from "./CommandSlider";
 export function Effect({ effectName }) {
   const { data } = useWebSocket();
 
-  // Effect-specific parameter configurations
+  // Fallback parameter configurations (used until the device sends its
+  // effectSchema, or when talking to older firmware)
   const effectConfigs = {
     delay: {
       displayName: "Delay",
@@ -106,7 +107,18 @@ export function Effect({ effectName }) {
     }
   };
 
-  const config = effectConfigs[effectName];
+  // Prefer the parameter table reported by the device
+  const schema = data.effectSchema?.find(e => e.name === effectName);
+  const config = schema
+    ? {
+        displayName: effectConfigs[effectName]?.displayName || effectName,
+        parameters: schema.params.map(param => ({
+          ...param,
+          unit: param.unit === '%' ? '' : param.unit,
+          defaultValue: param.min
+        }))
+      }
+    : effectConfigs[effectName];
 
   // Initialize state for each parameter
   const [paramValues, setParamValues] = useState(
@@ -143,6 +155,7 @@ export function Effect({ effectName }) {
     <div class="space-y-4">
       <ToggleSwitch
         label="Enable"
+        value={data.effects?.[effectName]?.enabled}
         onCommand={{
           cmd: "enableEffect",
           effect: effectName,
@@ -1,9 +1,214 @@
 import { h, createContext } from 'preact';
-import { useState, useEffect, useContext, useCallback } from 'preact/hooks';
+import { useState, useEffect, useContext, useCallback, useRef } from 'preact/hooks';
 
 // Context to share WebSocket across the app
 const WebSocketContext = createContext(null);
 
+// Binary telemetry frames (sensor / performance / tuner / spectrum).
+// Layout must match include/system/TelemetryProtocol.h (packed, little-endian).
+const TELEMETRY_VERSION = 1;
+const MSG_SENSOR = 1;
+const MSG_PERFORMANCE = 2;
+const MSG_TUNER = 3;
+const MSG_SPECTRUM = 4;
+const MSG_AUDIO = 5;
+const SPECTRUM_HEADER_SIZE = 16;
+const AUDIO_HEADER_SIZE = 20;
+const AUDIO_FORMAT_IMA_ADPCM = 1;
+const PERF_FLAG_OVERSAMPLED = 0x01;
+const PERF_FLAG_APLL = 0x02;
+const TUNER_FLAG_VALID = 0x01;
+const TUNER_FLAG_IN_TUNE = 0x02;
+const NOTE_NAMES = ['C', 'C#', 'D', 'D#', 'E', 'F', 'F#', 'G', 'G#', 'A', 'A#', 'B'];
+const STACK_LABELS = ['Audio', 'Web', 'Loop'];
+
+// IMA-ADPCM tables (same as the encoder in src/system/AudioCapture.cpp)
+const ADPCM_STEPS = [
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+  50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+  253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+  1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+  3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+  11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+  32767
+];
+const ADPCM_INDEX_STEP = [-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8];
+
+/**
+ * Merge a map of partial objects ({ "1": { volume: 0.5 } }) into the previous map
+ */
+function mergeEntries(prev, delta) {
+  if (!delta) return prev;
+  const next = { ...prev };
+  Object.keys(delta).forEach(key => {
+    next[key] = { ...prev[key], ...delta[key] };
+  });
+  return next;
+}
+
+/**
+ * Decode one binary telemetry frame into the same shape as the JSON state
+ * @returns {{ type: string, payload: object } | null} null for unknown versions/types
+ */
+function decodeTelemetry(buffer) {
+  const view = new DataView(buffer);
+  if (view.byteLength < 4 || view.getUint8(0) !== TELEMETRY_VERSION) {
+    return null;
+  }
+
+  switch (view.getUint8(1)) {
+    case MSG_SENSOR:
+      return {
+        type: 'sensor',
+        payload: {
+          pitch: view.getFloat32(4, true),
+          volume: view.getFloat32(8, true)
+        }
+      };
+
+    case MSG_PERFORMANCE: {
+      const stack = {};
+      STACK_LABELS.forEach((label, i) => {
+        stack[label] = view.getInt16(44 + i * 2, true);
+      });
+      const cpu0 = view.getUint8(50);
+      const cpu1 = view.getUint8(51);
+      const flags = view.getUint8(54);
+      return {
+        type: 'performance',
+        payload: {
+          uptime: view.getUint32(4, true),
+          ram: view.getUint32(8, true),
+          heap: {
+            free: view.getUint32(8, true),
+            largestBlock: view.getUint32(12, true),
+            minFree: view.getUint32(16, true),
+            fragmentation: view.getUint8(52)
+          },
+          sampleRate: view.getUint32(24, true),
+          audioTime: view.getUint16(28, true) / 1000,
+          maxAudioTime: view.getUint16(30, true) / 1000,
+          oscTime: view.getUint16(32, true) / 1000,
+          deadline: {
+            p50: view.getUint16(34, true),
+            p95: view.getUint16(36, true),
+            p99: view.getUint16(38, true),
+            max: view.getUint16(40, true),
+            underruns: view.getUint32(20, true),
+            blockedAvg: view.getUint16(42, true)
+          },
+          stack,
+          cpu: (cpu0 + cpu1) / 2,
+          cpu0,
+          cpu1,
+          i2sBits: view.getUint8(53),
+          i2cLoad: view.getUint8(55),
+          oversampled: (flags & PERF_FLAG_OVERSAMPLED) !== 0,
+          apll: (flags & PERF_FLAG_APLL) !== 0
+        }
+      };
+    }
+
+    case MSG_TUNER: {
+      const flags = view.getUint8(11);
+      if (!(flags & TUNER_FLAG_VALID)) {
+        return { type: 'tuner', payload: {} };
+      }
+      const noteName = NOTE_NAMES[view.getInt8(8)] || '---';
+      const octave = view.getInt8(9);
+      return {
+        type: 'tuner',
+        payload: {
+          note: `${noteName}${octave}`,
+          noteName,
+          octave,
+          frequency: view.getFloat32(4, true),
+          cents: view.getInt8(10),
+          inTune: (flags & TUNER_FLAG_IN_TUNE) !== 0
+        }
+      };
+    }
+
+    case MSG_SPECTRUM: {
+      const binCount = view.getUint8(8);
+      const scopeCount = view.getUint8(9);
+      const binsOffset = SPECTRUM_HEADER_SIZE;
+      const scopeOffset = binsOffset + binCount;
+      if (view.byteLength < scopeOffset + scopeCount) {
+        return null;
+      }
+      return {
+        type: 'scope',
+        payload: {
+          sampleRate: view.getUint32(4, true),
+          scopeStep: view.getUint8(10),
+          peak: view.getUint16(12, true),
+          // dBFS = value / 2 - 120
+          bins: Array.from(new Uint8Array(buffer, binsOffset, binCount), v => v / 2 - 120),
+          trace: Array.from(new Int8Array(buffer, scopeOffset, scopeCount))
+        }
+      };
+    }
+
+    default:
+      return null;
+  }
+}
+
+/**
+ * Decode one WAV IMA-ADPCM mono block (4-byte header, then 4-bit codes,
+ * low nibble first)
+ */
+function decodeAdpcmBlock(bytes, sampleCount) {
+  const out = new Int16Array(sampleCount);
+  let predictor = (bytes[0] | (bytes[1] << 8)) << 16 >> 16;
+  let index = Math.min(bytes[2], 88);
+  out[0] = predictor;
+
+  for (let i = 1; i < sampleCount; i++) {
+    const byte = bytes[4 + ((i - 1) >> 1)];
+    const code = (i & 1) ? (byte & 0x0f) : (byte >> 4);
+    const step = ADPCM_STEPS[index];
+    let delta = step >> 3;
+    if (code & 4) delta += step;
+    if (code & 2) delta += step >> 1;
+    if (code & 1) delta += step >> 2;
+    predictor = Math.max(-32768, Math.min(32767, predictor + ((code & 8) ? -delta : delta)));
+    index = Math.max(0, Math.min(88, index + ADPCM_INDEX_STEP[code]));
+    out[i] = predictor;
+  }
+  return out;
+}
+
+/**
+ * Decode one audio stream frame (MSG_AUDIO)
+ * @returns {{ sampleRate: number, position: number, dropped: number, samples: Int16Array } | null}
+ */
+function decodeAudio(buffer) {
+  const view = new DataView(buffer);
+  if (view.byteLength < AUDIO_HEADER_SIZE || view.getUint8(0) !== TELEMETRY_VERSION) {
+    return null;
+  }
+  const sampleCount = view.getUint16(16, true);
+  const payload = new Uint8Array(buffer, AUDIO_HEADER_SIZE);
+  let samples;
+  if (view.getUint8(18) === AUDIO_FORMAT_IMA_ADPCM) {
+    samples = decodeAdpcmBlock(payload, sampleCount);
+  } else {
+    // Copy: the payload offset is not 2-byte aligned for an Int16Array view
+    samples = new Int16Array(sampleCount);
+    for (let i = 0; i < sampleCount; i++) {
+      samples[i] = view.getInt16(AUDIO_HEADER_SIZE + i * 2, true);
+    }
+  }
+  return {
+    sampleRate: view.getUint32(4, true),
+    position: view.getUint32(8, true),
+    dropped: view.getUint32(12, true),
+    samples
+  };
+}
+
 export function WebSocketProvider({ children, url }) {
   const [ws, setWs] = useState(null);
   const [connected, setConnected] = useState(false);
@@ -13,19 +218,32 @@ export function WebSocketProvider({ children, url }) {
     sensor: {},
     performance: {},
     system: {},
-    tuner: {}
+    tuner: {},
+    scope: {},
+    effectSchema: [],
+    effectsOrder: [],
+    presets: {},
+    automation: {},
+    looper: {},
+    capture: {}
   });
   const [error, setError] = useState(null);
 
+  // Audio stream frames go straight to the listener (no state update per packet)
+  const audioListener = useRef(null);
+
   useEffect(() => {
     let websocket;
     let reconnectTimer;
+    // Configuration state version (from "complete"/"delta" messages)
+    let stateVersion = 0;
 
     const connect = () => {
       try {
         // Determine WebSocket URL
         const wsUrl = url || `ws://${window.location.hostname}/ws`;
         websocket = new WebSocket(wsUrl);
+        websocket.binaryType = 'arraybuffer';
 
         websocket.onopen = () => {
           console.log('WebSocket connected');
@@ -34,20 +252,89 @@ export function WebSocketProvider({ children, url }) {
         };
 
         websocket.onmessage = (event) => {
+          // High-rate telemetry arrives as binary frames
+          if (event.data instanceof ArrayBuffer) {
+            if (event.data.byteLength >= 2 && new Uint8Array(event.data)[1] === MSG_AUDIO) {
+              const audio = decodeAudio(event.data);
+              if (audio && audioListener.current) {
+                audioListener.current(audio);
+              }
+              return;
+            }
+
+            const decoded = decodeTelemetry(event.data);
+            if (!decoded) return;
+
+            if (decoded.type === 'performance') {
+              // Keep JSON-only fields (dsp, deadline.blockedMin) from the last resync
+              setData(prev => ({
+                ...prev,
+                performance: {
+                  ...prev.performance,
+                  ...decoded.payload,
+                  deadline: { ...prev.performance?.deadline, ...decoded.payload.deadline }
+                }
+              }));
+            } else {
+              setData(prev => ({
+                ...prev,
+                [decoded.type]: decoded.payload
+              }));
+            }
+            return;
+          }
+
           try {
             const parsed = JSON.parse(event.data);
 
             // Handle different message types
-            if (parsed.type === 'complete') {
+            if (parsed.type === 'delta') {
+              // Only the fields that changed. A "from" newer than our version
+              // means a delta was missed - ask for everything again.
+              if (parsed.from > stateVersion) {
+                websocket.send(JSON.stringify({ cmd: 'getState' }));
+              }
+              stateVersion = Math.max(stateVersion, parsed.version);
+              setData(prev => ({
+                ...prev,
+                oscillators: mergeEntries(prev.oscillators, parsed.oscillators),
+                effects: mergeEntries(prev.effects, parsed.effects),
+                effectsOrder: parsed.effectsOrder || prev.effectsOrder,
+                system: parsed.system ? { ...prev.system, ...parsed.system } : prev.system,
+                presets: parsed.presets || prev.presets,
+                automation: parsed.automation || prev.automation,
+                looper: parsed.looper || prev.looper,
+                capture: parsed.capture || prev.capture
+              }));
+            } else if (parsed.type === 'complete') {
+              stateVersion = parsed.version ?? stateVersion;
               // New batched message format - update all state at once
-              setData({
+              // (effectSchema is sent once on connect, keep it)
+              setData(prev => ({
+                ...prev,
                 oscillators: parsed.oscillators || {},
                 effects: parsed.effects || {},
+                effectsOrder: parsed.effectsOrder || prev.effectsOrder,
                 sensor: parsed.sensor || {},
                 performance: parsed.performance || {},
                 system: parsed.system || {},
-                tuner: parsed.tuner || {}
-              });
+                tuner: parsed.tuner || {},
+                presets: parsed.presets || prev.presets,
+                automation: parsed.automation || prev.automation,
+                looper: parsed.looper || prev.looper,
+                capture: parsed.capture || prev.capture
+              }));
+            } else if (parsed.type === 'effectSchema') {
+              // Effect parameter descriptors (sent once on connect)
+              setData(prev => ({
+                ...prev,
+                effectSchema: parsed.effects || []
+              }));
+            } else if (parsed.type === 'effectOrder') {
+              setData(prev => ({
+                ...prev,
+                effectsOrder: parsed.order || []
+              }));
             } else if (parsed.type === 'oscillator') {
               // Individual oscillator update (backward compatibility)
               setData(prev => ({
@@ -131,11 +418,17 @@ export function WebSocketProvider({ children, url }) {
     }
   }, [ws, connected]);
 
+  // Receive decoded audio stream frames (null to stop)
+  const setAudioListener = useCallback((listener) => {
+    audioListener.current = listener;
+  }, []);
+
   const value = {
     connected,
     data,
     error,
-    send
+    send,
+    setAudioListener
   };
 
   return h(WebSocketContext.Provider, { value }, children);
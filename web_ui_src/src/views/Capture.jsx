@@ -0,0 +1,224 @@
+import { useState, useEffect, useRef } from 'preact/hooks';
+import { useWebSocket } from '../hooks/WebSocketProvider';
+import { ControlButton } from '../components/ControlButton';
+
+// Longest gap filled with silence when stream packets are lost (seconds)
+const MAX_GAP_SECONDS = 5;
+
+/**
+ * Build a 16-bit mono WAV file from Int16Array chunks
+ */
+function buildWav(chunks, sampleRate) {
+  const total = chunks.reduce((count, chunk) => count + chunk.length, 0);
+  const buffer = new ArrayBuffer(44 + total * 2);
+  const view = new DataView(buffer);
+  const writeText = (offset, text) => {
+    for (let i = 0; i < text.length; i++) view.setUint8(offset + i, text.charCodeAt(i));
+  };
+
+  writeText(0, 'RIFF');
+  view.setUint32(4, 36 + total * 2, true);
+  writeText(8, 'WAVE');
+  writeText(12, 'fmt ');
+  view.setUint32(16, 16, true);
+  view.setUint16(20, 1, true);               // PCM
+  view.setUint16(22, 1, true);               // Mono
+  view.setUint32(24, sampleRate, true);
+  view.setUint32(28, sampleRate * 2, true);
+  view.setUint16(32, 2, true);
+  view.setUint16(34, 16, true);
+  writeText(36, 'data');
+  view.setUint32(40, total * 2, true);
+
+  let offset = 44;
+  chunks.forEach(chunk => {
+    for (let i = 0; i < chunk.length; i++, offset += 2) {
+      view.setInt16(offset, chunk[i], true);
+    }
+  });
+  return new Blob([buffer], { type: 'audio/wav' });
+}
+
+/**
+ * Capture View - Record the instrument output to the device or the browser
+ */
+export function Capture() {
+  const { data, send, connected, setAudioListener } = useWebSocket();
+
+  const capture = data.capture || {};
+  const state = capture.state || 'idle';
+
+  const [fileFormat, setFileFormat] = useState('pcm');
+  const [streamFormat, setStreamFormat] = useState('adpcm');
+
+  // Browser recording (stream frames are collected outside component state)
+  const [recording, setRecording] = useState(false);
+  const [stats, setStats] = useState({ seconds: 0, lost: 0, dropped: 0 });
+  const [downloadUrl, setDownloadUrl] = useState(null);
+  const chunks = useRef([]);
+  const nextPosition = useRef(null);
+  const sampleRate = useRef(22050);
+  const counters = useRef({ samples: 0, lost: 0, dropped: 0, frames: 0 });
+
+  const selectClass = 'px-3 py-2 rounded-lg border border-gray-300 dark:border-gray-600 bg-white dark:bg-gray-700 text-gray-900 dark:text-white';
+
+  const onFrame = (frame) => {
+    const count = counters.current;
+    sampleRate.current = frame.sampleRate;
+
+    // Lost packets (WiFi or this tab behind): keep the timing with silence
+    if (nextPosition.current !== null && frame.position > nextPosition.current) {
+      const gap = frame.position - nextPosition.current;
+      count.lost += gap;
+      chunks.current.push(new Int16Array(Math.min(gap, frame.sampleRate * MAX_GAP_SECONDS)));
+    }
+    nextPosition.current = frame.position + frame.samples.length;
+    chunks.current.push(frame.samples);
+    count.samples += frame.samples.length;
+    count.dropped = frame.dropped;
+
+    // Refresh the counters a few times per second, not per packet
+    if (++count.frames % 10 === 0) {
+      setStats({ seconds: count.samples / frame.sampleRate, lost: count.lost, dropped: count.dropped });
+    }
+  };
+
+  const startBrowserRecording = () => {
+    chunks.current = [];
+    nextPosition.current = null;
+    counters.current = { samples: 0, lost: 0, dropped: 0, frames: 0 };
+    setStats({ seconds: 0, lost: 0, dropped: 0 });
+    setAudioListener(onFrame);
+    send({ cmd: 'setAudioStream', enabled: true, format: streamFormat });
+    setRecording(true);
+  };
+
+  const stopBrowserRecording = () => {
+    send({ cmd: 'setAudioStream', enabled: false });
+    setAudioListener(null);
+    setRecording(false);
+
+    const count = counters.current;
+    setStats({ seconds: count.samples / sampleRate.current, lost: count.lost, dropped: count.dropped });
+    if (downloadUrl) URL.revokeObjectURL(downloadUrl);
+    setDownloadUrl(chunks.current.length > 0 ? URL.createObjectURL(buildWav(chunks.current, sampleRate.current)) : null);
+    chunks.current = [];
+  };
+
+  // Leaving the view stops the stream
+  const recordingRef = useRef(false);
+  recordingRef.current = recording;
+  useEffect(() => () => {
+    setAudioListener(null);
+    if (recordingRef.current) send({ cmd: 'setAudioStream', enabled: false });
+  }, []);
+
+  const seconds = (ms) => ((ms || 0) / 1000).toFixed(1);
+  const kilobytes = (bytes) => Math.round((bytes || 0) / 1024);
+
+  return (
+    <div class="max-w-7xl mx-auto px-4 py-8 sm:px-6 lg:px-8">
+      {/* Capture to the device filesystem */}
+      <section class="mb-8">
+        <h2 class="text-xl font-semibold text-gray-800 dark:text-white mb-4">Record to Device</h2>
+        <div class="bg-white dark:bg-gray-800 rounded-lg shadow p-6">
+          <p class="text-sm text-gray-600 dark:text-gray-400 mb-4">
+            Records the final output to {capture.file || '/capture.wav'} on the device flash. Each
+            recording replaces the previous one. ADPCM fits four times as long in the same space.
+          </p>
+          <p class="text-sm text-gray-900 dark:text-white mb-4">
+            {state === 'file' ? 'Recording' : state === 'stream' ? 'Streaming to a browser' : 'Idle'}
+            {capture.durationMs > 0 && ` - ${seconds(capture.durationMs)} s`}
+            {capture.bytes > 0 && `, ${kilobytes(capture.bytes)} KB`}
+            {capture.dropped > 0 && ` (${capture.dropped} blocks dropped)`}
+            {capture.error && ` - ${capture.error}`}
+          </p>
+
+          <div class="flex flex-wrap gap-2">
+            <select
+              class={selectClass}
+              value={fileFormat}
+              disabled={!connected || state !== 'idle'}
+              onChange={(e) => setFileFormat(e.target.value)}
+            >
+              <option value="pcm">16-bit PCM</option>
+              <option value="adpcm">IMA-ADPCM</option>
+            </select>
+            <ControlButton
+              label="Record"
+              variant="danger"
+              payload={state === 'idle' ? { cmd: 'startCapture', format: fileFormat } : null}
+            />
+            <ControlButton
+              label="Stop"
+              variant="primary"
+              payload={state === 'file' ? { cmd: 'stopCapture' } : null}
+            />
+            {state === 'idle' && capture.bytes > 0 && (
+              <a
+                href={capture.file || '/capture.wav'}
+                download
+                class="px-4 py-2 rounded-lg font-medium bg-green-600 hover:bg-green-700 text-white"
+              >
+                Download
+              </a>
+            )}
+          </div>
+        </div>
+      </section>
+
+      {/* Stream to this browser */}
+      <section class="mb-8">
+        <h2 class="text-xl font-semibold text-gray-800 dark:text-white mb-4">Record in Browser</h2>
+        <div class="bg-white dark:bg-gray-800 rounded-lg shadow p-6">
+          <p class="text-sm text-gray-600 dark:text-gray-400 mb-4">
+            Streams the output over WiFi and saves it here as a WAV file. ADPCM needs a quarter of
+            the bandwidth (about 11 KB/s). Not available while recording to the device.
+          </p>
+          <p class="text-sm text-gray-900 dark:text-white mb-4">
+            {recording ? 'Recording' : 'Stopped'} - {stats.seconds.toFixed(1)} s
+            {stats.lost > 0 && `, ${stats.lost} samples lost on the way`}
+            {stats.dropped > 0 && `, ${stats.dropped} blocks dropped on the device`}
+          </p>
+
+          <div class="flex flex-wrap gap-2">
+            <select
+              class={selectClass}
+              value={streamFormat}
+              disabled={!connected || recording}
+              onChange={(e) => setStreamFormat(e.target.value)}
+            >
+              <option value="adpcm">IMA-ADPCM</option>
+              <option value="pcm">16-bit PCM</option>
+            </select>
+            {recording ? (
+              <button
+                onClick={stopBrowserRecording}
+                class="px-4 py-2 rounded-lg font-medium bg-blue-600 hover:bg-blue-700 text-white"
+              >
+                Stop
+              </button>
+            ) : (
+              <button
+                onClick={startBrowserRecording}
+                disabled={!connected || state === 'file'}
+                class="px-4 py-2 rounded-lg font-medium bg-red-600 hover:bg-red-700 text-white disabled:opacity-50"
+              >
+                Record
+              </button>
+            )}
+            {!recording && downloadUrl && (
+              <a
+                href={downloadUrl}
+                download="theremin.wav"
+                class="px-4 py-2 rounded-lg font-medium bg-green-600 hover:bg-green-700 text-white"
+              >
+                Save WAV
+              </a>
+            )}
+          </div>
+        </div>
+      </section>
+    </div>
+  );
+}
@@ -188,6 +188,64 @@ export function Dashboard() {
             description="This is the time that the audio task takes, compared to the maximum available time calculated on buffer and sample values, es. 256 / 22050 * 1000 = 11.61 ms"
           />
 
+          <StatusCard
+            title="Audio p99 / Max"
+            value={
+              data.performance?.deadline
+                ? `${(data.performance.deadline.p99 / 1000).toFixed(1)} / ${(data.performance.deadline.max / 1000).toFixed(1)}`
+                : '0.0 / 0.0'
+            }
+            unit="ms"
+            description="Audio task compute time distribution (rolling ~10-20 s histogram, 0.1 ms bins). Max is the worst block since boot."
+          />
+
+          <StatusCard
+            title="I2S Underruns"
+            value={data.performance?.deadline?.underruns ?? 0}
+            unit=""
+            description={`Times the DMA queue ran dry. Avg time blocked in i2s_write: ${((data.performance?.deadline?.blockedAvg ?? 0) / 1000).toFixed(1)} ms`}
+          />
+
+          <StatusCard
+            title="CPU Core 0 / 1"
+            value={`${(data.performance?.cpu0 ?? 0).toFixed(0)} / ${(data.performance?.cpu1 ?? 0).toFixed(0)}`}
+            unit="%"
+            description="Core 0 runs WiFi and the web server, Core 1 runs the audio task and loop()."
+          />
+
+          <StatusCard
+            title="I2C Bus Load"
+            value={data.performance?.i2cLoad ?? 0}
+            unit="%"
+            description={
+              data.performance?.i2c
+                ? `Share of time the bus is held (sensors, switches, display) at ${data.performance.i2c.clock / 1000} kHz. Errors: ${data.performance.i2c.nack} NACK, ${data.performance.i2c.timeout} timeout, ${data.performance.i2c.errors} other, ${data.performance.i2c.recoveries} recoveries.`
+                : 'Share of time the bus is held (sensors, switches, display).'
+            }
+          />
+
+          <StatusCard
+            title="Heap Fragmentation"
+            value={data.performance?.heap?.fragmentation ?? 0}
+            unit="%"
+            description={`Largest free block: ${formatRAM(data.performance?.heap?.largestBlock)}, lowest free ever: ${formatRAM(data.performance?.heap?.minFree)}${
+              data.performance?.heap?.looper
+                ? `, looper: ${formatRAM(data.performance.heap.looper)} ${data.performance.heap.looperPsram ? 'PSRAM' : 'internal'}`
+                : ''
+            }`}
+          />
+
+          <StatusCard
+            title="Stack Free (Audio / Web / Loop)"
+            value={
+              data.performance?.stack
+                ? `${data.performance.stack.Audio ?? '-'} / ${data.performance.stack.Web ?? '-'} / ${data.performance.stack.Loop ?? '-'}`
+                : '- / - / -'
+            }
+            unit="B"
+            description="Stack high-water marks: bytes never touched since boot. Below 512 B a warning is printed on serial."
+          />
+
           <StatusCard
             title="Uptime"
             value={formatUptime(data.performance?.uptime)}
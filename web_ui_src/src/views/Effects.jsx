@@ -1,11 +1,27 @@
 import { useWebSocket } from '../hooks/WebSocketProvider';
 import { Effect } from '../components/Effect';
 
+const DEFAULT_ORDER = ['delay', 'chorus', 'reverb'];
+
 /**
  * Effects View
+ * Effects are listed in processing (slot) order as reported by the device.
  */
 export function Effects() {
-  const { data } = useWebSocket();
+  const { data, send } = useWebSocket();
+
+  const order = data.effectsOrder?.length ? data.effectsOrder : DEFAULT_ORDER;
+
+  const capitalize = (name) => name.charAt(0).toUpperCase() + name.slice(1);
+
+  // Swap an effect with its neighbour and send the new order
+  const move = (index, direction) => {
+    const target = index + direction;
+    if (target < 0 || target >= order.length) return;
+    const newOrder = [...order];
+    [newOrder[index], newOrder[target]] = [newOrder[target], newOrder[index]];
+    send({ cmd: 'setEffectOrder', order: newOrder });
+  };
 
   return (
     <div class="max-w-7xl mx-auto px-4 py-8 sm:px-6 lg:px-8">
@@ -13,18 +29,34 @@ export function Effects() {
         <h2 class="text-xl font-semibold text-gray-800 dark:text-white mb-4">Effects</h2>
 
         <div class="grid grid-cols-1 md:grid-cols-3 gap-4">
-          <div class="bg-white dark:bg-gray-800 rounded-lg shadow p-6">
-            <h3 class="text-lg font-medium text-gray-900 dark:text-white mb-4">Delay</h3>
-            <Effect effectName="delay" />
-          </div>
-          <div class="bg-white dark:bg-gray-800 rounded-lg shadow p-6">
-            <h3 class="text-lg font-medium text-gray-900 dark:text-white mb-4">Chorus</h3>
-            <Effect effectName="chorus" />
-          </div>
-          <div class="bg-white dark:bg-gray-800 rounded-lg shadow p-6">
-            <h3 class="text-lg font-medium text-gray-900 dark:text-white mb-4">Reverb</h3>
-            <Effect effectName="reverb" />
-          </div>
+          {order.map((name, index) => (
+            <div key={name} class="bg-white dark:bg-gray-800 rounded-lg shadow p-6">
+              <div class="flex items-center justify-between mb-4">
+                <h3 class="text-lg font-medium text-gray-900 dark:text-white">
+                  {index + 1}. {capitalize(name)}
+                </h3>
+                <div class="flex gap-1">
+                  <button
+                    class="px-2 py-1 text-sm rounded bg-gray-100 dark:bg-gray-700 text-gray-700 dark:text-gray-200 disabled:opacity-40"
+                    disabled={index === 0}
+                    onClick={() => move(index, -1)}
+                    title="Move earlier in chain"
+                  >
+                    &larr;
+                  </button>
+                  <button
+                    class="px-2 py-1 text-sm rounded bg-gray-100 dark:bg-gray-700 text-gray-700 dark:text-gray-200 disabled:opacity-40"
+                    disabled={index === order.length - 1}
+                    onClick={() => move(index, 1)}
+                    title="Move later in chain"
+                  >
+                    &rarr;
+                  </button>
+                </div>
+              </div>
+              <Effect effectName={name} />
+            </div>
+          ))}
         </div>
       </section>
     </div>
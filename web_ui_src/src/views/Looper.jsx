@@ -0,0 +1,122 @@
+import { useWebSocket } from '../hooks/WebSocketProvider';
+import { ControlButton } from '../components/ControlButton';
+
+const STATE_LABELS = {
+  empty: 'Empty',
+  recording: 'Recording',
+  playing: 'Playing',
+  overdubbing: 'Overdubbing',
+  stopped: 'Stopped'
+};
+
+/**
+ * Looper View - Record the output and play over it
+ */
+export function Looper() {
+  const { data, send, connected } = useWebSocket();
+
+  const looper = data.looper || {};
+  const state = looper.state || 'empty';
+
+  const selectClass = 'px-3 py-2 rounded-lg border border-gray-300 dark:border-gray-600 bg-white dark:bg-gray-700 text-gray-900 dark:text-white';
+  const sliderClass = 'w-full h-2 bg-gray-200 dark:bg-gray-700 rounded-lg appearance-none cursor-pointer slider disabled:opacity-50';
+
+  // Label of the one-button cycle for the current state
+  const recordLabel = {
+    empty: 'Record',
+    recording: 'Close loop',
+    playing: 'Overdub',
+    overdubbing: 'End overdub',
+    stopped: 'Play'
+  }[state] || 'Record';
+
+  const seconds = (ms) => ((ms || 0) / 1000).toFixed(1);
+
+  return (
+    <div class="max-w-7xl mx-auto px-4 py-8 sm:px-6 lg:px-8">
+      <section class="mb-8">
+        <h2 class="text-xl font-semibold text-gray-800 dark:text-white mb-4">Looper</h2>
+        <div class="bg-white dark:bg-gray-800 rounded-lg shadow p-6">
+          <p class="text-sm text-gray-600 dark:text-gray-400 mb-4">
+            Records the instrument output, then plays it back while you play over it. Each
+            overdub pass keeps the old loop at the feedback level; Undo removes the last one.
+            The OLED multi-button double-click on the Looper page does the same as the first button.
+          </p>
+          <p class="text-sm text-gray-900 dark:text-white mb-4">
+            {STATE_LABELS[state] || state}
+            {looper.lengthMs > 0 && ` - loop ${seconds(looper.lengthMs)} s`}
+            {looper.maxMs > 0 && ` (max ${seconds(looper.maxMs)} s)`}
+          </p>
+
+          <div class="flex flex-wrap gap-2">
+            <ControlButton label={recordLabel} variant="danger" payload={{ cmd: 'looperRecord' }} />
+            <ControlButton
+              label="Play"
+              variant="success"
+              payload={state !== 'empty' ? { cmd: 'looperPlay' } : null}
+            />
+            <ControlButton label="Stop" variant="primary" payload={{ cmd: 'looperStop' }} />
+            <ControlButton
+              label="Undo"
+              variant="warning"
+              payload={looper.canUndo ? { cmd: 'looperUndo' } : null}
+            />
+            <ControlButton label="Clear" variant="warning" payload={{ cmd: 'looperClear' }} />
+          </div>
+        </div>
+      </section>
+
+      <section class="mb-8">
+        <h2 class="text-xl font-semibold text-gray-800 dark:text-white mb-4">Settings</h2>
+        <div class="bg-white dark:bg-gray-800 rounded-lg shadow p-6">
+          <label class="block text-sm font-medium text-gray-700 dark:text-gray-300 mb-2">
+            Overdub feedback: {Math.round((looper.feedback ?? 0.9) * 100)}%
+          </label>
+          <input
+            type="range"
+            min="0"
+            max="100"
+            step="1"
+            value={Math.round((looper.feedback ?? 0.9) * 100)}
+            disabled={!connected}
+            onInput={(e) => send({ cmd: 'setLooperFeedback', value: parseInt(e.target.value, 10) / 100 })}
+            class={`mb-6 ${sliderClass}`}
+          />
+
+          <label class="block text-sm font-medium text-gray-700 dark:text-gray-300 mb-2">
+            Loop level: {Math.round((looper.level ?? 1) * 100)}%
+          </label>
+          <input
+            type="range"
+            min="0"
+            max="100"
+            step="1"
+            value={Math.round((looper.level ?? 1) * 100)}
+            disabled={!connected}
+            onInput={(e) => send({ cmd: 'setLooperLevel', value: parseInt(e.target.value, 10) / 100 })}
+            class={`mb-6 ${sliderClass}`}
+          />
+
+          <label class="block text-sm font-medium text-gray-700 dark:text-gray-300 mb-2">
+            Storage format (change while empty)
+          </label>
+          <select
+            class={selectClass}
+            value={looper.format || 'pcm'}
+            disabled={!connected || state !== 'empty'}
+            onChange={(e) => send({ cmd: 'setLooperFormat', format: e.target.value })}
+          >
+            <option value="pcm">16-bit PCM</option>
+            <option value="ulaw">8-bit u-law (twice as long)</option>
+          </select>
+
+          <p class="text-sm text-gray-600 dark:text-gray-400 mt-4">
+            {looper.memory > 0
+              ? `Buffer: ${Math.round(looper.memory / 1024)} KB in ${looper.psram ? 'PSRAM' : 'internal RAM'}`
+              : 'Buffer is allocated on the first recording'}
+          </p>
+        </div>
+      </section>
+    </div>
+  );
+}
@@ -0,0 +1,195 @@
+import { useState } from 'preact/hooks';
+import { useWebSocket } from '../hooks/WebSocketProvider';
+import { ControlButton } from '../components/ControlButton';
+
+// Must match PresetManager::NAME_LENGTH - 1
+const MAX_NAME_LENGTH = 11;
+
+/**
+ * Presets View - Store, recall and erase the preset bank
+ */
+export function Presets() {
+  const { data, send, connected } = useWebSocket();
+
+  // Name typed per slot (used by Save; empty keeps the stored name)
+  const [names, setNames] = useState({});
+
+  // Morph endpoints and position (position is local: it changes too often
+  // to be echoed back)
+  const [morphFrom, setMorphFrom] = useState(1);
+  const [morphTo, setMorphTo] = useState(2);
+  const [morphPosition, setMorphPosition] = useState(0);
+
+  // Automation loop length in seconds (0 = set by the recording)
+  const [loopSeconds, setLoopSeconds] = useState(0);
+
+  const slots = data.presets?.slots || [];
+  const active = data.presets?.active || 0;
+  const morph = data.presets?.morph || {};
+  const usedSlots = slots.filter(entry => entry.used);
+  const automation = data.automation || {};
+
+  const selectClass = 'px-3 py-2 rounded-lg border border-gray-300 dark:border-gray-600 bg-white dark:bg-gray-700 text-gray-900 dark:text-white';
+
+  // Continuous updates while dragging (onInput, not onChange)
+  const handleMorphInput = (e) => {
+    const value = parseInt(e.target.value, 10);
+    setMorphPosition(value);
+    send({ cmd: 'setMorph', value: value / 100 });
+  };
+
+  return (
+    <div class="max-w-7xl mx-auto px-4 py-8 sm:px-6 lg:px-8">
+      <section class="mb-8">
+        <h2 class="text-xl font-semibold text-gray-800 dark:text-white mb-4">Preset Bank</h2>
+        <p class="text-sm text-gray-600 dark:text-gray-400 mb-4">
+          Load switches at an audio buffer boundary. Saving writes flash and may cause a short
+          dropout - save between phrases.
+        </p>
+
+        <div class="grid grid-cols-1 md:grid-cols-2 gap-4">
+          {slots.map(entry => (
+            <div
+              key={entry.slot}
+              class={`bg-white dark:bg-gray-800 rounded-lg shadow p-6 ${
+                entry.slot === active ? 'ring-2 ring-blue-500' : ''
+              }`}
+            >
+              <h3 class="text-lg font-medium text-gray-900 dark:text-white mb-4">
+                {entry.slot}. {entry.used ? entry.name : <span class="text-gray-400">Empty</span>}
+              </h3>
+
+              <input
+                type="text"
+                maxLength={MAX_NAME_LENGTH}
+                placeholder={entry.used ? entry.name : `Preset ${entry.slot}`}
+                value={names[entry.slot] || ''}
+                onInput={(e) => setNames(prev => ({ ...prev, [entry.slot]: e.target.value }))}
+                class="w-full mb-4 px-3 py-2 rounded-lg border border-gray-300 dark:border-gray-600 bg-white dark:bg-gray-700 text-gray-900 dark:text-white"
+              />
+
+              <div class="flex gap-2">
+                <ControlButton
+                  label="Load"
+                  variant="primary"
+                  payload={entry.used ? { cmd: 'loadPreset', slot: entry.slot } : null}
+                />
+                <ControlButton
+                  label="Save"
+                  variant="success"
+                  payload={{ cmd: 'savePreset', slot: entry.slot, name: names[entry.slot] || '' }}
+                />
+                {entry.used && (
+                  <ControlButton
+                    label="Delete"
+                    variant="danger"
+                    payload={{ cmd: 'deletePreset', slot: entry.slot }}
+                  />
+                )}
+              </div>
+            </div>
+          ))}
+        </div>
+      </section>
+
+      {/* Morph between two presets */}
+      <section class="mb-8">
+        <h2 class="text-xl font-semibold text-gray-800 dark:text-white mb-4">Morph</h2>
+        <div class="bg-white dark:bg-gray-800 rounded-lg shadow p-6">
+          <p class="text-sm text-gray-600 dark:text-gray-400 mb-4">
+            Glides oscillator volumes, effect mixes, delay feedback, reverb size and smoothing
+            between two presets. Other settings come from the first one.
+            {morph.active && ` Now morphing ${morph.from} \u2194 ${morph.to}.`}
+          </p>
+
+          <div class="flex flex-wrap gap-2 mb-4">
+            <select
+              class={selectClass}
+              value={morphFrom}
+              onChange={(e) => setMorphFrom(parseInt(e.target.value, 10))}
+            >
+              {usedSlots.map(entry => (
+                <option key={entry.slot} value={entry.slot}>{entry.slot}. {entry.name}</option>
+              ))}
+            </select>
+            <select
+              class={selectClass}
+              value={morphTo}
+              onChange={(e) => setMorphTo(parseInt(e.target.value, 10))}
+            >
+              {usedSlots.map(entry => (
+                <option key={entry.slot} value={entry.slot}>{entry.slot}. {entry.name}</option>
+              ))}
+            </select>
+            <ControlButton
+              label="Start"
+              variant="primary"
+              payload={{ cmd: 'startMorph', from: morphFrom, to: morphTo }}
+            />
+            <ControlButton label="Stop" variant="warning" payload={{ cmd: 'stopMorph' }} />
+            <select
+              class={selectClass}
+              value={morph.source || 'manual'}
+              onChange={(e) => send({ cmd: 'setMorphSource', value: e.target.value })}
+            >
+              <option value="manual">Slider</option>
+              <option value="sensor">Volume hand</option>
+            </select>
+          </div>
+
+          <input
+            type="range"
+            min="0"
+            max="100"
+            step="1"
+            value={morphPosition}
+            disabled={!connected || morph.source === 'sensor'}
+            onInput={handleMorphInput}
+            class="w-full h-2 bg-gray-200 dark:bg-gray-700 rounded-lg appearance-none cursor-pointer slider disabled:opacity-50"
+          />
+        </div>
+      </section>
+
+      {/* Automation lane */}
+      <section class="mb-8">
+        <h2 class="text-xl font-semibold text-gray-800 dark:text-white mb-4">Automation</h2>
+        <div class="bg-white dark:bg-gray-800 rounded-lg shadow p-6">
+          <p class="text-sm text-gray-600 dark:text-gray-400 mb-4">
+            Records oscillator volume and effect moves, then loops them while you play.
+            Without a fixed length, Stop ends the loop. Delay time is not recorded.
+          </p>
+          <p class="text-sm text-gray-900 dark:text-white mb-4">
+            {automation.state || 'idle'} - {automation.events || 0} events
+            {automation.lengthMs > 0 && `, loop ${(automation.lengthMs / 1000).toFixed(1)} s`}
+            {automation.dropped > 0 && ` (${automation.dropped} dropped, lane full)`}
+          </p>
+
+          <div class="flex flex-wrap gap-2">
+            <ControlButton label="Record" variant="danger" payload={{ cmd: 'recordAutomation' }} />
+            <ControlButton label="Stop" variant="primary" payload={{ cmd: 'stopAutomation' }} />
+            <ControlButton
+              label="Play"
+              variant="success"
+              payload={automation.events > 0 ? { cmd: 'playAutomation' } : null}
+            />
+            <ControlButton label="Clear" variant="warning" payload={{ cmd: 'clearAutomation' }} />
+            <input
+              type="number"
+              min="0"
+              max="600"
+              step="0.5"
+              value={loopSeconds}
+              onInput={(e) => setLoopSeconds(parseFloat(e.target.value) || 0)}
+              class={`w-24 ${selectClass}`}
+            />
+            <ControlButton
+              label="Set length (s)"
+              variant="primary"
+              payload={{ cmd: 'setAutomationLength', value: Math.round(loopSeconds * 1000) }}
+            />
+          </div>
+        </div>
+      </section>
+    </div>
+  );
+}
@@ -0,0 +1,150 @@
+import { useEffect, useRef } from 'preact/hooks';
+import { useWebSocket } from '../hooks/WebSocketProvider';
+
+const DB_FLOOR = -120;
+const DB_CEIL = 0;
+const CLIP_PEAK = 32000;
+
+/**
+ * Draw the magnitude spectrum (dBFS, linear frequency axis)
+ */
+function drawSpectrum(canvas, bins) {
+  const ctx = canvas.getContext('2d');
+  const { width, height } = canvas;
+  ctx.clearRect(0, 0, width, height);
+
+  // -20 dB grid lines
+  ctx.strokeStyle = 'rgba(156, 163, 175, 0.2)';
+  ctx.lineWidth = 1;
+  for (let db = -20; db > DB_FLOOR; db -= 20) {
+    const y = ((DB_CEIL - db) / (DB_CEIL - DB_FLOOR)) * height;
+    ctx.beginPath();
+    ctx.moveTo(0, y);
+    ctx.lineTo(width, y);
+    ctx.stroke();
+  }
+
+  if (!bins || bins.length === 0) return;
+
+  const barWidth = width / bins.length;
+  ctx.fillStyle = '#60a5fa';
+  bins.forEach((db, i) => {
+    const h = ((Math.max(db, DB_FLOOR) - DB_FLOOR) / (DB_CEIL - DB_FLOOR)) * height;
+    ctx.fillRect(i * barWidth, height - h, Math.max(barWidth - 1, 1), h);
+  });
+}
+
+/**
+ * Draw the triggered scope trace (full scale = ±128)
+ */
+function drawTrace(canvas, trace) {
+  const ctx = canvas.getContext('2d');
+  const { width, height } = canvas;
+  ctx.clearRect(0, 0, width, height);
+
+  ctx.strokeStyle = 'rgba(156, 163, 175, 0.3)';
+  ctx.lineWidth = 1;
+  ctx.beginPath();
+  ctx.moveTo(0, height / 2);
+  ctx.lineTo(width, height / 2);
+  ctx.stroke();
+
+  if (!trace || trace.length === 0) return;
+
+  ctx.strokeStyle = '#34d399';
+  ctx.lineWidth = 2;
+  ctx.beginPath();
+  trace.forEach((v, i) => {
+    const x = (i / (trace.length - 1)) * width;
+    const y = height / 2 - (v / 128) * (height / 2);
+    if (i === 0) ctx.moveTo(x, y);
+    else ctx.lineTo(x, y);
+  });
+  ctx.stroke();
+}
+
+export default function Scope() {
+  const { data, send, connected } = useWebSocket();
+  const scope = data.scope;
+  const spectrumRef = useRef(null);
+  const traceRef = useRef(null);
+
+  // Subscribe while this view is open (the analyzer only runs when watched)
+  useEffect(() => {
+    if (!connected) return;
+    send({ cmd: 'setScope', enabled: true });
+    return () => send({ cmd: 'setScope', enabled: false });
+  }, [connected, send]);
+
+  useEffect(() => {
+    if (spectrumRef.current) drawSpectrum(spectrumRef.current, scope.bins);
+    if (traceRef.current) drawTrace(traceRef.current, scope.trace);
+  }, [scope]);
+
+  const hasData = scope && scope.bins;
+  const nyquist = hasData ? scope.sampleRate / 2 : 0;
+  const traceMs = hasData ? (scope.trace.length * scope.scopeStep * 1000) / scope.sampleRate : 0;
+  const peakDb = hasData && scope.peak > 0 ? 20 * Math.log10(scope.peak / 32768) : null;
+  const clipping = hasData && scope.peak >= CLIP_PEAK;
+
+  return (
+    <div className="space-y-6">
+      <h2 className="text-2xl font-bold">Scope</h2>
+
+      {!hasData ? (
+        <div className="bg-gray-800 rounded-lg p-8 text-center">
+          <p className="text-gray-400 text-lg">Waiting for analyzer...</p>
+        </div>
+      ) : (
+        <div className="bg-gray-800 rounded-lg p-4 flex gap-6 text-sm">
+          <div>
+            <span className="text-gray-400">Peak:</span>
+            <span className={`ml-2 font-medium ${clipping ? 'text-red-400' : ''}`}>
+              {peakDb !== null ? `${peakDb.toFixed(1)} dBFS` : 'silence'}
+            </span>
+          </div>
+          <div>
+            <span className="text-gray-400">Sample rate:</span>
+            <span className="ml-2 font-medium">{scope.sampleRate} Hz</span>
+          </div>
+          {clipping && (
+            <span className="px-3 py-1 rounded text-sm font-medium bg-red-500/20 text-red-400">
+              NEAR CLIPPING
+            </span>
+          )}
+        </div>
+      )}
+
+      {/* Spectrum */}
+      <div className="bg-gray-800 rounded-lg p-4">
+        <div className="flex justify-between mb-2 text-sm text-gray-400">
+          <span>Spectrum (0 to -120 dBFS)</span>
+          <span>{nyquist ? `0 - ${(nyquist / 1000).toFixed(1)} kHz` : ''}</span>
+        </div>
+        <canvas ref={spectrumRef} width={512} height={200} className="w-full h-48 bg-gray-900 rounded" />
+      </div>
+
+      {/* Scope trace */}
+      <div className="bg-gray-800 rounded-lg p-4">
+        <div className="flex justify-between mb-2 text-sm text-gray-400">
+          <span>Output waveform</span>
+          <span>{traceMs ? `${traceMs.toFixed(1)} ms` : ''}</span>
+        </div>
+        <canvas ref={traceRef} width={512} height={160} className="w-full h-40 bg-gray-900 rounded" />
+      </div>
+
+      {/* Info Section */}
+      <div className="bg-gray-800/50 rounded-lg p-4 text-sm text-gray-400">
+        <p className="mb-2">
+          <strong className="text-gray-300">About the Scope:</strong>
+        </p>
+        <ul className="list-disc list-inside space-y-1 ml-2">
+          <li>Shows the final output after effects and the master bus</li>
+          <li>Spectrum: 256-point FFT, Hann window, updated 20 times per second</li>
+          <li>Mirrored partials folding down from Nyquist are aliasing</li>
+          <li>With no note playing, the spectrum shows the reverb/noise floor</li>
+        </ul>
+      </div>
+    </div>
+  );
+}
@@ -13,6 +13,7 @@ export function Sensors() {
   const [pitchSmoothing, setPitchSmoothing] = useState('1');
   const [volumeSmoothing, setVolumeSmoothing] = useState('1');
   const [frequencyRange, setFrequencyRange] = useState('1');
+  const [quality, setQuality] = useState('0');
 
   // Sync local state with WebSocket data when it updates
   useEffect(() => {
@@ -26,6 +27,9 @@ export function Sensors() {
       if (data.system.frequencyRange !== undefined) {
         setFrequencyRange(String(data.system.frequencyRange));
       }
+      if (data.system.quality !== undefined) {
+        setQuality(String(data.system.quality));
+      }
     }
   }, [data.system]);
 
@@ -43,6 +47,12 @@ export function Sensors() {
     { value: '2', label: 'Wide (3 Octaves)' }
   ];
 
+  // Oscillator render quality options
+  const qualityOptions = [
+    { value: '0', label: 'Standard' },
+    { value: '1', label: 'High (2x Oversampled)' }
+  ];
+
   return (
     <div class="max-w-7xl mx-auto px-4 py-8 sm:px-6 lg:px-8">
 
@@ -159,6 +169,36 @@ export function Sensors() {
           </div>
         </div>
       </section>
+
+      {/* Audio Quality Configuration */}
+      <section class="mb-8">
+        <h2 class="text-xl font-semibold text-gray-800 dark:text-white mb-4">Audio Quality</h2>
+
+        <div class="bg-white dark:bg-gray-800 rounded-lg shadow p-6">
+          <h3 class="text-lg font-medium text-gray-900 dark:text-white mb-4">Oscillator Rendering</h3>
+          <p class="text-sm text-gray-600 dark:text-gray-400 mb-4">
+            High renders the oscillators at twice the sample rate to remove aliasing on high notes.
+            Oscillator render time: {data.performance?.oscTime?.toFixed(2) || '0'} ms per block.
+          </p>
+
+          <CommandSelect
+            label="Quality Preset"
+            options={qualityOptions.map(opt => opt.label)}
+            value={qualityOptions.find(opt => opt.value === quality)?.label || 'Standard'}
+            onChange={(label) => {
+              const option = qualityOptions.find(opt => opt.label === label);
+              if (option) setQuality(option.value);
+            }}
+            commandGenerator={(label) => {
+              const option = qualityOptions.find(opt => opt.label === label);
+              return {
+                cmd: 'setQuality',
+                value: parseInt(option?.value || '0', 10)
+              };
+            }}
+          />
+        </div>
+      </section>
     </div>
   );
 }
@@ -105,8 +105,8 @@ export default function Tuner() {
           <strong className="text-gray-300">About the Tuner:</strong>
         </p>
         <ul className="list-disc list-inside space-y-1 ml-2">
-          <li>The tuner calculates note information directly from the theremin's frequency</li>
-          <li>No microphone needed - data comes directly from the ESP32</li>
+          <li>The pitch is measured from the audio output, so octave shifts, glides and effects show up</li>
+          <li>No microphone needed - the ESP32 analyzes its own output signal</li>
           <li>"In tune" means within ±10 cents of perfect pitch</li>
           <li>100 cents = 1 semitone (musical half-step)</li>
         </ul>
@@ -1,20 +1,49 @@
 import { defineConfig } from 'vite';
 import preact from '@preact/preset-vite';
+import { readdirSync, readFileSync, writeFileSync, unlinkSync } from 'fs';
+import { resolve } from 'path';
+import { fileURLToPath } from 'url';
+import { gzipSync, constants } from 'zlib';
+
+// Replace every text asset in the output folder with a gzip copy (name.gz).
+// The ESP32 sends these as they are, with Content-Encoding: gzip, so
+// LittleFS only holds the compressed files.
+function gzipAssets(outDir) {
+  return {
+    name: 'gzip-assets',
+    apply: 'build',
+    closeBundle() {
+      for (const file of readdirSync(outDir)) {
+        if (!/\.(html|js|css|svg|json)$/.test(file)) continue;
+        const path = resolve(outDir, file);
+        const source = readFileSync(path);
+        const compressed = gzipSync(source, { level: constants.Z_BEST_COMPRESSION });
+        writeFileSync(`${path}.gz`, compressed);
+        unlinkSync(path);
+        console.log(`gzip: ${file} ${source.length} -> ${compressed.length} bytes`);
+      }
+    }
+  };
+}
+
+const outDir = fileURLToPath(new URL('../data', import.meta.url));
 
 // https://vitejs.dev/config/
 export default defineConfig({
-  plugins: [preact()],
+  plugins: [preact(), gzipAssets(outDir)],
 
   build: {
-    outDir: '../data',
+    outDir,
     emptyOutDir: true,
     minify: 'esbuild',
     cssCodeSplit: false,
     rollupOptions: {
       output: {
         manualChunks: undefined,
-        entryFileNames: 'app.js',
-        assetFileNames: 'app.[ext]'
+        // Content hash in the name: the ESP32 lets browsers cache these
+        // forever, a new build gets new names (index.html is revalidated)
+        entryFileNames: 'app.[hash].js',
+        assetFileNames: 'app.[hash].[ext]'
       }
     },
     target: 'es2015',